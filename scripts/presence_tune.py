@@ -0,0 +1,417 @@
+#!/usr/bin/env python3
+"""Tunes the presence algorithm settings on the selftest scenarios.
+
+The presence library only runs on the device, so the device replays the
+labeled scenarios: for every setting of the search, "selftest <key=value> ..."
+runs the simulated scenarios through a private presence instance with the
+setting, and "benchmark <key=value> ..." measures its processing time. The
+live detection and the stored settings are not changed. With several boards,
+one worker thread per board evaluates settings in parallel.
+
+    python3 presence_tune.py --port /dev/ttyACM0 --port /dev/ttyACM1 \\
+        --param macro_threshold=0.5:2.0:0.25 --param micro_threshold=6.25,12.5,25 \\
+        --param max_range_bin=3:6 --header tuned_presence_config.h
+
+A parameter is a list of values or a start:stop[:step] range. The keys are the
+fields macro_threshold, micro_threshold, min_range_bin, max_range_bin,
+macro_compare_interval_ms and micro_fft_size of xensiv_radar_presence_config_t.
+"--search random --trials N" samples N settings of the grid instead of
+running all of them.
+
+Every setting is scored in one mode (--mode) against the presence intervals
+of the scenarios, which the device prints from source/selftest_scenarios.c
+as "[SELFTEST] label" lines with every run (--labels replaces them): frame
+precision and recall, false alarms, the detection latency after a person
+enters and the mean presence processing time per frame. Frames within --exit-grace-ms after a person left are not scored, as
+the algorithm keeps reporting presence for its movement validity time. The
+best setting has the highest F1 score, then the fewest false alarms, then the
+lowest latency and processing time. It is exported with --header as a
+complete configuration based on the defaults of source/presence_settings.h.
+
+"--score capture.log" scores a captured selftest output without a device.
+
+Scope: this is not an offline replay tuner. The presence library exists only
+as a Cortex-M4 binary, so neither recorded raw_stream captures nor scene_gen
+streams can be run through it on Linux, and the evaluation is bound to the
+connected boards: settings run in parallel across boards, not host cores.
+The labeled data are the simulated selftest scenarios, all of which a board
+runs for every setting. Bayesian search is not offered, as the scripts use
+the standard library only.
+"""
+
+import argparse
+import csv
+import itertools
+import json
+import os
+import queue
+import random
+import re
+import select
+import sys
+import termios
+import time
+from concurrent.futures import ThreadPoolExecutor, as_completed
+
+from selftest_compare import parse_labels, parse_lines
+
+FRAME_MS = 100
+
+KEYS = ("macro_threshold", "micro_threshold", "min_range_bin", "max_range_bin",
+        "macro_compare_interval_ms", "micro_fft_size")
+FLOAT_KEYS = ("macro_threshold", "micro_threshold")
+BOOL_KEYS = ("macro_fft_bandpass_filter_enabled", "micro_fft_decimation_enabled")
+
+# Fields of the "[SELFTEST] config" line
+CONFIG_FIELDS = ("min_range_bin", "max_range_bin", "macro_threshold", "micro_threshold",
+                 "macro_fft_bandpass_filter_enabled", "micro_fft_decimation_enabled",
+                 "macro_compare_interval_ms", "micro_fft_size")
+
+DEFAULT_GRID = [
+    "macro_threshold=0.5,1.0,1.5,2.0",
+    "micro_threshold=6.25,12.5,25,50",
+    "max_range_bin=3:6",
+]
+
+SETTINGS_HEADER = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                               "..", "source", "presence_settings.h")
+
+
+class Board:
+    """Console of one board, commands are sent in the settings mode."""
+
+    def __init__(self, port, timeout):
+        self.port = port
+        self.timeout = timeout
+        self.buffer = b""
+        self.fd = os.open(port, os.O_RDWR | os.O_NOCTTY)
+        attributes = termios.tcgetattr(self.fd)
+        attributes[0] = 0
+        attributes[1] = 0
+        attributes[2] = termios.CS8 | termios.CREAD | termios.CLOCAL
+        attributes[3] = 0
+        attributes[4] = attributes[5] = termios.B115200
+        attributes[6][termios.VMIN] = 0
+        attributes[6][termios.VTIME] = 0
+        termios.tcsetattr(self.fd, termios.TCSANOW, attributes)
+        termios.tcflush(self.fd, termios.TCIOFLUSH)
+
+        # The first line enters the settings mode, in the settings mode it is an empty command
+        os.write(self.fd, b"\r")
+        self.read_until(lambda line: line.endswith("> "), partial=True)
+
+    def close(self):
+        os.write(self.fd, b"\x1b")
+        os.close(self.fd)
+
+    def read_until(self, done, partial=False):
+        """Returns the lines up to the first line for which done() is true."""
+        lines = []
+        deadline = time.monotonic() + self.timeout
+
+        while True:
+            while b"\n" in self.buffer:
+                raw, self.buffer = self.buffer.split(b"\n", 1)
+                line = raw.decode(errors="replace").strip("\r")
+                lines.append(line)
+                if done(line):
+                    return lines
+            if partial and done(self.buffer.decode(errors="replace")):
+                self.buffer = b""
+                return lines
+
+            remaining = deadline - time.monotonic()
+            if remaining <= 0:
+                raise TimeoutError("%s: no response" % self.port)
+            ready, _, _ = select.select([self.fd], [], [], remaining)
+            if ready:
+                self.buffer += os.read(self.fd, 4096)
+
+    def command(self, command, done):
+        os.write(self.fd, command.encode() + b"\r")
+        return self.read_until(done)
+
+
+def parse_values(key, spec):
+    """Returns the values of a list "a,b,c" or a range "start:stop[:step]"."""
+    convert = float if key in FLOAT_KEYS else int
+
+    if ":" not in spec:
+        return [convert(value) for value in spec.split(",")]
+
+    parts = [convert(value) for value in spec.split(":")]
+    start, stop = parts[0], parts[1]
+    step = parts[2] if len(parts) > 2 else convert(1)
+    if step <= 0:
+        raise ValueError("%s: the step must be positive" % key)
+
+    values = []
+    index = 0
+    while start + index * step <= stop + 1e-9:
+        values.append(round(start + index * step, 6) if convert is float else start + index * step)
+        index += 1
+    return values
+
+
+def override_args(setting):
+    return " ".join("%s=%s" % (key, setting[key]) for key in KEYS if key in setting)
+
+
+def state_at(events, timestamp):
+    """Returns true if the stream reports presence at the timestamp."""
+    present = False
+    for event in events:
+        if event[0] > timestamp:
+            break
+        present = event[1] != "absence"
+    return present
+
+
+def score(streams, skipped, mode, scenarios, exit_grace_ms):
+    """Returns the detection metrics of one mode over all scenarios.
+
+    The scenarios map a name to its frames and presence intervals in ms, as
+    printed by the device in the "[SELFTEST] label" lines.
+    """
+    if not scenarios:
+        raise ValueError("no presence labels, the selftest output has no label lines and --labels is not given")
+
+    true_positives = false_positives = false_negatives = 0
+    false_alarms = 0
+    latencies = []
+    missed = 0
+
+    for name, scenario in scenarios.items():
+        key = (name, mode)
+        if key not in streams:
+            raise ValueError("no selftest output for %s %s" % key)
+        events = streams[key]
+        frames = skipped.get(key, (0, scenario["frames"]))[1]
+        intervals = scenario["present"]
+
+        for frame in range(frames):
+            timestamp = frame * FRAME_MS
+            truth = any(start <= timestamp < end for start, end in intervals)
+            if not truth and any(end <= timestamp < end + exit_grace_ms for _, end in intervals):
+                continue
+            detected = state_at(events, timestamp)
+            true_positives += truth and detected
+            false_positives += detected and not truth
+            false_negatives += truth and not detected
+
+        for start, end in intervals:
+            if state_at(events, start):
+                latencies.append(0)
+                continue
+            detection = next((event[0] for event in events
+                              if start <= event[0] < end and event[1] != "absence"), None)
+            if detection is None:
+                missed += 1
+            else:
+                latencies.append(detection - start)
+
+        previous = False
+        for event in events:
+            present = event[1] != "absence"
+            expected = any(start <= event[0] < end + exit_grace_ms for start, end in intervals)
+            false_alarms += present and not previous and not expected
+            previous = present
+
+    precision = true_positives / max(1, true_positives + false_positives)
+    recall = true_positives / max(1, true_positives + false_negatives)
+    f1 = 2 * precision * recall / max(1e-9, precision + recall)
+
+    return {
+        "precision": precision,
+        "recall": recall,
+        "f1": f1,
+        "false_alarms": false_alarms,
+        "missed": missed,
+        "latency_mean_ms": sum(latencies) / len(latencies) if latencies else 0.0,
+        "latency_max_ms": max(latencies, default=0),
+    }
+
+
+def evaluate(board, setting, mode, scenarios, exit_grace_ms, benchmark):
+    """Runs selftest and benchmark with the setting, returns the result row."""
+    overrides = override_args(setting)
+    lines = board.command(("selftest " + overrides).strip(),
+                          lambda line: line.startswith(("[SELFTEST] done", "[SELFTEST] invalid")))
+    if not lines[-1].startswith("[SELFTEST] done 0"):
+        return dict(setting, error=lines[-1])
+
+    config, streams, skipped = parse_lines(lines)
+    result = dict(setting, **score(streams, skipped, mode, scenarios or parse_labels(lines), exit_grace_ms))
+    result["config"] = dict(zip(CONFIG_FIELDS, config))
+
+    if benchmark:
+        lines = board.command(("benchmark " + overrides).strip(),
+                              lambda line: '"core_hz"' in line or '"invalid"' in line)
+        for line in lines:
+            start = line.find("[BENCHMARK] ")
+            if start >= 0:
+                report = json.loads(line[start + len("[BENCHMARK] "):])
+                if report.get("kernel") == "presence_" + mode:
+                    result["cpu_us"] = report["ns_mean"] / 1000.0
+
+    return result
+
+
+def rank(result):
+    return (-result["f1"], result["false_alarms"], result["latency_mean_ms"], result.get("cpu_us", 0.0))
+
+
+def default_config():
+    """Returns the fields of default_config in presence_settings.h as strings."""
+    with open(SETTINGS_HEADER) as header:
+        text = header.read()
+    body = text[text.index("default_config"):]
+    body = body[body.index("{") + 1:body.index("};")]
+    return re.findall(r"\.(\w+)\s*=\s*([^,\n]+)", body)
+
+
+def write_header(path, result, mode, exit_grace_ms):
+    """Writes the configuration the best setting was tested with, the other fields are the defaults."""
+    tested = dict(result["config"], mode="XENSIV_RADAR_PRESENCE_MODE_" + mode.upper())
+    fields = []
+    for name, value in default_config():
+        if name in FLOAT_KEYS and name in tested:
+            value = "%gf" % tested[name]
+            if "." not in value and "e" not in value:
+                value = value[:-1] + ".0f"
+        elif name in BOOL_KEYS and name in tested:
+            value = "true" if tested[name] else "false"
+        elif name in tested:
+            value = tested[name] if name == "mode" else str(int(tested[name]))
+        fields.append((name, value.strip()))
+
+    guard = re.sub(r"\W", "_", os.path.basename(path)).upper()
+    width = max(len(name) for name, _ in fields)
+
+    with open(path, "w") as header:
+        header.write("/*\n * Presence settings tuned on the selftest scenarios in %s mode by\n"
+                     " * presence_tune.py: F1 %.3f, precision %.3f, recall %.3f,\n"
+                     " * %d false alarms, mean latency %.0f ms, exit grace %d ms\n */\n\n"
+                     % (mode, result["f1"], result["precision"], result["recall"],
+                        result["false_alarms"], result["latency_mean_ms"], exit_grace_ms))
+        header.write("#ifndef %s\n#define %s\n\n" % (guard, guard))
+        header.write('#include "radar_low_framerate_config.h"\n#include "xensiv_radar_presence.h"\n\n')
+        header.write("static const xensiv_radar_presence_config_t tuned_config =\n{\n")
+        header.write(",\n".join("    .%-*s = %s" % (width, name, value) for name, value in fields))
+        header.write("\n};\n\n#endif /* %s */\n" % guard)
+
+
+def print_result(result):
+    setting = " ".join("%s=%s" % (key, result[key]) for key in KEYS if key in result)
+    if "error" in result:
+        print("%s: %s" % (setting or "current", result["error"]))
+        return
+    print("%s: F1 %.3f precision %.3f recall %.3f false alarms %d missed %d latency %.0f/%d ms%s" %
+          (setting or "current", result["f1"], result["precision"], result["recall"],
+           result["false_alarms"], result["missed"], result["latency_mean_ms"], result["latency_max_ms"],
+           (" cpu %.0f us" % result["cpu_us"]) if "cpu_us" in result else ""))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--port", action="append", default=[],
+                        help="serial port of a board, repeat for parallel boards")
+    parser.add_argument("--param", action="append", default=[], metavar="KEY=VALUES",
+                        help="searched values, a list a,b,c or a range start:stop[:step]")
+    parser.add_argument("--search", choices=("grid", "random"), default="grid",
+                        help="runs the whole grid or --trials random settings of it")
+    parser.add_argument("--trials", type=int, default=32, help="settings of a random search, default 32")
+    parser.add_argument("--seed", type=int, default=1, help="seed of the random search")
+    parser.add_argument("--mode", default="micro_if_macro",
+                        choices=("macro_only", "micro_only", "micro_if_macro", "micro_and_macro"),
+                        help="scored mode, default micro_if_macro")
+    parser.add_argument("--labels", help="JSON file with the frames and presence intervals (ms) per scenario, "
+                        "replaces the [SELFTEST] label lines of the device")
+    parser.add_argument("--exit-grace-ms", type=int, default=5000,
+                        help="unscored time after a person left, default 5000 ms")
+    parser.add_argument("--no-benchmark", action="store_true", help="skips the processing time measurement")
+    parser.add_argument("--timeout", type=float, default=300.0, help="response timeout per command in seconds")
+    parser.add_argument("--csv", help="writes the results of all settings")
+    parser.add_argument("--header", help="writes the best setting as a C header")
+    parser.add_argument("--score", metavar="LOG", help="scores a captured selftest output instead")
+    args = parser.parse_args()
+
+    # The labels are printed by the device with every selftest run unless they are given
+    scenarios = None
+    if args.labels:
+        with open(args.labels) as labels:
+            scenarios = json.load(labels)
+
+    if args.score:
+        with open(args.score, errors="replace") as log:
+            lines = log.readlines()
+        _, streams, skipped = parse_lines(lines)
+        scenarios = scenarios or parse_labels(lines)
+        if not scenarios:
+            parser.error("%s has no [SELFTEST] label lines, give the presence intervals with --labels" % args.score)
+        print_result(score(streams, skipped, args.mode, scenarios, args.exit_grace_ms))
+        return 0
+
+    if not args.port:
+        parser.error("at least one --port is required")
+
+    grid = {}
+    for param in args.param or DEFAULT_GRID:
+        key, _, spec = param.partition("=")
+        if key not in KEYS or not spec:
+            parser.error("unknown parameter %s, the keys are %s" % (param, ", ".join(KEYS)))
+        grid[key] = parse_values(key, spec)
+
+    settings = [dict(zip(grid, values)) for values in itertools.product(*grid.values())]
+    if args.search == "random" and args.trials < len(settings):
+        settings = random.Random(args.seed).sample(settings, args.trials)
+    print("%d settings on %d boards" % (len(settings), len(args.port)))
+
+    boards = queue.Queue()
+    for port in args.port:
+        boards.put(Board(port, args.timeout))
+
+    def run(setting):
+        board = boards.get()
+        try:
+            return evaluate(board, setting, args.mode, scenarios, args.exit_grace_ms, not args.no_benchmark)
+        finally:
+            boards.put(board)
+
+    results = []
+    try:
+        with ThreadPoolExecutor(max_workers=len(args.port)) as pool:
+            for future in as_completed([pool.submit(run, setting) for setting in settings]):
+                result = future.result()
+                results.append(result)
+                print_result(result)
+    finally:
+        while not boards.empty():
+            boards.get().close()
+
+    scored = sorted((result for result in results if "error" not in result), key=rank)
+    if not scored:
+        print("no setting was evaluated")
+        return 1
+
+    print("best:")
+    print_result(scored[0])
+
+    if args.csv:
+        columns = [key for key in KEYS if key in grid] + \
+                  ["f1", "precision", "recall", "false_alarms", "missed",
+                   "latency_mean_ms", "latency_max_ms", "cpu_us", "error"]
+        with open(args.csv, "w", newline="") as table:
+            writer = csv.DictWriter(table, columns, extrasaction="ignore")
+            writer.writeheader()
+            writer.writerows(sorted(results, key=lambda result: rank(result) if "error" not in result
+                                    else (1.0, 0, 0, 0)))
+
+    if args.header:
+        write_header(args.header, scored[0], args.mode, args.exit_grace_ms)
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,141 @@
+#!/usr/bin/env python3
+"""Decoder of the raw frame stream of the presence application.
+
+Reads a log of the console UART, decodes the "[RAW] <base64>" lines sent
+after "set_raw_stream <decimation>" and writes the frames as little endian
+uint16 samples in FIFO order. Prints the compression ratio of the capture.
+
+    python3 raw_stream_decode.py capture.log -o frames.bin
+"""
+
+import argparse
+import base64
+import binascii
+import struct
+import sys
+import zlib
+
+HEADER = struct.Struct("<BBHHHI")
+VERSION = 1
+SAMPLE_BITS = 12
+K_BITS = 4
+K_RAW = 15
+ESCAPE = 16
+ESCAPE_BITS = SAMPLE_BITS + 1
+LINE_PREFIX = "[RAW] "
+
+
+class BitReader:
+    """MSB first bit reader, the counterpart of raw_stream_put_bits."""
+
+    def __init__(self, data):
+        self.value = int.from_bytes(data, "big")
+        self.remaining = len(data) * 8
+
+    def read(self, count):
+        if count > self.remaining:
+            raise ValueError("truncated bit stream")
+        self.remaining -= count
+        return (self.value >> self.remaining) & ((1 << count) - 1)
+
+    def read_unary(self):
+        """Number of ones before a zero, ESCAPE if ESCAPE ones follow."""
+        ones = 0
+        while ones < ESCAPE and self.read(1):
+            ones += 1
+        return ones
+
+
+def decompress(payload, num_blocks, block_size, stride):
+    reader = BitReader(payload)
+    samples = []
+
+    for _ in range(num_blocks):
+        k = reader.read(K_BITS)
+        if k == K_RAW:
+            samples.extend(reader.read(SAMPLE_BITS) for _ in range(block_size))
+            continue
+
+        block = [reader.read(SAMPLE_BITS) for _ in range(stride)]
+        for i in range(stride, block_size):
+            quotient = reader.read_unary()
+            if quotient == ESCAPE:
+                residual = reader.read(ESCAPE_BITS)
+            else:
+                residual = (quotient << k) | reader.read(k)
+            delta = (residual >> 1) ^ -(residual & 1)
+            block.append(block[i - stride] + delta)
+        samples.extend(block)
+
+    if any(not 0 <= s < (1 << SAMPLE_BITS) for s in samples):
+        raise ValueError("sample out of range")
+
+    return samples
+
+
+def decode_frame(frame):
+    if len(frame) < HEADER.size + 4:
+        raise ValueError("frame too short")
+
+    crc, = struct.unpack_from("<I", frame, len(frame) - 4)
+    if zlib.crc32(frame[:-4]) != crc:
+        raise ValueError("CRC mismatch")
+
+    version, antennas, samples_per_chirp, chirps, sequence, timestamp = HEADER.unpack_from(frame)
+    if version != VERSION:
+        raise ValueError("unsupported version %d" % version)
+
+    block_size = samples_per_chirp * antennas
+    samples = decompress(frame[HEADER.size:-4], chirps, block_size, antennas)
+
+    return sequence, timestamp, antennas, samples
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("log", nargs="?", type=argparse.FileType("r", errors="replace"),
+                        default=sys.stdin, help="console log, stdin if omitted")
+    parser.add_argument("-o", "--output", type=argparse.FileType("wb"),
+                        help="file for the samples, uint16 little endian, frame after frame")
+    args = parser.parse_args()
+
+    frames = errors = gaps = 0
+    raw_bytes = compressed_bytes = line_bytes = 0
+    last_sequence = None
+
+    for line in args.log:
+        start = line.find(LINE_PREFIX)
+        if start < 0:
+            continue
+        text = line[start + len(LINE_PREFIX):].strip()
+
+        try:
+            frame = base64.b64decode(text, validate=True)
+            sequence, timestamp, antennas, samples = decode_frame(frame)
+        except (binascii.Error, ValueError) as error:
+            errors += 1
+            print("frame %d: %s" % (frames + errors, error), file=sys.stderr)
+            continue
+
+        if last_sequence is not None:
+            gaps += (sequence - last_sequence - 1) & 0xFFFF
+        last_sequence = sequence
+
+        frames += 1
+        raw_bytes += len(samples) * SAMPLE_BITS // 8
+        compressed_bytes += len(frame)
+        line_bytes += len(LINE_PREFIX) + len(text) + 2
+
+        if args.output:
+            args.output.write(struct.pack("<%dH" % len(samples), *samples))
+
+    print("frames %d, corrupted %d, skipped by the device %d" % (frames, errors, gaps))
+    if frames:
+        print("12 bit samples %d bytes, compressed %d bytes, ratio %.2f, on the UART %d bytes"
+              % (raw_bytes, compressed_bytes, raw_bytes / compressed_bytes, line_bytes))
+
+    return 1 if errors else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
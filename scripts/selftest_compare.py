@@ -0,0 +1,149 @@
+#!/usr/bin/env python3
+"""Compares the output of the selftest command with a golden capture.
+
+Capture the console output of "selftest" with a reference build as the
+golden file and with the build under test, then:
+
+    python3 selftest_compare.py golden.log capture.log
+
+The event streams of every scenario and mode must report the same states in
+the same order. Timestamps and range bins may differ within the tolerances,
+which absorb float differences of optimized kernels. The exit code is 1 if a
+stream differs.
+
+A golden capture with the frame change gate disabled ("set_change_gate 0")
+and a capture with the gate enabled validate the gate: for every stream with
+skipped frames, the skipped share and the largest event delay are printed.
+"""
+
+import argparse
+import sys
+
+PREFIX = "[SELFTEST] "
+
+
+def parse_lines(lines):
+    """Returns the configuration, the event streams and the skipped frames of the lines of a capture."""
+    config = None
+    streams = {}
+    skipped = {}
+    ended = set()
+
+    for line in lines:
+        start = line.find(PREFIX)
+        if start < 0:
+            continue
+        fields = line[start + len(PREFIX):].split()
+
+        if fields[0] == "config":
+            config = [float(value) for value in fields[1:]]
+        elif fields[0] == "label":
+            continue
+        elif len(fields) == 5 and fields[2] == "skipped":
+            skipped[(fields[0], fields[1])] = (int(fields[3]), int(fields[4]))
+        elif len(fields) == 5 and fields[2] == "end":
+            ended.add((fields[0], fields[1]))
+            if int(fields[4]) > 0:
+                print("%s %s: %s events were not kept" % (fields[0], fields[1], fields[4]),
+                      file=sys.stderr)
+        elif len(fields) == 5:
+            key = (fields[0], fields[1])
+            streams.setdefault(key, []).append((int(fields[2]), fields[3], int(fields[4])))
+
+    for key in ended:
+        streams.setdefault(key, [])
+
+    return config, streams, skipped
+
+
+def parse_labels(lines):
+    """Returns the frames and presence intervals (ms) per scenario of the "[SELFTEST] label" lines."""
+    labels = {}
+
+    for line in lines:
+        start = line.find(PREFIX + "label ")
+        if start < 0:
+            continue
+        fields = line[start + len(PREFIX):].split()
+        labels[fields[1]] = {
+            "frames": int(fields[2]),
+            "present": [[int(value) for value in interval.split("-")] for interval in fields[3:]],
+        }
+
+    return labels
+
+
+def parse(path):
+    """Returns the configuration, the event streams and the skipped frames of a capture."""
+    with open(path, errors="replace") as log:
+        return parse_lines(log)
+
+
+def delay(golden, actual):
+    """Returns the largest delay of the events of a stream against the golden stream."""
+    return max([event[0] - expected[0] for expected, event in zip(golden, actual)], default=0)
+
+
+def compare(name, golden, actual, time_tolerance, bin_tolerance):
+    errors = []
+
+    if len(golden) != len(actual):
+        errors.append("%d events instead of %d" % (len(actual), len(golden)))
+
+    for index, (expected, event) in enumerate(zip(golden, actual)):
+        if event[1] != expected[1]:
+            errors.append("event %d is %s instead of %s" % (index, event[1], expected[1]))
+            break
+        if abs(event[0] - expected[0]) > time_tolerance:
+            errors.append("event %d at %d ms instead of %d ms" % (index, event[0], expected[0]))
+        if abs(event[2] - expected[2]) > bin_tolerance:
+            errors.append("event %d in bin %d instead of %d" % (index, event[2], expected[2]))
+
+    for error in errors:
+        print("%s: %s" % (name, error))
+
+    return not errors
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("golden", help="capture of the reference build")
+    parser.add_argument("capture", help="capture of the build under test")
+    parser.add_argument("--time-tolerance-ms", type=int, default=200,
+                        help="allowed timestamp difference, default 200 ms (two frames)")
+    parser.add_argument("--bin-tolerance", type=int, default=1,
+                        help="allowed range bin difference, default 1")
+    args = parser.parse_args()
+
+    golden_config, golden, _ = parse(args.golden)
+    config, actual, skipped = parse(args.capture)
+
+    if not golden:
+        print("no selftest output in %s" % args.golden)
+        return 1
+
+    if golden_config is not None and config is not None and \
+            any(abs(a - b) > 1e-6 * max(1.0, abs(a)) for a, b in zip(golden_config, config)):
+        print("the configurations differ, the streams are not comparable")
+        return 1
+
+    passed = 0
+    for key in sorted(golden):
+        name = "%s %s" % key
+        if key not in actual:
+            print("%s: missing" % name)
+        else:
+            if compare(name, golden[key], actual[key], args.time_tolerance_ms, args.bin_tolerance):
+                passed += 1
+            frames_skipped, frames = skipped.get(key, (0, 0))
+            if frames_skipped > 0:
+                print("%s: %d of %d frames skipped, events up to %d ms later" %
+                      (name, frames_skipped, frames, delay(golden[key], actual[key])))
+
+    print("%d of %d streams match" % (passed, len(golden)))
+
+    return 0 if passed == len(golden) else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
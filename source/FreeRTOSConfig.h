@@ -95,10 +95,16 @@
 #define configUSE_DAEMON_TASK_STARTUP_HOOK      0
 
 /* Run time and task stats gathering related definitions. */
-#define configGENERATE_RUN_TIME_STATS           0
+#define configGENERATE_RUN_TIME_STATS           1
 #define configUSE_TRACE_FACILITY                1
 #define configUSE_STATS_FORMATTING_FUNCTIONS    0
 
+/* The run time counter is a free running 1 MHz TCPWM timer, see task_stats.c */
+extern void task_stats_timer_init(void);
+extern uint32_t task_stats_timer_read(void);
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()    task_stats_timer_init()
+#define portGET_RUN_TIME_COUNTER_VALUE()            task_stats_timer_read()
+
 /* Co-routine related definitions. */
 #define configUSE_CO_ROUTINES                   0
 #define configMAX_CO_ROUTINE_PRIORITIES         1
@@ -111,6 +117,7 @@
 
 #define configAPPLICATION_PROVIDES_cOutputBuffer        0
 #define configCOMMAND_INT_MAX_OUTPUT_SIZE               128
+#define configCOMMAND_INT_MAX_PARAMETERS                8
 
 /*
 Interrupt nesting behavior configuration.
@@ -168,8 +175,8 @@ to exclude the API function. */
 #define INCLUDE_vTaskDelay                      1
 #define INCLUDE_xTaskGetSchedulerState          1
 #define INCLUDE_xTaskGetCurrentTaskHandle       1
-#define INCLUDE_uxTaskGetStackHighWaterMark     0
-#define INCLUDE_xTaskGetIdleTaskHandle          0
+#define INCLUDE_uxTaskGetStackHighWaterMark     1
+#define INCLUDE_xTaskGetIdleTaskHandle          1
 #define INCLUDE_eTaskGetState                   0
 #define INCLUDE_xEventGroupSetBitFromISR        1
 #define INCLUDE_xTimerPendFunctionCall          1
@@ -45,12 +45,25 @@ one of the application files:
 #define configAPPLICATION_PROVIDES_cOutputBuffer 0
 #endif
 
+/* Number of parameters of the running command that are located once when the
+command is found.  Parameters after these are found by scanning the string. */
+#ifndef configCOMMAND_INT_MAX_PARAMETERS
+#define configCOMMAND_INT_MAX_PARAMETERS 8
+#endif
+
 typedef struct xCOMMAND_INPUT_LIST
 {
     const CLI_Command_Definition_t *pxCommandLineDefinition;
     struct xCOMMAND_INPUT_LIST *pxNext;
 } CLI_Definition_List_Item_t;
 
+/* A parameter of the running command. */
+typedef struct xCOMMAND_PARAMETER
+{
+    const char *pcStart;
+    BaseType_t xLength;
+} CLI_Parameter_t;
+
 /*
  * The callback function that is executed when "help" is entered.  This is the
  * only default command that is always present.
@@ -58,9 +71,15 @@ typedef struct xCOMMAND_INPUT_LIST
 static BaseType_t prvHelpCommand( char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString );
 
 /*
- * Return the number of parameters that follow the command name.
+ * Locate the parameters that follow the command name, which starts
+ * pcCommandString, and return their number.
+ */
+static UBaseType_t prvTokenizeParameters( const char *pcCommandString, size_t xCommandInputLength );
+
+/*
+ * Binary search for the command word in the registered command table.
  */
-static int8_t prvGetNumberOfParameters( const char *pcCommandString );
+static const CLI_Command_Definition_t *prvFindInCommandTable( const char *pcCommandInput, size_t xCommandInputLength );
 
 /* The definition of the "help" command.  This command is always at the front
 of the list of registered commands. */
@@ -80,6 +99,18 @@ static CLI_Definition_List_Item_t xRegisteredCommands =
     NULL            /* The next pointer is initialised to NULL, as there are no other registered commands yet. */
 };
 
+/* Statically defined commands, sorted by name, registered with
+FreeRTOS_CLIRegisterCommandTable().  They are searched before the list. */
+static const CLI_Command_Definition_t *pxCommandTable = NULL;
+static UBaseType_t uxCommandTableLength = 0;
+
+/* Parameters of the running command, located once when the command is found.
+pcTokenizedCommand is the command string they belong to, or NULL when no
+command is running. */
+static const char *pcTokenizedCommand = NULL;
+static CLI_Parameter_t xParameters[ configCOMMAND_INT_MAX_PARAMETERS ];
+static UBaseType_t uxNumberOfParameters = 0;
+
 /* A buffer into which command outputs can be written is declared here, rather
 than in the command console implementation, to allow multiple command consoles
 to share the same buffer.  For example, an application may allow access to the
@@ -142,46 +173,114 @@ BaseType_t FreeRTOS_CLIRegisterCommand( const CLI_Command_Definition_t * const p
 }
 /*-----------------------------------------------------------*/
 
+BaseType_t FreeRTOS_CLIRegisterCommandTable( const CLI_Command_Definition_t * const pxCommands, UBaseType_t uxNumberOfCommands )
+{
+    UBaseType_t ux;
+
+    configASSERT( pxCommands );
+
+    /* The table is searched with a binary search, so it must be sorted by
+    command name and must not contain duplicates. */
+    for( ux = 1; ux < uxNumberOfCommands; ux++ )
+    {
+        configASSERT( strcmp( pxCommands[ ux - 1 ].pcCommand, pxCommands[ ux ].pcCommand ) < 0 );
+    }
+
+    taskENTER_CRITICAL();
+    {
+        pxCommandTable = pxCommands;
+        uxCommandTableLength = uxNumberOfCommands;
+    }
+    taskEXIT_CRITICAL();
+
+    return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+static const CLI_Command_Definition_t *prvFindInCommandTable( const char *pcCommandInput, size_t xCommandInputLength )
+{
+    UBaseType_t uxLow = 0;
+    UBaseType_t uxHigh = uxCommandTableLength;
+    UBaseType_t uxMiddle;
+    const char *pcRegisteredCommandString;
+    int xCompare;
+
+    while( uxLow < uxHigh )
+    {
+        uxMiddle = uxLow + ( ( uxHigh - uxLow ) / 2 );
+        pcRegisteredCommandString = pxCommandTable[ uxMiddle ].pcCommand;
+
+        /* A registered command which only starts with the input word is
+        longer, so it sorts after it. */
+        xCompare = strncmp( pcRegisteredCommandString, pcCommandInput, xCommandInputLength );
+        if( ( xCompare == 0 ) && ( pcRegisteredCommandString[ xCommandInputLength ] != 0x00 ) )
+        {
+            xCompare = 1;
+        }
+
+        if( xCompare == 0 )
+        {
+            return &pxCommandTable[ uxMiddle ];
+        }
+        else if( xCompare < 0 )
+        {
+            uxLow = uxMiddle + 1;
+        }
+        else
+        {
+            uxHigh = uxMiddle;
+        }
+    }
+
+    return NULL;
+}
+/*-----------------------------------------------------------*/
+
 BaseType_t FreeRTOS_CLIProcessCommand( const char * const pcCommandInput, char * pcWriteBuffer, size_t xWriteBufferLen  )
 {
-    static const CLI_Definition_List_Item_t *pxCommand = NULL;
+    static const CLI_Command_Definition_t *pxCommand = NULL;
+    const CLI_Definition_List_Item_t *pxListItem;
     BaseType_t xReturn = pdTRUE;
     const char *pcRegisteredCommandString;
-    size_t xCommandStringLength;
+    size_t xCommandInputLength;
 
     /* Note:  This function is not re-entrant.  It must not be called from more
     thank one task. */
 
     if( pxCommand == NULL )
     {
+        /* The command word is delimited once and compared by length, so a
+        sub-string of a longer command is not picked up. */
+        xCommandInputLength = strcspn( pcCommandInput, " " );
+
+        pxCommand = prvFindInCommandTable( pcCommandInput, xCommandInputLength );
+
         /* Search for the command string in the list of registered commands. */
-        for( pxCommand = &xRegisteredCommands; pxCommand != NULL; pxCommand = pxCommand->pxNext )
+        for( pxListItem = &xRegisteredCommands; ( pxCommand == NULL ) && ( pxListItem != NULL ); pxListItem = pxListItem->pxNext )
         {
-            pcRegisteredCommandString = pxCommand->pxCommandLineDefinition->pcCommand;
-            xCommandStringLength = strlen( pcRegisteredCommandString );
-
-            /* To ensure the string lengths match exactly, so as not to pick up
-            a sub-string of a longer command, check the byte after the expected
-            end of the string is either the end of the string or a space before
-            a parameter. */
-            if( strncmp( pcCommandInput, pcRegisteredCommandString, xCommandStringLength ) == 0 )
+            pcRegisteredCommandString = pxListItem->pxCommandLineDefinition->pcCommand;
+
+            if( ( strncmp( pcCommandInput, pcRegisteredCommandString, xCommandInputLength ) == 0 ) &&
+                ( pcRegisteredCommandString[ xCommandInputLength ] == 0x00 ) )
             {
-                if( ( pcCommandInput[ xCommandStringLength ] == ' ' ) || ( pcCommandInput[ xCommandStringLength ] == 0x00 ) )
-                {
-                    /* The command has been found.  Check it has the expected
-                    number of parameters.  If cExpectedNumberOfParameters is -1,
-                    then there could be a variable number of parameters and no
-                    check is made. */
-                    if( pxCommand->pxCommandLineDefinition->cExpectedNumberOfParameters >= 0 )
-                    {
-                        if( prvGetNumberOfParameters( pcCommandInput ) != pxCommand->pxCommandLineDefinition->cExpectedNumberOfParameters )
-                        {
-                            xReturn = pdFALSE;
-                        }
-                    }
-
-                    break;
-                }
+                pxCommand = pxListItem->pxCommandLineDefinition;
+            }
+        }
+
+        if( pxCommand != NULL )
+        {
+            /* The parameters are located once here, the callback reads them
+            with FreeRTOS_CLIGetParameter() without scanning the string again. */
+            uxNumberOfParameters = prvTokenizeParameters( pcCommandInput, xCommandInputLength );
+            pcTokenizedCommand = pcCommandInput;
+
+            /* The command has been found.  Check it has the expected number of
+            parameters.  If cExpectedNumberOfParameters is -1, then there could be
+            a variable number of parameters and no check is made. */
+            if( ( pxCommand->cExpectedNumberOfParameters >= 0 ) &&
+                ( uxNumberOfParameters != ( UBaseType_t ) pxCommand->cExpectedNumberOfParameters ) )
+            {
+                xReturn = pdFALSE;
             }
         }
     }
@@ -192,11 +291,12 @@ BaseType_t FreeRTOS_CLIProcessCommand( const char * const pcCommandInput, char *
         was incorrect. */
         strncpy( pcWriteBuffer, "Incorrect command parameter(s).  Enter \"help\" to view a list of available commands.\r\n\r\n", xWriteBufferLen );
         pxCommand = NULL;
+        pcTokenizedCommand = NULL;
     }
     else if( pxCommand != NULL )
     {
         /* Call the callback function that is registered to this command. */
-        xReturn = pxCommand->pxCommandLineDefinition->pxCommandInterpreter( pcWriteBuffer, xWriteBufferLen, pcCommandInput );
+        xReturn = pxCommand->pxCommandInterpreter( pcWriteBuffer, xWriteBufferLen, pcCommandInput );
 
         /* If xReturn is pdFALSE, then no further strings will be returned
         after this one, and pxCommand can be reset to NULL ready to search
@@ -204,6 +304,7 @@ BaseType_t FreeRTOS_CLIProcessCommand( const char * const pcCommandInput, char *
         if( xReturn == pdFALSE )
         {
             pxCommand = NULL;
+            pcTokenizedCommand = NULL;
         }
     }
     else
@@ -230,6 +331,19 @@ const char *FreeRTOS_CLIGetParameter( const char *pcCommandString, UBaseType_t u
 
     *pxParameterStringLength = 0;
 
+    /* The parameters of the running command were located when it was found. */
+    if( ( pcCommandString == pcTokenizedCommand ) && ( uxWantedParameter > 0 ) &&
+        ( ( uxWantedParameter <= configCOMMAND_INT_MAX_PARAMETERS ) || ( uxWantedParameter > uxNumberOfParameters ) ) )
+    {
+        if( uxWantedParameter <= uxNumberOfParameters )
+        {
+            *pxParameterStringLength = xParameters[ uxWantedParameter - 1 ].xLength;
+            pcReturn = xParameters[ uxWantedParameter - 1 ].pcStart;
+        }
+
+        return pcReturn;
+    }
+
     while( uxParametersFound < uxWantedParameter )
     {
         /* Index the character pointer past the current word.  If this is the start
@@ -282,25 +396,36 @@ const char *FreeRTOS_CLIGetParameter( const char *pcCommandString, UBaseType_t u
 static BaseType_t prvHelpCommand( char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString )
 {
     static const CLI_Definition_List_Item_t * pxCommand = NULL;
+    static UBaseType_t uxPosition = 0;
     BaseType_t xReturn;
 
     ( void ) pcCommandString;
 
-    if( pxCommand == NULL )
+    /* Return the next command help string, before moving on to the next
+    command.  The help command is followed by the command table and then by
+    the rest of the list. */
+    if( uxPosition == 0 )
+    {
+        strncpy( pcWriteBuffer, xRegisteredCommands.pxCommandLineDefinition->pcHelpString, xWriteBufferLen );
+        pxCommand = xRegisteredCommands.pxNext;
+    }
+    else if( uxPosition <= uxCommandTableLength )
     {
-        /* Reset the pxCommand pointer back to the start of the list. */
-        pxCommand = &xRegisteredCommands;
+        strncpy( pcWriteBuffer, pxCommandTable[ uxPosition - 1 ].pcHelpString, xWriteBufferLen );
+    }
+    else
+    {
+        strncpy( pcWriteBuffer, pxCommand->pxCommandLineDefinition->pcHelpString, xWriteBufferLen );
+        pxCommand = pxCommand->pxNext;
     }
 
-    /* Return the next command help string, before moving the pointer on to
-    the next command in the list. */
-    strncpy( pcWriteBuffer, pxCommand->pxCommandLineDefinition->pcHelpString, xWriteBufferLen );
-    pxCommand = pxCommand->pxNext;
+    uxPosition++;
 
-    if( pxCommand == NULL )
+    if( ( uxPosition > uxCommandTableLength ) && ( pxCommand == NULL ) )
     {
-        /* There are no more commands in the list, so there will be no more
-        strings to return after this one and pdFALSE should be returned. */
+        /* There are no more commands, so there will be no more strings to
+        return after this one and pdFALSE should be returned. */
+        uxPosition = 0;
         xReturn = pdFALSE;
     }
     else
@@ -312,39 +437,43 @@ static BaseType_t prvHelpCommand( char *pcWriteBuffer, size_t xWriteBufferLen, c
 }
 /*-----------------------------------------------------------*/
 
-static int8_t prvGetNumberOfParameters( const char *pcCommandString )
+static UBaseType_t prvTokenizeParameters( const char *pcCommandString, size_t xCommandInputLength )
 {
-    int8_t cParameters = 0;
-    BaseType_t xLastCharacterWasSpace = pdFALSE;
+    UBaseType_t uxParameters = 0;
+    const char *pcStart;
+
+    pcCommandString += xCommandInputLength;
 
-    /* Count the number of space delimited words in pcCommandString. */
-    while( *pcCommandString != 0x00 )
+    /* Words are delimited by one or more spaces, the first word is the command
+    itself.  All words are counted, the first configCOMMAND_INT_MAX_PARAMETERS
+    are stored. */
+    for( ;; )
     {
-        if( ( *pcCommandString ) == ' ' )
+        while( ( *pcCommandString ) == ' ' )
         {
-            if( xLastCharacterWasSpace != pdTRUE )
-            {
-                cParameters++;
-                xLastCharacterWasSpace = pdTRUE;
-            }
+            pcCommandString++;
         }
-        else
+
+        if( *pcCommandString == 0x00 )
         {
-            xLastCharacterWasSpace = pdFALSE;
+            break;
         }
 
-        pcCommandString++;
-    }
+        pcStart = pcCommandString;
+        while( ( ( *pcCommandString ) != 0x00 ) && ( ( *pcCommandString ) != ' ' ) )
+        {
+            pcCommandString++;
+        }
 
-    /* If the command string ended with spaces, then there will have been too
-    many parameters counted. */
-    if( xLastCharacterWasSpace == pdTRUE )
-    {
-        cParameters--;
+        if( uxParameters < configCOMMAND_INT_MAX_PARAMETERS )
+        {
+            xParameters[ uxParameters ].pcStart = pcStart;
+            xParameters[ uxParameters ].xLength = ( BaseType_t ) ( pcCommandString - pcStart );
+        }
+
+        uxParameters++;
     }
 
-    /* The value returned is one less than the number of space delimited words,
-    as the first word should be the command itself. */
-    return cParameters;
+    return uxParameters;
 }
 
@@ -61,6 +61,13 @@ typedef struct xCOMMAND_LINE_INPUT
  */
 BaseType_t FreeRTOS_CLIRegisterCommand( const CLI_Command_Definition_t * const pxCommandToRegister );
 
+/*
+ * Register a statically defined table of commands.  The table must be sorted
+ * by command name, it is searched with a binary search before the commands
+ * registered with FreeRTOS_CLIRegisterCommand().  No memory is allocated.
+ */
+BaseType_t FreeRTOS_CLIRegisterCommandTable( const CLI_Command_Definition_t * const pxCommands, UBaseType_t uxNumberOfCommands );
+
 /*
  * Runs the command interpreter for the command string "pcCommandInput".  Any
  * output generated by running the command will be placed into pcWriteBuffer.
@@ -90,7 +97,10 @@ BaseType_t FreeRTOS_CLIProcessCommand( const char * const pcCommandInput, char *
 char *FreeRTOS_CLIGetOutputBuffer( void );
 
 /*
- * Return a pointer to the xParameterNumber'th word in pcCommandString.
+ * Return a pointer to the xParameterNumber'th word in pcCommandString.  The
+ * parameters of the running command are located once by
+ * FreeRTOS_CLIProcessCommand(), so a callback reading its own command string
+ * does not scan it again.
  */
 const char *FreeRTOS_CLIGetParameter( const char *pcCommandString, UBaseType_t uxWantedParameter, BaseType_t *pxParameterStringLength );
 
@@ -0,0 +1,328 @@
+/*****************************************************************************
+ * File name: benchmark.c
+ *
+ * Description: This file implements the cycle count benchmark of the frame
+ *   path kernels with the DWT cycle counter
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "benchmark.h"
+
+typedef struct
+{
+    uint32_t count;
+    uint32_t min;
+    uint64_t total;
+} benchmark_probe_s;
+
+typedef struct
+{
+    uint32_t num_chirps;
+    uint32_t samples_per_chirp;
+    uint32_t num_antennas;
+    uint32_t num_macro_bins;
+    xensiv_radar_presence_handle_t handle;
+    benchmark_probe_s probes[BENCHMARK_NUM_PROBES];
+} benchmark_state_s;
+
+static const char * const probe_names[BENCHMARK_NUM_PROBES] =
+{
+    [BENCHMARK_PROBE_RDM_RUN]  = "rdm_run",
+    [BENCHMARK_PROBE_RDM_READ] = "rdm_read_from_buffer",
+    [BENCHMARK_PROBE_RDM_ACK]  = "rdm_ack_data_read"
+};
+
+static const char * const mode_names[] =
+{
+    [XENSIV_RADAR_PRESENCE_MODE_MACRO_ONLY]      = "presence_macro_only",
+    [XENSIV_RADAR_PRESENCE_MODE_MICRO_ONLY]      = "presence_micro_only",
+    [XENSIV_RADAR_PRESENCE_MODE_MICRO_IF_MACRO]  = "presence_micro_if_macro",
+    [XENSIV_RADAR_PRESENCE_MODE_MICRO_AND_MACRO] = "presence_micro_and_macro"
+};
+
+/* Slow time filter bank followed by the presence algorithm, per decimation factor */
+static const char * const decimation_names[SLOW_TIME_MAX_DECIMATION] =
+{
+    "decimated_presence_dec1",
+    "decimated_presence_dec2",
+    "decimated_presence_dec3",
+    "decimated_presence_dec4",
+    "decimated_presence_dec5",
+    "decimated_presence_dec6",
+    "decimated_presence_dec7",
+    "decimated_presence_dec8"
+};
+
+static benchmark_state_s bench_state;
+
+/*******************************************************************************
+ * Function Name: benchmark_to_ns
+ ****************************************************************************//**
+ *
+ * @param cycles Core cycles.
+ *
+ * @return Time in ns at the current core clock.
+ *
+ *******************************************************************************/
+static uint32_t benchmark_to_ns(uint32_t cycles)
+{
+    return (uint32_t)(((uint64_t)cycles * 1000000000ULL) / SystemCoreClock);
+}
+
+/*******************************************************************************
+ * Function Name: benchmark_measure_frames
+ ****************************************************************************//**
+ *
+ * @brief Runs a kernel a number of times with the scheduler suspended
+ * around every run and reports the result.
+ *
+ * @param name Kernel name.
+ * @param prepare Called before every run without being measured, may be NULL.
+ * @param kernel Measured kernel.
+ * @param kernels Buffers of the kernels.
+ * @param report Result callback.
+ * @param num_frames Number of runs.
+ *
+ *******************************************************************************/
+static void benchmark_measure_frames(const char *name, benchmark_kernel_t prepare, benchmark_kernel_t kernel,
+                                     benchmark_kernels_s *kernels, benchmark_report_t report, uint32_t num_frames)
+{
+    benchmark_result_s result = { .name = name, .frames = num_frames, .cycles_min = UINT32_MAX };
+    uint64_t total = 0U;
+
+    for (uint32_t frame = 0U; frame < num_frames; frame++)
+    {
+        uint32_t start;
+        uint32_t cycles;
+
+        if (prepare != NULL)
+        {
+            prepare(kernels, frame);
+        }
+
+        vTaskSuspendAll();
+        start = benchmark_get_cycles();
+        kernel(kernels, frame);
+        cycles = benchmark_get_cycles() - start;
+        xTaskResumeAll();
+
+        total += cycles;
+        if (cycles < result.cycles_min)
+        {
+            result.cycles_min = cycles;
+        }
+    }
+
+    result.cycles_mean = (uint32_t)(total / num_frames);
+    result.ns_mean = benchmark_to_ns(result.cycles_mean);
+    report(&result);
+}
+
+/*******************************************************************************
+ * Function Name: benchmark_process_frame
+ ****************************************************************************//**
+ *
+ * @brief One frame of the presence algorithm.
+ *
+ *******************************************************************************/
+static void benchmark_process_frame(benchmark_kernels_s *kernels, uint32_t frame)
+{
+    (void)xensiv_radar_presence_process_frame(bench_state.handle, kernels->chirp, frame * BENCHMARK_FRAME_PERIOD_MS);
+}
+
+/*******************************************************************************
+ * Function Name: benchmark_decimated_presence
+ ****************************************************************************//**
+ *
+ * @brief Slow time filter bank on one frame and one frame of the presence
+ * algorithm on every output of the decimator, so the mean is the cost per
+ * acquired frame.
+ *
+ *******************************************************************************/
+static void benchmark_decimated_presence(benchmark_kernels_s *kernels, uint32_t frame)
+{
+    if (slow_time_filter_process(kernels->filter, kernels->chirp, kernels->filtered))
+    {
+        (void)xensiv_radar_presence_process_frame(bench_state.handle, kernels->filtered,
+                                                  frame * BENCHMARK_FRAME_PERIOD_MS);
+    }
+}
+
+/*
+ * start the cycle counter
+ */
+void benchmark_init(uint32_t num_chirps, uint32_t samples_per_chirp,
+                    uint32_t num_antennas, uint32_t num_macro_bins)
+{
+    memset(&bench_state, 0, sizeof(bench_state));
+    bench_state.num_chirps = num_chirps;
+    bench_state.samples_per_chirp = samples_per_chirp;
+    bench_state.num_antennas = num_antennas;
+    bench_state.num_macro_bins = num_macro_bins;
+
+    for (uint32_t i = 0U; i < BENCHMARK_NUM_PROBES; i++)
+    {
+        bench_state.probes[i].min = UINT32_MAX;
+    }
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0U;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/*
+ * account a measured call
+ */
+void benchmark_probe_add(benchmark_probe_e probe, uint32_t cycles)
+{
+    benchmark_probe_s *entry = &bench_state.probes[probe];
+
+    entry->count++;
+    entry->total += cycles;
+
+    if (cycles < entry->min)
+    {
+        entry->min = cycles;
+    }
+}
+
+/*
+ * run all kernels
+ */
+int32_t benchmark_run(const xensiv_radar_presence_config_t *config, benchmark_report_t report)
+{
+    benchmark_kernels_s kernels;
+    const benchmark_kernel_s *table;
+    uint32_t num_kernels;
+    float32_t macro_bin_length;
+    int32_t result = 0;
+
+    if (config->num_samples_per_chirp > (int32_t)bench_state.samples_per_chirp)
+    {
+        return -1;
+    }
+
+    /* the macro bin length maps the range gate onto the bins of the chirp FFT */
+    if (xensiv_radar_presence_alloc(&bench_state.handle, config) != XENSIV_RADAR_PRESENCE_OK)
+    {
+        return -1;
+    }
+    macro_bin_length = xensiv_radar_presence_get_bin_length(bench_state.handle);
+    xensiv_radar_presence_free(bench_state.handle);
+
+    if (benchmark_kernels_alloc(&kernels, bench_state.num_chirps, bench_state.samples_per_chirp,
+                                bench_state.num_antennas, bench_state.num_macro_bins, macro_bin_length) != 0)
+    {
+        return -1;
+    }
+
+    table = benchmark_kernels_get(&num_kernels);
+    for (uint32_t i = 0U; i < num_kernels; i++)
+    {
+        if ((table[i].setup == NULL) || (table[i].setup(&kernels, config, table[i].arg) == 0))
+        {
+            benchmark_measure_frames(table[i].name, table[i].prepare, table[i].kernel, &kernels, report,
+                                     benchmark_kernels_get_frames(table[i].period));
+        }
+    }
+
+    for (uint32_t mode = 0U; mode < (sizeof(mode_names) / sizeof(mode_names[0])); mode++)
+    {
+        xensiv_radar_presence_config_t mode_config = *config;
+
+        mode_config.mode = (xensiv_radar_presence_mode_t)mode;
+
+        if (xensiv_radar_presence_alloc(&bench_state.handle, &mode_config) != XENSIV_RADAR_PRESENCE_OK)
+        {
+            result = -1;
+            break;
+        }
+
+        benchmark_measure_frames(mode_names[mode], benchmark_kernels_prepare_chirp, benchmark_process_frame,
+                                 &kernels, report, BENCHMARK_FRAMES);
+
+        xensiv_radar_presence_free(bench_state.handle);
+    }
+
+    /* The filter bank runs with the live cutoffs and frame rate, the presence algorithm only
+     * on the decimated frames. Whole decimation periods are measured, so the mean is exact. */
+    for (uint32_t decimation = 1U; (decimation <= SLOW_TIME_MAX_DECIMATION) && (result == 0); decimation++)
+    {
+        if (xensiv_radar_presence_alloc(&bench_state.handle, config) != XENSIV_RADAR_PRESENCE_OK)
+        {
+            result = -1;
+            break;
+        }
+
+        *kernels.filter = *slow_time_filter_get_live();
+        (void)slow_time_filter_set_decimation(kernels.filter, decimation);
+        benchmark_measure_frames(decimation_names[decimation - 1U], benchmark_kernels_prepare_chirp,
+                                 benchmark_decimated_presence, &kernels, report,
+                                 benchmark_kernels_get_frames(decimation));
+
+        xensiv_radar_presence_free(bench_state.handle);
+    }
+
+    benchmark_kernels_free(&kernels);
+
+    /* the probes report the live calls since the last run */
+    for (uint32_t i = 0U; i < BENCHMARK_NUM_PROBES; i++)
+    {
+        benchmark_probe_s probe;
+        benchmark_result_s probe_result = { .name = probe_names[i] };
+
+        taskENTER_CRITICAL();
+        probe = bench_state.probes[i];
+        bench_state.probes[i].count = 0U;
+        bench_state.probes[i].min = UINT32_MAX;
+        bench_state.probes[i].total = 0U;
+        taskEXIT_CRITICAL();
+
+        if (probe.count > 0U)
+        {
+            probe_result.frames = probe.count;
+            probe_result.cycles_min = probe.min;
+            probe_result.cycles_mean = (uint32_t)(probe.total / probe.count);
+            probe_result.ns_mean = benchmark_to_ns(probe_result.cycles_mean);
+            report(&probe_result);
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,125 @@
+/*****************************************************************************
+ * File name: benchmark.h
+ *
+ * Description: This file contains types and function prototypes of the
+ *   cycle count benchmark of the frame path kernels
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_BENCHMARK_H_
+#define SOURCE_BENCHMARK_H_
+
+#include <stdint.h>
+
+#include "cy_pdl.h"
+#include "xensiv_radar_presence.h"
+
+#include "benchmark_kernels.h"
+
+/*
+ * @def enum benchmark_probe_e
+ * Calls measured in place, the radar data manager only exists once and runs
+ * the live acquisition
+ * BENCHMARK_PROBE_RDM_RUN - mgr.run from the FIFO interrupt
+ * BENCHMARK_PROBE_RDM_READ - mgr.read_from_buffer in the acquisition task
+ * BENCHMARK_PROBE_RDM_ACK - mgr.ack_data_read in the acquisition task
+ */
+typedef enum
+{
+    BENCHMARK_PROBE_RDM_RUN,
+    BENCHMARK_PROBE_RDM_READ,
+    BENCHMARK_PROBE_RDM_ACK,
+    BENCHMARK_NUM_PROBES
+} benchmark_probe_e;
+
+/*******************************************************************************
+ * Function Name: benchmark_init
+ ****************************************************************************//**
+ *
+ * @brief Starts the DWT cycle counter of the core, clears the probes and sets
+ * the frame format of the synthetic data.
+ *
+ * @param num_chirps Number of chirps per frame.
+ * @param samples_per_chirp Number of samples per chirp and antenna.
+ * @param num_antennas Number of interleaved antennas.
+ * @param num_macro_bins Number of bins of the macro FFT buffer.
+ *
+ *******************************************************************************/
+void benchmark_init(uint32_t num_chirps, uint32_t samples_per_chirp,
+                    uint32_t num_antennas, uint32_t num_macro_bins);
+
+/*******************************************************************************
+ * Function Name: benchmark_get_cycles
+ ****************************************************************************//**
+ *
+ * @return Core cycle counter, wraps around.
+ *
+ *******************************************************************************/
+static inline uint32_t benchmark_get_cycles(void)
+{
+    return DWT->CYCCNT;
+}
+
+/*******************************************************************************
+ * Function Name: benchmark_probe_add
+ ****************************************************************************//**
+ *
+ * @brief Accounts one measured call. Every probe has one caller, which may be
+ * an interrupt handler.
+ *
+ * @param probe Probe.
+ * @param cycles Cycles of the call.
+ *
+ *******************************************************************************/
+void benchmark_probe_add(benchmark_probe_e probe, uint32_t cycles);
+
+/*******************************************************************************
+ * Function Name: benchmark_run
+ ****************************************************************************//**
+ *
+ * @brief Runs the kernel table of benchmark_kernels.h and the presence
+ * algorithm on synthetic data and reports the results one by one, followed
+ * by the probes since the last run. The
+ * scheduler is suspended during each measured run only, so the live
+ * processing continues in between. Called from the console task.
+ *
+ * @param config Presence configuration, every mode is measured with it.
+ * @param report Called for every result.
+ *
+ * @return 0 on success, -1 if the buffers cannot be allocated.
+ *
+ *******************************************************************************/
+int32_t benchmark_run(const xensiv_radar_presence_config_t *config, benchmark_report_t report);
+
+#endif /* SOURCE_BENCHMARK_H_ */
@@ -0,0 +1,533 @@
+/*****************************************************************************
+ * File name: benchmark_kernels.c
+ *
+ * Description: This file implements the frame path kernels measured by the
+ *   benchmark on synthetic data, on the device and on the host
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+
+#include "benchmark_kernels.h"
+#include "raw_stream.h"
+
+/* Range bin of the person in the synthetic macro FFT buffer */
+#define BENCHMARK_TARGET_BIN                (8U)
+
+/* Frames which fill the window of the breathing rate estimation before it is measured */
+#define BENCHMARK_VITAL_FILL_FRAMES         (VITAL_SETTLE_SAMPLES + VITAL_WINDOW_LENGTH)
+
+/*******************************************************************************
+ * Function Name: benchmark_fifo_to_float
+ ****************************************************************************//**
+ *
+ * @brief Conversion of the 12 bit FIFO samples to float and de-interleaving.
+ *
+ *******************************************************************************/
+static void benchmark_fifo_to_float(benchmark_kernels_s *kernels, uint32_t frame)
+{
+    (void)frame;
+
+    radar_rx_deinterleave(kernels->fifo, kernels->planar, kernels->num_antennas,
+                          kernels->num_chirps * kernels->samples_per_chirp);
+}
+
+/*******************************************************************************
+ * Function Name: benchmark_chirp_average
+ ****************************************************************************//**
+ *
+ * @brief Average of the chirps of every antenna, arm_add_f32 and arm_scale_f32.
+ *
+ *******************************************************************************/
+static void benchmark_chirp_average(benchmark_kernels_s *kernels, uint32_t frame)
+{
+    (void)frame;
+
+    radar_rx_average_chirps(kernels->planar, kernels->avg_chirps, kernels->num_antennas,
+                            kernels->num_chirps, kernels->samples_per_chirp);
+}
+
+/*******************************************************************************
+ * Function Name: benchmark_setup_rx_combine
+ ****************************************************************************//**
+ *
+ * @brief Starts the combiner of the benchmark without history.
+ *
+ *******************************************************************************/
+static int32_t benchmark_setup_rx_combine(benchmark_kernels_s *kernels, const xensiv_radar_presence_config_t *config,
+                                          uint32_t arg)
+{
+    (void)config;
+    (void)arg;
+
+    return radar_rx_combiner_init(kernels->combiner, kernels->num_chirp_antennas, kernels->samples_per_chirp);
+}
+
+/*******************************************************************************
+ * Function Name: benchmark_rx_combine
+ ****************************************************************************//**
+ *
+ * @brief Phase aligned combination of the average chirps of three antennas
+ * on a combiner of its own.
+ *
+ *******************************************************************************/
+static void benchmark_rx_combine(benchmark_kernels_s *kernels, uint32_t frame)
+{
+    radar_rx_combine(kernels->combiner, kernels->avg_chirps, kernels->chirp, frame * BENCHMARK_FRAME_PERIOD_MS);
+}
+
+/*******************************************************************************
+ * Function Name: benchmark_raw_stream_compress
+ ****************************************************************************//**
+ *
+ * @brief Compression of a FIFO frame for the raw stream.
+ *
+ *******************************************************************************/
+static void benchmark_raw_stream_compress(benchmark_kernels_s *kernels, uint32_t frame)
+{
+    (void)frame;
+
+    (void)raw_stream_compress(kernels->fifo, kernels->num_chirps,
+                              kernels->samples_per_chirp * kernels->num_antennas,
+                              kernels->num_antennas, kernels->compressed,
+                              RAW_STREAM_MAX_FRAME_SIZE);
+}
+
+/*******************************************************************************
+ * Function Name: benchmark_macro_fft_magnitude
+ ****************************************************************************//**
+ *
+ * @brief Magnitude of the macro FFT bins inside the gate as printed in the
+ * verbose mode.
+ *
+ *******************************************************************************/
+static void benchmark_macro_fft_magnitude(benchmark_kernels_s *kernels, uint32_t frame)
+{
+    (void)frame;
+
+    arm_cmplx_mag_f32((const float32_t *)&kernels->macro_fft[kernels->gate.first_bin],
+                      &kernels->magnitude[kernels->gate.first_bin], (uint32_t)kernels->gate.num_bins);
+}
+
+/*******************************************************************************
+ * Function Name: benchmark_slow_time_filter
+ ****************************************************************************//**
+ *
+ * @brief Slow time filter bank on one frame.
+ *
+ *******************************************************************************/
+static void benchmark_slow_time_filter(benchmark_kernels_s *kernels, uint32_t frame)
+{
+    (void)frame;
+
+    (void)slow_time_filter_process(kernels->filter, kernels->chirp, kernels->filtered);
+}
+
+/*******************************************************************************
+ * Function Name: benchmark_setup_slow_time_filter
+ ****************************************************************************//**
+ *
+ * @brief Copies the live filter bank, so it runs with the live cutoffs and
+ * frame rate, and sets the decimation factor arg.
+ *
+ *******************************************************************************/
+static int32_t benchmark_setup_slow_time_filter(benchmark_kernels_s *kernels,
+                                                const xensiv_radar_presence_config_t *config, uint32_t arg)
+{
+    (void)config;
+
+    *kernels->filter = *slow_time_filter_get_live();
+
+    return slow_time_filter_set_decimation(kernels->filter, arg);
+}
+
+/*******************************************************************************
+ * Function Name: benchmark_prepare_macro_fft
+ ****************************************************************************//**
+ *
+ * @brief Synthetic macro FFT buffer with noise and a target that moves a
+ * little every frame, the per range bin stages work on the frame to frame
+ * change.
+ *
+ *******************************************************************************/
+static void benchmark_prepare_macro_fft(benchmark_kernels_s *kernels, uint32_t frame)
+{
+    for (uint32_t bin = 0U; bin < kernels->num_macro_bins; bin++)
+    {
+        float32_t noise = 0.001f * (float32_t)(((bin + frame) * 7919U) % 17U);
+        float32_t target = (bin == BENCHMARK_TARGET_BIN) ? 0.2f : 0.0f;
+        float32_t phase = 0.4f * (float32_t)frame;
+
+        kernels->macro_fft[bin].real = noise + (target * arm_cos_f32(phase));
+        kernels->macro_fft[bin].imag = noise + (target * arm_sin_f32(phase));
+    }
+}
+
+/*******************************************************************************
+ * Function Name: benchmark_setup_range
+ ****************************************************************************//**
+ *
+ * @brief Sets the range gate of the per range bin stages, all bins for arg 0
+ * and the configured range for arg 1, and starts every stage without history.
+ *
+ *******************************************************************************/
+static int32_t benchmark_setup_range(benchmark_kernels_s *kernels, const xensiv_radar_presence_config_t *config,
+                                     uint32_t arg)
+{
+    range_gate_compute(&kernels->gate, (int32_t)kernels->num_macro_bins,
+                       config->min_range_bin, config->max_range_bin, (arg != 0U));
+    benchmark_prepare_macro_fft(kernels, 0U);
+
+    if ((presence_cfar_init(kernels->cfar, (int32_t)kernels->num_macro_bins) != 0) ||
+        (presence_tracker_init(kernels->tracker, (int32_t)kernels->num_macro_bins, kernels->macro_bin_length) != 0) ||
+        (radar_aoa_init(kernels->aoa, kernels->samples_per_chirp, config->bandwidth, kernels->macro_bin_length) != 0))
+    {
+        return -1;
+    }
+
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: benchmark_cfar
+ ****************************************************************************//**
+ *
+ * @brief One CFAR iteration in the selected mode on a detector of its own.
+ *
+ *******************************************************************************/
+static void benchmark_cfar(benchmark_kernels_s *kernels, uint32_t frame)
+{
+    (void)frame;
+
+    (void)presence_cfar_process(kernels->cfar, kernels->macro_fft, &kernels->gate,
+                                XENSIV_RADAR_PRESENCE_STATE_ABSENCE, 0.0f);
+}
+
+/*******************************************************************************
+ * Function Name: benchmark_tracker
+ ****************************************************************************//**
+ *
+ * @brief One tracker iteration on a tracker of its own.
+ *
+ *******************************************************************************/
+static void benchmark_tracker(benchmark_kernels_s *kernels, uint32_t frame)
+{
+    presence_tracker_process(kernels->tracker, kernels->macro_fft, &kernels->gate,
+                             XENSIV_RADAR_PRESENCE_STATE_MACRO_PRESENCE, (int32_t)BENCHMARK_TARGET_BIN,
+                             frame * BENCHMARK_FRAME_PERIOD_MS);
+}
+
+/*******************************************************************************
+ * Function Name: benchmark_setup_vital_signs
+ ****************************************************************************//**
+ *
+ * @brief Fills the window of the estimator, the estimate is only computed
+ * from a full window.
+ *
+ *******************************************************************************/
+static int32_t benchmark_setup_vital_signs(benchmark_kernels_s *kernels,
+                                           const xensiv_radar_presence_config_t *config, uint32_t arg)
+{
+    (void)config;
+    (void)arg;
+
+    if (presence_vital_signs_init(kernels->vital) != 0)
+    {
+        return -1;
+    }
+
+    presence_vital_signs_enable(kernels->vital, true);
+    for (uint32_t frame = 0U; frame < BENCHMARK_VITAL_FILL_FRAMES; frame++)
+    {
+        presence_vital_signs_process(kernels->vital, kernels->macro_fft, (int32_t)BENCHMARK_TARGET_BIN,
+                                     frame * BENCHMARK_FRAME_PERIOD_MS);
+    }
+
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: benchmark_vital_signs
+ ****************************************************************************//**
+ *
+ * @brief Phase of one frame and a breathing rate estimate from the full
+ * window on an estimator of its own.
+ *
+ *******************************************************************************/
+static void benchmark_vital_signs(benchmark_kernels_s *kernels, uint32_t frame)
+{
+    presence_vital_signs_s vital;
+
+    presence_vital_signs_process(kernels->vital, kernels->macro_fft, (int32_t)BENCHMARK_TARGET_BIN,
+                                 (BENCHMARK_VITAL_FILL_FRAMES + frame) * BENCHMARK_FRAME_PERIOD_MS);
+    (void)presence_vital_signs_get(kernels->vital, &vital);
+}
+
+/*******************************************************************************
+ * Function Name: benchmark_setup_clutter_map
+ ****************************************************************************//**
+ *
+ * @brief Starts the clutter map of the benchmark in the learn mode.
+ *
+ *******************************************************************************/
+static int32_t benchmark_setup_clutter_map(benchmark_kernels_s *kernels,
+                                           const xensiv_radar_presence_config_t *config, uint32_t arg)
+{
+    (void)config;
+    (void)arg;
+
+    if (clutter_map_init(kernels->clutter, kernels->samples_per_chirp) != 0)
+    {
+        return -1;
+    }
+
+    clutter_map_set_mode(kernels->clutter, CLUTTER_MAP_LEARN);
+
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: benchmark_clutter_map
+ ****************************************************************************//**
+ *
+ * @brief Background learning and subtraction of one averaged chirp on a
+ * clutter map of its own.
+ *
+ *******************************************************************************/
+static void benchmark_clutter_map(benchmark_kernels_s *kernels, uint32_t frame)
+{
+    clutter_map_process(kernels->clutter, kernels->chirp, true, frame * BENCHMARK_FRAME_PERIOD_MS);
+}
+
+/*******************************************************************************
+ * Function Name: benchmark_prepare_aoa
+ ****************************************************************************//**
+ *
+ * @brief Synthetic average chirps of three antennas with static clutter and a
+ * target off boresight that moves a little every frame.
+ *
+ *******************************************************************************/
+static void benchmark_prepare_aoa(benchmark_kernels_s *kernels, uint32_t frame)
+{
+    const uint32_t num_samples = kernels->samples_per_chirp;
+
+    for (uint32_t rx = 0U; rx < AOA_MIN_NUM_RX_ANTENNAS; rx++)
+    {
+        float32_t *chirp = &kernels->avg_chirps[rx * num_samples];
+        float32_t phase = (0.4f * (float32_t)frame) - (0.8f * (float32_t)rx);
+
+        for (uint32_t i = 0U; i < num_samples; i++)
+        {
+            chirp[i] = 0.5f + (0.1f * arm_cos_f32(0.3f * (float32_t)i)) +
+                       (0.05f * arm_sin_f32((0.6f * (float32_t)i) + phase));
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function Name: benchmark_aoa
+ ****************************************************************************//**
+ *
+ * @brief Angle of arrival estimation with background learning on an estimator
+ * of its own.
+ *
+ *******************************************************************************/
+static void benchmark_aoa(benchmark_kernels_s *kernels, uint32_t frame)
+{
+    (void)radar_aoa_process(kernels->aoa, kernels->avg_chirps, AOA_MIN_NUM_RX_ANTENNAS, &kernels->gate,
+                            true, frame * BENCHMARK_FRAME_PERIOD_MS, &kernels->aoa_result);
+}
+
+/* Kernels without the presence library, the per range bin stages over all bins and with the range gate */
+static const benchmark_kernel_s kernel_table[] =
+{
+    { "fifo_to_float", NULL, 0U, NULL, benchmark_fifo_to_float, 1U },
+    { "chirp_average", NULL, 0U, NULL, benchmark_chirp_average, 1U },
+    { "rx_combine", benchmark_setup_rx_combine, 0U, benchmark_prepare_aoa, benchmark_rx_combine, 1U },
+    { "raw_stream_compress", NULL, 0U, NULL, benchmark_raw_stream_compress, 1U },
+    { "macro_fft_magnitude", benchmark_setup_range, 0U, NULL, benchmark_macro_fft_magnitude, 1U },
+    { "cfar", benchmark_setup_range, 0U, benchmark_prepare_macro_fft, benchmark_cfar, 1U },
+    { "tracker", benchmark_setup_range, 0U, benchmark_prepare_macro_fft, benchmark_tracker, 1U },
+    { "aoa", benchmark_setup_range, 0U, benchmark_prepare_aoa, benchmark_aoa, 1U },
+    { "macro_fft_magnitude_gated", benchmark_setup_range, 1U, NULL, benchmark_macro_fft_magnitude, 1U },
+    { "cfar_gated", benchmark_setup_range, 1U, benchmark_prepare_macro_fft, benchmark_cfar, 1U },
+    { "tracker_gated", benchmark_setup_range, 1U, benchmark_prepare_macro_fft, benchmark_tracker, 1U },
+    { "aoa_gated", benchmark_setup_range, 1U, benchmark_prepare_aoa, benchmark_aoa, 1U },
+    { "vital_signs", benchmark_setup_vital_signs, 0U, benchmark_prepare_macro_fft, benchmark_vital_signs, 1U },
+    { "clutter_map", benchmark_setup_clutter_map, 0U, benchmark_kernels_prepare_chirp, benchmark_clutter_map, 1U },
+    { "slow_time_filter_dec1", benchmark_setup_slow_time_filter, 1U, benchmark_kernels_prepare_chirp,
+      benchmark_slow_time_filter, 1U },
+    { "slow_time_filter_dec2", benchmark_setup_slow_time_filter, 2U, benchmark_kernels_prepare_chirp,
+      benchmark_slow_time_filter, 2U },
+    { "slow_time_filter_dec3", benchmark_setup_slow_time_filter, 3U, benchmark_kernels_prepare_chirp,
+      benchmark_slow_time_filter, 3U },
+    { "slow_time_filter_dec4", benchmark_setup_slow_time_filter, 4U, benchmark_kernels_prepare_chirp,
+      benchmark_slow_time_filter, 4U },
+    { "slow_time_filter_dec5", benchmark_setup_slow_time_filter, 5U, benchmark_kernels_prepare_chirp,
+      benchmark_slow_time_filter, 5U },
+    { "slow_time_filter_dec6", benchmark_setup_slow_time_filter, 6U, benchmark_kernels_prepare_chirp,
+      benchmark_slow_time_filter, 6U },
+    { "slow_time_filter_dec7", benchmark_setup_slow_time_filter, 7U, benchmark_kernels_prepare_chirp,
+      benchmark_slow_time_filter, 7U },
+    { "slow_time_filter_dec8", benchmark_setup_slow_time_filter, 8U, benchmark_kernels_prepare_chirp,
+      benchmark_slow_time_filter, 8U }
+};
+
+/*
+ * allocate the buffers of the kernels
+ */
+int32_t benchmark_kernels_alloc(benchmark_kernels_s *kernels, uint32_t num_chirps, uint32_t samples_per_chirp,
+                                uint32_t num_antennas, uint32_t num_macro_bins, float32_t macro_bin_length)
+{
+    uint32_t num_samples = num_chirps * samples_per_chirp * num_antennas;
+
+    memset(kernels, 0, sizeof(*kernels));
+
+    if ((num_samples == 0U) || (num_samples > RAW_STREAM_MAX_SAMPLES))
+    {
+        return -1;
+    }
+
+    kernels->num_chirps = num_chirps;
+    kernels->samples_per_chirp = samples_per_chirp;
+    kernels->num_antennas = num_antennas;
+    /* the combination and the angle of arrival need three antennas, they are measured on single antenna builds too */
+    kernels->num_chirp_antennas = (num_antennas < (uint32_t)AOA_MIN_NUM_RX_ANTENNAS) ?
+                                  (uint32_t)AOA_MIN_NUM_RX_ANTENNAS : num_antennas;
+    kernels->num_macro_bins = num_macro_bins;
+    kernels->macro_bin_length = macro_bin_length;
+
+    kernels->fifo = pvPortMalloc(num_samples * sizeof(uint16_t));
+    kernels->planar = pvPortMalloc(num_samples * sizeof(float32_t));
+    kernels->avg_chirps = pvPortMalloc(samples_per_chirp * kernels->num_chirp_antennas * sizeof(float32_t));
+    kernels->chirp = pvPortMalloc(samples_per_chirp * sizeof(float32_t));
+    kernels->magnitude = pvPortMalloc(num_macro_bins * sizeof(float32_t));
+    kernels->compressed = pvPortMalloc(RAW_STREAM_MAX_FRAME_SIZE);
+    kernels->macro_fft = pvPortMalloc(num_macro_bins * sizeof(cfloat32_t));
+    kernels->cfar = pvPortMalloc(sizeof(presence_cfar_s));
+    kernels->tracker = pvPortMalloc(sizeof(presence_tracker_s));
+    kernels->vital = pvPortMalloc(sizeof(presence_vital_signs_state_s));
+    kernels->clutter = pvPortMalloc(sizeof(clutter_map_s));
+    kernels->aoa = pvPortMalloc(sizeof(radar_aoa_s));
+    kernels->combiner = pvPortMalloc(sizeof(radar_rx_combiner_s));
+    kernels->filter = pvPortMalloc(sizeof(slow_time_filter_s));
+    kernels->filtered = pvPortMalloc(samples_per_chirp * sizeof(float32_t));
+
+    if ((kernels->fifo == NULL) || (kernels->planar == NULL) || (kernels->avg_chirps == NULL) ||
+        (kernels->chirp == NULL) || (kernels->magnitude == NULL) || (kernels->compressed == NULL) ||
+        (kernels->macro_fft == NULL) || (kernels->cfar == NULL) || (kernels->aoa == NULL) ||
+        (kernels->combiner == NULL) || (kernels->filter == NULL) || (kernels->filtered == NULL) ||
+        (kernels->tracker == NULL) || (kernels->vital == NULL) || (kernels->clutter == NULL))
+    {
+        benchmark_kernels_free(kernels);
+        return -1;
+    }
+
+    /* IF signal with a little noise, as the FIFO delivers it */
+    for (uint32_t i = 0U; i < num_samples; i++)
+    {
+        float32_t phase = 0.3f * (float32_t)(i / num_antennas);
+
+        kernels->fifo[i] = (uint16_t)(2048.0f + (800.0f * sinf(phase)) + (float32_t)((i * 7919U) % 17U));
+    }
+
+    return 0;
+}
+
+/*
+ * release the buffers of the kernels
+ */
+void benchmark_kernels_free(benchmark_kernels_s *kernels)
+{
+    vPortFree(kernels->fifo);
+    vPortFree(kernels->planar);
+    vPortFree(kernels->avg_chirps);
+    vPortFree(kernels->chirp);
+    vPortFree(kernels->magnitude);
+    vPortFree(kernels->compressed);
+    vPortFree(kernels->macro_fft);
+    vPortFree(kernels->cfar);
+    vPortFree(kernels->tracker);
+    vPortFree(kernels->vital);
+    vPortFree(kernels->clutter);
+    vPortFree(kernels->aoa);
+    vPortFree(kernels->combiner);
+    vPortFree(kernels->filter);
+    vPortFree(kernels->filtered);
+    memset(kernels, 0, sizeof(*kernels));
+}
+
+/*
+ * get the kernel table
+ */
+const benchmark_kernel_s *benchmark_kernels_get(uint32_t *num_kernels)
+{
+    *num_kernels = sizeof(kernel_table) / sizeof(kernel_table[0]);
+
+    return kernel_table;
+}
+
+/*
+ * round the runs up to whole periods
+ */
+uint32_t benchmark_kernels_get_frames(uint32_t period)
+{
+    return ((BENCHMARK_FRAMES + period - 1U) / period) * period;
+}
+
+/*
+ * synthetic average chirp, the presence algorithm works in place on its input
+ */
+void benchmark_kernels_prepare_chirp(benchmark_kernels_s *kernels, uint32_t frame)
+{
+    for (uint32_t i = 0U; i < kernels->samples_per_chirp; i++)
+    {
+        kernels->chirp[i] = 0.5f + (0.05f * sinf((0.25f * (float32_t)i) + (0.4f * (float32_t)frame)));
+    }
+}
+
+/*
+ * print a result as a JSON object
+ */
+void benchmark_print_result(const benchmark_result_s *result)
+{
+    printf("[BENCHMARK] {\"kernel\":\"%s\",\"frames\":%" PRIu32 ",\"cycles_min\":%" PRIu32
+           ",\"cycles_mean\":%" PRIu32 ",\"ns_mean\":%" PRIu32 "}\n",
+           result->name, result->frames, result->cycles_min, result->cycles_mean, result->ns_mean);
+}
@@ -0,0 +1,226 @@
+/*****************************************************************************
+ * File name: benchmark_kernels.h
+ *
+ * Description: This file contains the declaration of the frame path kernels
+ *   measured by the benchmark, independent of the clock which times them
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_BENCHMARK_KERNELS_H_
+#define SOURCE_BENCHMARK_KERNELS_H_
+
+#include <stdint.h>
+
+#include "clutter_map.h"
+#include "presence_cfar.h"
+#include "presence_tracker.h"
+#include "presence_vital_signs.h"
+#include "radar_aoa.h"
+#include "radar_rx_processing.h"
+#include "range_gate.h"
+#include "slow_time_filter.h"
+#include "xensiv_radar_presence.h"
+
+/*
+ * @def BENCHMARK_FRAMES
+ * Number of measured runs of every kernel
+ */
+#define BENCHMARK_FRAMES                    (32U)
+
+/*
+ * @def BENCHMARK_FRAME_PERIOD_MS
+ * Time between two synthetic frames
+ */
+#define BENCHMARK_FRAME_PERIOD_MS           (100U)
+
+/*
+ * @def struct benchmark_result_s
+ * Result of one kernel
+ * name - kernel name
+ * frames - number of measured runs
+ * cycles_min - fastest run, least disturbed by interrupts
+ * cycles_mean - mean of all runs
+ * ns_mean - mean of all runs in ns at the current core clock
+ */
+typedef struct
+{
+    const char *name;
+    uint32_t frames;
+    uint32_t cycles_min;
+    uint32_t cycles_mean;
+    uint32_t ns_mean;
+} benchmark_result_s;
+
+typedef void (*benchmark_report_t)(const benchmark_result_s *result);
+
+/*
+ * @def struct benchmark_kernels_s
+ * Frame format and buffers of the kernels, the stages with a state of their
+ * own run on separate instances, so the live detection is not disturbed
+ */
+typedef struct
+{
+    uint32_t num_chirps;
+    uint32_t samples_per_chirp;
+    uint32_t num_antennas;
+    uint32_t num_chirp_antennas;    /*<< at least three, for the combination and the angle of arrival*/
+    uint32_t num_macro_bins;
+    float32_t macro_bin_length;
+    uint16_t *fifo;
+    float32_t *planar;
+    float32_t *avg_chirps;
+    float32_t *chirp;
+    float32_t *magnitude;
+    uint8_t *compressed;
+    cfloat32_t *macro_fft;
+    presence_cfar_s *cfar;
+    presence_tracker_s *tracker;
+    presence_vital_signs_state_s *vital;
+    clutter_map_s *clutter;
+    radar_aoa_s *aoa;
+    radar_rx_combiner_s *combiner;
+    slow_time_filter_s *filter;
+    float32_t *filtered;
+    radar_aoa_result_s aoa_result;
+    range_gate_s gate;
+} benchmark_kernels_s;
+
+typedef void (*benchmark_kernel_t)(benchmark_kernels_s *kernels, uint32_t frame);
+
+typedef int32_t (*benchmark_setup_t)(benchmark_kernels_s *kernels, const xensiv_radar_presence_config_t *config,
+                                     uint32_t arg);
+
+/*
+ * @def struct benchmark_kernel_s
+ * Entry of the kernel table
+ * name - kernel name
+ * setup - called once before the runs with arg, the kernel is skipped if it fails, may be NULL
+ * arg - argument of setup
+ * prepare - called before every run without being measured, may be NULL
+ * kernel - measured kernel
+ * period - the runs cover whole periods, e.g. of a decimation
+ */
+typedef struct
+{
+    const char *name;
+    benchmark_setup_t setup;
+    uint32_t arg;
+    benchmark_kernel_t prepare;
+    benchmark_kernel_t kernel;
+    uint32_t period;
+} benchmark_kernel_s;
+
+
+/*******************************************************************************
+ * Function Name: benchmark_kernels_alloc
+ ****************************************************************************//**
+ *
+ * @brief Allocates the buffers and instances of the kernels and fills the
+ * FIFO with a synthetic IF signal.
+ *
+ * @param kernels Kernels.
+ * @param num_chirps Number of chirps per frame.
+ * @param samples_per_chirp Number of samples per chirp and antenna.
+ * @param num_antennas Number of interleaved antennas.
+ * @param num_macro_bins Number of bins of the macro FFT buffer.
+ * @param macro_bin_length Length of a macro FFT bin in m.
+ *
+ * @return 0 on success, -1 if the frame is too large or the buffers cannot be
+ * allocated.
+ *
+ *******************************************************************************/
+int32_t benchmark_kernels_alloc(benchmark_kernels_s *kernels, uint32_t num_chirps, uint32_t samples_per_chirp,
+                                uint32_t num_antennas, uint32_t num_macro_bins, float32_t macro_bin_length);
+
+/*******************************************************************************
+ * Function Name: benchmark_kernels_free
+ ****************************************************************************//**
+ *
+ * @brief Releases the buffers and instances of the kernels.
+ *
+ * @param kernels Kernels.
+ *
+ *******************************************************************************/
+void benchmark_kernels_free(benchmark_kernels_s *kernels);
+
+/*******************************************************************************
+ * Function Name: benchmark_kernels_get
+ ****************************************************************************//**
+ *
+ * @brief Gets the table of the kernels which do not need the presence
+ * library, in the order of the report.
+ *
+ * @param num_kernels Number of entries.
+ *
+ * @return Kernel table.
+ *
+ *******************************************************************************/
+const benchmark_kernel_s *benchmark_kernels_get(uint32_t *num_kernels);
+
+/*******************************************************************************
+ * Function Name: benchmark_kernels_get_frames
+ ****************************************************************************//**
+ *
+ * @param period Period of the kernel.
+ *
+ * @return Number of runs, BENCHMARK_FRAMES rounded up to whole periods.
+ *
+ *******************************************************************************/
+uint32_t benchmark_kernels_get_frames(uint32_t period);
+
+/*******************************************************************************
+ * Function Name: benchmark_kernels_prepare_chirp
+ ****************************************************************************//**
+ *
+ * @brief Synthetic average chirp of a target that moves a little every frame.
+ *
+ * @param kernels Kernels.
+ * @param frame Run.
+ *
+ *******************************************************************************/
+void benchmark_kernels_prepare_chirp(benchmark_kernels_s *kernels, uint32_t frame);
+
+/*******************************************************************************
+ * Function Name: benchmark_print_result
+ ****************************************************************************//**
+ *
+ * @brief Prints a result as one line
+ * "[BENCHMARK] {"kernel":...,"frames":...,"cycles_min":...,"cycles_mean":...,"ns_mean":...}".
+ *
+ * @param result Result.
+ *
+ *******************************************************************************/
+void benchmark_print_result(const benchmark_result_s *result);
+
+#endif /* SOURCE_BENCHMARK_KERNELS_H_ */
@@ -0,0 +1,121 @@
+/*****************************************************************************
+ * File name: cli_command_list.h
+ *
+ * Description: This file contains the list of the CLI commands. It is the only
+ *   copy of the list: cli_task.c builds its command table from it and the
+ *   host tests build a table of the same names with counting callbacks.
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_CLI_COMMAND_LIST_H_
+#define SOURCE_CLI_COMMAND_LIST_H_
+
+/*
+ * @def CLI_COMMAND_LIST
+ * X(id, name, callback, expected number of parameters, help string) for every
+ * command, sorted by name as the table is searched with a binary search
+ */
+#define CLI_COMMAND_LIST(X) \
+    X(BATCH, "batch", apply_batch, -1, \
+      "batch <id> <key=value> ... - Applies all settings or none, replies [BATCH] <id> <status> <detail>\n") \
+    X(BENCHMARK, "benchmark", run_benchmark, -1, \
+      "benchmark [key=value] ... - Cycles of the frame path kernels as [BENCHMARK] JSON lines, the keys override the presence config\n") \
+    X(BOARD_INFO, "board_info", display_board_Info, 0, \
+      "board_info -  Board_Information\n") \
+    X(CONFIG, "config", display_solution_config, 0, \
+      "config - solution configuration information\n") \
+    X(HISTORY, "history", display_history, 1, \
+      "history <minutes> - Occupancy, transitions and dwell times of the last minutes\n") \
+    X(OCCUPANCY, "occupancy", display_occupancy, 2, \
+      "occupancy <first minute> <last minute> - Stored per-minute occupancy records in the range\n") \
+    X(RESET_CONFIG, "reset_config", reset_config, 0, \
+      "reset_config - Removes the stored settings, the defaults apply after the next reset\n") \
+    X(SELFTEST, "selftest", run_selftest, -1, \
+      "selftest [key=value] ... - Event streams of fixed frame sequences in every mode as [SELFTEST] lines, the keys override the presence config\n") \
+    X(SET_AUTO_THRESHOLD, "set_auto_threshold", turn_auto_threshold, 1, \
+      "set_auto_threshold <enable|disable> - Derives macro and micro thresholds from the learned noise floor\n") \
+    X(SET_BANDPASS_FILTER, "set_bandpass_filter", turn_bandpass_filter, 1, \
+      "set_bandpass_filter <enable|disable> - Enabling/disabling bandpass filter\n") \
+    X(SET_CFAR_MODE, "set_cfar_mode", set_cfar_mode, 1, \
+      "set_cfar_mode <ca|os> - Chooses cell averaging or ordered statistic CFAR\n") \
+    X(SET_CHANGE_GATE, "set_change_gate", set_change_gate, 1, \
+      "set_change_gate <value> - Skips frames of an empty scene whose change stays below this multiple of the noise. Range 0 (off) or <1.5-100>\n") \
+    X(SET_CLUTTER_MAP, "set_clutter_map", set_clutter_map, 1, \
+      "set_clutter_map <off|learn|freeze> - Background subtraction mode, the map is stored in flash\n") \
+    X(SET_COALESCING, "set_coalescing", set_coalescing, 1, \
+      "set_coalescing <value> - Frames read per sensor interrupt in the low frame rate profile, 1 disables. Range <1-3> with one antenna\n") \
+    X(SET_DECIMATION_FILTER, "set_decimation_filter", turn_decimation_filter, 1, \
+      "set_decimation_filter <enable|disable> - Enabling/disabling decimation filter\n") \
+    X(SET_FILTER_BANK, "set_filter_bank", set_filter_bank, 2, \
+      "set_filter_bank <highpass> <lowpass> - Sets the slow time filter cutoffs in Hz, 0 disables a filter. Range <0-100>\n") \
+    X(SET_FRAME_DECIMATION, "set_frame_decimation", set_frame_decimation, 1, \
+      "set_frame_decimation <value> - Runs the presence algorithm on every n-th filtered frame. Range <1-8>\n") \
+    X(SET_MACRO_THRESHOLD, "set_macro_threshold", set_macro_threshold, 1, \
+      "set_macro_threshold <value> - Sets macro threshold for presence algorithm. Range <0.5-2.0>\n") \
+    X(SET_MAX_RANGE, "set_max_range", set_max_range, 1, \
+      "set_max_range <value> - Sets the max range for presence algorithm in meters. Range <0.66-5.0>\n") \
+    X(SET_MICRO_THRESHOLD, "set_micro_threshold", set_micro_threshold, 1, \
+      "set_micro_threshold <value> - Sets micro threshold for presence algorithm. Range <0.2-50.0>\n") \
+    X(SET_MODE, "set_mode", set_presence_mode, 1, \
+      "set_mode <macro_only|micro_only|micro_if_macro|micro_and_macro> - Chooses work mode\n") \
+    X(SET_RANGE_GATE, "set_range_gate", turn_range_gate, 1, \
+      "set_range_gate <enable|disable> - Limits per range bin processing to the configured range\n") \
+    X(SET_RAW_STREAM, "set_raw_stream", set_raw_stream, 1, \
+      "set_raw_stream <0..1000> - Stream every Nth raw frame compressed as [RAW] lines, 0 stops\n") \
+    X(SET_TRACKER_THRESHOLD, "set_tracker_threshold", set_tracker_threshold, 1, \
+      "set_tracker_threshold <value> - Minimum frame to frame change of a range bin picked by the people tracker. Range <0.1-5.0>\n") \
+    X(SET_VITAL_SIGNS, "set_vital_signs", turn_vital_signs, 1, \
+      "set_vital_signs <enable|disable> - Estimates the breathing rate while micro presence is reported\n") \
+    X(STATS, "stats", display_task_stats, 0, \
+      "stats - CPU load, stack and heap usage of all tasks as [STATS] lines\n") \
+    X(VERBOSE, "verbose", set_verbose, 1, \
+      "verbose <enable|disable> - Enable/disable detailed verbose status to be updated every second\n")
+
+/*
+ * @def CLI_COMMAND_ENUM
+ * Index of the command in the list
+ */
+#define CLI_COMMAND_ENUM(id, name, callback, parameters, help) CLI_COMMAND_##id,
+
+/*
+ * @typedef typedef enum cli_command_e
+ * Indices of the commands, NUMBER_OF_COMMANDS is their number
+ */
+typedef enum
+{
+    CLI_COMMAND_LIST(CLI_COMMAND_ENUM)
+    NUMBER_OF_COMMANDS
+} cli_command_e;
+
+#endif /* SOURCE_CLI_COMMAND_LIST_H_ */
@@ -0,0 +1,172 @@
+/*****************************************************************************
+ * File name: cli_parse.c
+ *
+ * Description: This file implements the parsers for the CLI command
+ *   parameters
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <ctype.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cli_parse.h"
+
+/*******************************************************************************
+ * Variables
+ ********************************************************************************/
+/* Indexed by xensiv_radar_presence_mode_t */
+static const char * const mode_names[] =
+{
+    [XENSIV_RADAR_PRESENCE_MODE_MACRO_ONLY]      = MACRO_ONLY_STRING,
+    [XENSIV_RADAR_PRESENCE_MODE_MICRO_ONLY]      = MICRO_ONLY_STRING,
+    [XENSIV_RADAR_PRESENCE_MODE_MICRO_IF_MACRO]  = MICRO_IF_MACRO_STRING,
+    [XENSIV_RADAR_PRESENCE_MODE_MICRO_AND_MACRO] = MICRO_AND_MACRO_STRING
+};
+
+/*
+ * parse a finite decimal number
+ */
+bool cli_parse_float(const char *string, size_t length, float32_t *value)
+{
+    char number[CLI_PARSE_MAX_NUMBER_LENGTH + 1U];
+    char *end;
+    float32_t result;
+
+    /* strtof skips leading white space, the parameter must not start with it */
+    if ((length == 0U) || (length > CLI_PARSE_MAX_NUMBER_LENGTH) || isspace((unsigned char)string[0]))
+    {
+        return false;
+    }
+
+    memcpy(number, string, length);
+    number[length] = '\0';
+
+    result = strtof(number, &end);
+
+    if ((end != &number[length]) || !isfinite(result))
+    {
+        return false;
+    }
+
+    *value = result;
+
+    return true;
+}
+
+/*
+ * parse an unsigned decimal integer
+ */
+bool cli_parse_u32(const char *string, size_t length, uint32_t *value)
+{
+    uint32_t result = 0;
+
+    if ((length == 0U) || (length > CLI_PARSE_MAX_NUMBER_LENGTH))
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        uint32_t digit = (uint32_t)(string[i] - '0');
+
+        if ((string[i] < '0') || (string[i] > '9') ||
+            (result > ((UINT32_MAX - digit) / 10U)))
+        {
+            return false;
+        }
+
+        result = (result * 10U) + digit;
+    }
+
+    *value = result;
+
+    return true;
+}
+
+/*
+ * look up a name
+ */
+bool cli_parse_choice(const char *string, size_t length,
+                      const char * const *choices, uint32_t num_choices, uint32_t *index)
+{
+    for (uint32_t i = 0; i < num_choices; ++i)
+    {
+        /* the lengths are compared first, the parameter may contain a zero */
+        if ((strlen(choices[i]) == length) && (memcmp(string, choices[i], length) == 0))
+        {
+            *index = i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+ * parse one of two names
+ */
+bool cli_parse_bool(const char *string, size_t length,
+                    const char *true_string, const char *false_string, bool *value)
+{
+    const char * const choices[] = { false_string, true_string };
+    uint32_t index;
+
+    if (!cli_parse_choice(string, length, choices, 2U, &index))
+    {
+        return false;
+    }
+
+    *value = (index == 1U);
+
+    return true;
+}
+
+/*
+ * parse the name of a presence mode
+ */
+bool cli_parse_mode(const char *string, size_t length, xensiv_radar_presence_mode_t *mode)
+{
+    uint32_t index;
+
+    if (!cli_parse_choice(string, length, mode_names, sizeof(mode_names) / sizeof(mode_names[0]), &index))
+    {
+        return false;
+    }
+
+    *mode = (xensiv_radar_presence_mode_t)index;
+
+    return true;
+}
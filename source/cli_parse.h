@@ -0,0 +1,163 @@
+/*****************************************************************************
+ * File name: cli_parse.h
+ *
+ * Description: This file contains the function prototypes of the parsers for
+ *   the CLI command parameters
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_CLI_PARSE_H_
+#define SOURCE_CLI_PARSE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "arm_math.h"
+#include "xensiv_radar_presence.h"
+
+/* Names for presence mode */
+#define MACRO_ONLY_STRING      ("macro_only")
+#define MICRO_ONLY_STRING      ("micro_only")
+#define MICRO_IF_MACRO_STRING  ("micro_if_macro")
+#define MICRO_AND_MACRO_STRING ("micro_and_macro")
+
+/*
+ * @def CLI_PARSE_MAX_NUMBER_LENGTH
+ * Longest accepted number string
+ */
+#define CLI_PARSE_MAX_NUMBER_LENGTH         (24U)
+
+/*******************************************************************************
+ * Function Name: cli_parse_float
+ ****************************************************************************//**
+ *
+ * @brief Parses a decimal number. The whole string must be consumed, empty
+ * strings, leading white space, trailing characters, NaN and infinity are
+ * rejected.
+ *
+ * @param string Parameter string, does not need to be zero terminated.
+ * @param length Length of the parameter string.
+ * @param value Parsed value, only written on success.
+ *
+ * @return true if the string is a finite number, false otherwise.
+ *
+ *******************************************************************************/
+bool cli_parse_float(const char *string, size_t length, float32_t *value);
+
+/*******************************************************************************
+ * Function Name: cli_parse_u32
+ ****************************************************************************//**
+ *
+ * @brief Parses an unsigned decimal integer made of digits only.
+ *
+ * @param string Parameter string, does not need to be zero terminated.
+ * @param length Length of the parameter string.
+ * @param value Parsed value, only written on success.
+ *
+ * @return true if the string is a number which fits into 32 bits, false otherwise.
+ *
+ *******************************************************************************/
+bool cli_parse_u32(const char *string, size_t length, uint32_t *value);
+
+/*******************************************************************************
+ * Function Name: cli_parse_choice
+ ****************************************************************************//**
+ *
+ * @brief Looks up a parameter in a list of names.
+ *
+ * @param string Parameter string, does not need to be zero terminated.
+ * @param length Length of the parameter string.
+ * @param choices Accepted names.
+ * @param num_choices Number of accepted names.
+ * @param index Index of the matching name, only written on success.
+ *
+ * @return true if the parameter matches one of the names exactly, false otherwise.
+ *
+ *******************************************************************************/
+bool cli_parse_choice(const char *string, size_t length,
+                      const char * const *choices, uint32_t num_choices, uint32_t *index);
+
+/*******************************************************************************
+ * Function Name: cli_parse_bool
+ ****************************************************************************//**
+ *
+ * @brief Parses one of two names, for example enable and disable.
+ *
+ * @param string Parameter string, does not need to be zero terminated.
+ * @param length Length of the parameter string.
+ * @param true_string Name for true.
+ * @param false_string Name for false.
+ * @param value Parsed value, only written on success.
+ *
+ * @return true if the parameter is one of the names, false otherwise.
+ *
+ *******************************************************************************/
+bool cli_parse_bool(const char *string, size_t length,
+                    const char *true_string, const char *false_string, bool *value);
+
+/*******************************************************************************
+ * Function Name: cli_parse_mode
+ ****************************************************************************//**
+ *
+ * @brief Parses the name of a presence mode.
+ *
+ * @param string Parameter string, does not need to be zero terminated.
+ * @param length Length of the parameter string.
+ * @param mode Parsed mode, only written on success.
+ *
+ * @return true if the parameter is a mode name, false otherwise.
+ *
+ *******************************************************************************/
+bool cli_parse_mode(const char *string, size_t length, xensiv_radar_presence_mode_t *mode);
+
+/*******************************************************************************
+ * Function Name: cli_check_range
+ ****************************************************************************//**
+ *
+ * @brief Checks if a value is within a closed range. NaN is out of range.
+ *
+ * @param value Value.
+ * @param min Minimum value.
+ * @param max Maximum value.
+ *
+ * @return true if the value is within the range, false otherwise.
+ *
+ *******************************************************************************/
+static inline bool cli_check_range(float32_t value, float32_t min, float32_t max)
+{
+    return (value >= min) && (value <= max);
+}
+
+#endif /* SOURCE_CLI_PARSE_H_ */
@@ -38,6 +38,7 @@
 * so agrees to indemnify Cypress against all liability.
 *******************************************************************************/
 
+#include <inttypes.h>
 #include <stdlib.h>
 
 #include "cy_retarget_io.h"
@@ -47,45 +48,61 @@
 #include "FreeRTOS_CLI.h"
 
 #include "cli_task.h"
+#include "console_uart.h"
+#include "cli_parse.h"
 
 #include "xensiv_radar_presence.h"
 #include "radar_config_optimizer.h"
+#include "range_gate.h"
+#include "presence_cfar.h"
+#include "presence_tracker.h"
+#include "presence_vital_signs.h"
+#include "slow_time_filter.h"
+#include "clutter_map.h"
+#include "config_store.h"
+#include "presence_config_stage.h"
+#include "presence_event_log.h"
+#include "occupancy_store.h"
+#include "raw_stream.h"
+#include "benchmark.h"
+#include "selftest.h"
+#include "selftest_scenarios.h"
+#include "task_stats.h"
+#include "frame_deadline.h"
+#include "frame_coalescing.h"
+#include "frame_change_gate.h"
+#include "presence_settings.h"
+#include "cli_command_list.h"
 
 /*******************************************************************************
  * Macros
  ********************************************************************************/
-#define NUMBER_OF_COMMANDS (9)
-
 /* Strings length */
-#define MAX_INPUT_LENGTH  (50)
+#define MAX_INPUT_LENGTH  (CONSOLE_LINE_LENGTH)
 #define MAX_OUTPUT_LENGTH (100)
 
 /* Strings for enable and disable */
 #define ENABLE_STRING  ("enable")
 #define DISABLE_STRING ("disable")
 
-/* Max range min - max */
-#define MAX_RANGE_MIN_LIMIT (0.66f)
-#define MAX_RANGE_MAX_LIMIT (5.0f)
-
-/* Macro threshold min - max */
-#define MACRO_THRESHOLD_MIN_LIMIT (0.5f)
-#define MACRO_THRESHOLD_MAX_LIMIT (2.0f)
-
-/* Micro threshold min - max */
-#define MICRO_THRESHOLD_MIN_LIMIT (0.2f)
-#define MICRO_THRESHOLD_MAX_LIMIT (50.0f)
-
-/* Names for presence mode */
-#define MACRO_ONLY_STRING      ("macro_only")
-#define MICRO_ONLY_STRING      ("micro_only")
-#define MICRO_IF_MACRO_STRING  ("micro_if_macro")
-#define MICRO_AND_MACRO_STRING ("micro_and_macro")
-
-/* Keyboard keys */
-#define ENTER_KEY     (0x0D)
-#define ESC_KEY       (0x1B)
-#define BACKSPACE_KEY (0x08)
+/* Names for CFAR mode */
+#define CFAR_CA_STRING ("ca")
+#define CFAR_OS_STRING ("os")
+
+/* Names for clutter map mode */
+#define CLUTTER_OFF_STRING    ("off")
+#define CLUTTER_LEARN_STRING  ("learn")
+#define CLUTTER_FREEZE_STRING ("freeze")
+
+/* Commands for scripts, accepted outside of the settings mode */
+#define BATCH_COMMAND_STRING   ("batch")
+#define HISTORY_COMMAND_STRING ("history")
+#define HISTORY_MAX_MINUTES    (1440U)
+#define OCCUPANCY_COMMAND_STRING ("occupancy")
+#define BATCH_MAX_ID_LENGTH  (16)
+/* Batch keys ordered before range_gate belong to the presence algorithm */
+#define BATCH_PRESENCE_KEYS  ((1UL << BATCH_KEY_RANGE_GATE) - 1U)
+#define BATCH_FILTER_KEYS    ((1UL << BATCH_KEY_FILTER_HIGHPASS) | (1UL << BATCH_KEY_FILTER_LOWPASS))
 
 /*******************************************************************************
  * Local Declarations
@@ -95,8 +112,64 @@ typedef struct
     xensiv_radar_presence_event_t last_reported_event;
     bool verbose;
     XENSIV_RADAR_PRESENCE_TIMESTAMP bookmark_timestamp;
+    uint32_t people_count;
+    bool settings_mode;
 }ce_state_s;
 
+/* Status codes of the batch response */
+typedef enum
+{
+    BATCH_OK = 0,           /* all settings applied */
+    BATCH_ERR_SYNTAX = 1,   /* missing id or a setting is not key=value */
+    BATCH_ERR_KEY = 2,      /* unknown key */
+    BATCH_ERR_VALUE = 3,    /* invalid value */
+    BATCH_ERR_APPLY = 4     /* the settings were rejected when applied */
+} batch_status_e;
+
+/* Keys of the batch command, named like the set_* commands */
+typedef enum
+{
+    BATCH_KEY_MAX_RANGE,
+    BATCH_KEY_MACRO_THRESHOLD,
+    BATCH_KEY_MICRO_THRESHOLD,
+    BATCH_KEY_BANDPASS_FILTER,
+    BATCH_KEY_DECIMATION_FILTER,
+    BATCH_KEY_MODE,
+    BATCH_KEY_RANGE_GATE,
+    BATCH_KEY_AUTO_THRESHOLD,
+    BATCH_KEY_CFAR_MODE,
+    BATCH_KEY_VITAL_SIGNS,
+    BATCH_KEY_FILTER_HIGHPASS,
+    BATCH_KEY_FILTER_LOWPASS,
+    BATCH_KEY_FRAME_DECIMATION,
+    BATCH_KEY_CHANGE_GATE,
+    BATCH_KEY_CLUTTER_MAP,
+    BATCH_KEY_RAW_STREAM,
+    BATCH_KEY_COALESCING,
+    BATCH_KEY_TRACKER_THRESHOLD,
+    BATCH_KEY_COUNT
+} batch_key_e;
+
+/* Settings of one batch, validated before anything is applied */
+typedef struct
+{
+    uint32_t keys;          /* bit per batch_key_e */
+    bool needs_reset;
+    xensiv_radar_presence_config_t config;
+    bool range_gate;
+    bool auto_threshold;
+    presence_cfar_mode_e cfar_mode;
+    bool vital_signs;
+    float32_t highpass_hz;
+    float32_t lowpass_hz;
+    uint32_t frame_decimation;
+    float32_t change_gate;
+    uint32_t clutter_map;
+    uint32_t raw_stream;
+    uint32_t coalescing;
+    float32_t tracker_threshold;
+} batch_settings_s;
+
 /*******************************************************************************
  * Function Prototypes
  ********************************************************************************/
@@ -112,82 +185,104 @@ static BaseType_t turn_decimation_filter(char *pcWriteBuffer,
         size_t xWriteBufferLen, const char *pcCommandString);
 static BaseType_t set_presence_mode(char *pcWriteBuffer, size_t xWriteBufferLen,
         const char *pcCommandString);
+static BaseType_t turn_range_gate(char *pcWriteBuffer,
+        size_t xWriteBufferLen, const char *pcCommandString);
+static BaseType_t turn_auto_threshold(char *pcWriteBuffer,
+        size_t xWriteBufferLen, const char *pcCommandString);
+static BaseType_t set_cfar_mode(char *pcWriteBuffer,
+        size_t xWriteBufferLen, const char *pcCommandString);
+static BaseType_t set_change_gate(char *pcWriteBuffer,
+        size_t xWriteBufferLen, const char *pcCommandString);
+static BaseType_t set_tracker_threshold(char *pcWriteBuffer,
+        size_t xWriteBufferLen, const char *pcCommandString);
+static BaseType_t turn_vital_signs(char *pcWriteBuffer,
+        size_t xWriteBufferLen, const char *pcCommandString);
+static BaseType_t set_filter_bank(char *pcWriteBuffer,
+        size_t xWriteBufferLen, const char *pcCommandString);
+static BaseType_t set_frame_decimation(char *pcWriteBuffer,
+        size_t xWriteBufferLen, const char *pcCommandString);
+static BaseType_t set_raw_stream(char *pcWriteBuffer,
+        size_t xWriteBufferLen, const char *pcCommandString);
+static BaseType_t set_clutter_map(char *pcWriteBuffer,
+        size_t xWriteBufferLen, const char *pcCommandString);
+static BaseType_t set_coalescing(char *pcWriteBuffer,
+        size_t xWriteBufferLen, const char *pcCommandString);
+static BaseType_t reset_config(char *pcWriteBuffer,
+        size_t xWriteBufferLen, const char *pcCommandString);
+static BaseType_t apply_batch(char *pcWriteBuffer,
+        size_t xWriteBufferLen, const char *pcCommandString);
+static BaseType_t display_history(char *pcWriteBuffer,
+        size_t xWriteBufferLen, const char *pcCommandString);
+static BaseType_t run_benchmark(char *pcWriteBuffer,
+        size_t xWriteBufferLen, const char *pcCommandString);
+static BaseType_t run_selftest(char *pcWriteBuffer,
+        size_t xWriteBufferLen, const char *pcCommandString);
+static void print_selftest_run(const selftest_run_s *run);
+static void print_selftest_labels(void);
+static BaseType_t display_occupancy(char *pcWriteBuffer,
+        size_t xWriteBufferLen, const char *pcCommandString);
+static BaseType_t display_task_stats(char *pcWriteBuffer,
+        size_t xWriteBufferLen, const char *pcCommandString);
 static BaseType_t display_board_Info(char *pcWriteBuffer, size_t xWriteBufferLen,
         const char *pcCommandString);
 static BaseType_t display_solution_config(char *pcWriteBuffer, size_t xWriteBufferLen,
         const char *pcCommandString); 
 static BaseType_t set_verbose(char *pcWriteBuffer,
         size_t xWriteBufferLen, const char *pcCommandString);
-static inline bool check_bool_validation(const char *value, const char *enable,
-        const char *disable);
-static inline bool check_float_validation(float32_t value, float32_t min,
-        float32_t max);
-static inline bool string_to_bool(const char *string, const char *enable,
-        const char *disable);
-static inline bool check_mode_validation(const char *mode);
-static inline xensiv_radar_presence_mode_t string_to_mode(const char *mode);
-extern void presence_detection_cb(xensiv_radar_presence_handle_t handle,
-        const xensiv_radar_presence_event_t *event, void *data);
+static inline bool is_script_command(const char *command);
+static batch_status_e batch_parse_setting(char *setting, batch_settings_s *settings);
+static void batch_store_settings(const batch_settings_s *settings);
+static const char *parse_config_overrides(const char *command_string, xensiv_radar_presence_config_t *config);
 
 /*******************************************************************************
  * Variables
  ********************************************************************************/
+/*
+ * @def CLI_COMMAND_ENTRY
+ * Entry of the command table
+ */
+#define CLI_COMMAND_ENTRY(id, name, callback, parameters, help) \
+    { \
+        .pcCommand = name, \
+        .pcHelpString = help, \
+        .pxCommandInterpreter = callback, \
+        .cExpectedNumberOfParameters = parameters \
+    },
+
+/* Sorted by command name, the table is searched with a binary search */
 static const CLI_Command_Definition_t command_list[NUMBER_OF_COMMANDS] =
 {
-    {
-        .pcCommand = "set_max_range",
-        .pcHelpString = "set_max_range <value> - Sets the max range for presence algorithm in meters. Range <0.66-5.0>\n",
-        .pxCommandInterpreter = set_max_range,
-        .cExpectedNumberOfParameters = 1
-    },
-    {
-        .pcCommand = "set_macro_threshold",
-        .pcHelpString = "set_macro_threshold <value> - Sets macro threshold for presence algorithm. Range <0.5-2.0>\n",
-        .pxCommandInterpreter = set_macro_threshold,
-        .cExpectedNumberOfParameters = 1
-    },
-    {
-        .pcCommand = "set_micro_threshold",
-        .pcHelpString = "set_micro_threshold <value> - Sets micro threshold for presence algorithm. Range <0.2-50.0>\n",
-        .pxCommandInterpreter = set_micro_threshold,
-        .cExpectedNumberOfParameters = 1
-    },
-    {
-        .pcCommand = "set_bandpass_filter",
-        .pcHelpString = "set_bandpass_filter <enable|disable> - Enabling/disabling bandpass filter\n",
-        .pxCommandInterpreter = turn_bandpass_filter,
-        .cExpectedNumberOfParameters = 1
-    },
-    {
-        .pcCommand = "set_decimation_filter",
-        .pcHelpString = "set_decimation_filter <enable|disable> - Enabling/disabling decimation filter\n",
-        .pxCommandInterpreter = turn_decimation_filter,
-        .cExpectedNumberOfParameters = 1
-    },
-    {
-        .pcCommand = "set_mode",
-        .pcHelpString = "set_mode <macro_only|micro_only|micro_if_macro|micro_and_macro> - Chooses work mode\n",
-        .pxCommandInterpreter = set_presence_mode,
-        .cExpectedNumberOfParameters = 1
-    },
-    {
-        .pcCommand = "verbose",
-        .pcHelpString = "verbose <enable|disable> - Enable/disable detailed verbose status to be updated every second\n",
-        .pxCommandInterpreter = set_verbose,
-        .cExpectedNumberOfParameters = 1
-    },
-    {
-        .pcCommand = "board_info",
-        .pcHelpString = "board_info -  Board_Information\n",
-        .pxCommandInterpreter = display_board_Info,
-        .cExpectedNumberOfParameters = 0
-    },
-    {
-        .pcCommand = "config",
-        .pcHelpString = "config - solution configuration information\n",
-        .pxCommandInterpreter = display_solution_config,
-        .cExpectedNumberOfParameters = 0
-    }
+    CLI_COMMAND_LIST(CLI_COMMAND_ENTRY)
+};
+
+static const char * const batch_keys[BATCH_KEY_COUNT] =
+{
+    [BATCH_KEY_MAX_RANGE]         = "max_range",
+    [BATCH_KEY_MACRO_THRESHOLD]   = "macro_threshold",
+    [BATCH_KEY_MICRO_THRESHOLD]   = "micro_threshold",
+    [BATCH_KEY_BANDPASS_FILTER]   = "bandpass_filter",
+    [BATCH_KEY_DECIMATION_FILTER] = "decimation_filter",
+    [BATCH_KEY_MODE]              = "mode",
+    [BATCH_KEY_RANGE_GATE]        = "range_gate",
+    [BATCH_KEY_AUTO_THRESHOLD]    = "auto_threshold",
+    [BATCH_KEY_CFAR_MODE]         = "cfar_mode",
+    [BATCH_KEY_VITAL_SIGNS]       = "vital_signs",
+    [BATCH_KEY_FILTER_HIGHPASS]   = "filter_highpass",
+    [BATCH_KEY_FILTER_LOWPASS]    = "filter_lowpass",
+    [BATCH_KEY_FRAME_DECIMATION]  = "frame_decimation",
+    [BATCH_KEY_CHANGE_GATE]       = "change_gate",
+    [BATCH_KEY_CLUTTER_MAP]       = "clutter_map",
+    [BATCH_KEY_RAW_STREAM]        = "raw_stream",
+    [BATCH_KEY_COALESCING]        = "coalescing",
+    [BATCH_KEY_TRACKER_THRESHOLD] = "tracker_threshold"
+};
+
+/* Indexed by clutter_map_mode_e */
+static const char * const clutter_map_names[] =
+{
+    [CLUTTER_MAP_OFF]    = CLUTTER_OFF_STRING,
+    [CLUTTER_MAP_LEARN]  = CLUTTER_LEARN_STRING,
+    [CLUTTER_MAP_FREEZE] = CLUTTER_FREEZE_STRING
 };
 
 static xensiv_radar_presence_handle_t handle;
@@ -199,9 +294,10 @@ extern ce_state_s ce_app_state;
  * Summary:
  * This is the console task.
  *    1. Register commands
- *    2. In loop there are two modes: presence when the events are detected and setting_mode, when the user can change
+ *    2. Takes over the console UART, the line editing runs in the UART interrupt
+ *    3. In loop there are two modes: presence when the events are detected and setting_mode, when the user can change
  *work parameters
- *       - Waits for a sign
+ *       - Waits for a complete line or ESC
  *       - When ENTER is hit go to the settings mode
  *       - Use 'help' command to know what commands are available
  *       - Type commands with values to change parameters
@@ -216,8 +312,8 @@ extern ce_state_s ce_app_state;
  *******************************************************************************/
 __NO_RETURN void console_task(void *pvParameters)
 {
-    int8_t cInputIndex = 0;
     BaseType_t xMoreDataToFollow;
+    uint32_t events;
     /* The input and output buffers are declared static to keep them off the stack. */
     static char pcOutputString[MAX_OUTPUT_LENGTH];
     static char pcInputString[MAX_INPUT_LENGTH];
@@ -226,46 +322,45 @@ __NO_RETURN void console_task(void *pvParameters)
     handle = (xensiv_radar_presence_handle_t) pvParameters;
     CY_ASSERT(handle != NULL);
 
-    setvbuf(stdin, NULL, _IONBF, 0);
     setvbuf(stdout, NULL, _IONBF, 0);
 
-    for (int32_t i = 0; i < NUMBER_OF_COMMANDS; ++i)
+    if (console_uart_init(xTaskGetCurrentTaskHandle()) != 0)
     {
-        FreeRTOS_CLIRegisterCommand(&command_list[i]);
+        CY_ASSERT(0);
     }
 
+    FreeRTOS_CLIRegisterCommandTable(command_list, NUMBER_OF_COMMANDS);
+
     for (;;)
     {
-        /* Wait for a sign */
-        int32_t c = getchar();
+        /* Wait for a complete line or ESC */
+        (void)xTaskNotifyWait(0, UINT32_MAX, &events, portMAX_DELAY);
 
-        if (!setting_mode)
+        /* Several lines can be queued when commands are sent back to back */
+        while (((events & CONSOLE_EVENT_LINE) != 0U) &&
+               console_uart_read_line(pcInputString, MAX_INPUT_LENGTH))
         {
-            /* Enter setting mode */
-            if (c == ENTER_KEY)
+            if (is_script_command(pcInputString))
             {
-                cInputIndex = 0;
-                memset(pcInputString, 0x00, MAX_INPUT_LENGTH);
-                setting_mode = true;
-                xensiv_radar_presence_set_callback(handle, NULL, NULL);
-                printf("\r\nEnter setting mode and stop processing\r\n"
-                        "> ");
+                /* scripted commands get their response only, in any mode */
+                do
+                {
+                    xMoreDataToFollow = FreeRTOS_CLIProcessCommand(pcInputString, pcOutputString, MAX_OUTPUT_LENGTH);
+                    printf("%s", pcOutputString);
+                } while (xMoreDataToFollow != pdFALSE);
             }
-        }
-        else
-        {
-            /* Exit setting mode */
-            if (c == ESC_KEY)
+            else if (!setting_mode)
             {
-                cInputIndex = 0;
-                memset(pcInputString, 0x00, MAX_INPUT_LENGTH);
-                setting_mode = false;
-                printf("\r\nQuit from settings menu and back to processing\r\n\n");
-                xensiv_radar_presence_set_callback(handle, presence_detection_cb, NULL);
+                /* Enter setting mode, the line content is ignored */
+                setting_mode = true;
+                ce_app_state.settings_mode = true;
+                console_uart_set_echo(true);
+                printf("\r\nEnter setting mode, processing continues without reports\r\n"
+                        "> ");
             }
-            else if (c == ENTER_KEY) // confirm entered text
+            else
             {
-                putchar('\n');
+                printf("\n");
 
                 /* The command interpreter is called repeatedly until it returns
                  pdFALSE.  See the "Implementing a command" documentation for an
@@ -285,41 +380,17 @@ __NO_RETURN void console_task(void *pvParameters)
                     printf("%s", pcOutputString);
                 } while (xMoreDataToFollow != pdFALSE);
 
-                /* All the strings generated by the input command have been sent.
-                 Processing of the command is complete.  Clear the input string ready
-                 to receive the next command. */
-                cInputIndex = 0;
-                memset(pcInputString, 0x00, MAX_INPUT_LENGTH);
-
                 printf("> ");
             }
-            else
-            {
-                if (c == BACKSPACE_KEY)
-                {
-                    /* Backspace was pressed.  Erase the last character in the input
-                     buffer - if there are any. */
-                    if (cInputIndex > 0)
-                    {
-                        cInputIndex--;
-                        pcInputString[cInputIndex] = ' ';
-                        putchar(BACKSPACE_KEY);
-                    }
-                }
-                else
-                {
-                    /* A character was entered.  It was not a new line, backspace
-                     or carriage return, so it is accepted as part of the input and
-                     placed into the input buffer.  When a \n is entered the complete
-                     string will be passed to the command interpreter. */
-                    if (cInputIndex < MAX_INPUT_LENGTH)
-                    {
-                        pcInputString[cInputIndex] = c;
-                        cInputIndex++;
-                        putchar(c);
-                    }
-                }
-            }
+        }
+
+        /* Exit setting mode */
+        if (((events & CONSOLE_EVENT_ESC) != 0U) && setting_mode)
+        {
+            setting_mode = false;
+            ce_app_state.settings_mode = false;
+            console_uart_set_echo(false);
+            printf("\r\nQuit from settings menu and back to reporting\r\n\n");
         }
     }
 }
@@ -357,7 +428,7 @@ static BaseType_t set_max_range(char *pcWriteBuffer, size_t xWriteBufferLen,
             &lParameterStringLength); /* Store the parameter string length. */
 
     configASSERT(pcParameter);
-    result = xensiv_radar_presence_get_config(handle, &config);
+    result = presence_config_stage_get(&config);
 
     if (result != XENSIV_RADAR_PRESENCE_OK)
     {
@@ -365,16 +436,12 @@ static BaseType_t set_max_range(char *pcWriteBuffer, size_t xWriteBufferLen,
     }
     else
     {
-        float_value = strtof(pcParameter, NULL);
-
-        if (check_float_validation(float_value, MAX_RANGE_MIN_LIMIT, MAX_RANGE_MAX_LIMIT))
+        if (cli_parse_float(pcParameter, (size_t)lParameterStringLength, &float_value) &&
+            cli_check_range(float_value, MAX_RANGE_MIN_LIMIT, MAX_RANGE_MAX_LIMIT))
         {
             config.max_range_bin = (int32_t) (float_value
                     / (xensiv_radar_presence_get_bin_length(handle)));
-            vTaskSuspendAll();
-            result = xensiv_radar_presence_set_config(handle, &config);
-            xensiv_radar_presence_reset(handle);
-            xTaskResumeAll();
+            result = presence_config_stage_commit_and_wait(&config, true);
             maxRange = (xensiv_radar_presence_get_bin_length(handle)* config.max_range_bin);
 
             if (result != XENSIV_RADAR_PRESENCE_OK)
@@ -383,6 +450,7 @@ static BaseType_t set_max_range(char *pcWriteBuffer, size_t xWriteBufferLen,
             }
             else
             {
+                config_store_set_u32(CONFIG_KEY_MAX_RANGE_BIN, (uint32_t)config.max_range_bin);
                 sprintf(pcWriteBuffer," [CONFIG] max_range %f \r\n\n", maxRange);
             }
         }
@@ -427,7 +495,7 @@ static BaseType_t set_macro_threshold(char *pcWriteBuffer,
             &lParameterStringLength); /* Store the parameter string length. */
 
     configASSERT(pcParameter);
-    result = xensiv_radar_presence_get_config(handle, &config);
+    result = presence_config_stage_get(&config);
 
     if (result != XENSIV_RADAR_PRESENCE_OK)
     {
@@ -435,16 +503,12 @@ static BaseType_t set_macro_threshold(char *pcWriteBuffer,
     }
     else
     {
-        float_value = strtof(pcParameter, NULL);
-
-        if (check_float_validation(float_value, MACRO_THRESHOLD_MIN_LIMIT,
-                MACRO_THRESHOLD_MAX_LIMIT))
+        if (cli_parse_float(pcParameter, (size_t)lParameterStringLength, &float_value) &&
+            cli_check_range(float_value, MACRO_THRESHOLD_MIN_LIMIT, MACRO_THRESHOLD_MAX_LIMIT))
         {
             config.macro_threshold = float_value;
-            vTaskSuspendAll();
-            result = xensiv_radar_presence_set_config(handle, &config);
-            xensiv_radar_presence_reset(handle);
-            xTaskResumeAll();
+            /* thresholds take effect on the next frame without clearing the algorithm history */
+            result = presence_config_stage_commit_and_wait(&config, false);
 
             if (result != XENSIV_RADAR_PRESENCE_OK)
             {
@@ -452,6 +516,7 @@ static BaseType_t set_macro_threshold(char *pcWriteBuffer,
             }
             else
             {
+                config_store_set_float(CONFIG_KEY_MACRO_THRESHOLD, config.macro_threshold);
                 sprintf(pcWriteBuffer, "[CONFIG] macro_threshold %f \r\n\n",config.macro_threshold);
             }
         }
@@ -496,7 +561,7 @@ static BaseType_t set_micro_threshold(char *pcWriteBuffer,
             &lParameterStringLength); /* Store the parameter string length. */
 
     configASSERT(pcParameter);
-    result = xensiv_radar_presence_get_config(handle, &config);
+    result = presence_config_stage_get(&config);
 
     if (result != XENSIV_RADAR_PRESENCE_OK)
     {
@@ -504,16 +569,11 @@ static BaseType_t set_micro_threshold(char *pcWriteBuffer,
     }
     else
     {
-        float_value = strtof(pcParameter, NULL);
-
-        if (check_float_validation(float_value, MICRO_THRESHOLD_MIN_LIMIT,
-                MICRO_THRESHOLD_MAX_LIMIT))
+        if (cli_parse_float(pcParameter, (size_t)lParameterStringLength, &float_value) &&
+            cli_check_range(float_value, MICRO_THRESHOLD_MIN_LIMIT, MICRO_THRESHOLD_MAX_LIMIT))
         {
             config.micro_threshold = float_value;
-            vTaskSuspendAll();
-            result = xensiv_radar_presence_set_config(handle, &config);
-            xensiv_radar_presence_reset(handle);
-            xTaskResumeAll();
+            result = presence_config_stage_commit_and_wait(&config, false);
 
             if (result != XENSIV_RADAR_PRESENCE_OK)
             {
@@ -521,6 +581,7 @@ static BaseType_t set_micro_threshold(char *pcWriteBuffer,
             }
             else
             {
+                config_store_set_float(CONFIG_KEY_MICRO_THRESHOLD, config.micro_threshold);
                 sprintf(pcWriteBuffer, "[CONFIG] micro_threshold %f \r\n\n",config.micro_threshold);
             }
         }
@@ -564,7 +625,7 @@ static BaseType_t turn_bandpass_filter(char *pcWriteBuffer,
             &lParameterStringLength); /* Store the parameter string length. */
 
     configASSERT(pcParameter);
-    result = xensiv_radar_presence_get_config(handle, &config);
+    result = presence_config_stage_get(&config);
 
     if (result != XENSIV_RADAR_PRESENCE_OK)
     {
@@ -572,21 +633,19 @@ static BaseType_t turn_bandpass_filter(char *pcWriteBuffer,
     }
     else
     {
-        if (check_bool_validation(pcParameter, ENABLE_STRING, DISABLE_STRING))
+        if (cli_parse_bool(pcParameter, (size_t)lParameterStringLength, ENABLE_STRING, DISABLE_STRING,
+                           &config.macro_fft_bandpass_filter_enabled))
         {
-            config.macro_fft_bandpass_filter_enabled = string_to_bool(
-                    pcParameter, ENABLE_STRING, DISABLE_STRING);
-            vTaskSuspendAll();
-            result = xensiv_radar_presence_set_config(handle, &config);
-            xensiv_radar_presence_reset(handle);
-            xTaskResumeAll();
+            result = presence_config_stage_commit_and_wait(&config, true);
             if (result != XENSIV_RADAR_PRESENCE_OK)
             {
                 sprintf(pcWriteBuffer, "Error while setting new config.\r\n\n");
             }
             else
             {
-                sprintf(pcWriteBuffer, "[CONFIG] bandpass_filter %s \r\n\n", pcParameter);
+                config_store_set_u32(CONFIG_KEY_BANDPASS_FILTER, config.macro_fft_bandpass_filter_enabled ? 1U : 0U);
+                snprintf(pcWriteBuffer, xWriteBufferLen, "[CONFIG] bandpass_filter %.*s \r\n\n",
+                         (int)lParameterStringLength, pcParameter);
             }
         }
         else
@@ -629,7 +688,7 @@ static BaseType_t turn_decimation_filter(char *pcWriteBuffer,
             &lParameterStringLength); /* Store the parameter string length. */
 
     configASSERT(pcParameter);
-    result = xensiv_radar_presence_get_config(handle, &config);
+    result = presence_config_stage_get(&config);
 
     if (result != XENSIV_RADAR_PRESENCE_OK)
     {
@@ -637,14 +696,10 @@ static BaseType_t turn_decimation_filter(char *pcWriteBuffer,
     }
     else
     {
-        if (check_bool_validation(pcParameter, ENABLE_STRING, DISABLE_STRING))
+        if (cli_parse_bool(pcParameter, (size_t)lParameterStringLength, ENABLE_STRING, DISABLE_STRING,
+                           &config.micro_fft_decimation_enabled))
         {
-            config.micro_fft_decimation_enabled = string_to_bool(pcParameter,
-                    ENABLE_STRING, DISABLE_STRING);
-            vTaskSuspendAll();
-            result = xensiv_radar_presence_set_config(handle, &config);
-            xensiv_radar_presence_reset(handle);
-            xTaskResumeAll();
+            result = presence_config_stage_commit_and_wait(&config, true);
 
             if (result != XENSIV_RADAR_PRESENCE_OK)
             {
@@ -652,7 +707,9 @@ static BaseType_t turn_decimation_filter(char *pcWriteBuffer,
             }
             else
             {
-                sprintf(pcWriteBuffer, "[CONFIG] decimation_filter %s \r\n\n", pcParameter);
+                config_store_set_u32(CONFIG_KEY_DECIMATION_FILTER, config.micro_fft_decimation_enabled ? 1U : 0U);
+                snprintf(pcWriteBuffer, xWriteBufferLen, "[CONFIG] decimation_filter %.*s \r\n\n",
+                         (int)lParameterStringLength, pcParameter);
             }
         }
         else
@@ -686,6 +743,7 @@ static BaseType_t set_presence_mode(char *pcWriteBuffer, size_t xWriteBufferLen,
     xensiv_radar_presence_config_t config;
     const char *pcParameter;
     BaseType_t lParameterStringLength;
+    xensiv_radar_presence_mode_t mode;
 
     configASSERT(pcWriteBuffer);
 
@@ -695,7 +753,7 @@ static BaseType_t set_presence_mode(char *pcWriteBuffer, size_t xWriteBufferLen,
             &lParameterStringLength); /* Store the parameter string length. */
 
     configASSERT(pcParameter);
-    result = xensiv_radar_presence_get_config(handle, &config);
+    result = presence_config_stage_get(&config);
 
     if (result != XENSIV_RADAR_PRESENCE_OK)
     {
@@ -703,29 +761,27 @@ static BaseType_t set_presence_mode(char *pcWriteBuffer, size_t xWriteBufferLen,
     }
     else
     {
-        if (check_mode_validation(pcParameter))
+        if (cli_parse_mode(pcParameter, (size_t)lParameterStringLength, &mode))
         {
-            xensiv_radar_presence_mode_t mode = string_to_mode(pcParameter);
+            xensiv_radar_presence_mode_t previous_mode = config.mode;
 
             config.mode = mode;
-            vTaskSuspendAll();
-            result = xensiv_radar_presence_set_config(handle, &config);
-            xensiv_radar_presence_reset(handle);
-            xTaskResumeAll();
 
-            result = radar_config_optimizer_set_operational_mode(mode);
-            if(result != ESTATUS_SUCCESS)
+            /* the operational mode is restored if the config is rejected, so a failure changes nothing */
+            if (radar_config_optimizer_set_operational_mode(mode) != ESTATUS_SUCCESS)
             {
                 sprintf(pcWriteBuffer, "Error while setting new operational mode.\r\n\n");
             }
-
-            if (result != XENSIV_RADAR_PRESENCE_OK)
+            else if (presence_config_stage_commit_and_wait(&config, true) != XENSIV_RADAR_PRESENCE_OK)
             {
+                (void)radar_config_optimizer_set_operational_mode(previous_mode);
                 sprintf(pcWriteBuffer, "Error while setting new config.\r\n\n");
             }
             else
             {
-                sprintf(pcWriteBuffer, "[CONFIG] set_mode %s \r\n\n", pcParameter);
+                config_store_set_u32(CONFIG_KEY_MODE, (uint32_t)mode);
+                snprintf(pcWriteBuffer, xWriteBufferLen, "[CONFIG] set_mode %.*s \r\n\n",
+                         (int)lParameterStringLength, pcParameter);
             }
         }
         else
@@ -739,10 +795,10 @@ static BaseType_t set_presence_mode(char *pcWriteBuffer, size_t xWriteBufferLen,
 
 
 /*******************************************************************************
- * Function Name: set_verbose
+ * Function Name: turn_range_gate
  ********************************************************************************
  * Summary:
- *   Turning on/off bandpass filter for presence detection algorithm
+ *   Turning on/off range gated processing of the per range bin stages
  *
  * Parameters:
  *   pcWriteBuffer: buffer into which the output from executing the command can be written
@@ -753,11 +809,12 @@ static BaseType_t set_presence_mode(char *pcWriteBuffer, size_t xWriteBufferLen,
  * Return:
  *   pdFALSE indicating that the function ends it's processing
  *******************************************************************************/
-static BaseType_t set_verbose(char *pcWriteBuffer,
+static BaseType_t turn_range_gate(char *pcWriteBuffer,
         size_t xWriteBufferLen, const char *pcCommandString)
 {
     const char *pcParameter;
     BaseType_t lParameterStringLength;
+    bool value;
 
     configASSERT(pcWriteBuffer);
 
@@ -767,11 +824,14 @@ static BaseType_t set_verbose(char *pcWriteBuffer,
             &lParameterStringLength); /* Store the parameter string length. */
 
     configASSERT(pcParameter);
-    if (check_bool_validation(pcParameter, ENABLE_STRING, DISABLE_STRING))
+    if (cli_parse_bool(pcParameter, (size_t)lParameterStringLength, ENABLE_STRING, DISABLE_STRING, &value))
     {
-        ce_app_state.verbose = string_to_bool(pcParameter,
-                ENABLE_STRING, DISABLE_STRING);
-        sprintf(pcWriteBuffer, "ok\n");
+        vTaskSuspendAll();
+        range_gate_enable(value);
+        xTaskResumeAll();
+        config_store_set_u32(CONFIG_KEY_RANGE_GATE, range_gate_get()->enabled ? 1U : 0U);
+        snprintf(pcWriteBuffer, xWriteBufferLen, "[CONFIG] range_gate %.*s \r\n\n",
+                 (int)lParameterStringLength, pcParameter);
     }
     else
     {
@@ -779,48 +839,63 @@ static BaseType_t set_verbose(char *pcWriteBuffer,
     }
 
     return pdFALSE;
-
 }
 
+
 /*******************************************************************************
- * Function Name: display_device_Info
+ * Function Name: turn_auto_threshold
  ********************************************************************************
  * Summary:
- *   Query for device information
+ *   Turning on/off the automatic macro and micro thresholds. While enabled,
+ *   the learned noise floor overrides manually set thresholds.
  *
  * Parameters:
  *   pcWriteBuffer: buffer into which the output from executing the command can be written
  *   xWriteBufferLen:length, in bytes of the pcWriteBuffer buffer
- *   pcCommandString: entire string as input by the user (from which parameters can be extracted)
+ *   pcCommandString: entire string as input by
+ the user (from which parameters can be extracted)
  *
  * Return:
  *   pdFALSE indicating that the function ends it's processing
  *******************************************************************************/
-static BaseType_t display_board_Info(char *pcWriteBuffer, size_t xWriteBufferLen,
-        const char *pcCommandString)
+static BaseType_t turn_auto_threshold(char *pcWriteBuffer,
+        size_t xWriteBufferLen, const char *pcCommandString)
 {
-    printf(BOARD_INFO);
-    printf("\n");
-    printf(BOARD_INFO_APPLICATION);
-    printf("\n");
-    printf(BOARD_INFO_FIRMWARE);
-    printf("\n");
-    printf(BOARD_INFO_DEVICE_NAME);
-    printf("\n");
-    printf(BOARD_INFO_DEVICE_VERSION);
-    printf("\n");
-    printf(BOARD_INFO);
-    sprintf(pcWriteBuffer, "\n");
+    const char *pcParameter;
+    BaseType_t lParameterStringLength;
+    bool value;
+
+    configASSERT(pcWriteBuffer);
+
+    /* Obtain the parameter string. */
+    pcParameter = FreeRTOS_CLIGetParameter(pcCommandString, /* The command string itself. */
+            1, /* Return the first parameter. */
+            &lParameterStringLength); /* Store the parameter string length. */
+
+    configASSERT(pcParameter);
+    if (cli_parse_bool(pcParameter, (size_t)lParameterStringLength, ENABLE_STRING, DISABLE_STRING, &value))
+    {
+        vTaskSuspendAll();
+        presence_cfar_set_auto(value);
+        xTaskResumeAll();
+        config_store_set_u32(CONFIG_KEY_AUTO_THRESHOLD, presence_cfar_get_auto() ? 1U : 0U);
+        snprintf(pcWriteBuffer, xWriteBufferLen, "[CONFIG] auto_threshold %.*s \r\n\n",
+                 (int)lParameterStringLength, pcParameter);
+    }
+    else
+    {
+        sprintf(pcWriteBuffer, "Invalid value.\r\n\n");
+    }
 
     return pdFALSE;
 }
 
-/*******************************************************************************
 
- * Function Name: display_solution_config
+/*******************************************************************************
+ * Function Name: set_cfar_mode
  ********************************************************************************
  * Summary:
- *   display solution configuration
+ *   Selecting cell averaging or ordered statistic CFAR
  *
  * Parameters:
  *   pcWriteBuffer: buffer into which the output from executing the command can be written
@@ -831,66 +906,33 @@ static BaseType_t display_board_Info(char *pcWriteBuffer, size_t xWriteBufferLen
  * Return:
  *   pdFALSE indicating that the function ends it's processing
  *******************************************************************************/
-
-static BaseType_t display_solution_config(char *pcWriteBuffer, size_t xWriteBufferLen,
-        const char *pcCommandString)
+static BaseType_t set_cfar_mode(char *pcWriteBuffer,
+        size_t xWriteBufferLen, const char *pcCommandString)
 {
-    cy_rslt_t result = CY_RSLT_SUCCESS;
-    xensiv_radar_presence_config_t config;
-    float32_t maxRange;
-    float32_t minRange;
-
-    result = xensiv_radar_presence_get_config(handle, &config);
+    const char *pcParameter;
+    BaseType_t lParameterStringLength;
+    bool value;
 
-    maxRange = (xensiv_radar_presence_get_bin_length(handle)* config.max_range_bin);
-    minRange = (xensiv_radar_presence_get_bin_length(handle)* config.min_range_bin);
+    configASSERT(pcWriteBuffer);
 
-    const char* mode = MACRO_ONLY_STRING;
-    if(config.mode == XENSIV_RADAR_PRESENCE_MODE_MICRO_ONLY) 
-    {
-        mode = MICRO_ONLY_STRING;
-    } 
-    else if(config.mode == XENSIV_RADAR_PRESENCE_MODE_MICRO_IF_MACRO)
-    {
-        mode = MICRO_IF_MACRO_STRING;
-    }
-    else if(config.mode == XENSIV_RADAR_PRESENCE_MODE_MICRO_AND_MACRO)
-    {
-        mode = MICRO_AND_MACRO_STRING;
-    }
+    /* Obtain the parameter string. */
+    pcParameter = FreeRTOS_CLIGetParameter(pcCommandString, /* The command string itself. */
+            1, /* Return the first parameter. */
+            &lParameterStringLength); /* Store the parameter string length. */
 
-    if (result != XENSIV_RADAR_PRESENCE_OK)
+    configASSERT(pcParameter);
+    if (cli_parse_bool(pcParameter, (size_t)lParameterStringLength, CFAR_CA_STRING, CFAR_OS_STRING, &value))
     {
-        sprintf(pcWriteBuffer, "Error while reading presence config\r\n");
+        vTaskSuspendAll();
+        presence_cfar_set_mode(value ? CFAR_MODE_CA : CFAR_MODE_OS);
+        xTaskResumeAll();
+        config_store_set_u32(CONFIG_KEY_CFAR_MODE, (uint32_t)presence_cfar_get_mode());
+        snprintf(pcWriteBuffer, xWriteBufferLen, "[CONFIG] cfar_mode %.*s \r\n\n",
+                 (int)lParameterStringLength, pcParameter);
     }
-    else 
+    else
     {
-        printf(CONFIG);
-        printf("\n");
-        printf(CONFIG_MODE);
-        printf("%s",mode);
-        printf("\n");   
-        printf(CONFIG_MAX_RANGE);
-        printf("%f",maxRange);
-        printf("\n");   
-        printf(CONFIG_MIN_RANGE);
-        printf("%f",minRange);
-        printf("\n");
-        printf(CONFIG_MACRO_THRESHOLD);
-        printf("%f",config.macro_threshold);
-        printf("\n");
-        printf(CONFIG_MICRO_THRESHOLD);
-        printf("%f",config.micro_threshold);
-        printf("\n");
-        printf(CONFIG_BANDPASS_FILTER);
-        (config.macro_fft_bandpass_filter_enabled == true)?printf("enable"):printf("disable");
-        printf("\n");
-        printf(CONFIG_DECIMATION_FILTER);
-        (config.micro_fft_decimation_enabled == true)?printf("enable"):printf("disable");
-        printf("\n");
-
-        printf(CONFIG);
-        sprintf(pcWriteBuffer, "\n");
+        sprintf(pcWriteBuffer, "Invalid value.\r\n\n");
     }
 
     return pdFALSE;
@@ -898,166 +940,1690 @@ static BaseType_t display_solution_config(char *pcWriteBuffer, size_t xWriteBuff
 
 
 /*******************************************************************************
- * Function Name: check_bool_validation
+ * Function Name: set_tracker_threshold
  ********************************************************************************
  * Summary:
- *   Checks if entered value is a proper string for enable or disable
+ *   Setting the detection threshold of the people tracker
  *
  * Parameters:
- *   value : Entered string value
- *   enable : String value for enable
- *   disable : String value for disable
+ *   pcWriteBuffer: buffer into which the output from executing the command can be written
+ *   xWriteBufferLen:length, in bytes of the pcWriteBuffer buffer
+ *   pcCommandString: entire string as input by
+ the user (from which parameters can be extracted)
  *
  * Return:
- *   True if the value is same as enable or disable value, false if it is different
+ *   pdFALSE indicating that the function ends it's processing
  *******************************************************************************/
-static inline bool check_bool_validation(const char *value, const char *enable,
-        const char *disable)
+static BaseType_t set_tracker_threshold(char *pcWriteBuffer,
+        size_t xWriteBufferLen, const char *pcCommandString)
 {
-    bool result = false;
+    const char *pcParameter;
+    BaseType_t lParameterStringLength;
+    float32_t threshold;
+    int32_t result = -1;
+
+    configASSERT(pcWriteBuffer);
+
+    /* Obtain the parameter string. */
+    pcParameter = FreeRTOS_CLIGetParameter(pcCommandString, /* The command string itself. */
+            1, /* Return the first parameter. */
+            &lParameterStringLength); /* Store the parameter string length. */
+
+    configASSERT(pcParameter);
+    if (cli_parse_float(pcParameter, (size_t)lParameterStringLength, &threshold))
+    {
+        result = presence_tracker_set_threshold(threshold);
+    }
 
-    if ((strcmp(value, enable) == 0) || (strcmp(value, disable) == 0))
+    if (result == 0)
     {
-        result = true;
+        config_store_set_float(CONFIG_KEY_TRACKER_THRESHOLD, threshold);
+        sprintf(pcWriteBuffer, "[CONFIG] tracker_threshold %f \r\n\n", threshold);
     }
     else
     {
-        result = false;
+        sprintf(pcWriteBuffer, "Invalid value.\r\n\n");
     }
 
-    return result;
+    return pdFALSE;
 }
 
+
 /*******************************************************************************
- * Function Name: check_float_validation
+ * Function Name: set_change_gate
  ********************************************************************************
  * Summary:
- *   Checks if entered value is within a range
+ *   Setting the threshold of the frame change gate, 0 disables the gate
  *
  * Parameters:
- *   value : Entered float value
- *   min : Minimum value
- *   max : Maximum value
+ *   pcWriteBuffer: buffer into which the output from executing the command can be written
+ *   xWriteBufferLen:length, in bytes of the pcWriteBuffer buffer
+ *   pcCommandString: entire string as input by
+ the user (from which parameters can be extracted)
  *
  * Return:
- *   True if the value is within a range, false if not
+ *   pdFALSE indicating that the function ends it's processing
  *******************************************************************************/
-static inline bool check_float_validation(float32_t value, float32_t min, float32_t max)
+static BaseType_t set_change_gate(char *pcWriteBuffer,
+        size_t xWriteBufferLen, const char *pcCommandString)
 {
-    bool result = false;
+    const char *pcParameter;
+    BaseType_t lParameterStringLength;
+    float32_t threshold;
+    int32_t result = -1;
 
-    if ((value >= min) && (value <= max))
+    configASSERT(pcWriteBuffer);
+
+    /* Obtain the parameter string. */
+    pcParameter = FreeRTOS_CLIGetParameter(pcCommandString, /* The command string itself. */
+            1, /* Return the first parameter. */
+            &lParameterStringLength); /* Store the parameter string length. */
+
+    configASSERT(pcParameter);
+    if (cli_parse_float(pcParameter, (size_t)lParameterStringLength, &threshold))
     {
-        result = true;
+        result = frame_change_gate_set_threshold(threshold);
+    }
+
+    if (result == 0)
+    {
+        config_store_set_float(CONFIG_KEY_CHANGE_GATE, threshold);
+        sprintf(pcWriteBuffer, "[CONFIG] change_gate %f \r\n\n", threshold);
     }
     else
     {
-        result = false;
+        sprintf(pcWriteBuffer, "Invalid value.\r\n\n");
     }
 
-    return result;
+    return pdFALSE;
 }
 
+
 /*******************************************************************************
- * Function Name: string_to_bool
+ * Function Name: turn_vital_signs
  ********************************************************************************
  * Summary:
- *   Converts string value to true or false
+ *   Turning on/off the breathing rate estimation
  *
  * Parameters:
- *   string : Entered string value
- *   enable : String for enable value
- *   disable : String for disable value
+ *   pcWriteBuffer: buffer into which the output from executing the command can be written
+ *   xWriteBufferLen:length, in bytes of the pcWriteBuffer buffer
+ *   pcCommandString: entire string as input by
+ the user (from which parameters can be extracted)
  *
  * Return:
- *   True if entered string is enable, false if disable
+ *   pdFALSE indicating that the function ends it's processing
  *******************************************************************************/
-static inline bool string_to_bool(const char *string, const char *enable,
-        const char *disable)
+static BaseType_t turn_vital_signs(char *pcWriteBuffer,
+        size_t xWriteBufferLen, const char *pcCommandString)
 {
-    assert((strcmp(string, enable) == 0) || (strcmp(string, disable) == 0));
-    bool result = false;
+    const char *pcParameter;
+    BaseType_t lParameterStringLength;
+    bool value;
+
+    configASSERT(pcWriteBuffer);
 
-    if (strcmp(string, enable) == 0)
+    /* Obtain the parameter string. */
+    pcParameter = FreeRTOS_CLIGetParameter(pcCommandString, /* The command string itself. */
+            1, /* Return the first parameter. */
+            &lParameterStringLength); /* Store the parameter string length. */
+
+    configASSERT(pcParameter);
+    if (cli_parse_bool(pcParameter, (size_t)lParameterStringLength, ENABLE_STRING, DISABLE_STRING, &value))
     {
-        result = true;
+        vTaskSuspendAll();
+        presence_vital_signs_enable(presence_vital_signs_get_live(), value);
+        xTaskResumeAll();
+        config_store_set_u32(CONFIG_KEY_VITAL_SIGNS,
+                             presence_vital_signs_is_enabled(presence_vital_signs_get_live()) ? 1U : 0U);
+        snprintf(pcWriteBuffer, xWriteBufferLen, "[CONFIG] vital_signs %.*s \r\n\n",
+                 (int)lParameterStringLength, pcParameter);
     }
     else
     {
-        result = false;
+        sprintf(pcWriteBuffer, "Invalid value.\r\n\n");
     }
 
-    return result;
+    return pdFALSE;
 }
 
 
 /*******************************************************************************
- * Function Name: check_mode_validation
+ * Function Name: set_filter_bank
  ********************************************************************************
  * Summary:
- *   Checks if entered value is a proper mode value
+ *   Setting the cutoff frequencies of the slow time filter bank
  *
  * Parameters:
- *   value : Entered mode value
+ *   pcWriteBuffer: buffer into which the output from executing the command can be written
+ *   xWriteBufferLen:length, in bytes of the pcWriteBuffer buffer
+ *   pcCommandString: entire string as input by
+ the user (from which parameters can be extracted)
+ *
+ * Return:
+ *   pdFALSE indicating that the function ends it's processing
+ *******************************************************************************/
+static BaseType_t set_filter_bank(char *pcWriteBuffer,
+        size_t xWriteBufferLen, const char *pcCommandString)
+{
+    const char *pcParameter;
+    BaseType_t lParameterStringLength;
+    float32_t highpass_hz = 0.0f;
+    float32_t lowpass_hz = 0.0f;
+    int32_t result = -1;
+    bool valid;
+
+    configASSERT(pcWriteBuffer);
+
+    /* Obtain the parameter strings. */
+    pcParameter = FreeRTOS_CLIGetParameter(pcCommandString, 1, &lParameterStringLength);
+    configASSERT(pcParameter);
+    valid = cli_parse_float(pcParameter, (size_t)lParameterStringLength, &highpass_hz);
+
+    pcParameter = FreeRTOS_CLIGetParameter(pcCommandString, 2, &lParameterStringLength);
+    configASSERT(pcParameter);
+    valid = cli_parse_float(pcParameter, (size_t)lParameterStringLength, &lowpass_hz) && valid;
+
+    if (valid)
+    {
+        vTaskSuspendAll();
+        result = slow_time_filter_set_cutoff(slow_time_filter_get_live(), highpass_hz, lowpass_hz);
+        xTaskResumeAll();
+    }
+
+    if (result == 0)
+    {
+        config_store_set_float(CONFIG_KEY_FILTER_HIGHPASS, highpass_hz);
+        config_store_set_float(CONFIG_KEY_FILTER_LOWPASS, lowpass_hz);
+        sprintf(pcWriteBuffer, "[CONFIG] filter_bank %f %f \r\n\n", highpass_hz, lowpass_hz);
+    }
+    else
+    {
+        sprintf(pcWriteBuffer, "Invalid value.\r\n\n");
+    }
+
+    return pdFALSE;
+}
+
+
+/*******************************************************************************
+ * Function Name: set_frame_decimation
+ ********************************************************************************
+ * Summary:
+ *   Setting the frame decimation factor of the slow time filter bank
+ *
+ * Parameters:
+ *   pcWriteBuffer: buffer into which the output from executing the command can be written
+ *   xWriteBufferLen:length, in bytes of the pcWriteBuffer buffer
+ *   pcCommandString: entire string as input by
+ the user (from which parameters can be extracted)
+ *
+ * Return:
+ *   pdFALSE indicating that the function ends it's processing
+ *******************************************************************************/
+static BaseType_t set_frame_decimation(char *pcWriteBuffer,
+        size_t xWriteBufferLen, const char *pcCommandString)
+{
+    const char *pcParameter;
+    BaseType_t lParameterStringLength;
+    uint32_t decimation;
+    int32_t result = -1;
+
+    configASSERT(pcWriteBuffer);
+
+    /* Obtain the parameter string. */
+    pcParameter = FreeRTOS_CLIGetParameter(pcCommandString, /* The command string itself. */
+            1, /* Return the first parameter. */
+            &lParameterStringLength); /* Store the parameter string length. */
+
+    configASSERT(pcParameter);
+    if (cli_parse_u32(pcParameter, (size_t)lParameterStringLength, &decimation))
+    {
+        vTaskSuspendAll();
+        result = slow_time_filter_set_decimation(slow_time_filter_get_live(), decimation);
+        xTaskResumeAll();
+    }
+
+    if (result == 0)
+    {
+        config_store_set_u32(CONFIG_KEY_FRAME_DECIMATION, decimation);
+        sprintf(pcWriteBuffer, "[CONFIG] frame_decimation %" PRIu32 " \r\n\n", decimation);
+    }
+    else
+    {
+        sprintf(pcWriteBuffer, "Invalid value.\r\n\n");
+    }
+
+    return pdFALSE;
+}
+
+
+/*******************************************************************************
+ * Function Name: set_coalescing
+ ********************************************************************************
+ * Summary:
+ *   Setting the number of frames read per sensor interrupt in the low frame
+ *   rate profile. The setting is not stored, the coalescing is off after a
+ *   reset.
+ *
+ * Parameters:
+ *   pcWriteBuffer: buffer into which the output from executing the command can be written
+ *   xWriteBufferLen:length, in bytes of the pcWriteBuffer buffer
+ *   pcCommandString: entire string as input by
+ the user (from which parameters can be extracted)
  *
  * Return:
- *   True if the value is correct, false if the value is incorrect
+ *   pdFALSE indicating that the function ends it's processing
  *******************************************************************************/
-static inline bool check_mode_validation(const char *mode)
+static BaseType_t set_coalescing(char *pcWriteBuffer,
+        size_t xWriteBufferLen, const char *pcCommandString)
 {
-    bool result = false;
+    const char *pcParameter;
+    BaseType_t lParameterStringLength;
+    uint32_t frames;
+    int32_t result = -1;
+
+    configASSERT(pcWriteBuffer);
+
+    /* Obtain the parameter string. */
+    pcParameter = FreeRTOS_CLIGetParameter(pcCommandString, /* The command string itself. */
+            1, /* Return the first parameter. */
+            &lParameterStringLength); /* Store the parameter string length. */
+
+    configASSERT(pcParameter);
+    if (cli_parse_u32(pcParameter, (size_t)lParameterStringLength, &frames))
+    {
+        /* the acquisition reconfigures the sensor after its next interrupt */
+        result = frame_coalescing_set_frames(frames);
+    }
 
-    if ((strcmp(mode, MACRO_ONLY_STRING) == 0)
-            || (strcmp(mode, MICRO_ONLY_STRING) == 0)
-            || (strcmp(mode, MICRO_IF_MACRO_STRING) == 0)
-            || (strcmp(mode, MICRO_AND_MACRO_STRING) == 0))
+    if (result == 0)
     {
-        result = true;
+        sprintf(pcWriteBuffer, "[CONFIG] coalescing %" PRIu32 " \r\n\n", frames);
     }
     else
     {
-        result = false;
+        sprintf(pcWriteBuffer, "Invalid value.\r\n\n");
     }
 
-    return result;
+    return pdFALSE;
 }
 
+
 /*******************************************************************************
- * Function Name: string_to_mode
+ * Function Name: set_raw_stream
  ********************************************************************************
  * Summary:
- *   Translates string value into a numeral value for mode
+ *   Starting or stopping the compressed raw frame stream. The setting is not
+ *   stored, the stream is off after a reset.
  *
  * Parameters:
- *   value : Entered string
+ *   pcWriteBuffer: buffer into which the output from executing the command can be written
+ *   xWriteBufferLen:length, in bytes of the pcWriteBuffer buffer
+ *   pcCommandString: entire string as input by
+ the user (from which parameters can be extracted)
  *
  * Return:
- *   Presence mode value
+ *   pdFALSE indicating that the function ends it's processing
  *******************************************************************************/
-static inline xensiv_radar_presence_mode_t string_to_mode(const char *mode)
+static BaseType_t set_raw_stream(char *pcWriteBuffer,
+        size_t xWriteBufferLen, const char *pcCommandString)
 {
-    xensiv_radar_presence_mode_t result = XENSIV_RADAR_PRESENCE_MODE_MACRO_ONLY;
+    const char *pcParameter;
+    BaseType_t lParameterStringLength;
+    uint32_t decimation;
+    int32_t result = -1;
+
+    configASSERT(pcWriteBuffer);
+
+    /* Obtain the parameter string. */
+    pcParameter = FreeRTOS_CLIGetParameter(pcCommandString, /* The command string itself. */
+            1, /* Return the first parameter. */
+            &lParameterStringLength); /* Store the parameter string length. */
+
+    configASSERT(pcParameter);
+    if (cli_parse_u32(pcParameter, (size_t)lParameterStringLength, &decimation))
+    {
+        vTaskSuspendAll();
+        result = raw_stream_set_decimation(decimation);
+        xTaskResumeAll();
+    }
 
-    if (strcmp(mode, MACRO_ONLY_STRING) == 0)
+    if (result == 0)
     {
-        result = XENSIV_RADAR_PRESENCE_MODE_MACRO_ONLY;
+        sprintf(pcWriteBuffer, "[CONFIG] raw_stream %" PRIu32 " \r\n\n", decimation);
     }
-    else if (strcmp(mode, MICRO_ONLY_STRING) == 0)
+    else
     {
-        result = XENSIV_RADAR_PRESENCE_MODE_MICRO_ONLY;
+        sprintf(pcWriteBuffer, "Invalid value.\r\n\n");
     }
-    else if (strcmp(mode, MICRO_IF_MACRO_STRING) == 0)
+
+    return pdFALSE;
+}
+
+
+/*******************************************************************************
+ * Function Name: set_clutter_map
+ ********************************************************************************
+ * Summary:
+ *   Selecting the clutter map mode. The mode and the learned background are
+ *   stored in flash and restored on the next boot.
+ *
+ * Parameters:
+ *   pcWriteBuffer: buffer into which the output from executing the command can be written
+ *   xWriteBufferLen:length, in bytes of the pcWriteBuffer buffer
+ *   pcCommandString: entire string as input by
+ the user (from which parameters can be extracted)
+ *
+ * Return:
+ *   pdFALSE indicating that the function ends it's processing
+ *******************************************************************************/
+static BaseType_t set_clutter_map(char *pcWriteBuffer,
+        size_t xWriteBufferLen, const char *pcCommandString)
+{
+    const char *pcParameter;
+    BaseType_t lParameterStringLength;
+    uint32_t mode;
+
+    configASSERT(pcWriteBuffer);
+
+    /* Obtain the parameter string. */
+    pcParameter = FreeRTOS_CLIGetParameter(pcCommandString, /* The command string itself. */
+            1, /* Return the first parameter. */
+            &lParameterStringLength); /* Store the parameter string length. */
+
+    configASSERT(pcParameter);
+    if (!cli_parse_choice(pcParameter, (size_t)lParameterStringLength, clutter_map_names,
+                          sizeof(clutter_map_names) / sizeof(clutter_map_names[0]), &mode))
     {
-        result = XENSIV_RADAR_PRESENCE_MODE_MICRO_IF_MACRO;
+        sprintf(pcWriteBuffer, "Invalid value.\r\n\n");
+        return pdFALSE;
     }
-    else if (strcmp(mode, MICRO_AND_MACRO_STRING) == 0)
+
+    vTaskSuspendAll();
+    clutter_map_set_mode(clutter_map_get_live(), (clutter_map_mode_e)mode);
+    xTaskResumeAll();
+
+    if (clutter_map_save(clutter_map_get_live()) == 0)
     {
-        result = XENSIV_RADAR_PRESENCE_MODE_MICRO_AND_MACRO;
+        sprintf(pcWriteBuffer, "[CONFIG] clutter_map %s \r\n\n", clutter_map_names[mode]);
     }
     else
     {
+        sprintf(pcWriteBuffer, "Error while storing the clutter map.\r\n\n");
+    }
+
+    return pdFALSE;
+}
+
+
+/*******************************************************************************
+ * Function Name: reset_config
+ ********************************************************************************
+ * Summary:
+ *   Removing all settings from the configuration store
+ *
+ * Parameters:
+ *   pcWriteBuffer: buffer into which the output from executing the command can be written
+ *   xWriteBufferLen:length, in bytes of the pcWriteBuffer buffer
+ *   pcCommandString: entire string as input by
+ the user (from which parameters can be extracted)
+ *
+ * Return:
+ *   pdFALSE indicating that the function ends it's processing
+ *******************************************************************************/
+static BaseType_t reset_config(char *pcWriteBuffer,
+        size_t xWriteBufferLen, const char *pcCommandString)
+{
+    (void)pcCommandString;
+
+    configASSERT(pcWriteBuffer);
+
+    /* written by the flush timer like any other change */
+    config_store_clear();
+    sprintf(pcWriteBuffer, "[CONFIG] defaults restored after reset \r\n\n");
+
+    return pdFALSE;
+}
+
+
+/*******************************************************************************
+ * Function Name: apply_batch
+ ********************************************************************************
+ * Summary:
+ *   Applies a batch of key=value settings at once. All settings are validated
+ *   first, if one of them is invalid nothing is changed. The presence algorithm
+ *   settings are applied together at one frame boundary, and if they are
+ *   rejected the operational mode is restored and nothing else is applied. The response is a
+ *   single line "[BATCH] <id> <status> <detail>", where detail is the number of
+ *   applied settings or the key which failed.
+ *
+ * Parameters:
+ *   pcWriteBuffer: buffer into which the output from executing the command can be written
+ *   xWriteBufferLen:length, in bytes of the pcWriteBuffer buffer
+ *   pcCommandString: entire string as input by
+ the user (from which parameters can be extracted)
+ *
+ * Return:
+ *   pdFALSE indicating that the function ends it's processing
+ *******************************************************************************/
+static BaseType_t apply_batch(char *pcWriteBuffer,
+        size_t xWriteBufferLen, const char *pcCommandString)
+{
+    /* tokenized in place, so the command string is copied */
+    static char command[MAX_INPUT_LENGTH];
+    static batch_settings_s settings;
+    const slow_time_filter_config_s *filter_config = slow_time_filter_get_config(slow_time_filter_get_live());
+    batch_status_e status = BATCH_OK;
+    const char *detail = "";
+    const char *id;
+    char *token;
+    char *next;
+    uint32_t count = 0;
+    xensiv_radar_presence_mode_t previous_mode;
+
+    configASSERT(pcWriteBuffer);
+
+    strncpy(command, pcCommandString, MAX_INPUT_LENGTH - 1);
+    command[MAX_INPUT_LENGTH - 1] = '\0';
+
+    memset(&settings, 0, sizeof(settings));
+    (void)presence_config_stage_get(&settings.config);
+    previous_mode = settings.config.mode;
+    settings.highpass_hz = filter_config->highpass_hz;
+    settings.lowpass_hz = filter_config->lowpass_hz;
+
+    (void)strtok_r(command, " ", &next);
+    id = strtok_r(NULL, " ", &next);
+
+    if ((id == NULL) || (strlen(id) > BATCH_MAX_ID_LENGTH))
+    {
+        snprintf(pcWriteBuffer, xWriteBufferLen, "[BATCH] - %d id\r\n", BATCH_ERR_SYNTAX);
+        return pdFALSE;
+    }
+
+    /* validate everything before applying anything */
+    while ((status == BATCH_OK) && ((token = strtok_r(NULL, " ", &next)) != NULL))
+    {
+        detail = token;
+        status = batch_parse_setting(token, &settings);
+        count++;
+    }
+
+    if ((status == BATCH_OK) &&
+        ((settings.keys & BATCH_FILTER_KEYS) != 0U) &&
+        (settings.highpass_hz > 0.0f) && (settings.lowpass_hz > 0.0f) &&
+        (settings.highpass_hz >= settings.lowpass_hz))
+    {
+        detail = batch_keys[BATCH_KEY_FILTER_LOWPASS];
+        status = BATCH_ERR_VALUE;
+    }
+
+    /* the operational mode goes first and is restored if the presence config is rejected,
+     * so a failure leaves both unchanged */
+    if ((status == BATCH_OK) && ((settings.keys & (1UL << BATCH_KEY_MODE)) != 0U) &&
+        (radar_config_optimizer_set_operational_mode(settings.config.mode) != ESTATUS_SUCCESS))
+    {
+        detail = batch_keys[BATCH_KEY_MODE];
+        status = BATCH_ERR_APPLY;
+    }
+
+    if ((status == BATCH_OK) && ((settings.keys & BATCH_PRESENCE_KEYS) != 0U) &&
+        (presence_config_stage_commit_and_wait(&settings.config, settings.needs_reset) != XENSIV_RADAR_PRESENCE_OK))
+    {
+        detail = "presence";
+        status = BATCH_ERR_APPLY;
+        if ((settings.keys & (1UL << BATCH_KEY_MODE)) != 0U)
+        {
+            (void)radar_config_optimizer_set_operational_mode(previous_mode);
+        }
+    }
+
+    if (status == BATCH_OK)
+    {
+        vTaskSuspendAll();
+        if ((settings.keys & (1UL << BATCH_KEY_RANGE_GATE)) != 0U)
+        {
+            range_gate_enable(settings.range_gate);
+        }
+        if ((settings.keys & (1UL << BATCH_KEY_AUTO_THRESHOLD)) != 0U)
+        {
+            presence_cfar_set_auto(settings.auto_threshold);
+        }
+        if ((settings.keys & (1UL << BATCH_KEY_CFAR_MODE)) != 0U)
+        {
+            presence_cfar_set_mode(settings.cfar_mode);
+        }
+        if ((settings.keys & (1UL << BATCH_KEY_VITAL_SIGNS)) != 0U)
+        {
+            presence_vital_signs_enable(presence_vital_signs_get_live(), settings.vital_signs);
+        }
+        if ((settings.keys & BATCH_FILTER_KEYS) != 0U)
+        {
+            (void)slow_time_filter_set_cutoff(slow_time_filter_get_live(), settings.highpass_hz, settings.lowpass_hz);
+        }
+        if ((settings.keys & (1UL << BATCH_KEY_FRAME_DECIMATION)) != 0U)
+        {
+            (void)slow_time_filter_set_decimation(slow_time_filter_get_live(), settings.frame_decimation);
+        }
+        if ((settings.keys & (1UL << BATCH_KEY_CHANGE_GATE)) != 0U)
+        {
+            (void)frame_change_gate_set_threshold(settings.change_gate);
+        }
+        if ((settings.keys & (1UL << BATCH_KEY_CLUTTER_MAP)) != 0U)
+        {
+            clutter_map_set_mode(clutter_map_get_live(), (clutter_map_mode_e)settings.clutter_map);
+        }
+        if ((settings.keys & (1UL << BATCH_KEY_RAW_STREAM)) != 0U)
+        {
+            (void)raw_stream_set_decimation(settings.raw_stream);
+        }
+        if ((settings.keys & (1UL << BATCH_KEY_COALESCING)) != 0U)
+        {
+            /* the acquisition reconfigures the sensor after its next interrupt */
+            (void)frame_coalescing_set_frames(settings.coalescing);
+        }
+        if ((settings.keys & (1UL << BATCH_KEY_TRACKER_THRESHOLD)) != 0U)
+        {
+            (void)presence_tracker_set_threshold(settings.tracker_threshold);
+        }
+        xTaskResumeAll();
+
+        batch_store_settings(&settings);
+
+        /* the clutter map keeps its mode with the background in its own flash row */
+        if (((settings.keys & (1UL << BATCH_KEY_CLUTTER_MAP)) != 0U) &&
+            (clutter_map_save(clutter_map_get_live()) != 0))
+        {
+            status = BATCH_ERR_APPLY;
+            detail = batch_keys[BATCH_KEY_CLUTTER_MAP];
+        }
+    }
 
+    if (status == BATCH_OK)
+    {
+        snprintf(pcWriteBuffer, xWriteBufferLen, "[BATCH] %s %d %" PRIu32 "\r\n", id, BATCH_OK, count);
+    }
+    else
+    {
+        snprintf(pcWriteBuffer, xWriteBufferLen, "[BATCH] %s %d %.32s\r\n", id, status, detail);
     }
 
-    return result;
+    return pdFALSE;
+}
+
+
+/*******************************************************************************
+ * Function Name: parse_config_overrides
+ ********************************************************************************
+ * Summary:
+ *   Applies the "key=value" parameters of a command to a copy of the presence
+ *   configuration. The keys are the names of the configuration fields
+ *   macro_threshold, micro_threshold, min_range_bin, max_range_bin,
+ *   macro_compare_interval_ms and micro_fft_size. Commands that allocate
+ *   their own presence instance use it to evaluate settings without changing
+ *   the live detection.
+ *
+ * Parameters:
+ *   command_string: entire string as input by the user
+ *   config: configuration to modify
+ *
+ * Return:
+ *   NULL if all parameters are valid, otherwise the failing key or "syntax"
+ *******************************************************************************/
+static const char *parse_config_overrides(const char *command_string, xensiv_radar_presence_config_t *config)
+{
+    enum
+    {
+        OVERRIDE_MACRO_THRESHOLD,
+        OVERRIDE_MICRO_THRESHOLD,
+        OVERRIDE_MIN_RANGE_BIN,
+        OVERRIDE_MAX_RANGE_BIN,
+        OVERRIDE_MACRO_COMPARE_INTERVAL,
+        OVERRIDE_MICRO_FFT_SIZE,
+        OVERRIDE_COUNT
+    };
+    static const char * const keys[OVERRIDE_COUNT] =
+    {
+        [OVERRIDE_MACRO_THRESHOLD]        = "macro_threshold",
+        [OVERRIDE_MICRO_THRESHOLD]        = "micro_threshold",
+        [OVERRIDE_MIN_RANGE_BIN]          = "min_range_bin",
+        [OVERRIDE_MAX_RANGE_BIN]          = "max_range_bin",
+        [OVERRIDE_MACRO_COMPARE_INTERVAL] = "macro_compare_interval_ms",
+        [OVERRIDE_MICRO_FFT_SIZE]         = "micro_fft_size"
+    };
+    const uint32_t max_bin = (uint32_t)(MAX_RANGE_MAX_LIMIT / xensiv_radar_presence_get_bin_length(handle));
+    const char *parameter;
+    BaseType_t length;
+    UBaseType_t index = 1;
+
+    while ((parameter = FreeRTOS_CLIGetParameter(command_string, index++, &length)) != NULL)
+    {
+        const char *value = memchr(parameter, '=', (size_t)length);
+        float32_t float_value;
+        uint32_t u32_value;
+        uint32_t key;
+        size_t value_length;
+
+        if ((value == NULL) ||
+            !cli_parse_choice(parameter, (size_t)(value - parameter), keys, OVERRIDE_COUNT, &key))
+        {
+            return "syntax";
+        }
+
+        value++;
+        value_length = (size_t)length - (size_t)(value - parameter);
+
+        switch (key)
+        {
+            case OVERRIDE_MACRO_THRESHOLD:
+                if (!cli_parse_float(value, value_length, &float_value) ||
+                    !cli_check_range(float_value, MACRO_THRESHOLD_MIN_LIMIT, MACRO_THRESHOLD_MAX_LIMIT))
+                {
+                    return keys[key];
+                }
+                config->macro_threshold = float_value;
+                break;
+
+            case OVERRIDE_MICRO_THRESHOLD:
+                if (!cli_parse_float(value, value_length, &float_value) ||
+                    !cli_check_range(float_value, MICRO_THRESHOLD_MIN_LIMIT, MICRO_THRESHOLD_MAX_LIMIT))
+                {
+                    return keys[key];
+                }
+                config->micro_threshold = float_value;
+                break;
+
+            case OVERRIDE_MIN_RANGE_BIN:
+            case OVERRIDE_MAX_RANGE_BIN:
+                if (!cli_parse_u32(value, value_length, &u32_value) || (u32_value > max_bin))
+                {
+                    return keys[key];
+                }
+                if (key == OVERRIDE_MIN_RANGE_BIN)
+                {
+                    config->min_range_bin = (int32_t)u32_value;
+                }
+                else
+                {
+                    config->max_range_bin = (int32_t)u32_value;
+                }
+                break;
+
+            case OVERRIDE_MACRO_COMPARE_INTERVAL:
+                if (!cli_parse_u32(value, value_length, &u32_value) ||
+                    (u32_value < MACRO_COMPARE_INTERVAL_MIN_LIMIT) || (u32_value > MACRO_COMPARE_INTERVAL_MAX_LIMIT))
+                {
+                    return keys[key];
+                }
+                config->macro_compare_interval_ms = (XENSIV_RADAR_PRESENCE_TIMESTAMP)u32_value;
+                break;
+
+            default:
+                if (!cli_parse_u32(value, value_length, &u32_value) ||
+                    (u32_value < MICRO_FFT_SIZE_MIN_LIMIT) || (u32_value > MICRO_FFT_SIZE_MAX_LIMIT) ||
+                    ((u32_value & (u32_value - 1U)) != 0U))
+                {
+                    return keys[key];
+                }
+                config->micro_fft_size = (int32_t)u32_value;
+                break;
+        }
+    }
+
+    if (config->min_range_bin >= config->max_range_bin)
+    {
+        return keys[OVERRIDE_MAX_RANGE_BIN];
+    }
+
+    return NULL;
+}
+
+
+/*******************************************************************************
+ * Function Name: run_benchmark
+ ********************************************************************************
+ * Summary:
+ *   Measures the kernels of the frame path with the current presence
+ *   configuration, modified by the optional "key=value" parameters (see
+ *   parse_config_overrides). The results are printed as they are measured,
+ *   followed by a summary line with the core clock.
+ *
+ * Parameters:
+ *   pcWriteBuffer: buffer into which the output from executing the command can be written
+ *   xWriteBufferLen:length, in bytes of the pcWriteBuffer buffer
+ *   pcCommandString: entire string as input by
+ the user (from which parameters can be extracted)
+ *
+ * Return:
+ *   pdFALSE indicating that the function ends it's processing
+ *******************************************************************************/
+static BaseType_t run_benchmark(char *pcWriteBuffer,
+        size_t xWriteBufferLen, const char *pcCommandString)
+{
+    xensiv_radar_presence_config_t config;
+    const char *invalid;
+    int32_t result;
+
+    configASSERT(pcWriteBuffer);
+
+    if (presence_config_stage_get(&config) != 0)
+    {
+        sprintf(pcWriteBuffer, "Error while reading presence config\r\n");
+        return pdFALSE;
+    }
+
+    invalid = parse_config_overrides(pcCommandString, &config);
+    if (invalid != NULL)
+    {
+        snprintf(pcWriteBuffer, xWriteBufferLen, "[BENCHMARK] {\"invalid\":\"%s\"}\r\n\n", invalid);
+        return pdFALSE;
+    }
+
+    result = benchmark_run(&config, benchmark_print_result);
+
+    snprintf(pcWriteBuffer, xWriteBufferLen,
+             "[BENCHMARK] {\"core_hz\":%" PRIu32 ",\"status\":%" PRIi32 "}\r\n\n",
+             (uint32_t)SystemCoreClock, result);
+
+    return pdFALSE;
+}
+
+
+/*******************************************************************************
+ * Function Name: print_selftest_run
+ ********************************************************************************
+ * Summary:
+ *   Prints the events of one scenario and mode as
+ *   "[SELFTEST] <scenario> <mode> <timestamp> <state> <range bin>", followed by
+ *   "[SELFTEST] <scenario> <mode> skipped <skipped frames> <frames>" and
+ *   "[SELFTEST] <scenario> <mode> end <events> <dropped events>"
+ *
+ * Parameters:
+ *   run: event stream
+ *
+ * Return:
+ *   None
+ *******************************************************************************/
+static void print_selftest_run(const selftest_run_s *run)
+{
+    static const char * const mode_names[] =
+    {
+        [XENSIV_RADAR_PRESENCE_MODE_MACRO_ONLY]      = MACRO_ONLY_STRING,
+        [XENSIV_RADAR_PRESENCE_MODE_MICRO_ONLY]      = MICRO_ONLY_STRING,
+        [XENSIV_RADAR_PRESENCE_MODE_MICRO_IF_MACRO]  = MICRO_IF_MACRO_STRING,
+        [XENSIV_RADAR_PRESENCE_MODE_MICRO_AND_MACRO] = MICRO_AND_MACRO_STRING
+    };
+    static const char * const state_names[] =
+    {
+        [XENSIV_RADAR_PRESENCE_STATE_MACRO_PRESENCE] = "macro",
+        [XENSIV_RADAR_PRESENCE_STATE_MICRO_PRESENCE] = "micro",
+        [XENSIV_RADAR_PRESENCE_STATE_ABSENCE]        = "absence"
+    };
+
+    for (uint32_t i = 0; i < run->num_events; i++)
+    {
+        printf("[SELFTEST] %s %s %" PRIu32 " %s %" PRIi32 "\n",
+               run->scenario, mode_names[run->mode], run->events[i].timestamp,
+               state_names[run->events[i].state], run->events[i].range_bin);
+    }
+
+    printf("[SELFTEST] %s %s skipped %" PRIu32 " %" PRIu32 "\n",
+           run->scenario, mode_names[run->mode], run->num_skipped, run->num_frames);
+    printf("[SELFTEST] %s %s end %" PRIu32 " %" PRIu32 "\n",
+           run->scenario, mode_names[run->mode], run->num_events, run->num_dropped);
+}
+
+
+/*******************************************************************************
+ * Function Name: print_selftest_labels
+ ********************************************************************************
+ * Summary:
+ *   Prints the presence intervals of every scenario as
+ *   "[SELFTEST] label <scenario> <frames> <start ms>-<end ms> ...", a person is
+ *   present in the segments with more than the static clutter. Scripts score
+ *   the event streams against these lines instead of a copy of the scenarios.
+ *
+ * Parameters:
+ *   None
+ *
+ * Return:
+ *   None
+ *******************************************************************************/
+static void print_selftest_labels(void)
+{
+    uint32_t num_scenarios;
+    const selftest_scenario_s *scenarios = selftest_scenarios_get(&num_scenarios);
+
+    for (uint32_t s = 0; s < num_scenarios; s++)
+    {
+        const selftest_segment_s *segments = scenarios[s].segments;
+        uint32_t num_frames = 0U;
+        uint32_t start = 0U;
+
+        for (uint32_t i = 0; i < scenarios[s].num_segments; i++)
+        {
+            num_frames += segments[i].num_frames;
+        }
+        printf("[SELFTEST] label %s %" PRIu32, scenarios[s].name, num_frames);
+
+        /* an interval ends before the first segment without a person or at the end */
+        for (uint32_t i = 0, frame = 0U; i < scenarios[s].num_segments; frame += segments[i].num_frames, i++)
+        {
+            bool present = (segments[i].num_targets > 1U);
+            bool was_present = (i > 0U) && (segments[i - 1U].num_targets > 1U);
+
+            if (present && !was_present)
+            {
+                start = frame;
+            }
+            if (present && (((i + 1U) == scenarios[s].num_segments) || (segments[i + 1U].num_targets <= 1U)))
+            {
+                printf(" %" PRIu32 "-%" PRIu32, start * SELFTEST_FRAME_PERIOD_MS,
+                       (frame + segments[i].num_frames) * SELFTEST_FRAME_PERIOD_MS);
+            }
+        }
+        printf("\n");
+    }
+}
+
+
+/*******************************************************************************
+ * Function Name: run_selftest
+ ********************************************************************************
+ * Summary:
+ *   Runs the fixed frame sequences through the presence algorithm in every
+ *   mode with the current configuration, modified by the optional
+ *   "key=value" parameters (see parse_config_overrides). The configuration is
+ *   printed first, as the event streams are only comparable between equal
+ *   configurations, followed by the presence intervals of the scenarios.
+ *
+ * Parameters:
+ *   pcWriteBuffer: buffer into which the output from executing the command can be written
+ *   xWriteBufferLen:length, in bytes of the pcWriteBuffer buffer
+ *   pcCommandString: entire string as input by
+ the user (from which parameters can be extracted)
+ *
+ * Return:
+ *   pdFALSE indicating that the function ends it's processing
+ *******************************************************************************/
+static BaseType_t run_selftest(char *pcWriteBuffer,
+        size_t xWriteBufferLen, const char *pcCommandString)
+{
+    xensiv_radar_presence_config_t config;
+    const char *invalid;
+    int32_t result;
+
+    configASSERT(pcWriteBuffer);
+
+    if (presence_config_stage_get(&config) != 0)
+    {
+        sprintf(pcWriteBuffer, "Error while reading presence config\r\n");
+        return pdFALSE;
+    }
+
+    invalid = parse_config_overrides(pcCommandString, &config);
+    if (invalid != NULL)
+    {
+        snprintf(pcWriteBuffer, xWriteBufferLen, "[SELFTEST] invalid %s\r\n\n", invalid);
+        return pdFALSE;
+    }
+
+    printf("[SELFTEST] config %" PRIi32 " %" PRIi32 " %f %f %d %d %" PRIu32 " %" PRIi32 "\n",
+           config.min_range_bin, config.max_range_bin,
+           config.macro_threshold, config.micro_threshold,
+           config.macro_fft_bandpass_filter_enabled ? 1 : 0,
+           config.micro_fft_decimation_enabled ? 1 : 0,
+           (uint32_t)config.macro_compare_interval_ms, config.micro_fft_size);
+    print_selftest_labels();
+
+    result = selftest_run(&config, print_selftest_run);
+
+    snprintf(pcWriteBuffer, xWriteBufferLen, "[SELFTEST] done %" PRIi32 "\r\n\n", result);
+
+    return pdFALSE;
+}
+
+
+/*******************************************************************************
+ * Function Name: display_history
+ ********************************************************************************
+ * Summary:
+ *   Prints the aggregates of the presence event log over the last minutes as
+ *   "[HISTORY] <minutes> <occupancy %> <macro s> <micro s> <transitions>
+ *   <entries> <presence periods> <mean period s> <longest period s>"
+ *
+ * Parameters:
+ *   pcWriteBuffer: buffer into which the output from executing the command can be written
+ *   xWriteBufferLen:length, in bytes of the pcWriteBuffer buffer
+ *   pcCommandString: entire string as input by
+ the user (from which parameters can be extracted)
+ *
+ * Return:
+ *   pdFALSE indicating that the function ends it's processing
+ *******************************************************************************/
+static BaseType_t display_history(char *pcWriteBuffer,
+        size_t xWriteBufferLen, const char *pcCommandString)
+{
+    const char *pcParameter;
+    BaseType_t lParameterStringLength;
+    uint32_t minutes;
+    presence_event_log_stats_s stats;
+    float32_t occupancy = 0.0f;
+
+    configASSERT(pcWriteBuffer);
+
+    /* Obtain the parameter string. */
+    pcParameter = FreeRTOS_CLIGetParameter(pcCommandString, /* The command string itself. */
+            1, /* Return the first parameter. */
+            &lParameterStringLength); /* Store the parameter string length. */
+
+    configASSERT(pcParameter);
+    if (!cli_parse_u32(pcParameter, (size_t)lParameterStringLength, &minutes) ||
+        (minutes == 0U) || (minutes > HISTORY_MAX_MINUTES))
+    {
+        sprintf(pcWriteBuffer, "Invalid value.\r\n\n");
+        return pdFALSE;
+    }
+
+    vTaskSuspendAll();
+    presence_event_log_query(xTaskGetTickCount() * portTICK_PERIOD_MS, minutes * 60000U, &stats);
+    xTaskResumeAll();
+
+    if (stats.covered_ms > 0U)
+    {
+        occupancy = (100.0f * (float32_t)(stats.macro_ms + stats.micro_ms)) / (float32_t)stats.covered_ms;
+    }
+
+    snprintf(pcWriteBuffer, xWriteBufferLen,
+             "[HISTORY] %" PRIu32 " %.1f %" PRIu32 " %" PRIu32 " %" PRIu32 " %" PRIu32 " %" PRIu32 " %" PRIu32 " %" PRIu32 "\r\n",
+             minutes, occupancy,
+             stats.macro_ms / 1000U, stats.micro_ms / 1000U,
+             stats.transitions, stats.entries,
+             stats.dwell_count, stats.dwell_mean_ms / 1000U, stats.dwell_max_ms / 1000U);
+
+    return pdFALSE;
+}
+
+
+/*******************************************************************************
+ * Function Name: display_occupancy
+ ********************************************************************************
+ * Summary:
+ *   Streams the stored per-minute records of a minute range, one line per call
+ *   as "[OCCUPANCY] <minute> <boot> <occupancy %> <max range bin> <transitions>".
+ *   The last line is "[OCCUPANCY] end <records> <current minute>".
+ *
+ * Parameters:
+ *   pcWriteBuffer: buffer into which the output from executing the command can be written
+ *   xWriteBufferLen:length, in bytes of the pcWriteBuffer buffer
+ *   pcCommandString: entire string as input by
+ the user (from which parameters can be extracted)
+ *
+ * Return:
+ *   pdTRUE while more records follow, pdFALSE after the last line
+ *******************************************************************************/
+static BaseType_t display_occupancy(char *pcWriteBuffer,
+        size_t xWriteBufferLen, const char *pcCommandString)
+{
+    static occupancy_store_cursor_s cursor;
+    static bool streaming = false;
+    static uint32_t num_records;
+    occupancy_record_s record;
+
+    configASSERT(pcWriteBuffer);
+
+    if (!streaming)
+    {
+        const char *pcParameter;
+        BaseType_t lParameterStringLength;
+        uint32_t first_minute;
+        uint32_t last_minute;
+
+        pcParameter = FreeRTOS_CLIGetParameter(pcCommandString, 1, &lParameterStringLength);
+        configASSERT(pcParameter);
+        if (!cli_parse_u32(pcParameter, (size_t)lParameterStringLength, &first_minute))
+        {
+            sprintf(pcWriteBuffer, "Invalid value.\r\n\n");
+            return pdFALSE;
+        }
+
+        pcParameter = FreeRTOS_CLIGetParameter(pcCommandString, 2, &lParameterStringLength);
+        configASSERT(pcParameter);
+        if (!cli_parse_u32(pcParameter, (size_t)lParameterStringLength, &last_minute) ||
+            (last_minute < first_minute))
+        {
+            sprintf(pcWriteBuffer, "Invalid value.\r\n\n");
+            return pdFALSE;
+        }
+
+        occupancy_store_query_begin(&cursor, first_minute, last_minute);
+        streaming = true;
+        num_records = 0U;
+    }
+
+    if (occupancy_store_query_next(&cursor, &record))
+    {
+        num_records++;
+        snprintf(pcWriteBuffer, xWriteBufferLen,
+                 "[OCCUPANCY] %" PRIu32 " %u %u %" PRIi32 " %" PRIu32 "\r\n",
+                 record.minute, (unsigned int)record.boot, (unsigned int)record.occupancy,
+                 record.max_range_bin, record.transitions);
+        return pdTRUE;
+    }
+
+    streaming = false;
+    snprintf(pcWriteBuffer, xWriteBufferLen, "[OCCUPANCY] end %" PRIu32 " %" PRIu32 "\r\n",
+             num_records, occupancy_store_get_minute());
+
+    return pdFALSE;
+}
+
+
+/*******************************************************************************
+ * Function Name: display_task_stats
+ ********************************************************************************
+ * Summary:
+ *   Streams the statistics of the last window, one line per call. The first
+ *   line is "[STATS] <window ms> <load %> <heap free> <heap min free>", every
+ *   task follows as "[STATS] <name> <priority> <cpu %> <stack free bytes>".
+ *
+ * Parameters:
+ *   pcWriteBuffer: buffer into which the output from executing the command can be written
+ *   xWriteBufferLen:length, in bytes of the pcWriteBuffer buffer
+ *   pcCommandString: entire string as input by
+ the user (from which parameters can be extracted)
+ *
+ * Return:
+ *   pdTRUE while more tasks follow, pdFALSE after the last line
+ *******************************************************************************/
+static BaseType_t display_task_stats(char *pcWriteBuffer,
+        size_t xWriteBufferLen, const char *pcCommandString)
+{
+    static task_stats_s stats;
+    static bool streaming = false;
+    static uint32_t task;
+
+    (void)pcCommandString;
+    configASSERT(pcWriteBuffer);
+
+    if (!streaming)
+    {
+        if (!task_stats_get(&stats))
+        {
+            snprintf(pcWriteBuffer, xWriteBufferLen, "[STATS] not available yet\r\n\n");
+            return pdFALSE;
+        }
+
+        streaming = true;
+        task = 0U;
+        snprintf(pcWriteBuffer, xWriteBufferLen, "[STATS] %" PRIu32 " %.1f %" PRIu32 " %" PRIu32 "\r\n",
+                 stats.window_ms, (float32_t)stats.load_permille / 10.0f,
+                 stats.heap_free, stats.heap_min_free);
+        return pdTRUE;
+    }
+
+    snprintf(pcWriteBuffer, xWriteBufferLen, "[STATS] %s %" PRIu32 " %.1f %" PRIu32 "\r\n",
+             stats.tasks[task].name, stats.tasks[task].priority,
+             (float32_t)stats.tasks[task].cpu_permille / 10.0f, stats.tasks[task].stack_free);
+    task++;
+
+    if (task < stats.num_tasks)
+    {
+        return pdTRUE;
+    }
+
+    streaming = false;
+    strcat(pcWriteBuffer, "\n");
+
+    return pdFALSE;
+}
+
+
+/*******************************************************************************
+ * Function Name: set_verbose
+ ********************************************************************************
+ * Summary:
+ *   Turning on/off bandpass filter for presence detection algorithm
+ *
+ * Parameters:
+ *   pcWriteBuffer: buffer into which the output from executing the command can be written
+ *   xWriteBufferLen:length, in bytes of the pcWriteBuffer buffer
+ *   pcCommandString: entire string as input by
+ the user (from which parameters can be extracted)
+ *
+ * Return:
+ *   pdFALSE indicating that the function ends it's processing
+ *******************************************************************************/
+static BaseType_t set_verbose(char *pcWriteBuffer,
+        size_t xWriteBufferLen, const char *pcCommandString)
+{
+    const char *pcParameter;
+    BaseType_t lParameterStringLength;
+
+    configASSERT(pcWriteBuffer);
+
+    /* Obtain the parameter string. */
+    pcParameter = FreeRTOS_CLIGetParameter(pcCommandString, /* The command string itself. */
+            1, /* Return the first parameter. */
+            &lParameterStringLength); /* Store the parameter string length. */
+
+    configASSERT(pcParameter);
+    if (cli_parse_bool(pcParameter, (size_t)lParameterStringLength, ENABLE_STRING, DISABLE_STRING,
+                       &ce_app_state.verbose))
+    {
+        sprintf(pcWriteBuffer, "ok\n");
+    }
+    else
+    {
+        sprintf(pcWriteBuffer, "Invalid value.\r\n\n");
+    }
+
+    return pdFALSE;
+
+}
+
+/*******************************************************************************
+ * Function Name: display_device_Info
+ ********************************************************************************
+ * Summary:
+ *   Query for device information
+ *
+ * Parameters:
+ *   pcWriteBuffer: buffer into which the output from executing the command can be written
+ *   xWriteBufferLen:length, in bytes of the pcWriteBuffer buffer
+ *   pcCommandString: entire string as input by the user (from which parameters can be extracted)
+ *
+ * Return:
+ *   pdFALSE indicating that the function ends it's processing
+ *******************************************************************************/
+static BaseType_t display_board_Info(char *pcWriteBuffer, size_t xWriteBufferLen,
+        const char *pcCommandString)
+{
+    printf(BOARD_INFO);
+    printf("\n");
+    printf(BOARD_INFO_APPLICATION);
+    printf("\n");
+    printf(BOARD_INFO_FIRMWARE);
+    printf("\n");
+    printf(BOARD_INFO_DEVICE_NAME);
+    printf("\n");
+    printf(BOARD_INFO_DEVICE_VERSION);
+    printf("\n");
+    printf(BOARD_INFO);
+    sprintf(pcWriteBuffer, "\n");
+
+    return pdFALSE;
+}
+
+/*******************************************************************************
+
+ * Function Name: display_solution_config
+ ********************************************************************************
+ * Summary:
+ *   display solution configuration
+ *
+ * Parameters:
+ *   pcWriteBuffer: buffer into which the output from executing the command can be written
+ *   xWriteBufferLen:length, in bytes of the pcWriteBuffer buffer
+ *   pcCommandString: entire string as input by
+ the user (from which parameters can be extracted)
+ *
+ * Return:
+ *   pdFALSE indicating that the function ends it's processing
+ *******************************************************************************/
+
+static BaseType_t display_solution_config(char *pcWriteBuffer, size_t xWriteBufferLen,
+        const char *pcCommandString)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    xensiv_radar_presence_config_t config;
+    frame_change_gate_stats_s gate_stats;
+    const slow_time_filter_config_s *filter_config = slow_time_filter_get_config(slow_time_filter_get_live());
+    float32_t maxRange;
+    float32_t minRange;
+
+    result = presence_config_stage_get(&config);
+
+    maxRange = (xensiv_radar_presence_get_bin_length(handle)* config.max_range_bin);
+    minRange = (xensiv_radar_presence_get_bin_length(handle)* config.min_range_bin);
+
+    const char* mode = MACRO_ONLY_STRING;
+    if(config.mode == XENSIV_RADAR_PRESENCE_MODE_MICRO_ONLY) 
+    {
+        mode = MICRO_ONLY_STRING;
+    } 
+    else if(config.mode == XENSIV_RADAR_PRESENCE_MODE_MICRO_IF_MACRO)
+    {
+        mode = MICRO_IF_MACRO_STRING;
+    }
+    else if(config.mode == XENSIV_RADAR_PRESENCE_MODE_MICRO_AND_MACRO)
+    {
+        mode = MICRO_AND_MACRO_STRING;
+    }
+
+    if (result != XENSIV_RADAR_PRESENCE_OK)
+    {
+        sprintf(pcWriteBuffer, "Error while reading presence config\r\n");
+    }
+    else 
+    {
+        printf(CONFIG);
+        printf("\n");
+        printf(CONFIG_MODE);
+        printf("%s",mode);
+        printf("\n");   
+        printf(CONFIG_MAX_RANGE);
+        printf("%f",maxRange);
+        printf("\n");   
+        printf(CONFIG_MIN_RANGE);
+        printf("%f",minRange);
+        printf("\n");
+        printf(CONFIG_MACRO_THRESHOLD);
+        printf("%f",config.macro_threshold);
+        printf("\n");
+        printf(CONFIG_MICRO_THRESHOLD);
+        printf("%f",config.micro_threshold);
+        printf("\n");
+        printf(CONFIG_BANDPASS_FILTER);
+        (config.macro_fft_bandpass_filter_enabled == true)?printf("enable"):printf("disable");
+        printf("\n");
+        printf(CONFIG_DECIMATION_FILTER);
+        (config.micro_fft_decimation_enabled == true)?printf("enable"):printf("disable");
+        printf("\n");
+        printf(CONFIG_RANGE_GATE);
+        (range_gate_get()->enabled == true)?printf("enable"):printf("disable");
+        printf("\n");
+        printf(CONFIG_AUTO_THRESHOLD);
+        (presence_cfar_get_auto() == true)?printf("enable"):printf("disable");
+        printf("\n");
+        printf(CONFIG_CFAR_MODE);
+        (presence_cfar_get_mode() == CFAR_MODE_CA)?printf(CFAR_CA_STRING):printf(CFAR_OS_STRING);
+        printf("\n");
+        printf(CONFIG_VITAL_SIGNS);
+        (presence_vital_signs_is_enabled(presence_vital_signs_get_live()) == true)?printf("enable"):printf("disable");
+        printf("\n");
+        vTaskSuspendAll();
+        gate_stats = frame_change_gate_get_live()->stats;
+        xTaskResumeAll();
+        printf(CONFIG_CHANGE_GATE);
+        printf("%f %" PRIu32 " %" PRIu32 " %" PRIu32 " %" PRIu32,
+               frame_change_gate_get_threshold(),
+               gate_stats.frames,
+               gate_stats.skipped,
+               gate_stats.changes,
+               gate_stats.refreshes);
+        printf("\n");
+        printf(CONFIG_TRACKER_THRESHOLD);
+        printf("%f", presence_tracker_get_threshold());
+        printf("\n");
+        printf(CONFIG_FILTER_BANK);
+        printf("%f %f", filter_config->highpass_hz, filter_config->lowpass_hz);
+        printf("\n");
+        printf(CONFIG_FRAME_DECIMATION);
+        printf("%u", (unsigned int)filter_config->decimation);
+        printf("\n");
+        printf(CONFIG_CLUTTER_MAP);
+        switch (clutter_map_get_mode(clutter_map_get_live()))
+        {
+            case CLUTTER_MAP_LEARN:
+                printf(CLUTTER_LEARN_STRING);
+                break;
+            case CLUTTER_MAP_FREEZE:
+                printf(CLUTTER_FREEZE_STRING);
+                break;
+            default:
+                printf(CLUTTER_OFF_STRING);
+                break;
+        }
+        printf("\n");
+        printf(CONFIG_RECONFIGURATIONS);
+        printf("%" PRIu32 " %" PRIu32 " %" PRIu32,
+               presence_config_stage_get_stats()->reconfigurations,
+               presence_config_stage_get_stats()->frames_lost,
+               presence_config_stage_get_stats()->last_frames_lost);
+        printf("\n");
+        printf(CONFIG_RAW_STREAM);
+        printf("%" PRIu32 " %" PRIu32 " %" PRIu32 " %.2f",
+               raw_stream_get_decimation(),
+               raw_stream_get_stats()->frames_sent,
+               raw_stream_get_stats()->frames_dropped,
+               (raw_stream_get_stats()->compressed_bytes > 0U) ?
+               ((float32_t)raw_stream_get_stats()->raw_bytes / (float32_t)raw_stream_get_stats()->compressed_bytes) : 0.0f);
+        printf("\n");
+        printf(CONFIG_DEADLINE);
+        printf("%d %" PRIu32 " %" PRIu32 " %" PRIu32 " %" PRIu32 " %" PRIu32,
+               (int)frame_deadline_get_level(),
+               frame_deadline_get_stats()->frames,
+               frame_deadline_get_stats()->misses,
+               frame_deadline_get_stats()->max_us,
+               frame_deadline_get_stats()->window_max_us,
+               frame_deadline_get_stats()->level_changes);
+        printf("\n");
+        printf(CONFIG_COALESCING);
+        printf("%" PRIu32 " %" PRIu32, frame_coalescing_get_frames(), frame_coalescing_get_active());
+        printf("\n");
+
+        for (uint32_t frames = 1U; frames <= frame_coalescing_get_max_frames(); frames++)
+        {
+            frame_coalescing_stats_s coalescing;
+
+            (void)frame_coalescing_get_stats(frames, &coalescing);
+            printf(CONFIG_COALESCING_STATS);
+            printf("%" PRIu32 " %.2f %.2f %.1f",
+                   frames,
+                   (coalescing.time_us > 0U) ? ((float32_t)coalescing.wakeups * 1.0e6f / (float32_t)coalescing.time_us) : 0.0f,
+                   (coalescing.time_us > 0U) ? ((float32_t)coalescing.active_us * 100.0f / (float32_t)coalescing.time_us) : 0.0f,
+                   (float32_t)coalescing.time_us / 1.0e6f);
+            printf("\n");
+        }
+
+        printf(CONFIG);
+        sprintf(pcWriteBuffer, "\n");
+    }
+
+    return pdFALSE;
+}
+
+
+/*******************************************************************************
+ * Function Name: is_script_command
+ ********************************************************************************
+ * Summary:
+ *   Checks if a command line is a command for scripts
+ *
+ * Parameters:
+ *   command : Command line
+ *
+ * Return:
+ *   True if the line starts with the batch, history or occupancy command, false if not
+ *******************************************************************************/
+static inline bool is_script_command(const char *command)
+{
+    static const char * const commands[] =
+    {
+        BATCH_COMMAND_STRING, HISTORY_COMMAND_STRING, OCCUPANCY_COMMAND_STRING
+    };
+    uint32_t index;
+
+    return cli_parse_choice(command, strcspn(command, " "), commands,
+                            sizeof(commands) / sizeof(commands[0]), &index);
+}
+
+/*******************************************************************************
+ * Function Name: batch_parse_setting
+ ********************************************************************************
+ * Summary:
+ *   Validates one key=value setting of a batch and stores it in the batch
+ *   settings. The setting string is split at '='.
+ *
+ * Parameters:
+ *   setting : key=value string
+ *   settings : Settings of the batch
+ *
+ * Return:
+ *   BATCH_OK if the setting is valid, the error status otherwise
+ *******************************************************************************/
+static batch_status_e batch_parse_setting(char *setting, batch_settings_s *settings)
+{
+    char *value = strchr(setting, '=');
+    float32_t float_value = 0.0f;
+    bool bool_value = false;
+    bool float_valid;
+    bool bool_valid;
+    size_t length;
+    int32_t key;
+
+    if ((value == NULL) || (value == setting) || (value[1] == '\0'))
+    {
+        return BATCH_ERR_SYNTAX;
+    }
+
+    *value++ = '\0';
+
+    for (key = 0; key < BATCH_KEY_COUNT; ++key)
+    {
+        if (strcmp(setting, batch_keys[key]) == 0)
+        {
+            break;
+        }
+    }
+
+    length = strlen(value);
+    float_valid = cli_parse_float(value, length, &float_value);
+    bool_valid = cli_parse_bool(value, length, ENABLE_STRING, DISABLE_STRING, &bool_value);
+
+    switch (key)
+    {
+        case BATCH_KEY_MAX_RANGE:
+            if (!float_valid || !cli_check_range(float_value, MAX_RANGE_MIN_LIMIT, MAX_RANGE_MAX_LIMIT))
+            {
+                return BATCH_ERR_VALUE;
+            }
+            settings->config.max_range_bin = (int32_t)(float_value / xensiv_radar_presence_get_bin_length(handle));
+            settings->needs_reset = true;
+            break;
+
+        case BATCH_KEY_MACRO_THRESHOLD:
+            if (!float_valid || !cli_check_range(float_value, MACRO_THRESHOLD_MIN_LIMIT, MACRO_THRESHOLD_MAX_LIMIT))
+            {
+                return BATCH_ERR_VALUE;
+            }
+            settings->config.macro_threshold = float_value;
+            break;
+
+        case BATCH_KEY_MICRO_THRESHOLD:
+            if (!float_valid || !cli_check_range(float_value, MICRO_THRESHOLD_MIN_LIMIT, MICRO_THRESHOLD_MAX_LIMIT))
+            {
+                return BATCH_ERR_VALUE;
+            }
+            settings->config.micro_threshold = float_value;
+            break;
+
+        case BATCH_KEY_BANDPASS_FILTER:
+            if (!bool_valid)
+            {
+                return BATCH_ERR_VALUE;
+            }
+            settings->config.macro_fft_bandpass_filter_enabled = bool_value;
+            settings->needs_reset = true;
+            break;
+
+        case BATCH_KEY_DECIMATION_FILTER:
+            if (!bool_valid)
+            {
+                return BATCH_ERR_VALUE;
+            }
+            settings->config.micro_fft_decimation_enabled = bool_value;
+            settings->needs_reset = true;
+            break;
+
+        case BATCH_KEY_MODE:
+            if (!cli_parse_mode(value, length, &settings->config.mode))
+            {
+                return BATCH_ERR_VALUE;
+            }
+            settings->needs_reset = true;
+            break;
+
+        case BATCH_KEY_RANGE_GATE:
+            if (!bool_valid)
+            {
+                return BATCH_ERR_VALUE;
+            }
+            settings->range_gate = bool_value;
+            break;
+
+        case BATCH_KEY_AUTO_THRESHOLD:
+            if (!bool_valid)
+            {
+                return BATCH_ERR_VALUE;
+            }
+            settings->auto_threshold = bool_value;
+            break;
+
+        case BATCH_KEY_CFAR_MODE:
+            if (!cli_parse_bool(value, length, CFAR_CA_STRING, CFAR_OS_STRING, &bool_value))
+            {
+                return BATCH_ERR_VALUE;
+            }
+            settings->cfar_mode = bool_value ? CFAR_MODE_CA : CFAR_MODE_OS;
+            break;
+
+        case BATCH_KEY_VITAL_SIGNS:
+            if (!bool_valid)
+            {
+                return BATCH_ERR_VALUE;
+            }
+            settings->vital_signs = bool_value;
+            break;
+
+        case BATCH_KEY_FILTER_HIGHPASS:
+            if (!float_valid || !cli_check_range(float_value, 0.0f, SLOW_TIME_MAX_CUTOFF_HZ))
+            {
+                return BATCH_ERR_VALUE;
+            }
+            settings->highpass_hz = float_value;
+            break;
+
+        case BATCH_KEY_FILTER_LOWPASS:
+            if (!float_valid || !cli_check_range(float_value, 0.0f, SLOW_TIME_MAX_CUTOFF_HZ))
+            {
+                return BATCH_ERR_VALUE;
+            }
+            settings->lowpass_hz = float_value;
+            break;
+
+        case BATCH_KEY_FRAME_DECIMATION:
+            if (!cli_parse_u32(value, length, &settings->frame_decimation) ||
+                (settings->frame_decimation == 0U) || (settings->frame_decimation > SLOW_TIME_MAX_DECIMATION))
+            {
+                return BATCH_ERR_VALUE;
+            }
+            break;
+
+        case BATCH_KEY_CHANGE_GATE:
+            if (!float_valid ||
+                ((float_value != 0.0f) &&
+                 !cli_check_range(float_value, FRAME_CHANGE_GATE_MIN_THRESHOLD, FRAME_CHANGE_GATE_MAX_THRESHOLD)))
+            {
+                return BATCH_ERR_VALUE;
+            }
+            settings->change_gate = float_value;
+            break;
+
+        case BATCH_KEY_CLUTTER_MAP:
+            if (!cli_parse_choice(value, length, clutter_map_names,
+                                  sizeof(clutter_map_names) / sizeof(clutter_map_names[0]), &settings->clutter_map))
+            {
+                return BATCH_ERR_VALUE;
+            }
+            break;
+
+        case BATCH_KEY_RAW_STREAM:
+            if (!cli_parse_u32(value, length, &settings->raw_stream) ||
+                (settings->raw_stream > RAW_STREAM_MAX_DECIMATION))
+            {
+                return BATCH_ERR_VALUE;
+            }
+            break;
+
+        case BATCH_KEY_COALESCING:
+            if (!cli_parse_u32(value, length, &settings->coalescing) ||
+                (settings->coalescing == 0U) || (settings->coalescing > frame_coalescing_get_max_frames()))
+            {
+                return BATCH_ERR_VALUE;
+            }
+            break;
+
+        case BATCH_KEY_TRACKER_THRESHOLD:
+            if (!float_valid || !cli_check_range(float_value, TRACKER_MIN_THRESHOLD, TRACKER_MAX_THRESHOLD))
+            {
+                return BATCH_ERR_VALUE;
+            }
+            settings->tracker_threshold = float_value;
+            break;
+
+        default:
+            return BATCH_ERR_KEY;
+    }
+
+    settings->keys |= (1UL << key);
+
+    return BATCH_OK;
+}
+
+/*******************************************************************************
+ * Function Name: batch_store_settings
+ ********************************************************************************
+ * Summary:
+ *   Writes the settings of an applied batch to the configuration store
+ *
+ * Parameters:
+ *   settings : Settings of the batch
+ *
+ * Return:
+ *   None
+ *******************************************************************************/
+static void batch_store_settings(const batch_settings_s *settings)
+{
+    const uint32_t keys = settings->keys;
+
+    if ((keys & (1UL << BATCH_KEY_MAX_RANGE)) != 0U)
+    {
+        config_store_set_u32(CONFIG_KEY_MAX_RANGE_BIN, (uint32_t)settings->config.max_range_bin);
+    }
+    if ((keys & (1UL << BATCH_KEY_MACRO_THRESHOLD)) != 0U)
+    {
+        config_store_set_float(CONFIG_KEY_MACRO_THRESHOLD, settings->config.macro_threshold);
+    }
+    if ((keys & (1UL << BATCH_KEY_MICRO_THRESHOLD)) != 0U)
+    {
+        config_store_set_float(CONFIG_KEY_MICRO_THRESHOLD, settings->config.micro_threshold);
+    }
+    if ((keys & (1UL << BATCH_KEY_BANDPASS_FILTER)) != 0U)
+    {
+        config_store_set_u32(CONFIG_KEY_BANDPASS_FILTER, settings->config.macro_fft_bandpass_filter_enabled ? 1U : 0U);
+    }
+    if ((keys & (1UL << BATCH_KEY_DECIMATION_FILTER)) != 0U)
+    {
+        config_store_set_u32(CONFIG_KEY_DECIMATION_FILTER, settings->config.micro_fft_decimation_enabled ? 1U : 0U);
+    }
+    if ((keys & (1UL << BATCH_KEY_MODE)) != 0U)
+    {
+        config_store_set_u32(CONFIG_KEY_MODE, (uint32_t)settings->config.mode);
+    }
+    if ((keys & (1UL << BATCH_KEY_RANGE_GATE)) != 0U)
+    {
+        config_store_set_u32(CONFIG_KEY_RANGE_GATE, settings->range_gate ? 1U : 0U);
+    }
+    if ((keys & (1UL << BATCH_KEY_AUTO_THRESHOLD)) != 0U)
+    {
+        config_store_set_u32(CONFIG_KEY_AUTO_THRESHOLD, settings->auto_threshold ? 1U : 0U);
+    }
+    if ((keys & (1UL << BATCH_KEY_CFAR_MODE)) != 0U)
+    {
+        config_store_set_u32(CONFIG_KEY_CFAR_MODE, (uint32_t)settings->cfar_mode);
+    }
+    if ((keys & (1UL << BATCH_KEY_VITAL_SIGNS)) != 0U)
+    {
+        config_store_set_u32(CONFIG_KEY_VITAL_SIGNS, settings->vital_signs ? 1U : 0U);
+    }
+    if ((keys & BATCH_FILTER_KEYS) != 0U)
+    {
+        config_store_set_float(CONFIG_KEY_FILTER_HIGHPASS, settings->highpass_hz);
+        config_store_set_float(CONFIG_KEY_FILTER_LOWPASS, settings->lowpass_hz);
+    }
+    if ((keys & (1UL << BATCH_KEY_FRAME_DECIMATION)) != 0U)
+    {
+        config_store_set_u32(CONFIG_KEY_FRAME_DECIMATION, settings->frame_decimation);
+    }
+    if ((keys & (1UL << BATCH_KEY_CHANGE_GATE)) != 0U)
+    {
+        config_store_set_float(CONFIG_KEY_CHANGE_GATE, settings->change_gate);
+    }
+    if ((keys & (1UL << BATCH_KEY_TRACKER_THRESHOLD)) != 0U)
+    {
+        config_store_set_float(CONFIG_KEY_TRACKER_THRESHOLD, settings->tracker_threshold);
+    }
 }
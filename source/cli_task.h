@@ -62,6 +62,20 @@ __NO_RETURN void console_task(void *pvParameters);
 #define CONFIG_MICRO_THRESHOLD         ("[CONFIG] micro_threshold ")
 #define CONFIG_BANDPASS_FILTER         ("[CONFIG] bandpass_filter ")
 #define CONFIG_DECIMATION_FILTER       ("[CONFIG] decimation_filter ")
+#define CONFIG_RANGE_GATE              ("[CONFIG] range_gate ")
+#define CONFIG_AUTO_THRESHOLD          ("[CONFIG] auto_threshold ")
+#define CONFIG_CFAR_MODE               ("[CONFIG] cfar_mode ")
+#define CONFIG_VITAL_SIGNS             ("[CONFIG] vital_signs ")
+#define CONFIG_CHANGE_GATE             ("[CONFIG] change_gate ")
+#define CONFIG_TRACKER_THRESHOLD       ("[CONFIG] tracker_threshold ")
+#define CONFIG_FILTER_BANK             ("[CONFIG] filter_bank ")
+#define CONFIG_FRAME_DECIMATION        ("[CONFIG] frame_decimation ")
+#define CONFIG_CLUTTER_MAP             ("[CONFIG] clutter_map ")
+#define CONFIG_RECONFIGURATIONS        ("[CONFIG] reconfigurations ")
+#define CONFIG_RAW_STREAM              ("[CONFIG] raw_stream ")
+#define CONFIG_DEADLINE                ("[CONFIG] deadline ")
+#define CONFIG_COALESCING              ("[CONFIG] coalescing ")
+#define CONFIG_COALESCING_STATS        ("[CONFIG] coalescing_stats ")
 
 
 #define MSG                            ("[MSG]")
@@ -0,0 +1,266 @@
+/*****************************************************************************
+ * File name: clutter_map.c
+ *
+ * Description: This file implements the background clutter map with
+ *   exponential background subtraction
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+#include "clutter_map.h"
+#include "flash_storage.h"
+
+#define CLUTTER_MAP_MAGIC                   (0x434C544DU) /* "CLTM" */
+#define CLUTTER_MAP_VERSION                 (2U)
+
+typedef struct
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t num_samples;
+    uint32_t mode;
+    uint32_t has_background;    /* 0 if the background was never learned */
+    uint32_t crc;
+    float32_t background[CLUTTER_MAP_MAX_SAMPLES];
+} clutter_map_record_s;
+
+static clutter_map_s live_map;
+
+/* Record buffer of clutter_map_save */
+static clutter_map_record_s clutter_record;
+
+/* Map saved by the autosave timer */
+static clutter_map_s *autosave_map;
+
+/*******************************************************************************
+ * Function Name: clutter_map_record_crc
+ ****************************************************************************//**
+ *
+ * @brief Calculates the CRC of a record, the CRC field itself is excluded.
+ *
+ * @param record Stored record.
+ *
+ * @return CRC of the record.
+ *
+ *******************************************************************************/
+static uint32_t clutter_map_record_crc(const clutter_map_record_s *record)
+{
+    return flash_storage_crc32(record->background, record->num_samples * sizeof(float32_t)) ^
+           flash_storage_crc32(record, offsetof(clutter_map_record_s, crc));
+}
+
+/*
+ * initialize the clutter map
+ */
+int32_t clutter_map_init(clutter_map_s *map, uint32_t num_samples)
+{
+    const clutter_map_record_s *stored =
+        (const clutter_map_record_s *)flash_storage_get_address(FLASH_STORAGE_CLUTTER_MAP);
+
+    if ((num_samples == 0U) || (num_samples > CLUTTER_MAP_MAX_SAMPLES))
+    {
+        return -1;
+    }
+
+    memset(map, 0, sizeof(*map));
+    map->num_samples = num_samples;
+
+    if ((stored != NULL) &&
+        (stored->magic == CLUTTER_MAP_MAGIC) &&
+        (stored->version == CLUTTER_MAP_VERSION) &&
+        (stored->num_samples == num_samples) &&
+        (stored->mode <= (uint32_t)CLUTTER_MAP_FREEZE) &&
+        (stored->crc == clutter_map_record_crc(stored)))
+    {
+        map->mode = (clutter_map_mode_e)stored->mode;
+
+        /* a map stored before anything was learned only restores the mode */
+        if (stored->has_background != 0U)
+        {
+            memcpy(map->background, stored->background, num_samples * sizeof(float32_t));
+            map->has_background = true;
+        }
+    }
+
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: clutter_map_autosave_callback
+ ****************************************************************************//**
+ *
+ * @brief Autosave timer callback, stores the map if it learned since the
+ * last save.
+ *
+ * @param timer Autosave timer.
+ *
+ *******************************************************************************/
+static void clutter_map_autosave_callback(TimerHandle_t timer)
+{
+    (void)timer;
+
+    if (autosave_map->modified && (clutter_map_save(autosave_map) != 0))
+    {
+        printf("[MSG] ERROR: clutter map save failed\n");
+    }
+}
+
+/*
+ * save the learned background periodically
+ */
+int32_t clutter_map_start_autosave(clutter_map_s *map)
+{
+    TimerHandle_t timer;
+
+    autosave_map = map;
+    timer = xTimerCreate("clutter_map", pdMS_TO_TICKS(CLUTTER_MAP_SAVE_PERIOD_MS), pdTRUE, NULL,
+                         clutter_map_autosave_callback);
+
+    if (timer == NULL)
+    {
+        return -1;
+    }
+
+    return (xTimerStart(timer, 0) == pdPASS) ? 0 : -1;
+}
+
+/*
+ * get the live clutter map
+ */
+clutter_map_s *clutter_map_get_live(void)
+{
+    return &live_map;
+}
+
+/*
+ * select the clutter map mode
+ */
+void clutter_map_set_mode(clutter_map_s *map, clutter_map_mode_e mode)
+{
+    map->mode = mode;
+}
+
+/*
+ * get the clutter map mode
+ */
+clutter_map_mode_e clutter_map_get_mode(const clutter_map_s *map)
+{
+    return map->mode;
+}
+
+/*
+ * learn and subtract the background
+ */
+void clutter_map_process(clutter_map_s *map, float32_t *chirp, bool learn, uint32_t time_ms)
+{
+    uint32_t num_samples = map->num_samples;
+    float32_t alpha;
+
+    if ((map->mode == CLUTTER_MAP_OFF) || (num_samples == 0U))
+    {
+        return;
+    }
+
+    if ((map->mode == CLUTTER_MAP_LEARN) && learn)
+    {
+        if (!map->has_background)
+        {
+            arm_copy_f32(chirp, map->background, num_samples);
+            map->has_background = true;
+        }
+        else
+        {
+            /* the weight follows the frame period, so the time constant holds for both frame rates */
+            alpha = (float32_t)(time_ms - map->last_time_ms) / (float32_t)CLUTTER_MAP_TIME_CONSTANT_MS;
+            if (alpha > 1.0f)
+            {
+                alpha = 1.0f;
+            }
+
+            /* background += alpha * (chirp - background) */
+            arm_sub_f32(chirp, map->background, map->delta, num_samples);
+            arm_scale_f32(map->delta, alpha, map->delta, num_samples);
+            arm_add_f32(map->background, map->delta, map->background, num_samples);
+        }
+
+        map->modified = true;
+    }
+
+    map->last_time_ms = time_ms;
+
+    if (map->has_background)
+    {
+        arm_sub_f32(chirp, map->background, chirp, num_samples);
+    }
+}
+
+/*
+ * store the background and the mode in flash
+ */
+int32_t clutter_map_save(clutter_map_s *map)
+{
+    clutter_map_record_s *record = &clutter_record;
+    int32_t result;
+
+    memset(record, 0, sizeof(*record));
+    record->magic = CLUTTER_MAP_MAGIC;
+    record->version = CLUTTER_MAP_VERSION;
+    record->num_samples = (uint16_t)map->num_samples;
+
+    /* consistent snapshot, the map is updated by the acquisition task */
+    vTaskSuspendAll();
+    record->mode = (uint32_t)map->mode;
+    record->has_background = map->has_background ? 1U : 0U;
+    memcpy(record->background, map->background, map->num_samples * sizeof(float32_t));
+    map->modified = false;
+    xTaskResumeAll();
+
+    record->crc = clutter_map_record_crc(record);
+
+    result = flash_storage_write(FLASH_STORAGE_CLUTTER_MAP, 0U, record, sizeof(*record));
+    if (result != 0)
+    {
+        /* the next autosave tries again */
+        map->modified = true;
+    }
+
+    return result;
+}
@@ -0,0 +1,189 @@
+/*****************************************************************************
+ * File name: clutter_map.h
+ *
+ * Description: This file contains types and function prototypes of the
+ *   background clutter map
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_CLUTTER_MAP_H_
+#define SOURCE_CLUTTER_MAP_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "arm_math.h"
+
+/*
+ * @def CLUTTER_MAP_MAX_SAMPLES
+ * Largest number of samples per chirp
+ */
+#define CLUTTER_MAP_MAX_SAMPLES             (128)
+
+/*
+ * @def CLUTTER_MAP_TIME_CONSTANT_MS
+ * Time constant of the exponentially weighted background
+ */
+#define CLUTTER_MAP_TIME_CONSTANT_MS        (20000U)
+
+/*
+ * @def CLUTTER_MAP_SAVE_PERIOD_MS
+ * A background learned since the last save is stored with this period,
+ * 24 writes a day keep the rows within their endurance for over ten years
+ */
+#define CLUTTER_MAP_SAVE_PERIOD_MS          (3600000U)
+
+/*
+ * @def enum clutter_map_mode_e
+ * Clutter map modes
+ * CLUTTER_MAP_OFF - no background subtraction
+ * CLUTTER_MAP_LEARN - background is learned while the scene is absent and subtracted
+ * CLUTTER_MAP_FREEZE - learned background is subtracted but not updated
+ */
+typedef enum
+{
+    CLUTTER_MAP_OFF,
+    CLUTTER_MAP_LEARN,
+    CLUTTER_MAP_FREEZE
+} clutter_map_mode_e;
+
+/*
+ * @typedef typedef struct clutter_map_s
+ * Clutter map instance, the background of the averaged chirp
+ */
+typedef struct
+{
+    clutter_map_mode_e mode;
+    uint32_t num_samples;
+    bool has_background;
+    bool modified;          /*<< learned since the last save*/
+    uint32_t last_time_ms;
+    float32_t background[CLUTTER_MAP_MAX_SAMPLES];
+    float32_t delta[CLUTTER_MAP_MAX_SAMPLES];
+} clutter_map_s;
+
+
+/*******************************************************************************
+ * Function Name: clutter_map_init
+ ****************************************************************************//**
+ *
+ * @brief Initializes a clutter map. A valid mode stored in flash is restored,
+ * and so is the background if one had been learned, so a warm start does not
+ * need to learn the background again.
+ *
+ * @param map Clutter map instance.
+ * @param num_samples Number of samples per chirp.
+ *
+ * @return 0 on success, -1 on invalid parameters.
+ *
+ *******************************************************************************/
+int32_t clutter_map_init(clutter_map_s *map, uint32_t num_samples);
+
+/*******************************************************************************
+ * Function Name: clutter_map_start_autosave
+ ****************************************************************************//**
+ *
+ * @brief Creates a timer which stores the map every
+ * CLUTTER_MAP_SAVE_PERIOD_MS if it learned since the last save.
+ *
+ * @param map Clutter map instance, usually the live one.
+ *
+ * @return 0 on success, -1 if the timer cannot be created.
+ *
+ *******************************************************************************/
+int32_t clutter_map_start_autosave(clutter_map_s *map);
+
+/*******************************************************************************
+ * Function Name: clutter_map_get_live
+ ****************************************************************************//**
+ *
+ * @return The clutter map instance of the live detection.
+ *
+ *******************************************************************************/
+clutter_map_s *clutter_map_get_live(void);
+
+/*******************************************************************************
+ * Function Name: clutter_map_set_mode
+ ****************************************************************************//**
+ *
+ * @brief Selects the clutter map mode.
+ *
+ * @param map Clutter map instance.
+ * @param mode Clutter map mode.
+ *
+ *******************************************************************************/
+void clutter_map_set_mode(clutter_map_s *map, clutter_map_mode_e mode);
+
+/*******************************************************************************
+ * Function Name: clutter_map_get_mode
+ ****************************************************************************//**
+ *
+ * @param map Clutter map instance.
+ *
+ * @return The selected clutter map mode.
+ *
+ *******************************************************************************/
+clutter_map_mode_e clutter_map_get_mode(const clutter_map_s *map);
+
+/*******************************************************************************
+ * Function Name: clutter_map_process
+ ****************************************************************************//**
+ *
+ * @brief Updates the background with the chirp in learn mode and subtracts it.
+ * The chirp is a time domain signal, by linearity of the range FFT this equals
+ * a complex background per range bin.
+ *
+ * @param map Clutter map instance.
+ * @param chirp Averaged chirp, the background is removed in place.
+ * @param learn true if the scene is empty and the background may be updated.
+ * @param time_ms Timestamp of the frame.
+ *
+ *******************************************************************************/
+void clutter_map_process(clutter_map_s *map, float32_t *chirp, bool learn, uint32_t time_ms);
+
+/*******************************************************************************
+ * Function Name: clutter_map_save
+ ****************************************************************************//**
+ *
+ * @brief Stores the background, whether it was learned and the mode in
+ * flash. Must be called from a task, it blocks while the flash is programmed.
+ *
+ * @param map Clutter map instance.
+ *
+ * @return 0 on success, -1 on a flash error.
+ *
+ *******************************************************************************/
+int32_t clutter_map_save(clutter_map_s *map);
+
+#endif /* SOURCE_CLUTTER_MAP_H_ */
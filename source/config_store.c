@@ -0,0 +1,298 @@
+/*****************************************************************************
+ * File name: config_store.c
+ *
+ * Description: This file implements the persistent configuration store as
+ *   a wear levelled log of CRC protected snapshots
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+#include "config_store.h"
+#include "flash_storage.h"
+
+#define CONFIG_STORE_MAGIC                  (0x43464753U) /* "CFGS" */
+
+/* One snapshot per flash row, the row with the highest sequence wins */
+typedef struct
+{
+    uint32_t magic;
+    uint32_t sequence;
+    uint32_t valid_mask;
+    uint32_t values[CONFIG_STORE_NUM_KEYS];
+    uint32_t crc;
+} config_store_record_s;
+
+typedef struct
+{
+    uint32_t valid_mask;
+    uint32_t values[CONFIG_STORE_NUM_KEYS];
+    bool dirty;
+    uint32_t sequence;
+    uint32_t next_row;
+    uint32_t num_rows;
+    TimerHandle_t flush_timer;
+    config_store_record_s record;
+} config_store_state_s;
+
+static config_store_state_s store_state;
+
+/*******************************************************************************
+ * Function Name: config_store_flush_callback
+ ****************************************************************************//**
+ *
+ * @brief Flush timer callback, writes the batched changes.
+ *
+ * @param timer Flush timer.
+ *
+ *******************************************************************************/
+static void config_store_flush_callback(TimerHandle_t timer)
+{
+    (void)timer;
+
+    if (config_store_flush() != 0)
+    {
+        printf("[MSG] ERROR: config store flush failed\n");
+    }
+}
+
+/*******************************************************************************
+ * Function Name: config_store_schedule
+ ****************************************************************************//**
+ *
+ * @brief Marks the cache dirty and restarts the flush timer, so a burst of
+ * changes is written once.
+ *
+ *******************************************************************************/
+static void config_store_schedule(void)
+{
+    store_state.dirty = true;
+
+    if (store_state.flush_timer != NULL)
+    {
+        (void)xTimerReset(store_state.flush_timer, 0);
+    }
+}
+
+/*
+ * load the newest snapshot and create the flush timer
+ */
+int32_t config_store_init(void)
+{
+    const uint8_t *base = flash_storage_get_address(FLASH_STORAGE_CONFIG);
+    bool found = false;
+
+    memset(&store_state, 0, sizeof(store_state));
+    store_state.num_rows = flash_storage_get_size(FLASH_STORAGE_CONFIG) / FLASH_STORAGE_ROW_SIZE;
+
+    for (uint32_t row = 0; row < store_state.num_rows; row++)
+    {
+        const config_store_record_s *record =
+            (const config_store_record_s *)&base[row * FLASH_STORAGE_ROW_SIZE];
+
+        if ((record->magic == CONFIG_STORE_MAGIC) &&
+            (record->crc == flash_storage_crc32(record, offsetof(config_store_record_s, crc))) &&
+            (!found || ((int32_t)(record->sequence - store_state.sequence) > 0)))
+        {
+            found = true;
+            store_state.sequence = record->sequence;
+            store_state.next_row = (row + 1U) % store_state.num_rows;
+            store_state.valid_mask = record->valid_mask;
+            memcpy(store_state.values, record->values, sizeof(store_state.values));
+        }
+    }
+
+    store_state.flush_timer = xTimerCreate("config_store", pdMS_TO_TICKS(CONFIG_STORE_FLUSH_DELAY_MS),
+                                           pdFALSE, NULL, config_store_flush_callback);
+
+    return (store_state.flush_timer != NULL) ? 0 : -1;
+}
+
+/*
+ * read an integer setting
+ */
+bool config_store_get_u32(config_store_key_e key, uint32_t *value)
+{
+    if ((key >= CONFIG_STORE_NUM_KEYS) || ((store_state.valid_mask & (1UL << key)) == 0U))
+    {
+        return false;
+    }
+
+    *value = store_state.values[key];
+
+    return true;
+}
+
+/*
+ * read a floating point setting
+ */
+bool config_store_get_float(config_store_key_e key, float32_t *value)
+{
+    uint32_t raw;
+
+    if (!config_store_get_u32(key, &raw))
+    {
+        return false;
+    }
+
+    memcpy(value, &raw, sizeof(*value));
+
+    return true;
+}
+
+/*
+ * update an integer setting
+ */
+void config_store_set_u32(config_store_key_e key, uint32_t value)
+{
+    if (key >= CONFIG_STORE_NUM_KEYS)
+    {
+        return;
+    }
+
+    vTaskSuspendAll();
+    store_state.values[key] = value;
+    store_state.valid_mask |= (1UL << key);
+    xTaskResumeAll();
+
+    config_store_schedule();
+}
+
+/*
+ * update a floating point setting
+ */
+void config_store_set_float(config_store_key_e key, float32_t value)
+{
+    uint32_t raw;
+
+    memcpy(&raw, &value, sizeof(raw));
+    config_store_set_u32(key, raw);
+}
+
+/*
+ * remove all settings
+ */
+void config_store_clear(void)
+{
+    vTaskSuspendAll();
+    store_state.valid_mask = 0U;
+    memset(store_state.values, 0, sizeof(store_state.values));
+    xTaskResumeAll();
+
+    config_store_schedule();
+}
+
+/*
+ * overwrite the stored presence algorithm settings
+ */
+void config_store_apply(xensiv_radar_presence_config_t *config)
+{
+    uint32_t value;
+    float32_t float_value;
+
+    if (config_store_get_u32(CONFIG_KEY_MAX_RANGE_BIN, &value))
+    {
+        config->max_range_bin = (int32_t)value;
+    }
+
+    if (config_store_get_float(CONFIG_KEY_MACRO_THRESHOLD, &float_value))
+    {
+        config->macro_threshold = float_value;
+    }
+
+    if (config_store_get_float(CONFIG_KEY_MICRO_THRESHOLD, &float_value))
+    {
+        config->micro_threshold = float_value;
+    }
+
+    if (config_store_get_u32(CONFIG_KEY_BANDPASS_FILTER, &value))
+    {
+        config->macro_fft_bandpass_filter_enabled = (value != 0U);
+    }
+
+    if (config_store_get_u32(CONFIG_KEY_DECIMATION_FILTER, &value))
+    {
+        config->micro_fft_decimation_enabled = (value != 0U);
+    }
+
+    if (config_store_get_u32(CONFIG_KEY_MODE, &value))
+    {
+        config->mode = (xensiv_radar_presence_mode_t)value;
+    }
+}
+
+/*
+ * write pending changes as a new snapshot
+ */
+int32_t config_store_flush(void)
+{
+    config_store_record_s *record = &store_state.record;
+    int32_t result;
+
+    if (!store_state.dirty || (store_state.num_rows == 0U))
+    {
+        return 0;
+    }
+
+    vTaskSuspendAll();
+    store_state.dirty = false;
+    record->valid_mask = store_state.valid_mask;
+    memcpy(record->values, store_state.values, sizeof(record->values));
+    xTaskResumeAll();
+
+    record->magic = CONFIG_STORE_MAGIC;
+    record->sequence = store_state.sequence + 1U;
+    record->crc = flash_storage_crc32(record, offsetof(config_store_record_s, crc));
+
+    result = flash_storage_write(FLASH_STORAGE_CONFIG, store_state.next_row * FLASH_STORAGE_ROW_SIZE,
+                                 record, sizeof(*record));
+
+    if (result == 0)
+    {
+        store_state.sequence = record->sequence;
+        store_state.next_row = (store_state.next_row + 1U) % store_state.num_rows;
+    }
+    else
+    {
+        store_state.dirty = true;
+    }
+
+    return result;
+}
@@ -0,0 +1,178 @@
+/*****************************************************************************
+ * File name: config_store.h
+ *
+ * Description: This file contains types and function prototypes of the
+ *   persistent configuration store
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_CONFIG_STORE_H_
+#define SOURCE_CONFIG_STORE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "arm_math.h"
+#include "xensiv_radar_presence.h"
+
+/*
+ * @def CONFIG_STORE_FLUSH_DELAY_MS
+ * Changes are written to flash once no further change arrived for this time
+ */
+#define CONFIG_STORE_FLUSH_DELAY_MS         (5000U)
+
+/*
+ * @def enum config_store_key_e
+ * Keys of the stored settings, new keys are only appended
+ */
+typedef enum
+{
+    CONFIG_KEY_MAX_RANGE_BIN,
+    CONFIG_KEY_MACRO_THRESHOLD,
+    CONFIG_KEY_MICRO_THRESHOLD,
+    CONFIG_KEY_BANDPASS_FILTER,
+    CONFIG_KEY_DECIMATION_FILTER,
+    CONFIG_KEY_MODE,
+    CONFIG_KEY_RANGE_GATE,
+    CONFIG_KEY_AUTO_THRESHOLD,
+    CONFIG_KEY_CFAR_MODE,
+    CONFIG_KEY_VITAL_SIGNS,
+    CONFIG_KEY_FILTER_HIGHPASS,
+    CONFIG_KEY_FILTER_LOWPASS,
+    CONFIG_KEY_FRAME_DECIMATION,
+    CONFIG_KEY_CHANGE_GATE,
+    CONFIG_KEY_TRACKER_THRESHOLD,
+    CONFIG_STORE_NUM_KEYS
+} config_store_key_e;
+
+
+/*******************************************************************************
+ * Function Name: config_store_init
+ ****************************************************************************//**
+ *
+ * @brief Loads the newest valid snapshot from flash into the RAM cache and
+ * creates the flush timer. Needs an initialized flash storage.
+ *
+ * @return 0 on success, -1 if the flush timer cannot be created.
+ *
+ *******************************************************************************/
+int32_t config_store_init(void);
+
+/*******************************************************************************
+ * Function Name: config_store_get_u32
+ ****************************************************************************//**
+ *
+ * @brief Reads an integer setting from the RAM cache.
+ *
+ * @param key Setting.
+ * @param value Stored value.
+ *
+ * @return true if the setting is stored, false otherwise.
+ *
+ *******************************************************************************/
+bool config_store_get_u32(config_store_key_e key, uint32_t *value);
+
+/*******************************************************************************
+ * Function Name: config_store_get_float
+ ****************************************************************************//**
+ *
+ * @brief Reads a floating point setting from the RAM cache.
+ *
+ * @param key Setting.
+ * @param value Stored value.
+ *
+ * @return true if the setting is stored, false otherwise.
+ *
+ *******************************************************************************/
+bool config_store_get_float(config_store_key_e key, float32_t *value);
+
+/*******************************************************************************
+ * Function Name: config_store_set_u32
+ ****************************************************************************//**
+ *
+ * @brief Updates an integer setting in the RAM cache and schedules a flush.
+ *
+ * @param key Setting.
+ * @param value New value.
+ *
+ *******************************************************************************/
+void config_store_set_u32(config_store_key_e key, uint32_t value);
+
+/*******************************************************************************
+ * Function Name: config_store_set_float
+ ****************************************************************************//**
+ *
+ * @brief Updates a floating point setting in the RAM cache and schedules a
+ * flush.
+ *
+ * @param key Setting.
+ * @param value New value.
+ *
+ *******************************************************************************/
+void config_store_set_float(config_store_key_e key, float32_t value);
+
+/*******************************************************************************
+ * Function Name: config_store_clear
+ ****************************************************************************//**
+ *
+ * @brief Removes all settings, the defaults apply after the next boot.
+ *
+ *******************************************************************************/
+void config_store_clear(void);
+
+/*******************************************************************************
+ * Function Name: config_store_apply
+ ****************************************************************************//**
+ *
+ * @brief Overwrites the stored presence algorithm settings in a configuration.
+ *
+ * @param config Presence algorithm configuration.
+ *
+ *******************************************************************************/
+void config_store_apply(xensiv_radar_presence_config_t *config);
+
+/*******************************************************************************
+ * Function Name: config_store_flush
+ ****************************************************************************//**
+ *
+ * @brief Writes pending changes as a new snapshot. The snapshots rotate over
+ * all rows of the region for wear levelling. Called by the flush timer, blocks
+ * while the flash is programmed.
+ *
+ * @return 0 on success or if nothing is pending, -1 on a flash error.
+ *
+ *******************************************************************************/
+int32_t config_store_flush(void);
+
+#endif /* SOURCE_CONFIG_STORE_H_ */
@@ -0,0 +1,467 @@
+/*****************************************************************************
+ * File name: console_uart.c
+ *
+ * Description: This file implements the interrupt driven console UART. The RX
+ *   line discipline runs in the UART interrupt, stdout is sent from a ring buffer
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "cyhal.h"
+#include "cy_retarget_io.h"
+#include "semphr.h"
+
+#include "console_uart.h"
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+#define KEY_ENTER                           (0x0D)
+#define KEY_LINE_FEED                       (0x0A)
+#define KEY_ESC                             (0x1B)
+#define KEY_BACKSPACE                       (0x08)
+
+/*******************************************************************************
+ * Types
+ ********************************************************************************/
+typedef struct
+{
+    cyhal_uart_t *uart;
+    TaskHandle_t task;
+    volatile bool echo;
+    bool initialized;
+
+    /* RX line being edited and the queue of complete lines */
+    char line[CONSOLE_LINE_LENGTH];
+    size_t line_length;
+    bool last_cr;
+    char rx_lines[CONSOLE_RX_LINES][CONSOLE_LINE_LENGTH];
+    size_t rx_head;
+    size_t rx_count;
+    uint32_t rx_overruns;
+
+    /* TX ring, tx_active bytes from tx_tail are in transfer */
+    uint8_t tx_buffer[CONSOLE_TX_BUFFER_SIZE];
+    size_t tx_tail;
+    size_t tx_count;
+    size_t tx_active;
+    SemaphoreHandle_t tx_space;
+    StaticSemaphore_t tx_space_buffer;
+    SemaphoreHandle_t tx_lock;
+    StaticSemaphore_t tx_lock_buffer;
+} console_uart_state_s;
+
+/*******************************************************************************
+ * Variables
+ ********************************************************************************/
+static console_uart_state_s console_state;
+
+/*******************************************************************************
+ * Function Name: tx_put
+ ****************************************************************************//**
+ *
+ * @brief Appends a character to the TX ring. Must be called in a critical
+ * section.
+ *
+ * @param c Character.
+ *
+ * @return true if the character was stored, false if the ring is full.
+ *
+ *******************************************************************************/
+static bool tx_put(char c)
+{
+    if (console_state.tx_count >= CONSOLE_TX_BUFFER_SIZE)
+    {
+        return false;
+    }
+
+    console_state.tx_buffer[(console_state.tx_tail + console_state.tx_count) % CONSOLE_TX_BUFFER_SIZE] = (uint8_t)c;
+    console_state.tx_count++;
+
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: tx_start
+ ****************************************************************************//**
+ *
+ * @brief Starts the transfer of the oldest contiguous block of the TX ring if
+ * no transfer is active. Must be called in a critical section.
+ *
+ *******************************************************************************/
+static void tx_start(void)
+{
+    size_t length;
+
+    if ((console_state.tx_active != 0U) || (console_state.tx_count == 0U))
+    {
+        return;
+    }
+
+    length = CONSOLE_TX_BUFFER_SIZE - console_state.tx_tail;
+    if (length > console_state.tx_count)
+    {
+        length = console_state.tx_count;
+    }
+
+    if (cyhal_uart_write_async(console_state.uart,
+                               &console_state.tx_buffer[console_state.tx_tail],
+                               length) == CY_RSLT_SUCCESS)
+    {
+        console_state.tx_active = length;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: rx_char
+ ****************************************************************************//**
+ *
+ * @brief Line discipline for one received character. CR, LF and CRLF each
+ * end one line. Must be called in a critical section.
+ *
+ * @param c Received character.
+ *
+ * @return CONSOLE_EVENT_* bits to notify.
+ *
+ *******************************************************************************/
+static uint32_t rx_char(char c)
+{
+    bool after_cr = console_state.last_cr;
+
+    console_state.last_cr = (c == KEY_ENTER);
+
+    switch (c)
+    {
+        case KEY_LINE_FEED:
+            /* the LF of a CRLF was already handled with the CR */
+            if (after_cr)
+            {
+                break;
+            }
+            /* fall through */
+
+        case KEY_ENTER:
+            console_state.line[console_state.line_length] = '\0';
+            if (console_state.rx_count < CONSOLE_RX_LINES)
+            {
+                memcpy(console_state.rx_lines[(console_state.rx_head + console_state.rx_count) % CONSOLE_RX_LINES],
+                       console_state.line, console_state.line_length + 1U);
+                console_state.rx_count++;
+            }
+            else
+            {
+                console_state.rx_overruns++;
+            }
+            console_state.line_length = 0;
+            return CONSOLE_EVENT_LINE;
+
+        case KEY_ESC:
+            console_state.line_length = 0;
+            return CONSOLE_EVENT_ESC;
+
+        case KEY_BACKSPACE:
+            if (console_state.line_length > 0U)
+            {
+                console_state.line_length--;
+                if (console_state.echo)
+                {
+                    (void)tx_put(c);
+                }
+            }
+            break;
+
+        default:
+            if (console_state.line_length < (CONSOLE_LINE_LENGTH - 1U))
+            {
+                console_state.line[console_state.line_length++] = c;
+                if (console_state.echo)
+                {
+                    (void)tx_put(c);
+                }
+            }
+            break;
+    }
+
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: console_uart_event_handler
+ ****************************************************************************//**
+ *
+ * @brief UART interrupt callback. Continues the TX ring transfer and feeds
+ * received characters to the line discipline.
+ *
+ * @param arg Unused.
+ * @param event UART events.
+ *
+ *******************************************************************************/
+static void console_uart_event_handler(void *arg, cyhal_uart_event_t event)
+{
+    BaseType_t higher_priority_task_woken = pdFALSE;
+    uint32_t notify = 0;
+    UBaseType_t saved_interrupt_status;
+    uint8_t c;
+
+    (void)arg;
+
+    saved_interrupt_status = taskENTER_CRITICAL_FROM_ISR();
+
+    if ((event & CYHAL_UART_IRQ_TX_DONE) != 0)
+    {
+        console_state.tx_tail = (console_state.tx_tail + console_state.tx_active) % CONSOLE_TX_BUFFER_SIZE;
+        console_state.tx_count -= console_state.tx_active;
+        console_state.tx_active = 0;
+    }
+
+    if ((event & CYHAL_UART_IRQ_RX_NOT_EMPTY) != 0)
+    {
+        while (cyhal_uart_readable(console_state.uart) > 0U)
+        {
+            if (cyhal_uart_getc(console_state.uart, &c, 0) != CY_RSLT_SUCCESS)
+            {
+                break;
+            }
+            notify |= rx_char((char)c);
+        }
+    }
+
+    tx_start();
+
+    taskEXIT_CRITICAL_FROM_ISR(saved_interrupt_status);
+
+    if ((event & CYHAL_UART_IRQ_TX_DONE) != 0)
+    {
+        (void)xSemaphoreGiveFromISR(console_state.tx_space, &higher_priority_task_woken);
+    }
+
+    if (notify != 0U)
+    {
+        (void)xTaskNotifyFromISR(console_state.task, notify, eSetBits, &higher_priority_task_woken);
+    }
+
+    portYIELD_FROM_ISR(higher_priority_task_woken);
+}
+
+/*******************************************************************************
+ * Function Name: write_blocking
+ ****************************************************************************//**
+ *
+ * @brief Writes characters directly to the UART. Used before the console task
+ * has taken over the UART.
+ *
+ * @param ptr Characters.
+ * @param len Number of characters.
+ *
+ *******************************************************************************/
+static void write_blocking(const char *ptr, int len)
+{
+    for (int i = 0; i < len; ++i)
+    {
+#ifdef CY_RETARGET_IO_CONVERT_LF_TO_CRLF
+        if (ptr[i] == '\n')
+        {
+            (void)cyhal_uart_putc(&cy_retarget_io_uart_obj, '\r');
+        }
+#endif
+        (void)cyhal_uart_putc(&cy_retarget_io_uart_obj, (uint32_t)ptr[i]);
+    }
+}
+
+/*
+ * take over the retarget-io UART
+ */
+int32_t console_uart_init(TaskHandle_t task)
+{
+    console_state.uart = &cy_retarget_io_uart_obj;
+    console_state.task = task;
+
+    console_state.tx_space = xSemaphoreCreateBinaryStatic(&console_state.tx_space_buffer);
+    console_state.tx_lock = xSemaphoreCreateMutexStatic(&console_state.tx_lock_buffer);
+
+    if ((console_state.tx_space == NULL) || (console_state.tx_lock == NULL))
+    {
+        return -1;
+    }
+
+    /* interrupt driven transfers are used if no DMA channel is available */
+    (void)cyhal_uart_set_async_mode(console_state.uart, CYHAL_ASYNC_DMA, CYHAL_DMA_PRIORITY_DEFAULT);
+
+    cyhal_uart_register_callback(console_state.uart, console_uart_event_handler, NULL);
+    cyhal_uart_enable_event(console_state.uart,
+                            (cyhal_uart_event_t)(CYHAL_UART_IRQ_TX_DONE | CYHAL_UART_IRQ_RX_NOT_EMPTY),
+                            CONSOLE_UART_IRQ_PRIORITY,
+                            true);
+
+    console_state.initialized = true;
+
+    return 0;
+}
+
+/*
+ * enable the echo of received characters
+ */
+void console_uart_set_echo(bool enabled)
+{
+    console_state.echo = enabled;
+}
+
+/*
+ * read the oldest queued line
+ */
+bool console_uart_read_line(char *line, size_t size)
+{
+    bool available;
+
+    taskENTER_CRITICAL();
+    available = (console_state.rx_count > 0U);
+    if (available)
+    {
+        strncpy(line, console_state.rx_lines[console_state.rx_head], size - 1U);
+        line[size - 1U] = '\0';
+        console_state.rx_head = (console_state.rx_head + 1U) % CONSOLE_RX_LINES;
+        console_state.rx_count--;
+    }
+    taskEXIT_CRITICAL();
+
+    return available;
+}
+
+/*
+ * get the number of dropped lines
+ */
+uint32_t console_uart_get_rx_overruns(void)
+{
+    return console_state.rx_overruns;
+}
+
+/*
+ * write a block to the console in one piece
+ */
+void console_uart_write(const char *data, size_t length)
+{
+    size_t i = 0U;
+
+    if (!console_state.initialized)
+    {
+        write_blocking(data, (int)length);
+        return;
+    }
+
+    (void)xSemaphoreTake(console_state.tx_lock, portMAX_DELAY);
+
+    while (i < length)
+    {
+        taskENTER_CRITICAL();
+        for (; i < length; ++i)
+        {
+#ifdef CY_RETARGET_IO_CONVERT_LF_TO_CRLF
+            if (data[i] == '\n')
+            {
+                if ((CONSOLE_TX_BUFFER_SIZE - console_state.tx_count) < 2U)
+                {
+                    break;
+                }
+                (void)tx_put('\r');
+            }
+#endif
+            if (!tx_put(data[i]))
+            {
+                break;
+            }
+        }
+        tx_start();
+        taskEXIT_CRITICAL();
+
+        /* the ring is full, wait until a transfer completes */
+        if (i < length)
+        {
+            (void)xSemaphoreTake(console_state.tx_space, portMAX_DELAY);
+        }
+    }
+
+    (void)xSemaphoreGive(console_state.tx_lock);
+}
+
+/* The output hooks of the toolchains override the weak implementations of
+ * retarget-io, so that printf only copies into the TX ring and returns and
+ * never writes the UART while a transfer of the ring is in flight. */
+#if defined(__ARMCC_VERSION)
+/*
+ * Arm compiler output hook
+ */
+int fputc(int ch, FILE *f)
+{
+    char c = (char)ch;
+
+    (void)f;
+    console_uart_write(&c, 1U);
+
+    return ch;
+}
+#elif defined(__ICCARM__)
+/*
+ * IAR output hook, a NULL buffer asks for a flush
+ */
+size_t __write(int handle, const unsigned char *buffer, size_t size)
+{
+    (void)handle;
+
+    if ((buffer != NULL) && (size > 0U))
+    {
+        console_uart_write((const char *)buffer, size);
+    }
+
+    return size;
+}
+#elif defined(__GNUC__)
+/*
+ * newlib output hook
+ */
+int _write(int fd, const char *ptr, int len)
+{
+    (void)fd;
+
+    if (len > 0)
+    {
+        console_uart_write(ptr, (size_t)len);
+    }
+
+    return len;
+}
+#else
+#error "console_uart.c: no output hook for this toolchain"
+#endif
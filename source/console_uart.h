@@ -0,0 +1,152 @@
+/*****************************************************************************
+ * File name: console_uart.h
+ *
+ * Description: This file contains the function prototypes of the interrupt
+ *   driven console UART with RX line discipline and buffered TX
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_CONSOLE_UART_H_
+#define SOURCE_CONSOLE_UART_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*
+ * @def CONSOLE_EVENT_LINE
+ * Notification bit set when a complete line was received
+ */
+#define CONSOLE_EVENT_LINE                  (1UL << 0)
+
+/*
+ * @def CONSOLE_EVENT_ESC
+ * Notification bit set when ESC was received
+ */
+#define CONSOLE_EVENT_ESC                   (1UL << 1)
+
+/*
+ * @def CONSOLE_LINE_LENGTH
+ * Size of the RX line buffers including the terminating zero
+ */
+#define CONSOLE_LINE_LENGTH                 (256U)
+
+/*
+ * @def CONSOLE_RX_LINES
+ * Complete lines queued for the task, allows to send commands back to back
+ */
+#define CONSOLE_RX_LINES                    (4U)
+
+/*
+ * @def CONSOLE_TX_BUFFER_SIZE
+ * Size of the TX ring buffer in bytes
+ */
+#define CONSOLE_TX_BUFFER_SIZE              (2048U)
+
+/*
+ * @def CONSOLE_UART_IRQ_PRIORITY
+ * Priority of the UART interrupt, lowest so that radar interrupts are not delayed
+ */
+#define CONSOLE_UART_IRQ_PRIORITY           (7U)
+
+
+/*******************************************************************************
+ * Function Name: console_uart_init
+ ****************************************************************************//**
+ *
+ * @brief Takes over the UART initialized by retarget-io. Received characters
+ * are edited into a line in the UART interrupt and the task is notified per
+ * complete line. stdout is written through a ring buffer which is sent
+ * asynchronously, using DMA if a channel is available. Must be called from a
+ * task.
+ *
+ * @param task Task which receives the CONSOLE_EVENT_* notification bits.
+ *
+ * @return 0 on success, -1 if the synchronization objects cannot be created.
+ *
+ *******************************************************************************/
+int32_t console_uart_init(TaskHandle_t task);
+
+/*******************************************************************************
+ * Function Name: console_uart_set_echo
+ ****************************************************************************//**
+ *
+ * @brief Enables the echo of received characters.
+ *
+ * @param enabled true to echo received characters.
+ *
+ *******************************************************************************/
+void console_uart_set_echo(bool enabled);
+
+/*******************************************************************************
+ * Function Name: console_uart_read_line
+ ****************************************************************************//**
+ *
+ * @brief Reads the oldest queued line and releases its slot.
+ *
+ * @param line Buffer for the zero terminated line.
+ * @param size Size of the buffer.
+ *
+ * @return true if a line was available, false otherwise.
+ *
+ *******************************************************************************/
+bool console_uart_read_line(char *line, size_t size);
+
+/*******************************************************************************
+ * Function Name: console_uart_get_rx_overruns
+ ****************************************************************************//**
+ *
+ * @return Number of lines dropped because the queue was full.
+ *
+ *******************************************************************************/
+uint32_t console_uart_get_rx_overruns(void);
+
+/*******************************************************************************
+ * Function Name: console_uart_write
+ ****************************************************************************//**
+ *
+ * @brief Writes a block of characters to the console. The block is not
+ * interleaved with the output of other tasks, printf may split its output.
+ * Blocks while the TX ring is full.
+ *
+ * @param data Characters.
+ * @param length Number of characters.
+ *
+ *******************************************************************************/
+void console_uart_write(const char *data, size_t length);
+
+#endif /* SOURCE_CONSOLE_UART_H_ */
@@ -0,0 +1,163 @@
+/*****************************************************************************
+ * File name: flash_storage.c
+ *
+ * Description: This file implements the persistent storage regions in the
+ *   auxiliary flash
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+
+#include "cyhal.h"
+#include "FreeRTOS.h"
+#include "semphr.h"
+
+#include "flash_storage.h"
+
+typedef struct
+{
+    uint32_t first_row;
+    uint32_t num_rows;
+} flash_storage_layout_s;
+
+typedef struct
+{
+    cyhal_flash_t flash;
+    SemaphoreHandle_t lock;
+    StaticSemaphore_t lock_buffer;
+    uint32_t row_buff[FLASH_STORAGE_ROW_SIZE / sizeof(uint32_t)];
+} flash_storage_state_s;
+
+static const flash_storage_layout_s flash_storage_layout[FLASH_STORAGE_NUM_REGIONS] =
+{
+    [FLASH_STORAGE_CLUTTER_MAP] = { 0U, FLASH_STORAGE_CLUTTER_MAP_ROWS },
+    [FLASH_STORAGE_CONFIG]      = { FLASH_STORAGE_CLUTTER_MAP_ROWS, FLASH_STORAGE_CONFIG_ROWS },
+    [FLASH_STORAGE_OCCUPANCY]   = { FLASH_STORAGE_CLUTTER_MAP_ROWS + FLASH_STORAGE_CONFIG_ROWS,
+                                    FLASH_STORAGE_OCCUPANCY_ROWS }
+};
+
+/* Placed in the emulated EEPROM section of the linker script (auxiliary flash) */
+CY_SECTION(".cy_em_eeprom") CY_ALIGN(FLASH_STORAGE_ROW_SIZE)
+static const uint8_t flash_storage_area[FLASH_STORAGE_NUM_ROWS * FLASH_STORAGE_ROW_SIZE] = { 0U };
+
+static flash_storage_state_s storage_state;
+
+/*
+ * initialize the flash driver
+ */
+int32_t flash_storage_init(void)
+{
+    if (cyhal_flash_init(&storage_state.flash) != CY_RSLT_SUCCESS)
+    {
+        return -1;
+    }
+
+    storage_state.lock = xSemaphoreCreateMutexStatic(&storage_state.lock_buffer);
+
+    return (storage_state.lock != NULL) ? 0 : -1;
+}
+
+/*
+ * get the start of a region
+ */
+const uint8_t *flash_storage_get_address(flash_storage_region_e region)
+{
+    if (region >= FLASH_STORAGE_NUM_REGIONS)
+    {
+        return NULL;
+    }
+
+    return &flash_storage_area[flash_storage_layout[region].first_row * FLASH_STORAGE_ROW_SIZE];
+}
+
+/*
+ * get the size of a region
+ */
+uint32_t flash_storage_get_size(flash_storage_region_e region)
+{
+    if (region >= FLASH_STORAGE_NUM_REGIONS)
+    {
+        return 0U;
+    }
+
+    return flash_storage_layout[region].num_rows * FLASH_STORAGE_ROW_SIZE;
+}
+
+/*
+ * write data into a region
+ */
+int32_t flash_storage_write(flash_storage_region_e region, uint32_t offset,
+                            const void *data, size_t len)
+{
+    const uint8_t *src = (const uint8_t *)data;
+    const uint8_t *base = flash_storage_get_address(region);
+    int32_t result = 0;
+
+    if ((base == NULL) || (data == NULL) || (storage_state.lock == NULL) ||
+        (((size_t)offset + len) > flash_storage_get_size(region)))
+    {
+        return -1;
+    }
+
+    (void)xSemaphoreTake(storage_state.lock, portMAX_DELAY);
+
+    while ((len > 0U) && (result == 0))
+    {
+        uint32_t row_offset = offset % FLASH_STORAGE_ROW_SIZE;
+        const uint8_t *row = &base[offset - row_offset];
+        size_t chunk = FLASH_STORAGE_ROW_SIZE - row_offset;
+
+        if (chunk > len)
+        {
+            chunk = len;
+        }
+
+        /* read-modify-write of the whole row */
+        memcpy(storage_state.row_buff, row, FLASH_STORAGE_ROW_SIZE);
+        memcpy(&((uint8_t *)storage_state.row_buff)[row_offset], src, chunk);
+
+        if (cyhal_flash_write(&storage_state.flash, (uint32_t)(uintptr_t)row, storage_state.row_buff) != CY_RSLT_SUCCESS)
+        {
+            result = -1;
+        }
+
+        src += chunk;
+        offset += (uint32_t)chunk;
+        len -= chunk;
+    }
+
+    (void)xSemaphoreGive(storage_state.lock);
+
+    return result;
+}
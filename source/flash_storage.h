@@ -0,0 +1,165 @@
+/*****************************************************************************
+ * File name: flash_storage.h
+ *
+ * Description: This file contains types and function prototypes of the
+ *   persistent storage regions in the auxiliary flash
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_FLASH_STORAGE_H_
+#define SOURCE_FLASH_STORAGE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "cy_pdl.h"
+
+/*
+ * @def FLASH_STORAGE_ROW_SIZE
+ * Smallest erasable and programmable unit of the flash in bytes
+ */
+#define FLASH_STORAGE_ROW_SIZE              (CY_FLASH_SIZEOF_ROW)
+
+/*
+ * @def FLASH_STORAGE_CLUTTER_MAP_ROWS
+ * Rows of the clutter map region
+ */
+#define FLASH_STORAGE_CLUTTER_MAP_ROWS      (2U)
+
+/*
+ * @def FLASH_STORAGE_CONFIG_ROWS
+ * Rows of the configuration region
+ */
+#define FLASH_STORAGE_CONFIG_ROWS           (4U)
+
+/*
+ * @def FLASH_STORAGE_OCCUPANCY_ROWS
+ * Rows of the occupancy history region, the last one is the shadow row of the
+ * open segment
+ */
+#define FLASH_STORAGE_OCCUPANCY_ROWS        (48U)
+
+/*
+ * @def FLASH_STORAGE_NUM_ROWS
+ * Rows of all regions, which follow each other in the order of the regions
+ */
+#define FLASH_STORAGE_NUM_ROWS              (FLASH_STORAGE_CLUTTER_MAP_ROWS + FLASH_STORAGE_CONFIG_ROWS + \
+                                             FLASH_STORAGE_OCCUPANCY_ROWS)
+
+/*
+ * @def enum flash_storage_region_e
+ * Storage regions, each one occupies whole flash rows
+ * FLASH_STORAGE_CLUTTER_MAP - background clutter map
+ * FLASH_STORAGE_CONFIG - configuration snapshots
+ * FLASH_STORAGE_OCCUPANCY - per-minute occupancy history
+ */
+typedef enum
+{
+    FLASH_STORAGE_CLUTTER_MAP,
+    FLASH_STORAGE_CONFIG,
+    FLASH_STORAGE_OCCUPANCY,
+    FLASH_STORAGE_NUM_REGIONS
+} flash_storage_region_e;
+
+
+/*******************************************************************************
+ * Function Name: flash_storage_init
+ ****************************************************************************//**
+ *
+ * @brief Initializes the flash driver. Must be called before the scheduler
+ * runs other users of the storage.
+ *
+ * @return 0 on success, -1 on failure.
+ *
+ *******************************************************************************/
+int32_t flash_storage_init(void);
+
+/*******************************************************************************
+ * Function Name: flash_storage_get_address
+ ****************************************************************************//**
+ *
+ * @brief The flash is memory mapped, regions are read through this pointer.
+ *
+ * @param region Storage region.
+ *
+ * @return Start of the region, NULL for an invalid region.
+ *
+ *******************************************************************************/
+const uint8_t *flash_storage_get_address(flash_storage_region_e region);
+
+/*******************************************************************************
+ * Function Name: flash_storage_get_size
+ ****************************************************************************//**
+ *
+ * @param region Storage region.
+ *
+ * @return Size of the region in bytes, 0 for an invalid region.
+ *
+ *******************************************************************************/
+uint32_t flash_storage_get_size(flash_storage_region_e region);
+
+/*******************************************************************************
+ * Function Name: flash_storage_write
+ ****************************************************************************//**
+ *
+ * @brief Writes data into a region. Every touched row is read, merged with the
+ * new data and rewritten, so offset and length need no alignment. Blocks the
+ * calling task until the rows are programmed.
+ *
+ * @param region Storage region.
+ * @param offset Offset inside the region in bytes.
+ * @param data Data to write.
+ * @param len Number of bytes to write.
+ *
+ * @return 0 on success, -1 on invalid parameters or a flash error.
+ *
+ *******************************************************************************/
+int32_t flash_storage_write(flash_storage_region_e region, uint32_t offset,
+                            const void *data, size_t len);
+
+/*******************************************************************************
+ * Function Name: flash_storage_crc32
+ ****************************************************************************//**
+ *
+ * @brief Calculates the CRC-32 (IEEE 802.3) of a buffer.
+ *
+ * @param data Buffer.
+ * @param len Number of bytes.
+ *
+ * @return CRC of the buffer.
+ *
+ *******************************************************************************/
+uint32_t flash_storage_crc32(const void *data, size_t len);
+
+#endif /* SOURCE_FLASH_STORAGE_H_ */
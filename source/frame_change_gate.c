@@ -0,0 +1,167 @@
+/*****************************************************************************
+ * File name: frame_change_gate.c
+ *
+ * Description: This file implements the frame change gate, which skips
+ *   the presence processing of static scenes
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+
+#include "frame_change_gate.h"
+
+/* shared by the live gate and the gate of the selftest */
+static volatile float32_t gate_threshold;
+
+static frame_change_gate_s live_gate;
+
+/*******************************************************************************
+ * Function Name: frame_change_gate_pass
+ ****************************************************************************//**
+ *
+ * @brief Takes a chirp which passes the gate as the new reference.
+ *
+ * @param gate Gate instance.
+ * @param chirp Chirp fed to the presence algorithm.
+ *
+ * @return Always true.
+ *
+ *******************************************************************************/
+static bool frame_change_gate_pass(frame_change_gate_s *gate, const float32_t *chirp)
+{
+    memcpy(gate->reference, chirp, gate->num_samples * sizeof(float32_t));
+    gate->has_reference = true;
+    gate->skip_run = 0U;
+
+    return true;
+}
+
+/*
+ * initialize a gate
+ */
+int32_t frame_change_gate_init(frame_change_gate_s *gate, uint32_t num_samples)
+{
+    if ((num_samples == 0U) || (num_samples > FRAME_CHANGE_GATE_MAX_SAMPLES))
+    {
+        return -1;
+    }
+
+    memset(gate, 0, sizeof(*gate));
+    gate->num_samples = num_samples;
+
+    return 0;
+}
+
+/*
+ * get the gate of the live frame path
+ */
+frame_change_gate_s *frame_change_gate_get_live(void)
+{
+    return &live_gate;
+}
+
+/*
+ * set the threshold of the gates
+ */
+int32_t frame_change_gate_set_threshold(float32_t threshold)
+{
+    if ((threshold != 0.0f) &&
+        ((threshold < FRAME_CHANGE_GATE_MIN_THRESHOLD) || (threshold > FRAME_CHANGE_GATE_MAX_THRESHOLD)))
+    {
+        return -1;
+    }
+
+    gate_threshold = threshold;
+
+    return 0;
+}
+
+/*
+ * get the threshold of the gates
+ */
+float32_t frame_change_gate_get_threshold(void)
+{
+    return gate_threshold;
+}
+
+/*
+ * decide if a chirp is processed
+ */
+bool frame_change_gate_process(frame_change_gate_s *gate, const float32_t *chirp, bool empty)
+{
+    float32_t threshold = gate_threshold;
+    float32_t energy;
+
+    if (!empty || (threshold == 0.0f) || !gate->has_reference)
+    {
+        return frame_change_gate_pass(gate, chirp);
+    }
+
+    gate->stats.frames++;
+
+    /* the signature is the energy of the difference to the last processed chirp */
+    arm_sub_f32(chirp, gate->reference, gate->difference, gate->num_samples);
+    arm_power_f32(gate->difference, gate->num_samples, &energy);
+
+    if (gate->learned_frames < FRAME_CHANGE_GATE_LEARN_FRAMES)
+    {
+        /* a static scene is assumed while learning, all frames pass */
+        gate->learned_frames++;
+        gate->static_energy += (energy - gate->static_energy) / (float32_t)gate->learned_frames;
+
+        return frame_change_gate_pass(gate, chirp);
+    }
+
+    if (energy > (threshold * gate->static_energy))
+    {
+        gate->stats.changes++;
+
+        return frame_change_gate_pass(gate, chirp);
+    }
+
+    /* only unchanged frames track the slow drift of the noise */
+    gate->static_energy += (energy - gate->static_energy) / (float32_t)FRAME_CHANGE_GATE_LEARN_FRAMES;
+
+    if (gate->skip_run >= FRAME_CHANGE_GATE_MAX_SKIP)
+    {
+        gate->stats.refreshes++;
+
+        return frame_change_gate_pass(gate, chirp);
+    }
+
+    gate->skip_run++;
+    gate->stats.skipped++;
+
+    return false;
+}
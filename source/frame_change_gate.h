@@ -0,0 +1,175 @@
+/*****************************************************************************
+ * File name: frame_change_gate.h
+ *
+ * Description: This file contains types and function prototypes of the
+ *   frame change gate, which skips the presence processing of static scenes
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_FRAME_CHANGE_GATE_H_
+#define SOURCE_FRAME_CHANGE_GATE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "arm_math.h"
+
+/*
+ * @def FRAME_CHANGE_GATE_MAX_SAMPLES
+ * Maximum number of samples per chirp
+ */
+#define FRAME_CHANGE_GATE_MAX_SAMPLES       (128)
+
+/*
+ * @def FRAME_CHANGE_GATE_MIN_THRESHOLD
+ * Smallest threshold, as a multiple of the difference energy of a static scene
+ */
+#define FRAME_CHANGE_GATE_MIN_THRESHOLD     (1.5f)
+
+/*
+ * @def FRAME_CHANGE_GATE_MAX_THRESHOLD
+ * Largest threshold
+ */
+#define FRAME_CHANGE_GATE_MAX_THRESHOLD     (100.0f)
+
+/*
+ * @def FRAME_CHANGE_GATE_LEARN_FRAMES
+ * Frames which pass the gate to learn the difference energy of a static scene
+ */
+#define FRAME_CHANGE_GATE_LEARN_FRAMES      (16U)
+
+/*
+ * @def FRAME_CHANGE_GATE_MAX_SKIP
+ * Longest run of skipped frames, the next frame passes to keep the presence
+ * algorithm and the reference current
+ */
+#define FRAME_CHANGE_GATE_MAX_SKIP          (9U)
+
+/*
+ * @typedef typedef struct frame_change_gate_stats_s
+ * Gate counters
+ */
+typedef struct
+{
+    uint32_t frames;     /*<< frames offered while the scene was empty*/
+    uint32_t skipped;    /*<< frames which did not differ from the reference*/
+    uint32_t changes;    /*<< frames which passed because they differed*/
+    uint32_t refreshes;  /*<< frames which passed after FRAME_CHANGE_GATE_MAX_SKIP skipped frames*/
+} frame_change_gate_stats_s;
+
+/*
+ * @typedef typedef struct frame_change_gate_s
+ * Gate instance, the reference is the last chirp which passed the gate
+ */
+typedef struct
+{
+    uint32_t num_samples;
+    uint32_t learned_frames;
+    uint32_t skip_run;
+    bool has_reference;
+    float32_t static_energy;
+    frame_change_gate_stats_s stats;
+    float32_t reference[FRAME_CHANGE_GATE_MAX_SAMPLES];
+    float32_t difference[FRAME_CHANGE_GATE_MAX_SAMPLES];
+} frame_change_gate_s;
+
+
+/*******************************************************************************
+ * Function Name: frame_change_gate_init
+ ****************************************************************************//**
+ *
+ * @brief Initializes a gate without reference, the first frames pass.
+ *
+ * @param gate Gate instance.
+ * @param num_samples Number of samples per chirp.
+ *
+ * @return 0 on success, -1 if num_samples is out of range.
+ *
+ *******************************************************************************/
+int32_t frame_change_gate_init(frame_change_gate_s *gate, uint32_t num_samples);
+
+/*******************************************************************************
+ * Function Name: frame_change_gate_get_live
+ ****************************************************************************//**
+ *
+ * @return Gate instance of the live frame path.
+ *
+ *******************************************************************************/
+frame_change_gate_s *frame_change_gate_get_live(void);
+
+/*******************************************************************************
+ * Function Name: frame_change_gate_set_threshold
+ ****************************************************************************//**
+ *
+ * @brief Sets the threshold of all gates. A frame differs from the reference
+ * when the energy of the difference exceeds the threshold times the learned
+ * difference energy of a static scene.
+ *
+ * @param threshold Threshold, 0 disables the gates.
+ *
+ * @return 0 on success, -1 if the threshold is out of range.
+ *
+ *******************************************************************************/
+int32_t frame_change_gate_set_threshold(float32_t threshold);
+
+/*******************************************************************************
+ * Function Name: frame_change_gate_get_threshold
+ ****************************************************************************//**
+ *
+ * @return Threshold of the gates, 0 if disabled.
+ *
+ *******************************************************************************/
+float32_t frame_change_gate_get_threshold(void);
+
+/*******************************************************************************
+ * Function Name: frame_change_gate_process
+ ****************************************************************************//**
+ *
+ * @brief Decides if the presence algorithm has to process a chirp. Only
+ * frames of an empty scene are skipped, and only if they do not differ from
+ * the last chirp the algorithm processed. Every chirp which passes becomes the
+ * new reference, so the algorithm resumes from the frame the gate compared
+ * against.
+ *
+ * @param gate Gate instance.
+ * @param chirp Chirp fed to the presence algorithm.
+ * @param empty true while the scene is empty and the algorithm only waits for
+ * macro movement.
+ *
+ * @return true if the chirp has to be processed.
+ *
+ *******************************************************************************/
+bool frame_change_gate_process(frame_change_gate_s *gate, const float32_t *chirp, bool empty);
+
+#endif /* SOURCE_FRAME_CHANGE_GATE_H_ */
@@ -0,0 +1,207 @@
+/*****************************************************************************
+ * File name: frame_coalescing.c
+ *
+ * Description: This file implements the frame interrupt coalescing of
+ *   the low frame rate profile
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+#include "task_stats.h"
+#include "frame_coalescing.h"
+
+typedef struct
+{
+    uint32_t max_frames;
+    volatile uint32_t frames;
+    uint32_t active_frames;
+    volatile uint32_t wakeups;
+    uint32_t last_time_us;
+    uint32_t last_idle_us;
+    frame_coalescing_stats_s stats[FRAME_COALESCING_MAX_FRAMES];
+    SemaphoreHandle_t processed;
+    StaticSemaphore_t processed_buffer;
+} frame_coalescing_state_s;
+
+static frame_coalescing_state_s coalescing_state;
+
+/*
+ * initialize the coalescing
+ */
+int32_t frame_coalescing_init(uint32_t max_frames)
+{
+    if ((max_frames == 0U) || (max_frames > FRAME_COALESCING_MAX_FRAMES))
+    {
+        return -1;
+    }
+
+    coalescing_state.processed = xSemaphoreCreateBinaryStatic(&coalescing_state.processed_buffer);
+    coalescing_state.max_frames = max_frames;
+    coalescing_state.frames = 1U;
+    coalescing_state.active_frames = 0U;
+    coalescing_state.last_time_us = task_stats_timer_read();
+    coalescing_state.last_idle_us = ulTaskGetIdleRunTimeCounter();
+
+    return 0;
+}
+
+/*
+ * request the frames per interrupt
+ */
+int32_t frame_coalescing_set_frames(uint32_t frames)
+{
+    if ((frames == 0U) || (frames > coalescing_state.max_frames))
+    {
+        return -1;
+    }
+
+    coalescing_state.frames = frames;
+
+    return 0;
+}
+
+/*
+ * get the requested frames per interrupt
+ */
+uint32_t frame_coalescing_get_frames(void)
+{
+    return coalescing_state.frames;
+}
+
+/*
+ * get the largest setting
+ */
+uint32_t frame_coalescing_get_max_frames(void)
+{
+    return coalescing_state.max_frames;
+}
+
+/*
+ * switch the accounting to a new setting
+ */
+void frame_coalescing_set_active(uint32_t frames)
+{
+    /* the time so far belongs to the previous setting */
+    frame_coalescing_update();
+    coalescing_state.active_frames = frames;
+}
+
+/*
+ * get the setting the sensor runs with
+ */
+uint32_t frame_coalescing_get_active(void)
+{
+    return coalescing_state.active_frames;
+}
+
+/*
+ * count a sensor interrupt
+ */
+void frame_coalescing_wakeup(void)
+{
+    coalescing_state.wakeups++;
+}
+
+/*
+ * account the time since the last update
+ */
+void frame_coalescing_update(void)
+{
+    uint32_t time_us = task_stats_timer_read();
+    uint32_t idle_us = ulTaskGetIdleRunTimeCounter();
+    uint32_t elapsed_us = time_us - coalescing_state.last_time_us;
+    uint32_t idle_elapsed_us = idle_us - coalescing_state.last_idle_us;
+    uint32_t wakeups;
+
+    taskENTER_CRITICAL();
+    wakeups = coalescing_state.wakeups;
+    coalescing_state.wakeups = 0U;
+
+    if (coalescing_state.active_frames > 0U)
+    {
+        frame_coalescing_stats_s *stats = &coalescing_state.stats[coalescing_state.active_frames - 1U];
+
+        stats->wakeups += wakeups;
+        stats->time_us += elapsed_us;
+        stats->active_us += (idle_elapsed_us < elapsed_us) ? (elapsed_us - idle_elapsed_us) : 0U;
+    }
+    taskEXIT_CRITICAL();
+
+    coalescing_state.last_time_us = time_us;
+    coalescing_state.last_idle_us = idle_us;
+}
+
+/*
+ * get the accounting of a setting
+ */
+bool frame_coalescing_get_stats(uint32_t frames, frame_coalescing_stats_s *stats)
+{
+    if ((frames == 0U) || (frames > coalescing_state.max_frames))
+    {
+        return false;
+    }
+
+    taskENTER_CRITICAL();
+    *stats = coalescing_state.stats[frames - 1U];
+    taskEXIT_CRITICAL();
+
+    return true;
+}
+
+/*
+ * forget the end of an earlier frame
+ */
+void frame_coalescing_clear_processed(void)
+{
+    (void)xSemaphoreTake(coalescing_state.processed, 0);
+}
+
+/*
+ * wait for the end of the frame handed over last
+ */
+bool frame_coalescing_wait_processed(void)
+{
+    return (xSemaphoreTake(coalescing_state.processed, pdMS_TO_TICKS(FRAME_COALESCING_WAIT_MS)) == pdTRUE);
+}
+
+/*
+ * signal the end of a frame
+ */
+void frame_coalescing_frame_processed(void)
+{
+    (void)xSemaphoreGive(coalescing_state.processed);
+}
@@ -0,0 +1,204 @@
+/*****************************************************************************
+ * File name: frame_coalescing.h
+ *
+ * Description: This file contains types and function prototypes of the
+ *   frame interrupt coalescing of the low frame rate profile
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_FRAME_COALESCING_H_
+#define SOURCE_FRAME_COALESCING_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * @def FRAME_COALESCING_MAX_FRAMES
+ * Largest number of frames per sensor interrupt, the application lowers it to
+ * what fits into the sensor FIFO
+ */
+#define FRAME_COALESCING_MAX_FRAMES         (4U)
+
+/*
+ * @def FRAME_COALESCING_WAIT_MS
+ * Longest wait for the processing of one frame of a batch before the next
+ * frame is handed over anyway
+ */
+#define FRAME_COALESCING_WAIT_MS            (100U)
+
+/*
+ * @typedef typedef struct frame_coalescing_stats_s
+ * Wake-up and active time accounting of one coalescing setting
+ */
+typedef struct
+{
+    uint32_t wakeups;    /*<< sensor interrupts*/
+    uint64_t time_us;    /*<< time spent in the low frame rate profile with this setting*/
+    uint64_t active_us;  /*<< part of that time the CPU was not idle*/
+} frame_coalescing_stats_s;
+
+
+/*******************************************************************************
+ * Function Name: frame_coalescing_init
+ ****************************************************************************//**
+ *
+ * @brief Initializes the coalescing with one frame per interrupt. The active
+ * time is taken from the run time counter of the idle task.
+ *
+ * @param max_frames Largest accepted setting, at most FRAME_COALESCING_MAX_FRAMES.
+ *
+ * @return 0 on success, -1 if max_frames is out of range.
+ *
+ *******************************************************************************/
+int32_t frame_coalescing_init(uint32_t max_frames);
+
+/*******************************************************************************
+ * Function Name: frame_coalescing_set_frames
+ ****************************************************************************//**
+ *
+ * @brief Requests the number of frames read per sensor interrupt in the low
+ * frame rate profile. The acquisition applies it between two interrupts.
+ *
+ * @param frames Frames per interrupt, 1 disables the coalescing.
+ *
+ * @return 0 on success, -1 if frames is out of range.
+ *
+ *******************************************************************************/
+int32_t frame_coalescing_set_frames(uint32_t frames);
+
+/*******************************************************************************
+ * Function Name: frame_coalescing_get_frames
+ ****************************************************************************//**
+ *
+ * @return Requested frames per interrupt.
+ *
+ *******************************************************************************/
+uint32_t frame_coalescing_get_frames(void);
+
+/*******************************************************************************
+ * Function Name: frame_coalescing_get_max_frames
+ ****************************************************************************//**
+ *
+ * @return Largest accepted setting.
+ *
+ *******************************************************************************/
+uint32_t frame_coalescing_get_max_frames(void);
+
+/*******************************************************************************
+ * Function Name: frame_coalescing_set_active
+ ****************************************************************************//**
+ *
+ * @brief Tells the accounting which setting the sensor runs with after a
+ * reconfiguration.
+ *
+ * @param frames Frames per interrupt, 0 pauses the accounting while a profile
+ * without coalescing runs.
+ *
+ *******************************************************************************/
+void frame_coalescing_set_active(uint32_t frames);
+
+/*******************************************************************************
+ * Function Name: frame_coalescing_get_active
+ ****************************************************************************//**
+ *
+ * @return Frames per interrupt the sensor runs with, 0 outside of the low frame
+ * rate profile.
+ *
+ *******************************************************************************/
+uint32_t frame_coalescing_get_active(void);
+
+/*******************************************************************************
+ * Function Name: frame_coalescing_wakeup
+ ****************************************************************************//**
+ *
+ * @brief Called from the sensor interrupt, counts a wake-up.
+ *
+ *******************************************************************************/
+void frame_coalescing_wakeup(void);
+
+/*******************************************************************************
+ * Function Name: frame_coalescing_update
+ ****************************************************************************//**
+ *
+ * @brief Adds the time and the wake-ups since the last call to the active
+ * setting. Called by the acquisition after every interrupt, often enough for
+ * the 32 bit run time counter not to wrap in between.
+ *
+ *******************************************************************************/
+void frame_coalescing_update(void);
+
+/*******************************************************************************
+ * Function Name: frame_coalescing_get_stats
+ ****************************************************************************//**
+ *
+ * @param frames Setting to report.
+ * @param stats Copy of the accounting of the setting.
+ *
+ * @return true if frames is a valid setting.
+ *
+ *******************************************************************************/
+bool frame_coalescing_get_stats(uint32_t frames, frame_coalescing_stats_s *stats);
+
+/*******************************************************************************
+ * Function Name: frame_coalescing_clear_processed
+ ****************************************************************************//**
+ *
+ * @brief Discards the end of an earlier frame, called before a frame is handed
+ * over to the processing task.
+ *
+ *******************************************************************************/
+void frame_coalescing_clear_processed(void);
+
+/*******************************************************************************
+ * Function Name: frame_coalescing_wait_processed
+ ****************************************************************************//**
+ *
+ * @brief Waits until the processing task finished the frame handed over last,
+ * so that a batch is processed one frame at a time.
+ *
+ * @return true if the frame was processed within FRAME_COALESCING_WAIT_MS.
+ *
+ *******************************************************************************/
+bool frame_coalescing_wait_processed(void);
+
+/*******************************************************************************
+ * Function Name: frame_coalescing_frame_processed
+ ****************************************************************************//**
+ *
+ * @brief Called by the processing task at the end of every frame.
+ *
+ *******************************************************************************/
+void frame_coalescing_frame_processed(void);
+
+#endif /* SOURCE_FRAME_COALESCING_H_ */
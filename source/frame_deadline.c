@@ -0,0 +1,200 @@
+/*****************************************************************************
+ * File name: frame_deadline.c
+ *
+ * Description: This file implements the frame deadline monitor and
+ *   overload governor
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdbool.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "benchmark.h"
+#include "frame_deadline.h"
+
+typedef struct
+{
+    volatile bool busy;
+    uint32_t start_cycles;
+    uint32_t budget_cycles;
+    uint32_t cycles_per_us;
+    uint32_t window_frames;
+    uint32_t window_max_cycles;
+    uint32_t window_misses;
+    uint32_t calm_windows;
+    volatile frame_deadline_level_e level;
+    frame_deadline_stats_s stats;
+} frame_deadline_state_s;
+
+static frame_deadline_state_s deadline_state;
+
+/*******************************************************************************
+ * Function Name: frame_deadline_govern
+ ****************************************************************************//**
+ *
+ * @brief Moves one level up after a window with a miss or a frame close to the
+ * deadline, and one level down after FRAME_DEADLINE_CALM_WINDOWS windows with
+ * low load. The asymmetry keeps the level from toggling at the border.
+ *
+ *******************************************************************************/
+static void frame_deadline_govern(void)
+{
+    frame_deadline_level_e level = deadline_state.level;
+    float32_t load = (float32_t)deadline_state.window_max_cycles / (float32_t)deadline_state.budget_cycles;
+
+    if ((deadline_state.window_misses > 0U) || (load > FRAME_DEADLINE_HIGH_LOAD))
+    {
+        deadline_state.calm_windows = 0U;
+
+        if (level < FRAME_DEADLINE_LEVEL_NO_TELEMETRY)
+        {
+            level++;
+        }
+    }
+    else if (load < FRAME_DEADLINE_LOW_LOAD)
+    {
+        deadline_state.calm_windows++;
+
+        if ((deadline_state.calm_windows >= FRAME_DEADLINE_CALM_WINDOWS) && (level > FRAME_DEADLINE_LEVEL_FULL))
+        {
+            deadline_state.calm_windows = 0U;
+            level--;
+        }
+    }
+    else
+    {
+        deadline_state.calm_windows = 0U;
+    }
+
+    if (level != deadline_state.level)
+    {
+        deadline_state.level = level;
+        deadline_state.stats.level_changes++;
+    }
+}
+
+/*
+ * initialize the monitor
+ */
+void frame_deadline_init(float32_t frame_period_s)
+{
+    deadline_state.cycles_per_us = SystemCoreClock / 1000000U;
+    deadline_state.level = FRAME_DEADLINE_LEVEL_FULL;
+    frame_deadline_set_period(frame_period_s);
+}
+
+/*
+ * set the deadline of the frames
+ */
+void frame_deadline_set_period(float32_t frame_period_s)
+{
+    taskENTER_CRITICAL();
+    deadline_state.budget_cycles = (uint32_t)(frame_period_s * (float32_t)SystemCoreClock);
+    deadline_state.window_frames = 0U;
+    deadline_state.window_max_cycles = 0U;
+    deadline_state.window_misses = 0U;
+    taskEXIT_CRITICAL();
+}
+
+/*
+ * check the deadline of the previous frame
+ */
+void frame_deadline_irq(void)
+{
+    if (deadline_state.busy)
+    {
+        deadline_state.window_misses++;
+        deadline_state.stats.misses++;
+    }
+}
+
+/*
+ * a frame is read
+ */
+void frame_deadline_begin(void)
+{
+    deadline_state.start_cycles = benchmark_get_cycles();
+    deadline_state.busy = true;
+}
+
+/*
+ * a frame is processed
+ */
+void frame_deadline_end(void)
+{
+    uint32_t cycles = benchmark_get_cycles() - deadline_state.start_cycles;
+
+    /* the acquisition task ends decimated frames, the processing task all others */
+    taskENTER_CRITICAL();
+    deadline_state.busy = false;
+    deadline_state.stats.frames++;
+
+    if (cycles > deadline_state.window_max_cycles)
+    {
+        deadline_state.window_max_cycles = cycles;
+    }
+
+    if ((cycles / deadline_state.cycles_per_us) > deadline_state.stats.max_us)
+    {
+        deadline_state.stats.max_us = cycles / deadline_state.cycles_per_us;
+    }
+
+    if (++deadline_state.window_frames >= FRAME_DEADLINE_WINDOW_FRAMES)
+    {
+        deadline_state.stats.window_max_us = deadline_state.window_max_cycles / deadline_state.cycles_per_us;
+        frame_deadline_govern();
+        deadline_state.window_frames = 0U;
+        deadline_state.window_max_cycles = 0U;
+        deadline_state.window_misses = 0U;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*
+ * get the degradation level
+ */
+frame_deadline_level_e frame_deadline_get_level(void)
+{
+    return deadline_state.level;
+}
+
+/*
+ * get the deadline counters
+ */
+const frame_deadline_stats_s *frame_deadline_get_stats(void)
+{
+    return &deadline_state.stats;
+}
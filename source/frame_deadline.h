@@ -0,0 +1,171 @@
+/*****************************************************************************
+ * File name: frame_deadline.h
+ *
+ * Description: This file contains types and function prototypes of the
+ *   frame deadline monitor and overload governor
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_FRAME_DEADLINE_H_
+#define SOURCE_FRAME_DEADLINE_H_
+
+#include <stdint.h>
+
+#include "arm_math.h"
+
+/*
+ * @def FRAME_DEADLINE_WINDOW_FRAMES
+ * The governor decides on the frames of a window of this length
+ */
+#define FRAME_DEADLINE_WINDOW_FRAMES        (20U)
+
+/*
+ * @def FRAME_DEADLINE_HIGH_LOAD
+ * A window with a frame longer than this share of the frame period, or with a
+ * missed deadline, sheds the next level of optional work
+ */
+#define FRAME_DEADLINE_HIGH_LOAD            (0.9f)
+
+/*
+ * @def FRAME_DEADLINE_LOW_LOAD
+ * Windows with all frames shorter than this share of the frame period count
+ * towards restoring the last shed level
+ */
+#define FRAME_DEADLINE_LOW_LOAD             (0.5f)
+
+/*
+ * @def FRAME_DEADLINE_CALM_WINDOWS
+ * Consecutive low load windows needed to restore one level
+ */
+#define FRAME_DEADLINE_CALM_WINDOWS         (10U)
+
+/*
+ * @typedef typedef enum frame_deadline_level_e
+ * Degradation levels, every level also sheds the work of the levels below
+ */
+typedef enum
+{
+    FRAME_DEADLINE_LEVEL_FULL = 0,          /*<< all work is done*/
+    FRAME_DEADLINE_LEVEL_NO_VERBOSE,        /*<< the verbose output is suppressed*/
+    FRAME_DEADLINE_LEVEL_MICRO_DECIMATION,  /*<< the micro FFT decimation is forced on*/
+    FRAME_DEADLINE_LEVEL_NO_TELEMETRY       /*<< raw stream and breathing rate reports stop*/
+} frame_deadline_level_e;
+
+/*
+ * @typedef typedef struct frame_deadline_stats_s
+ * Deadline counters
+ */
+typedef struct
+{
+    uint32_t frames;         /*<< frames processed*/
+    uint32_t misses;         /*<< frame interrupts while the previous frame was still processed*/
+    uint32_t max_us;         /*<< longest frame since boot*/
+    uint32_t window_max_us;  /*<< longest frame of the last window*/
+    uint32_t level_changes;  /*<< changes of the degradation level*/
+} frame_deadline_stats_s;
+
+
+/*******************************************************************************
+ * Function Name: frame_deadline_init
+ ****************************************************************************//**
+ *
+ * @brief Initializes the monitor at full service. Frame times are taken with
+ * the core cycle counter enabled by benchmark_init.
+ *
+ * @param frame_period_s Initial frame period.
+ *
+ *******************************************************************************/
+void frame_deadline_init(float32_t frame_period_s);
+
+/*******************************************************************************
+ * Function Name: frame_deadline_set_period
+ ****************************************************************************//**
+ *
+ * @brief Sets the deadline after a change of the frame rate. The current
+ * window is discarded.
+ *
+ * @param frame_period_s New frame period.
+ *
+ *******************************************************************************/
+void frame_deadline_set_period(float32_t frame_period_s);
+
+/*******************************************************************************
+ * Function Name: frame_deadline_irq
+ ****************************************************************************//**
+ *
+ * @brief Called from the frame interrupt, counts a miss if the previous frame
+ * is still being processed.
+ *
+ *******************************************************************************/
+void frame_deadline_irq(void);
+
+/*******************************************************************************
+ * Function Name: frame_deadline_begin
+ ****************************************************************************//**
+ *
+ * @brief Marks the start of the processing of a frame, called when the frame
+ * is read from the data manager.
+ *
+ *******************************************************************************/
+void frame_deadline_begin(void);
+
+/*******************************************************************************
+ * Function Name: frame_deadline_end
+ ****************************************************************************//**
+ *
+ * @brief Marks the end of the processing of a frame and runs the governor at
+ * the end of a window.
+ *
+ *******************************************************************************/
+void frame_deadline_end(void);
+
+/*******************************************************************************
+ * Function Name: frame_deadline_get_level
+ ****************************************************************************//**
+ *
+ * @return Current degradation level.
+ *
+ *******************************************************************************/
+frame_deadline_level_e frame_deadline_get_level(void);
+
+/*******************************************************************************
+ * Function Name: frame_deadline_get_stats
+ ****************************************************************************//**
+ *
+ * @return Pointer to the deadline counters.
+ *
+ *******************************************************************************/
+const frame_deadline_stats_s *frame_deadline_get_stats(void);
+
+#endif /* SOURCE_FRAME_DEADLINE_H_ */
@@ -37,6 +37,7 @@
 *******************************************************************************/
 
 #include <inttypes.h>
+#include <math.h>
 #include <stdio.h>
 
 #include "cy_pdl.h"
@@ -54,6 +55,25 @@
 #include "xensiv_bgt60trxx_mtb.h"
 #include "xensiv_radar_presence.h"
 #include "radar_config_optimizer.h"
+#include "range_gate.h"
+#include "radar_rx_processing.h"
+#include "radar_aoa.h"
+#include "presence_tracker.h"
+#include "presence_cfar.h"
+#include "presence_vital_signs.h"
+#include "slow_time_filter.h"
+#include "flash_storage.h"
+#include "clutter_map.h"
+#include "config_store.h"
+#include "presence_config_stage.h"
+#include "presence_event_log.h"
+#include "occupancy_store.h"
+#include "raw_stream.h"
+#include "benchmark.h"
+#include "task_stats.h"
+#include "frame_deadline.h"
+#include "frame_coalescing.h"
+#include "frame_change_gate.h"
 
 #include "radar_low_framerate_config.h"
 
@@ -81,10 +101,34 @@
 #define CLI_TASK_NAME                       "cli_task"
 #define CLI_TASK_STACK_SIZE                 (configMINIMAL_STACK_SIZE * 20)
 #define CLI_TASK_PRIORITY                   (tskIDLE_PRIORITY)
+#define RAW_STREAM_TASK_NAME                "raw_stream_task"
+#define RAW_STREAM_TASK_STACK_SIZE          (configMINIMAL_STACK_SIZE * 2)
+#define RAW_STREAM_TASK_PRIORITY            (tskIDLE_PRIORITY)
 
 /* Interrupt priorities */
 #define GPIO_INTERRUPT_PRIORITY             (7)
 
+/* 8192 FIFO words of two samples, one more frame must fit while a burst is read */
+#define SENSOR_FIFO_SAMPLES                 (16384U)
+#define COALESCING_FIFO_FRAMES              ((SENSOR_FIFO_SAMPLES - NUM_SAMPLES_PER_FRAME) / (NUM_SAMPLES_PER_FRAME * 2))
+#define COALESCING_MAX_FRAMES               ((COALESCING_FIFO_FRAMES < 1U) ? 1U : \
+                                             ((COALESCING_FIFO_FRAMES > FRAME_COALESCING_MAX_FRAMES) ? \
+                                              FRAME_COALESCING_MAX_FRAMES : COALESCING_FIFO_FRAMES))
+
+/* The data manager holds two bursts and the chirp averaging reads one frame ahead */
+#define RDM_BUFFER_SIZE                     (NUM_SAMPLES_PER_FRAME * 2 * ((2U * COALESCING_MAX_FRAMES) + 1U))
+
+/* Angle of arrival needs the L-shaped array of three receivers */
+#define AOA_ENABLED                         (NUM_RX_ANTENNAS >= AOA_MIN_NUM_RX_ANTENNAS)
+
+/* Auto thresholds are re-evaluated at this interval and only applied if they
+ * moved by more than the relative hysteresis */
+#define CFAR_AUTO_UPDATE_MS                 (10000U)
+#define CFAR_AUTO_HYSTERESIS                (0.05f)
+
+/* Interval of the breathing rate reports outside of verbose mode */
+#define VITAL_REPORT_MS                     (5000U)
+
 
 /*******************************************************************************
 * Function Prototypes
@@ -96,7 +140,17 @@ static void timer_callbak(TimerHandle_t xTimer);
 static int32_t init_leds(void);
 static int32_t init_sensor(void);
 static void process_verbose_cmd(xensiv_radar_presence_handle_t handle, XENSIV_RADAR_PRESENCE_TIMESTAMP time_ms);
+static void process_tracks(xensiv_radar_presence_handle_t handle, XENSIV_RADAR_PRESENCE_TIMESTAMP time_ms);
+static void process_cfar(xensiv_radar_presence_handle_t handle, XENSIV_RADAR_PRESENCE_TIMESTAMP time_ms);
+static void process_vital_signs(xensiv_radar_presence_handle_t handle, XENSIV_RADAR_PRESENCE_TIMESTAMP time_ms);
+static void print_vital_signs(XENSIV_RADAR_PRESENCE_TIMESTAMP time_ms);
+static void apply_stored_settings(void);
+static void apply_staged_config(xensiv_radar_presence_handle_t handle);
+static void apply_degradation_level(void);
 static void xensiv_bgt60trxx_interrupt_handler(void* args, cyhal_gpio_event_t event);
+#if AOA_ENABLED
+static void print_aoa(int32_t range_bin, XENSIV_RADAR_PRESENCE_TIMESTAMP time_ms);
+#endif
 void presence_detection_cb(xensiv_radar_presence_handle_t handle,
                            const xensiv_radar_presence_event_t* event,
                            void *data);
@@ -109,6 +163,8 @@ typedef struct {
     xensiv_radar_presence_event_t last_reported_event;
     bool verbose;
     XENSIV_RADAR_PRESENCE_TIMESTAMP bookmark_timestamp;
+    uint32_t people_count;
+    bool settings_mode;
 }ce_state_s;
 
 
@@ -117,11 +173,29 @@ typedef struct {
 ********************************************************************************/
 static cyhal_spi_t spi_obj;
 static xensiv_bgt60trxx_mtb_t bgt60_obj;
+#if (NUM_RX_ANTENNAS > 1)
+static float32_t rx_frame[NUM_SAMPLES_PER_FRAME];
+static float32_t rx_avg_chirp[NUM_RX_ANTENNAS * NUM_SAMPLES_PER_CHIRP];
+#else
 static float32_t frame[NUM_SAMPLES_PER_FRAME * 2];
+#endif
 static float32_t avg_chirp[NUM_SAMPLES_PER_CHIRP];
+static float32_t presence_chirp[NUM_SAMPLES_PER_CHIRP];
+#if AOA_ENABLED
+static radar_aoa_result_s aoa_result;
+#endif
+static float32_t macro_fft_mag[MACRO_FFT_BUFF_SIZE];
+static task_stats_s load_stats;
+static XENSIV_RADAR_PRESENCE_TIMESTAMP cfar_auto_timestamp;
+static XENSIV_RADAR_PRESENCE_TIMESTAMP vital_report_timestamp;
+static bool first_detection_reported;
+static volatile uint32_t coalesced_frames = 1U;
+static uint32_t frame_period_ms = (uint32_t)(XENSIV_BGT60TRXX_CONF_FRAME_REPETITION_TIME_S * 1000.0f);
+static XENSIV_RADAR_PRESENCE_TIMESTAMP frame_timestamp;
 
 static TaskHandle_t main_task_handler;
 static TaskHandle_t processing_task_handler;
+static TaskHandle_t raw_stream_task_handler;
 static TimerHandle_t timer_handler;
 radar_data_manager_s mgr;
 
@@ -137,7 +211,7 @@ volatile bool print_job_locked;
 *
 * Parameters:
 *  * data: pointer to radar data
-*  *num_samples: pointer to number of samples per frame
+*  *num_samples: pointer to number of samples read, all coalesced frames
 *  samples_ub: maximum number of samples to be copied at a time from owner task/caller
 *
 * Return:
@@ -146,16 +220,22 @@ volatile bool print_job_locked;
 *******************************************************************************/
 int32_t read_radar_data(uint16_t* data, uint32_t *num_samples, uint32_t samples_ub)
 {
+    uint32_t frames = coalesced_frames;
+
+    *num_samples = 0U;
+
+    /* a burst which does not fit into the buffer is dropped, the FIFO restarts empty */
+    if (samples_ub < NUM_SAMPLES_PER_FRAME * 2 * frames)
+    {
+        xensiv_bgt60trxx_soft_reset(&bgt60_obj.dev,XENSIV_BGT60TRXX_RESET_FIFO );
+        return 0;
+    }
+
     if (xensiv_bgt60trxx_get_fifo_data(&bgt60_obj.dev,
             data,
-            NUM_SAMPLES_PER_FRAME) == XENSIV_BGT60TRXX_STATUS_OK)
+            NUM_SAMPLES_PER_FRAME * frames) == XENSIV_BGT60TRXX_STATUS_OK)
     {
-        *num_samples = NUM_SAMPLES_PER_FRAME *2; // in bytes
-
-        if (samples_ub < NUM_SAMPLES_PER_FRAME *2)
-        {
-            xensiv_bgt60trxx_soft_reset(&bgt60_obj.dev,XENSIV_BGT60TRXX_RESET_FIFO );
-        }
+        *num_samples = NUM_SAMPLES_PER_FRAME * 2 * frames; // in bytes
     }
 
     return 0;
@@ -165,7 +245,8 @@ int32_t read_radar_data(uint16_t* data, uint32_t *num_samples, uint32_t samples_
 * Function Name: reconf_radar
 ********************************************************************************
 * Summary:
-* This is the function for radar reconfiguration
+* This is the function for radar reconfiguration. The low frame rate profile
+* reads the requested number of coalesced frames per interrupt.
 *
 * Parameters:
 *  requested: Choosed configuration
@@ -176,11 +257,18 @@ int32_t read_radar_data(uint16_t* data, uint32_t *num_samples, uint32_t samples_
 *******************************************************************************/
 void reconf_radar(optimization_type_e requested)
 {
+    uint32_t frames = 1U;
+
     if (requested == CONFIG_UNINITIALIZED)
     {
         return;
     }
 
+    if (requested == CONFIG_LOW_FRAME_RATE_OPT)
+    {
+        frames = frame_coalescing_get_frames();
+    }
+
     if (xensiv_bgt60trxx_config(&bgt60_obj.dev,
             optimizations_list[requested].reg_list,
             optimizations_list[requested].reg_list_size) != CY_RSLT_SUCCESS)
@@ -190,12 +278,24 @@ void reconf_radar(optimization_type_e requested)
     }
 
     if (xensiv_bgt60trxx_set_fifo_limit(&bgt60_obj.dev,
-            optimizations_list[requested].fifo_limit) != CY_RSLT_SUCCESS)
+            optimizations_list[requested].fifo_limit * frames) != CY_RSLT_SUCCESS)
     {
         printf("[MSG] ERROR: xensiv_bgt60trxx set fifo limit failed\n");
         CY_ASSERT(0);
     }
 
+    coalesced_frames = frames;
+    frame_period_ms = (uint32_t)(optimizations_list[requested].frame_period_s * 1000.0f);
+    frame_coalescing_set_active((requested == CONFIG_LOW_FRAME_RATE_OPT) ? frames : 0U);
+
+    /* the slow time filters are redesigned for the new frame rate */
+    vTaskSuspendAll();
+    (void)slow_time_filter_set_frame_period(slow_time_filter_get_live(),
+                                            optimizations_list[requested].frame_period_s);
+    xTaskResumeAll();
+
+    frame_deadline_set_period(optimizations_list[requested].frame_period_s);
+
     if (xensiv_bgt60trxx_start_frame(&bgt60_obj.dev, true) != CY_RSLT_SUCCESS)
     {
         printf("[MSG] ERROR: xensiv_bgt60trxx_start_frame failed\n");
@@ -232,6 +332,12 @@ int main(void)
     /* Enable global interrupts */
     __enable_irq();
 
+    /* The cycle counter times the kernels of the frame path */
+    benchmark_init(NUM_CHIRPS_PER_FRAME, NUM_SAMPLES_PER_CHIRP, NUM_RX_ANTENNAS, MACRO_FFT_BUFF_SIZE);
+
+    /* Frames must be processed before the next one arrives */
+    frame_deadline_init(XENSIV_BGT60TRXX_CONF_FRAME_REPETITION_TIME_S);
+
     /* Initialize retarget-io to use the debug UART port */
     cy_retarget_io_init(CYBSP_DEBUG_UART_TX, CYBSP_DEBUG_UART_RX, CY_RETARGET_IO_BAUDRATE);
 
@@ -243,7 +349,7 @@ int main(void)
 #endif
 
     mgr.in_read_radar_data = read_radar_data;
-    radar_data_manager_init(&mgr, NUM_SAMPLES_PER_FRAME *6, NUM_SAMPLES_PER_FRAME *2);
+    radar_data_manager_init(&mgr, RDM_BUFFER_SIZE, NUM_SAMPLES_PER_FRAME *2);
     radar_data_manager_set_malloc_free(pvPortMalloc,
             vPortFree);
 
@@ -262,6 +368,12 @@ int main(void)
         CY_ASSERT(0);
     }
 
+    /* CPU load, stack and heap statistics of all tasks */
+    if (task_stats_init() != 0)
+    {
+        CY_ASSERT(0);
+    }
+
     /* Start the FreeRTOS scheduler. */
     vTaskStartScheduler();
 
@@ -279,7 +391,11 @@ int main(void)
 *    4. Initializes the radar device
 *    5. In an infinite loop
 *       - Waits for interrupt from radar device indicating availability of data
-*       - Reads the data, converts it to floating point and notifies the processing task
+*       - Reads the data, converts it to floating point, runs the slow time filter
+*         bank, removes the background clutter and notifies the processing task
+*         unless the frame change gate finds an empty scene unchanged
+*       - A burst of coalesced frames is handed over one frame at a time, each
+*         with the time it was acquired
 * Parameters:
 *  void
 *
@@ -294,6 +410,10 @@ static __NO_RETURN void main_task(void *pvParameters)
     uint16_t *data_buff = NULL;
     cy_rslt_t result;
     XENSIV_RADAR_PRESENCE_TIMESTAMP last_timestamp = 0;
+    XENSIV_RADAR_PRESENCE_TIMESTAMP now_ms;
+    uint32_t num_slots;
+    uint32_t start_cycles;
+    bool process;
 
     timer_handler = xTimerCreate("timer", pdMS_TO_TICKS(1000), pdTRUE, NULL, timer_callbak);    
     if (timer_handler == NULL)
@@ -306,11 +426,56 @@ static __NO_RETURN void main_task(void *pvParameters)
         CY_ASSERT(0);
     }
 
+    if (slow_time_filter_init(slow_time_filter_get_live(), NUM_SAMPLES_PER_CHIRP,
+                              XENSIV_BGT60TRXX_CONF_FRAME_REPETITION_TIME_S) != 0)
+    {
+        CY_ASSERT(0);
+    }
+
+    if (flash_storage_init() != 0)
+    {
+        CY_ASSERT(0);
+    }
+
+    /* the run time counter for the active time is started with the scheduler */
+    if (frame_coalescing_init(COALESCING_MAX_FRAMES) != 0)
+    {
+        CY_ASSERT(0);
+    }
+
+    if ((clutter_map_init(clutter_map_get_live(), NUM_SAMPLES_PER_CHIRP) != 0) ||
+        (clutter_map_start_autosave(clutter_map_get_live()) != 0))
+    {
+        CY_ASSERT(0);
+    }
+
+#if (NUM_RX_ANTENNAS > 1)
+    if (radar_rx_combiner_init(radar_rx_combiner_get_live(), NUM_RX_ANTENNAS, NUM_SAMPLES_PER_CHIRP) != 0)
+    {
+        CY_ASSERT(0);
+    }
+#endif
+
+    if (frame_change_gate_init(frame_change_gate_get_live(), NUM_SAMPLES_PER_CHIRP) != 0)
+    {
+        CY_ASSERT(0);
+    }
+
     if (xTaskCreate(processing_task, PROCESSING_TASK_NAME, PROCESSING_TASK_STACK_SIZE, NULL, PROCESSING_TASK_PRIORITY, &processing_task_handler) != pdPASS)
     {
         CY_ASSERT(0);
     }
 
+    if (xTaskCreate(raw_stream_task, RAW_STREAM_TASK_NAME, RAW_STREAM_TASK_STACK_SIZE, NULL, RAW_STREAM_TASK_PRIORITY, &raw_stream_task_handler) != pdPASS)
+    {
+        CY_ASSERT(0);
+    }
+
+    if (raw_stream_init(raw_stream_task_handler, NUM_CHIRPS_PER_FRAME, NUM_SAMPLES_PER_CHIRP, NUM_RX_ANTENNAS) != 0)
+    {
+        CY_ASSERT(0);
+    }
+
     if (init_sensor() != 0)
     {
         CY_ASSERT(0);
@@ -337,42 +502,130 @@ static __NO_RETURN void main_task(void *pvParameters)
     {
         /* Wait for the GPIO interrupt to indicate that another slice is available */
         ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-        mgr.read_from_buffer(1, &data_buff, &sz);
+        now_ms = xTaskGetTickCount() * portTICK_PERIOD_MS;
+        num_slots = 0U;
 
-        /* Data preprocessing */
-        uint16_t *bgt60_buffer_ptr = data_buff;
-        float32_t *frame_ptr = &frame[0];
-        for (int32_t sample = 0; sample < NUM_SAMPLES_PER_FRAME * 2; ++sample)
+        /* count the slots of the burst, there is one per coalesced frame */
+        while (mgr.read_slot(1, num_slots, &data_buff, &sz) == 0)
         {
-            *frame_ptr++ = ((float32_t)(*bgt60_buffer_ptr++) / 4096.0F);
+            num_slots++;
         }
 
-        mgr.ack_data_read(1);
+        for (uint32_t slot = 0U; slot < num_slots; slot++)
+        {
+            start_cycles = benchmark_get_cycles();
+            mgr.read_slot(1, slot, &data_buff, &sz);
+            benchmark_probe_add(BENCHMARK_PROBE_RDM_READ, benchmark_get_cycles() - start_cycles);
+            frame_deadline_begin();
 
-        /* calculate the average of the chirps first */
-        arm_fill_f32(0, avg_chirp, NUM_SAMPLES_PER_CHIRP);
+            /* the frames of a burst were acquired one frame period apart */
+            frame_timestamp = now_ms - ((num_slots - 1U - slot) * frame_period_ms);
 
-        for (int chirp = 0; chirp < NUM_CHIRPS_PER_FRAME * 2; chirp++)
-        {
-            arm_add_f32(avg_chirp, &frame[NUM_SAMPLES_PER_CHIRP * chirp], avg_chirp, NUM_SAMPLES_PER_CHIRP);
-        }
+            /* the FIFO samples are only valid until the buffer is released */
+            if (frame_deadline_get_level() < FRAME_DEADLINE_LEVEL_NO_TELEMETRY)
+            {
+                raw_stream_capture(data_buff, frame_timestamp);
+            }
 
-        arm_scale_f32(avg_chirp, 1.0f / NUM_CHIRPS_PER_FRAME, avg_chirp, NUM_SAMPLES_PER_CHIRP);
+#if (NUM_RX_ANTENNAS > 1)
+            /* Data preprocessing, one contiguous block per antenna */
+            radar_rx_deinterleave(data_buff, rx_frame, NUM_RX_ANTENNAS,
+                                  NUM_CHIRPS_PER_FRAME * NUM_SAMPLES_PER_CHIRP);
 
-        if(ce_app_state.last_reported_event.timestamp != last_timestamp)
-        {
-            last_timestamp = ce_app_state.last_reported_event.timestamp; // save latest timestamp
-            result = radar_config_optimize(ce_app_state.last_reported_event.state);
-            if(result != ESTATUS_SUCCESS)
+            /* the burst is released with its last frame */
+            if (slot == (num_slots - 1U))
+            {
+                start_cycles = benchmark_get_cycles();
+                mgr.ack_data_read(1);
+                benchmark_probe_add(BENCHMARK_PROBE_RDM_ACK, benchmark_get_cycles() - start_cycles);
+            }
+
+            radar_rx_average_chirps(rx_frame, rx_avg_chirp, NUM_RX_ANTENNAS,
+                                    NUM_CHIRPS_PER_FRAME, NUM_SAMPLES_PER_CHIRP);
+
+            /* the presence algorithm is fed with the phase aligned combination of all antennas */
+            radar_rx_combine(radar_rx_combiner_get_live(), rx_avg_chirp, avg_chirp, frame_timestamp);
+#else
+            /* Data preprocessing, the conversion is the single antenna case of the de-interleaving */
+            radar_rx_deinterleave(data_buff, frame, 1U, NUM_SAMPLES_PER_FRAME * 2);
+
+            /* the burst is released with its last frame */
+            if (slot == (num_slots - 1U))
+            {
+                start_cycles = benchmark_get_cycles();
+                mgr.ack_data_read(1);
+                benchmark_probe_add(BENCHMARK_PROBE_RDM_ACK, benchmark_get_cycles() - start_cycles);
+            }
+
+            /* calculate the average of the chirps first */
+            arm_fill_f32(0, avg_chirp, NUM_SAMPLES_PER_CHIRP);
+
+            for (int chirp = 0; chirp < NUM_CHIRPS_PER_FRAME * 2; chirp++)
+            {
+                arm_add_f32(avg_chirp, &frame[NUM_SAMPLES_PER_CHIRP * chirp], avg_chirp, NUM_SAMPLES_PER_CHIRP);
+            }
+
+            arm_scale_f32(avg_chirp, 1.0f / NUM_CHIRPS_PER_FRAME, avg_chirp, NUM_SAMPLES_PER_CHIRP);
+#endif
+
+            if(ce_app_state.last_reported_event.timestamp != last_timestamp)
+            {
+                last_timestamp = ce_app_state.last_reported_event.timestamp; // save latest timestamp
+                result = radar_config_optimize(ce_app_state.last_reported_event.state);
+                if(result != ESTATUS_SUCCESS)
+                {
+                    printf("[MSG] ERROR: radar_config_optimize failed with error %" PRIi32 "\n", result);
+                    CY_ASSERT(0);
+                }
+            }
+
+            /* Tell processing task to take over once the filter bank has an output */
+            process = slow_time_filter_process(slow_time_filter_get_live(), avg_chirp, presence_chirp);
+
+            if (process)
+            {
+                bool empty = (ce_app_state.last_reported_event.state == XENSIV_RADAR_PRESENCE_STATE_ABSENCE);
+
+                /* the background is only learned while the scene is empty */
+                clutter_map_process(clutter_map_get_live(), presence_chirp, empty, frame_timestamp);
+
+                /* an empty scene is only watched for macro movement, unchanged frames are not processed.
+                 * A pending configuration passes the next frame, so its writer is not held up */
+                process = frame_change_gate_process(frame_change_gate_get_live(), presence_chirp,
+                                                    empty && (radar_config_get_current_optimization() == CONFIG_LOW_FRAME_RATE_OPT) &&
+                                                    !presence_config_stage_is_pending());
+            }
+
+            if (process)
             {
-                printf("[MSG] ERROR: radar_config_optimize failed with error %" PRIi32 "\n", result);
-                CY_ASSERT(0);
+                frame_coalescing_clear_processed();
+                xTaskNotifyGive(processing_task_handler);
+
+                /* a batch is caught up one frame at a time, the processing shares the chirp buffers */
+                if (slot < (num_slots - 1U))
+                {
+                    (void)frame_coalescing_wait_processed();
+                }
+            }
+            else
+            {
+                /* decimated and unchanged frames end here */
+                frame_deadline_end();
             }
         }
 
-        /* Tell processing task to take over */
-        xTaskNotifyGive(processing_task_handler);
+        frame_coalescing_update();
+
+        /* coalesced and decimated frames delay the next frame boundary of the processing task */
+        presence_config_stage_set_interval(frame_period_ms * coalesced_frames *
+                                           slow_time_filter_get_config(slow_time_filter_get_live())->decimation);
 
+        /* a new coalescing setting is applied between two bursts */
+        if ((radar_config_get_current_optimization() == CONFIG_LOW_FRAME_RATE_OPT) &&
+            (frame_coalescing_get_frames() != coalesced_frames))
+        {
+            reconf_radar(CONFIG_LOW_FRAME_RATE_OPT);
+        }
     }
 }
 
@@ -399,17 +652,68 @@ static __NO_RETURN void processing_task(void *pvParameters)
     (void)pvParameters;
 
     xensiv_radar_presence_handle_t handle;
+    xensiv_radar_presence_config_t config = default_config;
     cy_rslt_t result;
 
+    /* Settings changed through the CLI before the last reset override the defaults */
+    if (config_store_init() != 0)
+    {
+        CY_ASSERT(0);
+    }
+
+    config_store_apply(&config);
+
     xensiv_radar_presence_set_malloc_free(pvPortMalloc,
                                           vPortFree);
 
-    if (xensiv_radar_presence_alloc(&handle, &default_config) != 0)
+    if (xensiv_radar_presence_alloc(&handle, &config) != 0)
+    {
+        CY_ASSERT(0);
+    }
+
+    presence_event_log_init();
+
+    if (occupancy_store_init() != 0)
     {
         CY_ASSERT(0);
     }
 
     xensiv_radar_presence_set_callback(handle, presence_detection_cb, NULL);
+
+    range_gate_init(MACRO_FFT_BUFF_SIZE);
+    range_gate_update(&config);
+
+    if (presence_tracker_init(presence_tracker_get_live(), MACRO_FFT_BUFF_SIZE,
+                              xensiv_radar_presence_get_bin_length(handle)) != 0)
+    {
+        CY_ASSERT(0);
+    }
+
+    if (presence_cfar_init(presence_cfar_get_live(), MACRO_FFT_BUFF_SIZE) != 0)
+    {
+        CY_ASSERT(0);
+    }
+
+    if (presence_vital_signs_init(presence_vital_signs_get_live()) != 0)
+    {
+        CY_ASSERT(0);
+    }
+
+#if AOA_ENABLED
+    if (radar_aoa_init(radar_aoa_get_live(), NUM_SAMPLES_PER_CHIRP, config.bandwidth,
+                       xensiv_radar_presence_get_bin_length(handle)) != 0)
+    {
+        CY_ASSERT(0);
+    }
+#endif
+
+    apply_stored_settings();
+
+    if (presence_config_stage_init(&config) != 0)
+    {
+        CY_ASSERT(0);
+    }
+
     result = radar_config_optimizer_init(reconf_radar);
 
     if(result != ESTATUS_SUCCESS)
@@ -418,7 +722,7 @@ static __NO_RETURN void processing_task(void *pvParameters)
         CY_ASSERT(0);
     }
 
-    result = radar_config_optimizer_set_operational_mode(default_config.mode);
+    result = radar_config_optimizer_set_operational_mode(config.mode);
 
     if(result != ESTATUS_SUCCESS)
     {
@@ -433,14 +737,147 @@ static __NO_RETURN void processing_task(void *pvParameters)
 
     for(;;)
     {
-        /* Wait for frame data available to process */
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-        xensiv_radar_presence_process_frame(handle, avg_chirp, xTaskGetTickCount() * portTICK_PERIOD_MS);
-        process_verbose_cmd(handle, xTaskGetTickCount() * portTICK_PERIOD_MS);
+        /* Wait for frame data available to process, more than one notification means frames were overwritten */
+        presence_config_stage_count_frames(ulTaskNotifyTake(pdTRUE, portMAX_DELAY));
+
+        /* configuration changes are applied between two frames */
+        apply_degradation_level();
+        apply_staged_config(handle);
+#if AOA_ENABLED
+        /* angles are estimated first so that the presence events can report them,
+         * the background of the antennas is only learned while the scene is empty */
+        radar_aoa_process(radar_aoa_get_live(), rx_avg_chirp, NUM_RX_ANTENNAS, range_gate_get(),
+                          (ce_app_state.last_reported_event.state == XENSIV_RADAR_PRESENCE_STATE_ABSENCE),
+                          frame_timestamp, &aoa_result);
+#endif
+        xensiv_radar_presence_process_frame(handle, presence_chirp, frame_timestamp);
+        process_tracks(handle, frame_timestamp);
+        process_cfar(handle, frame_timestamp);
+        process_vital_signs(handle, frame_timestamp);
+        process_verbose_cmd(handle, frame_timestamp);
+        occupancy_store_update(frame_timestamp);
+        frame_deadline_end();
+        frame_coalescing_frame_processed();
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: apply_stored_settings
+********************************************************************************
+* Summary:
+* This function restores the settings of the application stages from the
+* configuration store. Settings of the presence algorithm are applied before
+* its allocation by config_store_apply.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void apply_stored_settings(void)
+{
+    uint32_t value;
+    float32_t threshold;
+    float32_t highpass_hz;
+    float32_t lowpass_hz;
+
+    if (config_store_get_u32(CONFIG_KEY_RANGE_GATE, &value))
+    {
+        range_gate_enable(value != 0U);
+    }
+
+    if (config_store_get_u32(CONFIG_KEY_AUTO_THRESHOLD, &value))
+    {
+        presence_cfar_set_auto(value != 0U);
+    }
+
+    if (config_store_get_u32(CONFIG_KEY_CFAR_MODE, &value))
+    {
+        presence_cfar_set_mode((presence_cfar_mode_e)value);
+    }
+
+    if (config_store_get_u32(CONFIG_KEY_VITAL_SIGNS, &value))
+    {
+        presence_vital_signs_enable(presence_vital_signs_get_live(), value != 0U);
+    }
+
+    if (config_store_get_float(CONFIG_KEY_CHANGE_GATE, &threshold))
+    {
+        (void)frame_change_gate_set_threshold(threshold);
+    }
+
+    if (config_store_get_float(CONFIG_KEY_TRACKER_THRESHOLD, &threshold))
+    {
+        (void)presence_tracker_set_threshold(threshold);
+    }
+
+    /* the filter bank runs in the acquisition task */
+    vTaskSuspendAll();
+    if (config_store_get_float(CONFIG_KEY_FILTER_HIGHPASS, &highpass_hz) &&
+        config_store_get_float(CONFIG_KEY_FILTER_LOWPASS, &lowpass_hz))
+    {
+        (void)slow_time_filter_set_cutoff(slow_time_filter_get_live(), highpass_hz, lowpass_hz);
+    }
+
+    if (config_store_get_u32(CONFIG_KEY_FRAME_DECIMATION, &value))
+    {
+        (void)slow_time_filter_set_decimation(slow_time_filter_get_live(), value);
+    }
+    xTaskResumeAll();
+}
+
+
+/*******************************************************************************
+* Function Name: apply_staged_config
+********************************************************************************
+* Summary:
+* This function applies a configuration committed through the CLI or the auto
+* thresholds at a frame boundary and updates the application stages which
+* depend on it. The presence algorithm stays allocated and keeps reporting.
+*
+* Parameters:
+*  handle: presence algorithm handle
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void apply_staged_config(xensiv_radar_presence_handle_t handle)
+{
+    xensiv_radar_presence_config_t config;
+
+    if (presence_config_stage_apply(handle, &config))
+    {
+        range_gate_update(&config);
     }
 }
 
 
+/*******************************************************************************
+* Function Name: apply_degradation_level
+********************************************************************************
+* Summary:
+* This function forces the micro FFT decimation on while the frame deadline
+* governor asks for it. The configuration stage overlays it on the user
+* configuration without a reset of the algorithm, so the presence state is
+* kept and the setting of the user is in effect again afterwards.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void apply_degradation_level(void)
+{
+    presence_config_stage_force_micro_decimation(frame_deadline_get_level() >= FRAME_DEADLINE_LEVEL_MICRO_DECIMATION);
+}
+
+
 /*******************************************************************************
 * Function Name: presence_detection_cb
 ********************************************************************************
@@ -461,7 +898,19 @@ void presence_detection_cb(xensiv_radar_presence_handle_t handle,
     (void)handle;
     (void)data;
 
-    if (!ce_app_state.verbose)
+    /* timestamps count from the scheduler start, which is a few ms after reset. A first
+     * detection in the settings mode is not reported, the menu already held up the output */
+    if (!first_detection_reported && (event->state != XENSIV_RADAR_PRESENCE_STATE_ABSENCE))
+    {
+        first_detection_reported = true;
+        if (!ce_app_state.settings_mode)
+        {
+            printf("[INFO] boot to first detection %" PRIu32 " ms\n", event->timestamp);
+        }
+    }
+
+    /* LEDs and reports are frozen while the settings are changed, the state is still tracked */
+    if (!ce_app_state.verbose && !ce_app_state.settings_mode)
     {
         switch (event->state)
         {
@@ -471,6 +920,9 @@ void presence_detection_cb(xensiv_radar_presence_handle_t handle,
                 printf("[INFO] macro presence %" PRIi32 " %" PRIi32 "\n",
                         event->range_bin,
                         event->timestamp);
+#if AOA_ENABLED
+                print_aoa(event->range_bin, event->timestamp);
+#endif
                 break;
 
             case XENSIV_RADAR_PRESENCE_STATE_MICRO_PRESENCE:
@@ -479,6 +931,10 @@ void presence_detection_cb(xensiv_radar_presence_handle_t handle,
                 printf("[INFO] micro presence %" PRIi32 " %" PRIi32 "\n",
                         event->range_bin,
                         event->timestamp);
+#if AOA_ENABLED
+                print_aoa(event->range_bin, event->timestamp);
+#endif
+                print_vital_signs(event->timestamp);
                 break;
 
             case XENSIV_RADAR_PRESENCE_STATE_ABSENCE:
@@ -494,11 +950,44 @@ void presence_detection_cb(xensiv_radar_presence_handle_t handle,
 
     }
 
-    /* save the last reported event state */
+    /* save the last reported event state, the history is kept in the event log */
     ce_app_state.last_reported_event = *event;
+    presence_event_log_add(event);
+    occupancy_store_add_event(event);
 }
 
 
+#if AOA_ENABLED
+/*******************************************************************************
+* Function Name: print_aoa
+********************************************************************************
+* Summary:
+* This function prints the angle of arrival of the target closest to the
+* reported range bin.
+* Parameters:
+*  range_bin: range bin of the presence event
+*  time_ms: timestamp of the presence event
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void print_aoa(int32_t range_bin, XENSIV_RADAR_PRESENCE_TIMESTAMP time_ms)
+{
+    const radar_aoa_target_s *target = radar_aoa_find_target(&aoa_result, range_bin);
+
+    if (target != NULL)
+    {
+        printf("[AOA] %" PRIi32 " %f %f %" PRIu32 "\n",
+                target->range_bin,
+                target->azimuth,
+                target->elevation,
+                time_ms);
+    }
+}
+#endif
+
+
 /*******************************************************************************
 * Function Name: init_sensor
 ********************************************************************************
@@ -607,7 +1096,12 @@ static void xensiv_bgt60trxx_interrupt_handler(void *args, cyhal_gpio_irq_event_
     CY_UNUSED_PARAMETER(args);
     CY_UNUSED_PARAMETER(event);
 
+    frame_deadline_irq();
+    frame_coalescing_wakeup();
+
+    uint32_t start_cycles = benchmark_get_cycles();
     mgr.run(true);
+    benchmark_probe_add(BENCHMARK_PROBE_RDM_RUN, benchmark_get_cycles() - start_cycles);
 }
 
 
@@ -659,7 +1153,8 @@ void process_verbose_cmd(xensiv_radar_presence_handle_t handle,
     float32_t energy = 0;
     int range_bin = 0;
 
-    if (ce_app_state.verbose == false)
+    /* the verbose output is the first work shed under overload */
+    if ((ce_app_state.verbose == false) || (frame_deadline_get_level() >= FRAME_DEADLINE_LEVEL_NO_VERBOSE))
     {
         return;
     }
@@ -697,14 +1192,19 @@ void process_verbose_cmd(xensiv_radar_presence_handle_t handle,
         }
 
         const cfloat32_t *macro_fft_buff = xensiv_radar_presence_get_macro_fft_buffer(handle);
+        const range_gate_s *gate = range_gate_get();
+
+        /* Only the bins inside the range gate are computed, the others are reported as zero */
+        arm_fill_f32(0, macro_fft_mag, MACRO_FFT_BUFF_SIZE);
+        arm_cmplx_mag_f32((const float32_t*)&macro_fft_buff[gate->first_bin],
+                          &macro_fft_mag[gate->first_bin],
+                          gate->num_bins);
 
         printf("[MACRO_FFT] %lu",(unsigned long)time_ms);
 
         for(int i = 0; i< MACRO_FFT_BUFF_SIZE; i++)
         {
-            float zero[2] = { 0.f, 0.f};
-
-            printf("%lf ", arm_euclidean_distance_f32((float*)&macro_fft_buff[i], zero, 2));
+            printf("%lf ", macro_fft_mag[i]);
         }
 
         printf("\n");
@@ -715,6 +1215,48 @@ void process_verbose_cmd(xensiv_radar_presence_handle_t handle,
         xensiv_radar_presence_get_max_micro(handle, &energy, &range_bin);
         printf("[MICRO] %d %lf %lu\n", range_bin, energy, (unsigned long) time_ms);
 
+        const presence_tracks_s *tracks = presence_tracker_get_tracks(presence_tracker_get_live());
+        for (uint32_t i = 0; i < tracks->count; i++)
+        {
+            if (presence_tracker_is_confirmed(presence_tracker_get_live(), i))
+            {
+                printf("[TRACK] %u %f %f %lu\n",
+                        (unsigned int)tracks->id[i],
+                        tracks->range[i],
+                        tracks->velocity[i],
+                        (unsigned long)time_ms);
+            }
+        }
+
+        print_vital_signs(time_ms);
+
+        const presence_cfar_stats_s *cfar_stats = presence_cfar_get_stats(presence_cfar_get_live());
+        printf("[CFAR] %lu %lu %lu %lu\n",
+                (unsigned long)cfar_stats->detections,
+                (unsigned long)cfar_stats->false_alarms,
+                (unsigned long)cfar_stats->absence_frames,
+                (unsigned long)time_ms);
+
+        if (task_stats_get(&load_stats))
+        {
+            printf("[LOAD] %f %lu %lu %lu\n",
+                    (float32_t)load_stats.load_permille / 10.0f,
+                    (unsigned long)load_stats.heap_free,
+                    (unsigned long)load_stats.heap_min_free,
+                    (unsigned long)time_ms);
+        }
+
+#if AOA_ENABLED
+        for (uint32_t i = 0; i < aoa_result.num_targets; i++)
+        {
+            printf("[AOA] %" PRIi32 " %f %f %lu\n",
+                    aoa_result.targets[i].range_bin,
+                    aoa_result.targets[i].azimuth,
+                    aoa_result.targets[i].elevation,
+                    (unsigned long)time_ms);
+        }
+#endif
+
         ce_app_state.bookmark_timestamp = time_ms;
 
         print_job_locked = false;
@@ -722,6 +1264,196 @@ void process_verbose_cmd(xensiv_radar_presence_handle_t handle,
 }
 
 
+/*******************************************************************************
+ * Function Name: process_tracks
+ ********************************************************************************
+ * Summary:
+ * This function runs the multi-target tracker on the latest macro FFT buffer
+ * and reports changes of the number of people. The reported presence state
+ * keeps the tracks of people who sit still.
+ *
+ * Parameters:
+ *  handle: presence algorithm handle
+ *  time_ms: timestamp of the frame
+ *
+ * Return:
+ *  none
+ *
+ *******************************************************************************/
+static void process_tracks(xensiv_radar_presence_handle_t handle,
+        XENSIV_RADAR_PRESENCE_TIMESTAMP time_ms)
+{
+    uint32_t people_count;
+
+    presence_tracker_process(presence_tracker_get_live(),
+                             xensiv_radar_presence_get_macro_fft_buffer(handle),
+                             range_gate_get(),
+                             ce_app_state.last_reported_event.state,
+                             ce_app_state.last_reported_event.range_bin,
+                             time_ms);
+
+    people_count = presence_tracker_get_count(presence_tracker_get_live());
+
+    if (people_count != ce_app_state.people_count)
+    {
+        ce_app_state.people_count = people_count;
+
+        if (!ce_app_state.verbose && !ce_app_state.settings_mode)
+        {
+            printf("[INFO] people count %" PRIu32 " %" PRIu32 "\n", people_count, time_ms);
+        }
+    }
+}
+
+
+/*******************************************************************************
+ * Function Name: process_cfar
+ ********************************************************************************
+ * Summary:
+ * This function runs the CFAR detector on the latest macro FFT buffer. The
+ * detections are observe-only, they do not change the presence decision. If auto
+ * thresholds are enabled, the macro and micro thresholds of the presence
+ * algorithm follow the learned noise floor. The update is rate limited and
+ * staged, so it is applied at the next frame boundary without a reset.
+ *
+ * Parameters:
+ *  handle: presence algorithm handle
+ *  time_ms: timestamp of the frame
+ *
+ * Return:
+ *  none
+ *
+ *******************************************************************************/
+static void process_cfar(xensiv_radar_presence_handle_t handle,
+        XENSIV_RADAR_PRESENCE_TIMESTAMP time_ms)
+{
+    float32_t energy = 0;
+    int range_bin = 0;
+    float32_t macro_threshold;
+    float32_t micro_threshold;
+    xensiv_radar_presence_config_t config;
+
+    xensiv_radar_presence_get_max_micro(handle, &energy, &range_bin);
+    presence_cfar_process(presence_cfar_get_live(),
+                          xensiv_radar_presence_get_macro_fft_buffer(handle),
+                          range_gate_get(),
+                          ce_app_state.last_reported_event.state,
+                          energy);
+
+    if (!presence_cfar_get_auto() || ((time_ms - cfar_auto_timestamp) < CFAR_AUTO_UPDATE_MS))
+    {
+        return;
+    }
+
+    cfar_auto_timestamp = time_ms;
+
+    presence_config_stage_get(&config);
+
+    if (!presence_cfar_get_auto_thresholds(presence_cfar_get_live(),
+                                           config.min_range_bin, config.max_range_bin,
+                                           &macro_threshold, &micro_threshold))
+    {
+        return;
+    }
+
+    macro_threshold = fmaxf(MACRO_THRESHOLD_MIN_LIMIT, fminf(macro_threshold, MACRO_THRESHOLD_MAX_LIMIT));
+    micro_threshold = fmaxf(MICRO_THRESHOLD_MIN_LIMIT, fminf(micro_threshold, MICRO_THRESHOLD_MAX_LIMIT));
+
+    if ((fabsf(macro_threshold - config.macro_threshold) <= (CFAR_AUTO_HYSTERESIS * config.macro_threshold)) &&
+        (fabsf(micro_threshold - config.micro_threshold) <= (CFAR_AUTO_HYSTERESIS * config.micro_threshold)))
+    {
+        return;
+    }
+
+    config.macro_threshold = macro_threshold;
+    config.micro_threshold = micro_threshold;
+
+    /* thresholds take effect on the next frame, no reset of the algorithm state is needed */
+    presence_config_stage_commit(&config, false);
+
+    if (!ce_app_state.settings_mode)
+    {
+        printf("[CONFIG] auto thresholds %f %f %" PRIu32 "\n", macro_threshold, micro_threshold, time_ms);
+    }
+}
+
+
+/*******************************************************************************
+ * Function Name: process_vital_signs
+ ********************************************************************************
+ * Summary:
+ * This function feeds the phase of the reported range bin into the breathing
+ * rate estimation while micro presence is reported inside the range gate. Any other state clears the
+ * history, as the phase is dominated by body movement then. Outside of verbose
+ * mode the breathing rate is reported periodically.
+ *
+ * Parameters:
+ *  handle: presence algorithm handle
+ *  time_ms: timestamp of the frame
+ *
+ * Return:
+ *  none
+ *
+ *******************************************************************************/
+static void process_vital_signs(xensiv_radar_presence_handle_t handle,
+        XENSIV_RADAR_PRESENCE_TIMESTAMP time_ms)
+{
+    if (!presence_vital_signs_is_enabled(presence_vital_signs_get_live()))
+    {
+        return;
+    }
+
+    /* like the other per range bin stages, bins outside the range gate are not processed */
+    if ((ce_app_state.last_reported_event.state != XENSIV_RADAR_PRESENCE_STATE_MICRO_PRESENCE) ||
+        !range_gate_contains(range_gate_get(), ce_app_state.last_reported_event.range_bin))
+    {
+        presence_vital_signs_reset(presence_vital_signs_get_live());
+        return;
+    }
+
+    presence_vital_signs_process(presence_vital_signs_get_live(),
+                                 xensiv_radar_presence_get_macro_fft_buffer(handle),
+                                 ce_app_state.last_reported_event.range_bin,
+                                 time_ms);
+
+    if (!ce_app_state.verbose && !ce_app_state.settings_mode &&
+        (frame_deadline_get_level() < FRAME_DEADLINE_LEVEL_NO_TELEMETRY) &&
+        ((time_ms - vital_report_timestamp) >= VITAL_REPORT_MS))
+    {
+        vital_report_timestamp = time_ms;
+        print_vital_signs(time_ms);
+    }
+}
+
+
+/*******************************************************************************
+ * Function Name: print_vital_signs
+ ********************************************************************************
+ * Summary:
+ * This function prints the breathing rate if a valid estimate is available.
+ *
+ * Parameters:
+ *  time_ms: timestamp of the report
+ *
+ * Return:
+ *  none
+ *
+ *******************************************************************************/
+static void print_vital_signs(XENSIV_RADAR_PRESENCE_TIMESTAMP time_ms)
+{
+    presence_vital_signs_s vital;
+
+    if (presence_vital_signs_get(presence_vital_signs_get_live(), &vital))
+    {
+        printf("[VITAL] %" PRIi32 " %f %f %" PRIu32 "\n",
+                vital.range_bin,
+                vital.rate_bpm,
+                vital.confidence,
+                time_ms);
+    }
+}
+
+
 /*******************************************************************************
 * Function Name: timer_callbak
 ********************************************************************************
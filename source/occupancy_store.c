@@ -0,0 +1,761 @@
+/*****************************************************************************
+ * File name: occupancy_store.c
+ *
+ * Description: This file implements the per-minute occupancy history, an
+ *   append-only log of delta and varint encoded records in flash rows
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+#include "flash_storage.h"
+#include "occupancy_store.h"
+
+#define OCCUPANCY_STORE_MAGIC               (0x4F434355U) /* "OCCU" */
+
+/* Varint minute delta, occupancy, zigzag varint range bin delta, varint transitions */
+#define OCCUPANCY_RECORD_MAX_SIZE           (5U + 1U + 5U + 5U)
+
+/* Boot marker: varint minute offset from the segment start, the marker byte in
+ * place of the occupancy, varint boot number. The records after it count from
+ * its minute with a range bin code of 0. */
+#define OCCUPANCY_MARKER                    (0xFFU)
+#define OCCUPANCY_MARKER_MAX_SIZE           (5U + 1U + 3U)
+
+/* Without records, the minute index is written at most once a day */
+#define OCCUPANCY_STORE_IDLE_WRITE_MINUTES  (1440U)
+
+/* One segment per flash row, the segment with sequence s is kept in row s % rows.
+ * The open segment is written alternately to its row and to the shadow row
+ * after the ring, so a power loss during a write keeps the previous copy. */
+typedef struct
+{
+    uint32_t magic;
+    uint32_t crc;               /* over the rest of the header and the used payload */
+    uint32_t sequence;
+    uint32_t first_minute;
+    uint32_t last_minute;       /* last closed minute, first_minute - 1 if none */
+    uint16_t boot;              /* newest boot with records in the segment */
+    uint16_t length;            /* used payload in bytes */
+} occupancy_segment_header_s;
+
+typedef struct
+{
+    occupancy_segment_header_s header;
+    uint8_t payload[FLASH_STORAGE_ROW_SIZE - sizeof(occupancy_segment_header_s)];
+} occupancy_segment_s;
+
+typedef struct
+{
+    /* aggregates of the current minute, owned by the processing task */
+    uint32_t minute;
+    XENSIV_RADAR_PRESENCE_TIMESTAMP minute_end_ms;
+    XENSIV_RADAR_PRESENCE_TIMESTAMP since_ms;
+    uint32_t occupied_ms;
+    uint32_t transitions;
+    int32_t max_range_bin;
+    int32_t range_bin;
+    bool present;
+
+    /* encoder state of the open segment */
+    uint32_t last_record_minute;
+    uint32_t last_bin_code;
+    uint16_t boot;
+    bool marker_pending;
+
+    uint32_t num_rows;          /* rows of the ring, the shadow row follows them */
+    uint32_t written_minute;    /* last closed minute in flash */
+    bool open_in_shadow;        /* the shadow row holds the last written copy of the open segment */
+    bool dirty;
+    bool sealed_pending;
+    TimerHandle_t flush_timer;
+
+    occupancy_segment_s open;   /* write-back cache of the newest row */
+    occupancy_segment_s sealed; /* full segment waiting for the next flush */
+    occupancy_segment_s flush;  /* copy being programmed */
+    occupancy_segment_s read;   /* copy being decoded by a query */
+    uint32_t read_sequence;
+    bool read_cached;
+} occupancy_store_state_s;
+
+static occupancy_store_state_s store_state;
+
+/*******************************************************************************
+ * Function Name: occupancy_store_put_varint
+ ****************************************************************************//**
+ *
+ * @brief Encodes a value in 7 bit groups, least significant first. The top bit
+ * of a byte is set if more bytes follow.
+ *
+ * @param dst Destination, at least 5 bytes.
+ * @param value Value to encode.
+ *
+ * @return Number of bytes written.
+ *
+ *******************************************************************************/
+static uint32_t occupancy_store_put_varint(uint8_t *dst, uint32_t value)
+{
+    uint32_t size = 0U;
+
+    while (value >= 0x80U)
+    {
+        dst[size++] = (uint8_t)(value | 0x80U);
+        value >>= 7;
+    }
+
+    dst[size++] = (uint8_t)value;
+
+    return size;
+}
+
+/*******************************************************************************
+ * Function Name: occupancy_store_get_varint
+ ****************************************************************************//**
+ *
+ * @brief Decodes a value written by occupancy_store_put_varint.
+ *
+ * @param src Encoded data.
+ * @param len Number of bytes available.
+ * @param value Decoded value.
+ *
+ * @return Number of bytes consumed, 0 if the data is truncated or too long.
+ *
+ *******************************************************************************/
+static uint32_t occupancy_store_get_varint(const uint8_t *src, uint32_t len, uint32_t *value)
+{
+    uint32_t result = 0U;
+
+    for (uint32_t i = 0U; (i < len) && (i < 5U); i++)
+    {
+        result |= (uint32_t)(src[i] & 0x7FU) << (7U * i);
+
+        if ((src[i] & 0x80U) == 0U)
+        {
+            *value = result;
+            return i + 1U;
+        }
+    }
+
+    return 0U;
+}
+
+/*******************************************************************************
+ * Function Name: occupancy_store_crc
+ ****************************************************************************//**
+ *
+ * @param segment Segment.
+ *
+ * @return CRC of the header fields after the CRC and of the used payload.
+ *
+ *******************************************************************************/
+static uint32_t occupancy_store_crc(const occupancy_segment_s *segment)
+{
+    return flash_storage_crc32(&segment->header.sequence,
+                               (offsetof(occupancy_segment_s, payload) -
+                                offsetof(occupancy_segment_header_s, sequence)) +
+                               segment->header.length);
+}
+
+/*******************************************************************************
+ * Function Name: occupancy_store_is_valid
+ ****************************************************************************//**
+ *
+ * @param segment Segment read from flash.
+ *
+ * @return true if the segment is complete and not corrupted.
+ *
+ *******************************************************************************/
+static bool occupancy_store_is_valid(const occupancy_segment_s *segment)
+{
+    return (segment->header.magic == OCCUPANCY_STORE_MAGIC) &&
+           (segment->header.length <= sizeof(segment->payload)) &&
+           (segment->header.crc == occupancy_store_crc(segment));
+}
+
+/*******************************************************************************
+ * Function Name: occupancy_store_write
+ ****************************************************************************//**
+ *
+ * @brief Programs a segment into its flash row or into the shadow row.
+ *
+ * @param segment Segment, its CRC is updated.
+ * @param shadow true to write the shadow row.
+ *
+ * @return 0 on success, -1 on a flash error.
+ *
+ *******************************************************************************/
+static int32_t occupancy_store_write(occupancy_segment_s *segment, bool shadow)
+{
+    uint32_t row = shadow ? store_state.num_rows : (segment->header.sequence % store_state.num_rows);
+
+    segment->header.crc = occupancy_store_crc(segment);
+
+    return flash_storage_write(FLASH_STORAGE_OCCUPANCY, row * FLASH_STORAGE_ROW_SIZE, segment, sizeof(*segment));
+}
+
+/*******************************************************************************
+ * Function Name: occupancy_store_flush_callback
+ ****************************************************************************//**
+ *
+ * @brief Flush timer callback, writes the segments to flash.
+ *
+ * @param timer Flush timer.
+ *
+ *******************************************************************************/
+static void occupancy_store_flush_callback(TimerHandle_t timer)
+{
+    (void)timer;
+
+    if (occupancy_store_flush() != 0)
+    {
+        printf("[MSG] ERROR: occupancy store flush failed\n");
+    }
+}
+
+/*******************************************************************************
+ * Function Name: occupancy_store_append
+ ****************************************************************************//**
+ *
+ * @brief Appends the record of a closed minute to the open segment, after the
+ * boot marker if it is the first record of the boot or of the segment. A full
+ * segment is handed to the next flush and a new one is opened, its row holds
+ * the oldest segment which is dropped. Called with the scheduler suspended.
+ *
+ * @param occupancy Part of the minute with presence in percent.
+ *
+ *******************************************************************************/
+static void occupancy_store_append(uint32_t occupancy)
+{
+    occupancy_segment_header_s *header = &store_state.open.header;
+    uint32_t bin_code = (uint32_t)(store_state.max_range_bin + 1);
+    int32_t bin_delta;
+    uint32_t size = OCCUPANCY_RECORD_MAX_SIZE + (store_state.marker_pending ? OCCUPANCY_MARKER_MAX_SIZE : 0U);
+    uint8_t *dst;
+
+    if ((header->length + size) > sizeof(store_state.open.payload))
+    {
+        /* a full segment still unwritten here is lost, this takes a failing flash */
+        memcpy(&store_state.sealed, &store_state.open, sizeof(store_state.sealed));
+        store_state.sealed_pending = true;
+
+        header->sequence++;
+        header->first_minute = store_state.minute;
+        header->last_minute = store_state.minute - 1U;
+        header->length = 0U;
+        store_state.marker_pending = true;
+        store_state.open_in_shadow = true;
+    }
+
+    dst = &store_state.open.payload[header->length];
+
+    if (store_state.marker_pending)
+    {
+        dst += occupancy_store_put_varint(dst, store_state.minute - header->first_minute);
+        *dst++ = OCCUPANCY_MARKER;
+        dst += occupancy_store_put_varint(dst, store_state.boot);
+        header->boot = store_state.boot;
+        store_state.marker_pending = false;
+        store_state.last_record_minute = store_state.minute;
+        store_state.last_bin_code = 0U;
+    }
+
+    bin_delta = (int32_t)(bin_code - store_state.last_bin_code);
+
+    dst += occupancy_store_put_varint(dst, store_state.minute - store_state.last_record_minute);
+    *dst++ = (uint8_t)occupancy;
+    dst += occupancy_store_put_varint(dst, ((uint32_t)bin_delta << 1) ^ (uint32_t)(bin_delta >> 31));
+    dst += occupancy_store_put_varint(dst, store_state.transitions);
+
+    header->length = (uint16_t)(dst - store_state.open.payload);
+    store_state.last_record_minute = store_state.minute;
+    store_state.last_bin_code = bin_code;
+}
+
+/*******************************************************************************
+ * Function Name: occupancy_store_close_minute
+ ****************************************************************************//**
+ *
+ * @brief Stores the aggregates of the current minute and starts the next one.
+ *
+ *******************************************************************************/
+static void occupancy_store_close_minute(void)
+{
+    uint32_t occupancy;
+
+    if (store_state.present && ((int32_t)(store_state.minute_end_ms - store_state.since_ms) > 0))
+    {
+        store_state.occupied_ms += store_state.minute_end_ms - store_state.since_ms;
+        store_state.since_ms = store_state.minute_end_ms;
+    }
+
+    occupancy = ((store_state.occupied_ms * 100U) + (OCCUPANCY_STORE_MINUTE_MS / 2U)) / OCCUPANCY_STORE_MINUTE_MS;
+
+    if (occupancy > 100U)
+    {
+        occupancy = 100U;
+    }
+
+    vTaskSuspendAll();
+
+    /* minutes without presence are implied by the gaps */
+    if ((store_state.occupied_ms > 0U) || (store_state.transitions > 0U))
+    {
+        occupancy_store_append(occupancy);
+        store_state.dirty = true;
+    }
+
+    /* an empty room only moves the minute index, which is rarely worth a row erase */
+    store_state.open.header.last_minute = store_state.minute;
+    if ((store_state.minute - store_state.written_minute) >= OCCUPANCY_STORE_IDLE_WRITE_MINUTES)
+    {
+        store_state.dirty = true;
+    }
+    xTaskResumeAll();
+
+    store_state.minute++;
+    store_state.minute_end_ms += OCCUPANCY_STORE_MINUTE_MS;
+    store_state.occupied_ms = 0U;
+    store_state.transitions = 0U;
+    store_state.max_range_bin = store_state.present ? store_state.range_bin : -1;
+}
+
+/*******************************************************************************
+ * Function Name: occupancy_store_read
+ ****************************************************************************//**
+ *
+ * @brief Copies a segment into the read buffer of the queries. The open and
+ * the unwritten full segment are taken from RAM, the others from flash.
+ *
+ * @param sequence Sequence of the segment.
+ *
+ * @return 0 on success, -1 if the segment was overwritten or is corrupted.
+ *
+ *******************************************************************************/
+static int32_t occupancy_store_read(uint32_t sequence)
+{
+    const occupancy_segment_s *stored = (const occupancy_segment_s *)
+        &flash_storage_get_address(FLASH_STORAGE_OCCUPANCY)[(sequence % store_state.num_rows) * FLASH_STORAGE_ROW_SIZE];
+    bool from_flash = false;
+
+    /* copies from RAM are refreshed, the segments may have grown or moved to flash */
+    if (store_state.read_cached && (store_state.read_sequence == sequence))
+    {
+        return 0;
+    }
+
+    vTaskSuspendAll();
+
+    if (sequence == store_state.open.header.sequence)
+    {
+        memcpy(&store_state.read, &store_state.open, sizeof(store_state.read));
+    }
+    else if (store_state.sealed_pending && (sequence == store_state.sealed.header.sequence))
+    {
+        memcpy(&store_state.read, &store_state.sealed, sizeof(store_state.read));
+    }
+    else
+    {
+        memcpy(&store_state.read, stored, sizeof(store_state.read));
+        from_flash = true;
+    }
+
+    xTaskResumeAll();
+
+    if (from_flash && (!occupancy_store_is_valid(&store_state.read) ||
+                       (store_state.read.header.sequence != sequence)))
+    {
+        store_state.read_cached = false;
+        return -1;
+    }
+
+    store_state.read_sequence = sequence;
+    store_state.read_cached = from_flash;
+
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: occupancy_store_is_newer
+ ****************************************************************************//**
+ *
+ * @param segment Valid segment read from flash.
+ * @param newest Newest segment found so far, NULL if none.
+ *
+ * @return true if the segment has a later sequence, or the same sequence and
+ * later minutes.
+ *
+ *******************************************************************************/
+static bool occupancy_store_is_newer(const occupancy_segment_s *segment, const occupancy_segment_s *newest)
+{
+    return (newest == NULL) ||
+           ((int32_t)(segment->header.sequence - newest->header.sequence) > 0) ||
+           ((segment->header.sequence == newest->header.sequence) &&
+            ((int32_t)(segment->header.last_minute - newest->header.last_minute) > 0));
+}
+
+/*
+ * continue the newest stored segment, or open a new one after it, and create the flush timer
+ */
+int32_t occupancy_store_init(void)
+{
+    const uint8_t *base = flash_storage_get_address(FLASH_STORAGE_OCCUPANCY);
+    const occupancy_segment_s *newest = NULL;
+    const occupancy_segment_s *shadow;
+    occupancy_segment_header_s *header = &store_state.open.header;
+    uint32_t num_rows = flash_storage_get_size(FLASH_STORAGE_OCCUPANCY) / FLASH_STORAGE_ROW_SIZE;
+
+    memset(&store_state, 0, sizeof(store_state));
+
+    if (num_rows < 2U)
+    {
+        return -1;
+    }
+
+    store_state.num_rows = num_rows - 1U;
+    shadow = (const occupancy_segment_s *)&base[store_state.num_rows * FLASH_STORAGE_ROW_SIZE];
+
+    for (uint32_t row = 0U; row < store_state.num_rows; row++)
+    {
+        const occupancy_segment_s *segment = (const occupancy_segment_s *)&base[row * FLASH_STORAGE_ROW_SIZE];
+
+        if (occupancy_store_is_valid(segment) &&
+            ((segment->header.sequence % store_state.num_rows) == row) &&
+            occupancy_store_is_newer(segment, newest))
+        {
+            newest = segment;
+        }
+    }
+
+    /* the shadow row holds the open segment if its last write went there */
+    store_state.open_in_shadow = occupancy_store_is_valid(shadow) && occupancy_store_is_newer(shadow, newest);
+    if (store_state.open_in_shadow)
+    {
+        newest = shadow;
+    }
+
+    header->magic = OCCUPANCY_STORE_MAGIC;
+
+    if (newest != NULL)
+    {
+        store_state.boot = newest->header.boot + 1U;
+
+        if ((newest->header.length + OCCUPANCY_MARKER_MAX_SIZE + OCCUPANCY_RECORD_MAX_SIZE) <=
+            sizeof(store_state.open.payload))
+        {
+            /* a boot appends to the newest segment, so resets do not use up rows */
+            memcpy(&store_state.open, newest, sizeof(store_state.open));
+        }
+        else
+        {
+            if (store_state.open_in_shadow)
+            {
+                /* the full segment still has to reach its own row */
+                memcpy(&store_state.sealed, newest, sizeof(store_state.sealed));
+                store_state.sealed_pending = true;
+            }
+
+            /* the time the device was off is not counted */
+            header->sequence = newest->header.sequence + 1U;
+            header->first_minute = newest->header.last_minute + 1U;
+            header->last_minute = newest->header.last_minute;
+            header->boot = newest->header.boot;
+            store_state.open_in_shadow = true;
+        }
+    }
+    else
+    {
+        header->last_minute = header->first_minute - 1U;
+        store_state.open_in_shadow = true;
+    }
+
+    /* timestamps count from the scheduler start */
+    store_state.minute = header->last_minute + 1U;
+    store_state.written_minute = header->last_minute;
+    store_state.minute_end_ms = OCCUPANCY_STORE_MINUTE_MS;
+    store_state.max_range_bin = -1;
+    store_state.marker_pending = true;
+
+    store_state.flush_timer = xTimerCreate("occupancy_store", pdMS_TO_TICKS(OCCUPANCY_STORE_FLUSH_PERIOD_MS),
+                                           pdTRUE, NULL, occupancy_store_flush_callback);
+
+    if (store_state.flush_timer == NULL)
+    {
+        return -1;
+    }
+
+    return (xTimerStart(store_state.flush_timer, 0) == pdPASS) ? 0 : -1;
+}
+
+/*
+ * account a presence event in the current minute
+ */
+void occupancy_store_add_event(const xensiv_radar_presence_event_t *event)
+{
+    occupancy_store_update(event->timestamp);
+
+    if ((int32_t)(event->timestamp - store_state.since_ms) > 0)
+    {
+        if (store_state.present)
+        {
+            store_state.occupied_ms += event->timestamp - store_state.since_ms;
+        }
+
+        store_state.since_ms = event->timestamp;
+    }
+
+    store_state.present = (event->state != XENSIV_RADAR_PRESENCE_STATE_ABSENCE);
+    store_state.transitions++;
+
+    if (store_state.present)
+    {
+        store_state.range_bin = event->range_bin;
+
+        if (event->range_bin > store_state.max_range_bin)
+        {
+            store_state.max_range_bin = event->range_bin;
+        }
+    }
+}
+
+/*
+ * store the minutes that ended before now
+ */
+void occupancy_store_update(XENSIV_RADAR_PRESENCE_TIMESTAMP now_ms)
+{
+    while ((int32_t)(now_ms - store_state.minute_end_ms) >= 0)
+    {
+        occupancy_store_close_minute();
+    }
+}
+
+/*
+ * get the index of the current minute
+ */
+uint32_t occupancy_store_get_minute(void)
+{
+    return store_state.minute;
+}
+
+/*
+ * write the full and the open segment
+ */
+int32_t occupancy_store_flush(void)
+{
+    int32_t result = 0;
+    bool pending;
+    bool shadow;
+
+    if (store_state.num_rows == 0U)
+    {
+        return 0;
+    }
+
+    vTaskSuspendAll();
+    pending = store_state.sealed_pending;
+
+    if (pending)
+    {
+        memcpy(&store_state.flush, &store_state.sealed, sizeof(store_state.flush));
+    }
+
+    xTaskResumeAll();
+
+    if (pending)
+    {
+        result = occupancy_store_write(&store_state.flush, false);
+
+        vTaskSuspendAll();
+
+        /* queries read it from flash from now on */
+        if ((result == 0) && (store_state.sealed.header.sequence == store_state.flush.header.sequence))
+        {
+            store_state.sealed_pending = false;
+        }
+
+        xTaskResumeAll();
+    }
+
+    vTaskSuspendAll();
+    pending = store_state.dirty;
+    store_state.dirty = false;
+    shadow = !store_state.open_in_shadow;
+
+    if (pending)
+    {
+        memcpy(&store_state.flush, &store_state.open, sizeof(store_state.flush));
+    }
+
+    xTaskResumeAll();
+
+    if (!pending)
+    {
+        return result;
+    }
+
+    /* the row with the previous copy is left alone */
+    if (occupancy_store_write(&store_state.flush, shadow) != 0)
+    {
+        store_state.dirty = true;
+        return -1;
+    }
+
+    vTaskSuspendAll();
+    if (store_state.open.header.sequence == store_state.flush.header.sequence)
+    {
+        store_state.open_in_shadow = shadow;
+    }
+    store_state.written_minute = store_state.flush.header.last_minute;
+    xTaskResumeAll();
+
+    return result;
+}
+
+/*
+ * start a range query at the oldest segment
+ */
+void occupancy_store_query_begin(occupancy_store_cursor_s *cursor,
+                                 uint32_t first_minute, uint32_t last_minute)
+{
+    uint32_t newest = store_state.open.header.sequence;
+
+    memset(cursor, 0, sizeof(*cursor));
+    cursor->first_minute = first_minute;
+    cursor->last_minute = last_minute;
+    cursor->sequence = (newest >= store_state.num_rows) ? (newest - store_state.num_rows + 1U) : 0U;
+}
+
+/*
+ * get the next record of a range query
+ */
+bool occupancy_store_query_next(occupancy_store_cursor_s *cursor, occupancy_record_s *record)
+{
+    const occupancy_segment_header_s *header = &store_state.read.header;
+
+    while ((int32_t)(cursor->sequence - store_state.open.header.sequence) <= 0)
+    {
+        uint32_t delta;
+        uint32_t bin_delta;
+        uint32_t transitions;
+        uint32_t size;
+        uint32_t used;
+        const uint8_t *src;
+
+        /* segments that end before the range are skipped without decoding */
+        if ((occupancy_store_read(cursor->sequence) != 0) ||
+            (header->last_minute < cursor->first_minute) ||
+            (cursor->offset >= header->length))
+        {
+            cursor->sequence++;
+            cursor->offset = 0U;
+            continue;
+        }
+
+        if (cursor->offset == 0U)
+        {
+            cursor->minute = header->first_minute;
+            cursor->bin_code = 0U;
+            cursor->boot = header->boot;
+        }
+
+        src = &store_state.read.payload[cursor->offset];
+        size = header->length - cursor->offset;
+
+        used = occupancy_store_get_varint(src, size, &delta);
+        if ((used == 0U) || (used >= size))
+        {
+            cursor->offset = header->length;
+            continue;
+        }
+
+        if (src[used] == OCCUPANCY_MARKER)
+        {
+            uint32_t boot;
+
+            size = occupancy_store_get_varint(&src[used + 1U], header->length - cursor->offset - used - 1U, &boot);
+            if (size == 0U)
+            {
+                cursor->offset = header->length;
+                continue;
+            }
+
+            /* the records of the boot count from the marker */
+            cursor->offset += used + 1U + size;
+            cursor->minute = header->first_minute + delta;
+            cursor->bin_code = 0U;
+            cursor->boot = boot;
+            continue;
+        }
+
+        record->occupancy = src[used++];
+        size = occupancy_store_get_varint(&src[used], header->length - cursor->offset - used, &bin_delta);
+        used = (size == 0U) ? 0U : (used + size);
+        size = (used == 0U) ? 0U :
+               occupancy_store_get_varint(&src[used], header->length - cursor->offset - used, &transitions);
+
+        if (size == 0U)
+        {
+            /* corrupted record, the rest of the segment is skipped */
+            cursor->offset = header->length;
+            continue;
+        }
+
+        cursor->offset += used + size;
+        cursor->minute += delta;
+        cursor->bin_code += (bin_delta >> 1) ^ (0U - (bin_delta & 1U));
+
+        if (cursor->minute > cursor->last_minute)
+        {
+            /* the minutes only increase, nothing more is in the range */
+            cursor->sequence = store_state.open.header.sequence + 1U;
+            return false;
+        }
+
+        if (cursor->minute >= cursor->first_minute)
+        {
+            record->minute = cursor->minute;
+            record->boot = (uint16_t)cursor->boot;
+            record->max_range_bin = (int32_t)cursor->bin_code - 1;
+            record->transitions = transitions;
+            return true;
+        }
+    }
+
+    return false;
+}
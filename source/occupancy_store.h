@@ -0,0 +1,189 @@
+/*****************************************************************************
+ * File name: occupancy_store.h
+ *
+ * Description: This file contains types and function prototypes of the
+ *   per-minute occupancy history in the auxiliary flash
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_OCCUPANCY_STORE_H_
+#define SOURCE_OCCUPANCY_STORE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "xensiv_radar_presence.h"
+
+/*
+ * @def OCCUPANCY_STORE_FLUSH_PERIOD_MS
+ * The RAM copy of the open segment is written to flash with this period if
+ * records were added. The writes alternate between the row of the segment and
+ * a shadow row, so a reset, also during a write, loses at most the minutes
+ * since the last completed write
+ */
+#define OCCUPANCY_STORE_FLUSH_PERIOD_MS     (600000U)
+
+/*
+ * @def OCCUPANCY_STORE_MINUTE_MS
+ * Length of one aggregation interval
+ */
+#define OCCUPANCY_STORE_MINUTE_MS           (60000U)
+
+/*
+ * @def struct occupancy_record_s
+ * Aggregates of one minute
+ * minute - minute index, continues over resets after the last minute in
+ * flash, without counting the time off
+ * boot - number of the boot that recorded the minute
+ * occupancy - part of the minute with presence in percent
+ * max_range_bin - farthest range bin reported with presence, -1 if none
+ * transitions - number of reported state changes
+ */
+typedef struct
+{
+    uint32_t minute;
+    uint16_t boot;
+    uint8_t occupancy;
+    int32_t max_range_bin;
+    uint32_t transitions;
+} occupancy_record_s;
+
+/*
+ * @def struct occupancy_store_cursor_s
+ * Position of a range query, records are returned one by one so a query can
+ * span several calls of a CLI command
+ */
+typedef struct
+{
+    uint32_t first_minute;
+    uint32_t last_minute;
+    uint32_t sequence;
+    uint32_t offset;
+    uint32_t minute;
+    uint32_t bin_code;
+    uint32_t boot;
+} occupancy_store_cursor_s;
+
+
+/*******************************************************************************
+ * Function Name: occupancy_store_init
+ ****************************************************************************//**
+ *
+ * @brief Finds the newest segment in flash and continues it, or opens a new
+ * segment after it if it is full, and creates the flush timer. The first
+ * record of the boot is preceded by a boot marker. Needs an initialized flash
+ * storage.
+ *
+ * @return 0 on success, -1 if the region has less than two rows or the flush
+ * timer cannot be created.
+ *
+ *******************************************************************************/
+int32_t occupancy_store_init(void);
+
+/*******************************************************************************
+ * Function Name: occupancy_store_add_event
+ ****************************************************************************//**
+ *
+ * @brief Accounts a presence event in the aggregates of the current minute.
+ * Called from the presence callback.
+ *
+ * @param event Presence event.
+ *
+ *******************************************************************************/
+void occupancy_store_add_event(const xensiv_radar_presence_event_t *event);
+
+/*******************************************************************************
+ * Function Name: occupancy_store_update
+ ****************************************************************************//**
+ *
+ * @brief Closes the minutes that ended before the given time and appends
+ * their records to the open segment. Minutes without presence and without
+ * transitions are not stored. Called once per frame.
+ *
+ * @param now_ms Current time in ms, same time base as the presence events.
+ *
+ *******************************************************************************/
+void occupancy_store_update(XENSIV_RADAR_PRESENCE_TIMESTAMP now_ms);
+
+/*******************************************************************************
+ * Function Name: occupancy_store_get_minute
+ ****************************************************************************//**
+ *
+ * @return Index of the current, not yet stored minute.
+ *
+ *******************************************************************************/
+uint32_t occupancy_store_get_minute(void);
+
+/*******************************************************************************
+ * Function Name: occupancy_store_flush
+ ****************************************************************************//**
+ *
+ * @brief Writes the completed segment, if any, and the open segment to flash.
+ * Blocks the calling task until the rows are programmed.
+ *
+ * @return 0 on success, -1 on a flash error.
+ *
+ *******************************************************************************/
+int32_t occupancy_store_flush(void);
+
+/*******************************************************************************
+ * Function Name: occupancy_store_query_begin
+ ****************************************************************************//**
+ *
+ * @brief Starts a range query at the oldest stored segment.
+ *
+ * @param cursor Query position.
+ * @param first_minute First minute of the range.
+ * @param last_minute Last minute of the range, inclusive.
+ *
+ *******************************************************************************/
+void occupancy_store_query_begin(occupancy_store_cursor_s *cursor,
+                                 uint32_t first_minute, uint32_t last_minute);
+
+/*******************************************************************************
+ * Function Name: occupancy_store_query_next
+ ****************************************************************************//**
+ *
+ * @brief Returns the next record of a range query. Only one query may run at
+ * a time.
+ *
+ * @param cursor Query position.
+ * @param record Next record in the range.
+ *
+ * @return true if a record was returned, false at the end of the range.
+ *
+ *******************************************************************************/
+bool occupancy_store_query_next(occupancy_store_cursor_s *cursor, occupancy_record_s *record);
+
+#endif /* SOURCE_OCCUPANCY_STORE_H_ */
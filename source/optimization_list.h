@@ -58,6 +58,13 @@
  */
 #define NUM_CHIRPS_PER_FRAME                XENSIV_BGT60TRXX_CONF_NUM_CHIRPS_PER_FRAME
 
+/*
+ * @def NUM_RX_ANTENNAS
+ * Number of receiving antennas
+ * @note: The samples of all antennas are interleaved in the FIFO
+ */
+#define NUM_RX_ANTENNAS                     XENSIV_BGT60TRXX_CONF_NUM_RX_ANTENNAS
+
 /*
  * @def NUM_SAMPLES_PER_CHIRP
  * Number of samples per chirp
@@ -81,18 +88,21 @@ typedef struct {
     uint32_t *reg_list;
     uint8_t  reg_list_size;
     uint32_t fifo_limit;
+    float32_t frame_period_s;
 }optimization_s;
 
 optimization_s optimizations_list [] = {
         {
                 register_list_macro_only,
                 XENSIV_BGT60TRXX_CONF_NUM_REGS_MACRO,
-                NUM_SAMPLES_PER_FRAME*2
+                NUM_SAMPLES_PER_FRAME*2,
+                XENSIV_BGT60TRXX_CONF_FRAME_REPETITION_TIME_S
         },
         {
                 register_list_micro_only,
                 XENSIV_BGT60TRXX_CONF_NUM_REGS_MICRO,
-                NUM_SAMPLES_PER_FRAME*2
+                NUM_SAMPLES_PER_FRAME*2,
+                XENSIV_BGT60TRXX_CONF_HIGH_FRAME_REPETITION_TIME_S
         }
 };
 
@@ -0,0 +1,327 @@
+/*****************************************************************************
+ * File name: presence_cfar.c
+ *
+ * Description: This file implements an adaptive CFAR detector on the macro
+ *   FFT buffer and derives the presence thresholds from the noise statistics
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+
+#include "presence_cfar.h"
+
+/* Frames needed before a bin may be detected */
+#define CFAR_WARMUP_FRAMES                  (64U)
+
+/* Rank of the ordered statistic (0 is the smallest training cell) */
+#define CFAR_OS_RANK                        ((3 * 2 * CFAR_TRAINING_CELLS) / 4)
+
+/* shared by the live detector and the detector of the benchmark */
+static presence_cfar_mode_e cfar_mode;
+static bool cfar_auto_enabled;
+
+static presence_cfar_s live_cfar;
+
+/*******************************************************************************
+ * Function Name: cfar_update_stats
+ ****************************************************************************//**
+ *
+ * @brief Updates an exponentially weighted mean and variance.
+ *
+ * @param mean Running mean.
+ * @param var Running variance.
+ * @param value New sample.
+ *
+ *******************************************************************************/
+static inline void cfar_update_stats(float32_t *mean, float32_t *var, float32_t value)
+{
+    float32_t delta = value - *mean;
+
+    *mean += CFAR_NOISE_ALPHA * delta;
+    *var = (1.0f - CFAR_NOISE_ALPHA) * (*var + (CFAR_NOISE_ALPHA * delta * delta));
+}
+
+/*******************************************************************************
+ * Function Name: cfar_noise_floor
+ ****************************************************************************//**
+ *
+ * @brief Estimates the noise floor of a cell under test from the running
+ * noise means of the training cells inside the gate.
+ *
+ * @param cfar Detector instance.
+ * @param cut Index of the cell under test.
+ * @param first_bin First bin of the gate.
+ * @param last_bin Last bin of the gate.
+ *
+ * @return Estimated noise floor.
+ *
+ *******************************************************************************/
+static float32_t cfar_noise_floor(const presence_cfar_s *cfar, int32_t cut, int32_t first_bin, int32_t last_bin)
+{
+    float32_t cells[2 * CFAR_TRAINING_CELLS];
+    uint32_t num_cells = 0;
+    float32_t sum = 0.0f;
+
+    for (int32_t offset = CFAR_GUARD_CELLS + 1; offset <= (CFAR_GUARD_CELLS + CFAR_TRAINING_CELLS); offset++)
+    {
+        if ((cut - offset) >= first_bin)
+        {
+            cells[num_cells++] = cfar->noise_mean[cut - offset];
+        }
+        if ((cut + offset) <= last_bin)
+        {
+            cells[num_cells++] = cfar->noise_mean[cut + offset];
+        }
+    }
+
+    if (num_cells == 0U)
+    {
+        return cfar->noise_mean[cut];
+    }
+
+    if (cfar_mode == CFAR_MODE_OS)
+    {
+        uint32_t rank = (CFAR_OS_RANK * num_cells) / (2U * CFAR_TRAINING_CELLS);
+
+        /* insertion sort, at most 2 * CFAR_TRAINING_CELLS entries */
+        for (uint32_t i = 1; i < num_cells; i++)
+        {
+            float32_t value = cells[i];
+            uint32_t j = i;
+
+            while ((j > 0U) && (cells[j - 1U] > value))
+            {
+                cells[j] = cells[j - 1U];
+                j--;
+            }
+            cells[j] = value;
+        }
+
+        return cells[rank];
+    }
+
+    for (uint32_t i = 0; i < num_cells; i++)
+    {
+        sum += cells[i];
+    }
+
+    return sum / (float32_t)num_cells;
+}
+
+/*
+ * initialize a CFAR detector
+ */
+int32_t presence_cfar_init(presence_cfar_s *cfar, int32_t num_range_bins)
+{
+    if ((num_range_bins <= 0) || (num_range_bins > CFAR_MAX_RANGE_BINS))
+    {
+        return -1;
+    }
+
+    memset(cfar, 0, sizeof(*cfar));
+    cfar->num_range_bins = num_range_bins;
+
+    return 0;
+}
+
+/*
+ * get the detector of the live frame path
+ */
+presence_cfar_s *presence_cfar_get_live(void)
+{
+    return &live_cfar;
+}
+
+/*
+ * select the CFAR mode
+ */
+void presence_cfar_set_mode(presence_cfar_mode_e mode)
+{
+    cfar_mode = mode;
+}
+
+/*
+ * get the CFAR mode
+ */
+presence_cfar_mode_e presence_cfar_get_mode(void)
+{
+    return cfar_mode;
+}
+
+/*
+ * enable or disable the auto thresholds
+ */
+void presence_cfar_set_auto(bool enable)
+{
+    cfar_auto_enabled = enable;
+}
+
+/*
+ * check if auto thresholds are enabled
+ */
+bool presence_cfar_get_auto(void)
+{
+    return cfar_auto_enabled;
+}
+
+/*
+ * run one CFAR iteration
+ */
+uint32_t presence_cfar_process(presence_cfar_s *cfar,
+                               const cfloat32_t *macro_fft_buff,
+                               const range_gate_s *gate,
+                               xensiv_radar_presence_state_t state,
+                               float32_t micro_energy)
+{
+    const float32_t *current = (const float32_t *)macro_fft_buff;
+    bool absence = (state == XENSIV_RADAR_PRESENCE_STATE_ABSENCE);
+    uint32_t num_detected = 0;
+
+    if ((cfar->num_range_bins == 0) || (macro_fft_buff == NULL))
+    {
+        return 0;
+    }
+
+    /* macro presence raises the micro energy as well, only absence is noise */
+    if (absence)
+    {
+        if (cfar->micro_frames == 0U)
+        {
+            cfar->micro_mean = micro_energy;
+        }
+        cfar_update_stats(&cfar->micro_mean, &cfar->micro_var, micro_energy);
+        cfar->micro_frames++;
+    }
+
+    if (cfar->has_previous && (gate->num_bins > 0))
+    {
+        int32_t first_bin = gate->first_bin;
+        int32_t last_bin = gate->first_bin + gate->num_bins - 1;
+
+        /* frame to frame change of the gated bins, static reflectors cancel out */
+        arm_sub_f32(&current[2 * first_bin], &cfar->previous[2 * first_bin],
+                    cfar->diff, 2U * (uint32_t)gate->num_bins);
+        arm_cmplx_mag_f32(cfar->diff, &cfar->change[first_bin], (uint32_t)gate->num_bins);
+
+        for (int32_t bin = first_bin; bin <= last_bin; bin++)
+        {
+            float32_t floor = cfar_noise_floor(cfar, bin, first_bin, last_bin);
+
+            cfar->detected[bin] = (cfar->stats.frames >= CFAR_WARMUP_FRAMES) &&
+                                       (cfar->change[bin] > (CFAR_SCALE * floor));
+            if (cfar->detected[bin])
+            {
+                num_detected++;
+            }
+        }
+
+        /* learn the noise only from bins without a detection */
+        for (int32_t bin = first_bin; bin <= last_bin; bin++)
+        {
+            if (!cfar->detected[bin])
+            {
+                if (cfar->stats.frames == 0U)
+                {
+                    cfar->noise_mean[bin] = cfar->change[bin];
+                }
+                cfar_update_stats(&cfar->noise_mean[bin], &cfar->noise_var[bin],
+                                  cfar->change[bin]);
+            }
+        }
+
+        cfar->stats.frames++;
+        cfar->stats.detections += num_detected;
+        if (absence)
+        {
+            cfar->stats.absence_frames++;
+            cfar->stats.false_alarms += num_detected;
+        }
+    }
+
+    arm_copy_f32(current, cfar->previous, 2U * (uint32_t)cfar->num_range_bins);
+    cfar->has_previous = true;
+
+    return num_detected;
+}
+
+/*
+ * derive the macro and micro thresholds from the noise statistics
+ */
+bool presence_cfar_get_auto_thresholds(const presence_cfar_s *cfar,
+                                       int32_t min_range_bin, int32_t max_range_bin,
+                                       float32_t *macro_threshold, float32_t *micro_threshold)
+{
+    float32_t macro = 0.0f;
+    float32_t sigma;
+
+    if ((cfar->stats.absence_frames < CFAR_AUTO_MIN_FRAMES) ||
+        (cfar->micro_frames < CFAR_AUTO_MIN_FRAMES))
+    {
+        return false;
+    }
+
+    if (min_range_bin < 0)
+    {
+        min_range_bin = 0;
+    }
+    if (max_range_bin > (cfar->num_range_bins - 1))
+    {
+        max_range_bin = cfar->num_range_bins - 1;
+    }
+
+    /* only the detection range counts, the DC bin and the bins beyond are never detected */
+    for (int32_t bin = min_range_bin; bin <= max_range_bin; bin++)
+    {
+        arm_sqrt_f32(cfar->noise_var[bin], &sigma);
+        if ((cfar->noise_mean[bin] + (CFAR_AUTO_SIGMA * sigma)) > macro)
+        {
+            macro = cfar->noise_mean[bin] + (CFAR_AUTO_SIGMA * sigma);
+        }
+    }
+
+    arm_sqrt_f32(cfar->micro_var, &sigma);
+
+    *macro_threshold = macro;
+    *micro_threshold = cfar->micro_mean + (CFAR_AUTO_SIGMA * sigma);
+
+    return true;
+}
+
+/*
+ * get the detection counters
+ */
+const presence_cfar_stats_s *presence_cfar_get_stats(const presence_cfar_s *cfar)
+{
+    return &cfar->stats;
+}
@@ -0,0 +1,258 @@
+/*****************************************************************************
+ * File name: presence_cfar.h
+ *
+ * Description: This file contains types and function prototypes of the
+ *   adaptive CFAR thresholding stage
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_PRESENCE_CFAR_H_
+#define SOURCE_PRESENCE_CFAR_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "arm_math.h"
+#include "xensiv_radar_presence.h"
+#include "range_gate.h"
+
+/*
+ * @def CFAR_MAX_RANGE_BINS
+ * Largest supported macro FFT buffer
+ */
+#define CFAR_MAX_RANGE_BINS                 (64)
+
+/*
+ * @def CFAR_TRAINING_CELLS
+ * Training cells on each side of the cell under test
+ */
+#define CFAR_TRAINING_CELLS                 (4)
+
+/*
+ * @def CFAR_GUARD_CELLS
+ * Guard cells on each side of the cell under test
+ */
+#define CFAR_GUARD_CELLS                    (1)
+
+/*
+ * @def CFAR_SCALE
+ * Detection threshold relative to the estimated noise floor
+ */
+#define CFAR_SCALE                          (4.0f)
+
+/*
+ * @def CFAR_NOISE_ALPHA
+ * Smoothing factor of the running noise statistics (time constant of
+ * about 64 frames)
+ */
+#define CFAR_NOISE_ALPHA                    (1.0f / 64.0f)
+
+/*
+ * @def CFAR_AUTO_SIGMA
+ * Auto thresholds are placed this many standard deviations above the mean
+ */
+#define CFAR_AUTO_SIGMA                     (5.0f)
+
+/*
+ * @def CFAR_AUTO_MIN_FRAMES
+ * Number of noise frames needed before auto thresholds are derived
+ */
+#define CFAR_AUTO_MIN_FRAMES                (200U)
+
+/*
+ * @def enum presence_cfar_mode_e
+ * Combination of the training cells
+ * CFAR_MODE_CA - cell averaging
+ * CFAR_MODE_OS - ordered statistic, robust against neighbouring targets
+ */
+typedef enum
+{
+    CFAR_MODE_CA,
+    CFAR_MODE_OS
+} presence_cfar_mode_e;
+
+/*
+ * @typedef typedef struct presence_cfar_stats_s
+ * Detection counters
+ */
+typedef struct
+{
+    uint32_t frames;            /*<< processed frames*/
+    uint32_t absence_frames;    /*<< processed frames in absence state*/
+    uint32_t detections;        /*<< detected range bins*/
+    uint32_t false_alarms;      /*<< detected range bins while the presence state was absence*/
+} presence_cfar_stats_s;
+
+/*
+ * @typedef typedef struct presence_cfar_s
+ * Detector instance, the running noise statistics of every range bin
+ */
+typedef struct
+{
+    int32_t num_range_bins;
+    bool has_previous;
+    presence_cfar_stats_s stats;
+    float32_t previous[2 * CFAR_MAX_RANGE_BINS];
+    float32_t diff[2 * CFAR_MAX_RANGE_BINS];
+    float32_t change[CFAR_MAX_RANGE_BINS];
+    float32_t noise_mean[CFAR_MAX_RANGE_BINS];
+    float32_t noise_var[CFAR_MAX_RANGE_BINS];
+    bool detected[CFAR_MAX_RANGE_BINS];
+    float32_t micro_mean;
+    float32_t micro_var;
+    uint32_t micro_frames;
+} presence_cfar_s;
+
+/*******************************************************************************
+ * Function Name: presence_cfar_init
+ ****************************************************************************//**
+ *
+ * @brief Initializes a detector and clears its running statistics.
+ *
+ * @param cfar Detector instance.
+ * @param num_range_bins Number of bins of the macro FFT buffer.
+ *
+ * @return 0 on success, -1 on invalid parameters.
+ *
+ *******************************************************************************/
+int32_t presence_cfar_init(presence_cfar_s *cfar, int32_t num_range_bins);
+
+/*******************************************************************************
+ * Function Name: presence_cfar_get_live
+ ****************************************************************************//**
+ *
+ * @return Detector instance of the live frame path.
+ *
+ *******************************************************************************/
+presence_cfar_s *presence_cfar_get_live(void);
+
+/*******************************************************************************
+ * Function Name: presence_cfar_set_mode
+ ****************************************************************************//**
+ *
+ * @brief Selects how the training cells are combined, for all detectors.
+ *
+ * @param mode CFAR_MODE_CA or CFAR_MODE_OS.
+ *
+ *******************************************************************************/
+void presence_cfar_set_mode(presence_cfar_mode_e mode);
+
+/*******************************************************************************
+ * Function Name: presence_cfar_get_mode
+ ****************************************************************************//**
+ *
+ * @return The selected CFAR mode.
+ *
+ *******************************************************************************/
+presence_cfar_mode_e presence_cfar_get_mode(void);
+
+/*******************************************************************************
+ * Function Name: presence_cfar_set_auto
+ ****************************************************************************//**
+ *
+ * @brief Enables or disables the automatic derivation of the macro and micro
+ * thresholds.
+ *
+ * @param enable true to enable auto thresholds.
+ *
+ *******************************************************************************/
+void presence_cfar_set_auto(bool enable);
+
+/*******************************************************************************
+ * Function Name: presence_cfar_get_auto
+ ****************************************************************************//**
+ *
+ * @return true if auto thresholds are enabled.
+ *
+ *******************************************************************************/
+bool presence_cfar_get_auto(void);
+
+/*******************************************************************************
+ * Function Name: presence_cfar_process
+ ****************************************************************************//**
+ *
+ * @brief Runs one CFAR iteration on the frame to frame change of the macro
+ * FFT buffer. The running noise statistics of a range bin are only updated
+ * while it is not detected. The maximum micro energy feeds the micro noise
+ * statistics while absence is reported.
+ * @note: The detections are observe-only. They feed the counters and the noise
+ *        statistics behind the auto thresholds, the presence decision and the
+ *        tracker are not changed by them.
+ *
+ * @param macro_fft_buff Macro FFT buffer of the presence algorithm.
+ * @param gate Range bins to be processed.
+ * @param state Presence state reported last.
+ * @param micro_energy Maximum micro energy of the presence algorithm.
+ *
+ * @return Number of detected range bins.
+ *
+ *******************************************************************************/
+uint32_t presence_cfar_process(presence_cfar_s *cfar,
+                               const cfloat32_t *macro_fft_buff,
+                               const range_gate_s *gate,
+                               xensiv_radar_presence_state_t state,
+                               float32_t micro_energy);
+
+/*******************************************************************************
+ * Function Name: presence_cfar_get_auto_thresholds
+ ****************************************************************************//**
+ *
+ * @brief Derives the macro and micro thresholds from the running noise
+ * statistics of the detection range.
+ *
+ * @param cfar Detector instance.
+ * @param min_range_bin First range bin of the detection range.
+ * @param max_range_bin Last range bin of the detection range.
+ * @param macro_threshold Derived macro threshold.
+ * @param micro_threshold Derived micro threshold.
+ *
+ * @return true if enough noise frames have been collected, false otherwise.
+ *
+ *******************************************************************************/
+bool presence_cfar_get_auto_thresholds(const presence_cfar_s *cfar,
+                                       int32_t min_range_bin, int32_t max_range_bin,
+                                       float32_t *macro_threshold, float32_t *micro_threshold);
+
+/*******************************************************************************
+ * Function Name: presence_cfar_get_stats
+ ****************************************************************************//**
+ *
+ * @param cfar Detector instance.
+ *
+ * @return Pointer to the detection counters.
+ *
+ *******************************************************************************/
+const presence_cfar_stats_s *presence_cfar_get_stats(const presence_cfar_s *cfar);
+
+#endif /* SOURCE_PRESENCE_CFAR_H_ */
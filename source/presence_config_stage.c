@@ -0,0 +1,282 @@
+/*****************************************************************************
+ * File name: presence_config_stage.c
+ *
+ * Description: This file implements the double buffered configuration of
+ *   the presence algorithm, applied by the processing task at a frame boundary
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "task.h"
+#include "semphr.h"
+
+#include "presence_config_stage.h"
+
+typedef struct
+{
+    xensiv_radar_presence_config_t staged;
+    xensiv_radar_presence_config_t pending;
+    xensiv_radar_presence_config_t active;
+    bool pending_valid;
+    bool pending_reset;
+    bool pending_notify;
+    bool count_next_frames;
+    bool force_micro_decimation;
+    int32_t apply_result;
+    volatile uint32_t interval_ms;
+    SemaphoreHandle_t applied;
+    StaticSemaphore_t applied_buffer;
+    presence_config_stage_stats_s stats;
+} presence_config_stage_state_s;
+
+static presence_config_stage_state_s stage_state;
+
+/*******************************************************************************
+ * Function Name: config_stage_publish
+ ****************************************************************************//**
+ *
+ * @brief Copies a configuration into the staged and the pending buffer.
+ *
+ * @param config New configuration.
+ * @param needs_reset true if the algorithm history must be cleared.
+ * @param notify true if the writer waits for the result.
+ *
+ *******************************************************************************/
+static void config_stage_publish(const xensiv_radar_presence_config_t *config, bool needs_reset, bool notify)
+{
+    taskENTER_CRITICAL();
+    stage_state.staged = *config;
+    stage_state.pending = *config;
+    stage_state.pending_valid = true;
+    stage_state.pending_reset |= needs_reset;
+    stage_state.pending_notify |= notify;
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+ * Function Name: config_stage_withdraw
+ ****************************************************************************//**
+ *
+ * @brief Drops the pending changes, the staged configuration falls back to
+ * the active one. Must be called in a critical section.
+ *
+ *******************************************************************************/
+static void config_stage_withdraw(void)
+{
+    stage_state.staged = stage_state.active;
+    stage_state.pending_valid = false;
+    stage_state.pending_reset = false;
+    stage_state.pending_notify = false;
+}
+
+/*
+ * initialize the staged configuration
+ */
+int32_t presence_config_stage_init(const xensiv_radar_presence_config_t *config)
+{
+    stage_state.staged = *config;
+    stage_state.active = *config;
+    stage_state.pending_valid = false;
+    stage_state.applied = xSemaphoreCreateBinaryStatic(&stage_state.applied_buffer);
+
+    return (stage_state.applied != NULL) ? 0 : -1;
+}
+
+/*
+ * read the latest committed configuration
+ */
+int32_t presence_config_stage_get(xensiv_radar_presence_config_t *config)
+{
+    taskENTER_CRITICAL();
+    *config = stage_state.staged;
+    taskEXIT_CRITICAL();
+
+    return XENSIV_RADAR_PRESENCE_OK;
+}
+
+/*
+ * hand a configuration over to the processing task
+ */
+void presence_config_stage_commit(const xensiv_radar_presence_config_t *config, bool needs_reset)
+{
+    config_stage_publish(config, needs_reset, false);
+}
+
+/*
+ * commit a configuration and wait until it is applied
+ */
+int32_t presence_config_stage_commit_and_wait(const xensiv_radar_presence_config_t *config, bool needs_reset)
+{
+    bool withdrawn;
+
+    /* drop a stale signal of an earlier apply */
+    (void)xSemaphoreTake(stage_state.applied, 0);
+
+    config_stage_publish(config, needs_reset, true);
+
+    if (xSemaphoreTake(stage_state.applied, pdMS_TO_TICKS(CONFIG_STAGE_WAIT_MS + stage_state.interval_ms)) != pdTRUE)
+    {
+        /* a change that was not taken yet is withdrawn, so a failed command leaves nothing behind */
+        taskENTER_CRITICAL();
+        withdrawn = stage_state.pending_valid;
+        if (withdrawn)
+        {
+            config_stage_withdraw();
+        }
+        taskEXIT_CRITICAL();
+
+        if (withdrawn)
+        {
+            return -1;
+        }
+
+        /* the processing task is applying it right now */
+        (void)xSemaphoreTake(stage_state.applied, portMAX_DELAY);
+    }
+
+    return stage_state.apply_result;
+}
+
+/*
+ * apply a pending configuration
+ */
+bool presence_config_stage_apply(xensiv_radar_presence_handle_t handle,
+                                 xensiv_radar_presence_config_t *applied)
+{
+    xensiv_radar_presence_config_t effective;
+    bool needs_reset;
+    bool notify;
+
+    if (!stage_state.pending_valid)
+    {
+        return false;
+    }
+
+    taskENTER_CRITICAL();
+    *applied = stage_state.pending;
+    needs_reset = stage_state.pending_reset;
+    notify = stage_state.pending_notify;
+    stage_state.pending_valid = false;
+    stage_state.pending_reset = false;
+    stage_state.pending_notify = false;
+    taskEXIT_CRITICAL();
+
+    /* the forced decimation is only applied to the algorithm, the staged configuration keeps the user setting */
+    effective = *applied;
+    effective.micro_fft_decimation_enabled |= stage_state.force_micro_decimation;
+
+    stage_state.apply_result = xensiv_radar_presence_set_config(handle, &effective);
+    if (stage_state.apply_result == XENSIV_RADAR_PRESENCE_OK)
+    {
+        stage_state.active = *applied;
+        if (needs_reset)
+        {
+            xensiv_radar_presence_reset(handle);
+        }
+    }
+    else
+    {
+        /* a rejected configuration is not kept as the base of the next change */
+        taskENTER_CRITICAL();
+        if (!stage_state.pending_valid)
+        {
+            stage_state.staged = stage_state.active;
+        }
+        taskEXIT_CRITICAL();
+    }
+
+    stage_state.stats.reconfigurations++;
+    stage_state.count_next_frames = true;
+
+    if (notify)
+    {
+        (void)xSemaphoreGive(stage_state.applied);
+    }
+
+    return stage_state.apply_result == XENSIV_RADAR_PRESENCE_OK;
+}
+
+/*
+ * force the micro FFT decimation on or release it
+ */
+void presence_config_stage_force_micro_decimation(bool force)
+{
+    taskENTER_CRITICAL();
+    if (force != stage_state.force_micro_decimation)
+    {
+        stage_state.force_micro_decimation = force;
+        if (!stage_state.pending_valid)
+        {
+            stage_state.pending = stage_state.active;
+            stage_state.pending_valid = true;
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*
+ * check for a configuration waiting for the next frame boundary
+ */
+bool presence_config_stage_is_pending(void)
+{
+    return stage_state.pending_valid;
+}
+
+/*
+ * set the longest time between two processed frames
+ */
+void presence_config_stage_set_interval(uint32_t interval_ms)
+{
+    stage_state.interval_ms = interval_ms;
+}
+
+/*
+ * account the frames of one processing iteration
+ */
+void presence_config_stage_count_frames(uint32_t num_frames)
+{
+    if (stage_state.count_next_frames)
+    {
+        stage_state.count_next_frames = false;
+        stage_state.stats.last_frames_lost = (num_frames > 1U) ? (num_frames - 1U) : 0U;
+        stage_state.stats.frames_lost += stage_state.stats.last_frames_lost;
+    }
+}
+
+/*
+ * get the reconfiguration counters
+ */
+const presence_config_stage_stats_s *presence_config_stage_get_stats(void)
+{
+    return &stage_state.stats;
+}
@@ -0,0 +1,202 @@
+/*****************************************************************************
+ * File name: presence_config_stage.h
+ *
+ * Description: This file contains types and function prototypes of the
+ *   double buffered configuration of the presence algorithm
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_PRESENCE_CONFIG_STAGE_H_
+#define SOURCE_PRESENCE_CONFIG_STAGE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "xensiv_radar_presence.h"
+
+/*
+ * @def CONFIG_STAGE_WAIT_MS
+ * Time a writer waits for the processing task to apply a change, on top of
+ * the interval between two processed frames
+ */
+#define CONFIG_STAGE_WAIT_MS                (1000U)
+
+/*
+ * @typedef typedef struct presence_config_stage_stats_s
+ * Reconfiguration counters
+ */
+typedef struct
+{
+    uint32_t reconfigurations;  /*<< applied configuration changes*/
+    uint32_t frames_lost;       /*<< frames not processed right after a reconfiguration, all changes*/
+    uint32_t last_frames_lost;  /*<< frames not processed right after the last reconfiguration*/
+} presence_config_stage_stats_s;
+
+
+/*******************************************************************************
+ * Function Name: presence_config_stage_init
+ ****************************************************************************//**
+ *
+ * @brief Initializes the staged configuration with the configuration the
+ * presence algorithm was allocated with.
+ *
+ * @param config Active configuration.
+ *
+ * @return 0 on success, -1 if the synchronization object cannot be created.
+ *
+ *******************************************************************************/
+int32_t presence_config_stage_init(const xensiv_radar_presence_config_t *config);
+
+/*******************************************************************************
+ * Function Name: presence_config_stage_get
+ ****************************************************************************//**
+ *
+ * @brief Reads the latest committed configuration. Writers start from this
+ * copy, so pending changes of other writers are not lost.
+ *
+ * @param config Latest committed configuration.
+ *
+ * @return XENSIV_RADAR_PRESENCE_OK.
+ *
+ *******************************************************************************/
+int32_t presence_config_stage_get(xensiv_radar_presence_config_t *config);
+
+/*******************************************************************************
+ * Function Name: presence_config_stage_commit
+ ****************************************************************************//**
+ *
+ * @brief Hands a configuration over to the processing task, which applies it
+ * at the next frame boundary. Commits before that are merged, the last one
+ * wins and a reset is done if any of them needs one.
+ *
+ * @param config New configuration.
+ * @param needs_reset true if the algorithm history must be cleared.
+ *
+ *******************************************************************************/
+void presence_config_stage_commit(const xensiv_radar_presence_config_t *config, bool needs_reset);
+
+/*******************************************************************************
+ * Function Name: presence_config_stage_commit_and_wait
+ ****************************************************************************//**
+ *
+ * @brief Commits a configuration and blocks the calling task until it is
+ * applied. If the processing task did not take the change in time, the
+ * pending changes are withdrawn. A rejected configuration is dropped as
+ * well, the next change starts from the active configuration.
+ *
+ * @param config New configuration.
+ * @param needs_reset true if the algorithm history must be cleared.
+ *
+ * @return Result of xensiv_radar_presence_set_config, -1 on timeout.
+ *
+ *******************************************************************************/
+int32_t presence_config_stage_commit_and_wait(const xensiv_radar_presence_config_t *config, bool needs_reset);
+
+/*******************************************************************************
+ * Function Name: presence_config_stage_apply
+ ****************************************************************************//**
+ *
+ * @brief Applies a pending configuration. Must be called by the processing
+ * task between two frames.
+ *
+ * @param handle Presence algorithm handle.
+ * @param applied Applied configuration, only written if one was pending.
+ *
+ * @return true if a configuration was applied successfully, false otherwise.
+ *
+ *******************************************************************************/
+bool presence_config_stage_apply(xensiv_radar_presence_handle_t handle,
+                                 xensiv_radar_presence_config_t *applied);
+
+/*******************************************************************************
+ * Function Name: presence_config_stage_force_micro_decimation
+ ****************************************************************************//**
+ *
+ * @brief Forces the micro FFT decimation on, or releases it, at the next
+ * frame boundary without a reset of the algorithm. The decimation is only
+ * overlaid on the configuration passed to the algorithm: the staged
+ * configuration keeps the setting of the user, which is in effect again
+ * once the decimation is released.
+ *
+ * @param force true to force the decimation on.
+ *
+ *******************************************************************************/
+void presence_config_stage_force_micro_decimation(bool force);
+
+/*******************************************************************************
+ * Function Name: presence_config_stage_is_pending
+ ****************************************************************************//**
+ *
+ * @return true if a configuration waits for the next frame boundary.
+ *
+ *******************************************************************************/
+bool presence_config_stage_is_pending(void);
+
+/*******************************************************************************
+ * Function Name: presence_config_stage_set_interval
+ ****************************************************************************//**
+ *
+ * @brief Sets the longest time between two frames passed to the processing
+ * task, which extends the wait of presence_config_stage_commit_and_wait.
+ *
+ * @param interval_ms Frame period times the frames that can be held back,
+ * by coalescing and decimation.
+ *
+ *******************************************************************************/
+void presence_config_stage_set_interval(uint32_t interval_ms);
+
+/*******************************************************************************
+ * Function Name: presence_config_stage_count_frames
+ ****************************************************************************//**
+ *
+ * @brief Accounts the frames of one processing iteration. Frames beyond the
+ * first one were overwritten before they were processed. The first iteration
+ * after a reconfiguration attributes them to that reconfiguration.
+ *
+ * @param num_frames Frames signalled since the last iteration.
+ *
+ *******************************************************************************/
+void presence_config_stage_count_frames(uint32_t num_frames);
+
+/*******************************************************************************
+ * Function Name: presence_config_stage_get_stats
+ ****************************************************************************//**
+ *
+ * @return Pointer to the reconfiguration counters.
+ *
+ *******************************************************************************/
+const presence_config_stage_stats_s *presence_config_stage_get_stats(void);
+
+#endif /* SOURCE_PRESENCE_CONFIG_STAGE_H_ */
@@ -0,0 +1,223 @@
+/*****************************************************************************
+ * File name: presence_event_log.c
+ *
+ * Description: This file implements a circular log of the presence events
+ *   with occupancy, transition and dwell queries
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+
+#include "presence_event_log.h"
+
+typedef struct
+{
+    presence_event_record_s records[EVENT_LOG_SIZE];
+    uint32_t head;          /* index of the oldest record */
+    uint32_t count;
+    XENSIV_RADAR_PRESENCE_TIMESTAMP first_timestamp;   /* timestamp of the oldest record */
+    XENSIV_RADAR_PRESENCE_TIMESTAMP last_timestamp;    /* timestamp of the newest record */
+} presence_event_log_state_s;
+
+static presence_event_log_state_s log_state;
+
+/*
+ * clear the event log
+ */
+void presence_event_log_init(void)
+{
+    memset(&log_state, 0, sizeof(log_state));
+}
+
+/*
+ * append a presence event
+ */
+void presence_event_log_add(const xensiv_radar_presence_event_t *event)
+{
+    presence_event_record_s *record;
+
+    if (log_state.count == EVENT_LOG_SIZE)
+    {
+        /* the next record becomes the oldest one */
+        log_state.head = (log_state.head + 1U) % EVENT_LOG_SIZE;
+        log_state.first_timestamp += log_state.records[log_state.head].delta_ms;
+        log_state.count--;
+    }
+
+    record = &log_state.records[(log_state.head + log_state.count) % EVENT_LOG_SIZE];
+    record->delta_ms = (log_state.count == 0U) ? 0U : (event->timestamp - log_state.last_timestamp);
+    record->range_bin = (int16_t)event->range_bin;
+    record->state = (uint8_t)event->state;
+    record->reserved = 0;
+
+    if (log_state.count == 0U)
+    {
+        log_state.first_timestamp = event->timestamp;
+    }
+
+    log_state.last_timestamp = event->timestamp;
+    log_state.count++;
+}
+
+/*
+ * get the number of records
+ */
+uint32_t presence_event_log_get_count(void)
+{
+    return log_state.count;
+}
+
+/*
+ * read a logged event, 0 is the newest one
+ */
+int32_t presence_event_log_get(uint32_t index, xensiv_radar_presence_event_t *event)
+{
+    const presence_event_record_s *record;
+    XENSIV_RADAR_PRESENCE_TIMESTAMP timestamp = log_state.last_timestamp;
+    uint32_t position;
+
+    if (index >= log_state.count)
+    {
+        return -1;
+    }
+
+    /* timestamps are rebuilt backwards from the newest record */
+    position = log_state.head + log_state.count - 1U;
+    for (uint32_t i = 0; i < index; ++i)
+    {
+        timestamp -= log_state.records[position % EVENT_LOG_SIZE].delta_ms;
+        position--;
+    }
+
+    record = &log_state.records[position % EVENT_LOG_SIZE];
+    event->timestamp = timestamp;
+    event->range_bin = record->range_bin;
+    event->state = (xensiv_radar_presence_state_t)record->state;
+
+    return 0;
+}
+
+/*
+ * compute the aggregates over the last window_ms
+ */
+void presence_event_log_query(XENSIV_RADAR_PRESENCE_TIMESTAMP now_ms, uint32_t window_ms,
+                              presence_event_log_stats_s *stats)
+{
+    XENSIV_RADAR_PRESENCE_TIMESTAMP timestamp = log_state.first_timestamp;
+    uint32_t dwell_ms = 0;
+    uint32_t dwell_total_ms = 0;
+    uint32_t age;
+    uint32_t next_age;
+    uint32_t duration;
+    uint8_t previous_state = (uint8_t)XENSIV_RADAR_PRESENCE_STATE_ABSENCE;
+
+    memset(stats, 0, sizeof(*stats));
+
+    if (log_state.count == 0U)
+    {
+        return;
+    }
+
+    /* ages are used instead of timestamps, so the window is not affected by timer wrap around */
+    age = now_ms - timestamp;
+    stats->covered_ms = (age < window_ms) ? age : window_ms;
+
+    for (uint32_t i = 0; i < log_state.count; ++i)
+    {
+        const presence_event_record_s *record = &log_state.records[(log_state.head + i) % EVENT_LOG_SIZE];
+
+        if (i > 0U)
+        {
+            timestamp += record->delta_ms;
+        }
+
+        age = now_ms - timestamp;
+        next_age = (i + 1U < log_state.count) ?
+                   (now_ms - (timestamp + log_state.records[(log_state.head + i + 1U) % EVENT_LOG_SIZE].delta_ms)) : 0U;
+
+        /* part of the segment from this event to the next one within the window */
+        duration = ((age < window_ms) ? age : window_ms) - ((next_age < window_ms) ? next_age : window_ms);
+
+        if (age <= window_ms)
+        {
+            stats->transitions++;
+
+            if ((record->state != (uint8_t)XENSIV_RADAR_PRESENCE_STATE_ABSENCE) &&
+                (previous_state == (uint8_t)XENSIV_RADAR_PRESENCE_STATE_ABSENCE))
+            {
+                stats->entries++;
+            }
+        }
+
+        if (record->state == (uint8_t)XENSIV_RADAR_PRESENCE_STATE_ABSENCE)
+        {
+            /* a presence period ends */
+            if (dwell_ms > 0U)
+            {
+                stats->dwell_count++;
+                dwell_total_ms += dwell_ms;
+                stats->dwell_max_ms = (dwell_ms > stats->dwell_max_ms) ? dwell_ms : stats->dwell_max_ms;
+                dwell_ms = 0;
+            }
+        }
+        else
+        {
+            if (record->state == (uint8_t)XENSIV_RADAR_PRESENCE_STATE_MACRO_PRESENCE)
+            {
+                stats->macro_ms += duration;
+            }
+            else
+            {
+                stats->micro_ms += duration;
+            }
+
+            /* macro and micro presence belong to the same period */
+            dwell_ms += duration;
+        }
+
+        previous_state = record->state;
+    }
+
+    if (dwell_ms > 0U)
+    {
+        stats->dwell_count++;
+        dwell_total_ms += dwell_ms;
+        stats->dwell_max_ms = (dwell_ms > stats->dwell_max_ms) ? dwell_ms : stats->dwell_max_ms;
+    }
+
+    if (stats->dwell_count > 0U)
+    {
+        stats->dwell_mean_ms = dwell_total_ms / stats->dwell_count;
+    }
+}
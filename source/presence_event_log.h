@@ -0,0 +1,144 @@
+/*****************************************************************************
+ * File name: presence_event_log.h
+ *
+ * Description: This file contains types and function prototypes of the
+ *   presence event log and its occupancy queries
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_PRESENCE_EVENT_LOG_H_
+#define SOURCE_PRESENCE_EVENT_LOG_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "xensiv_radar_presence.h"
+
+/*
+ * @def EVENT_LOG_SIZE
+ * Number of records kept, the oldest record is overwritten when the log is full
+ */
+#define EVENT_LOG_SIZE                      (256U)
+
+/*
+ * @typedef typedef struct presence_event_record_s
+ * Compact event record, 8 bytes
+ */
+typedef struct
+{
+    uint32_t delta_ms;      /*<< time since the previous record*/
+    int16_t range_bin;      /*<< reported range bin*/
+    uint8_t state;          /*<< xensiv_radar_presence_state_t*/
+    uint8_t reserved;
+} presence_event_record_s;
+
+/*
+ * @typedef typedef struct presence_event_log_stats_s
+ * Aggregates over a time window ending now
+ */
+typedef struct
+{
+    uint32_t covered_ms;    /*<< part of the window covered by the log*/
+    uint32_t macro_ms;      /*<< time in macro presence*/
+    uint32_t micro_ms;      /*<< time in micro presence*/
+    uint32_t transitions;   /*<< reported events*/
+    uint32_t entries;       /*<< transitions from absence to presence*/
+    uint32_t dwell_count;   /*<< presence periods, a period still going on counts*/
+    uint32_t dwell_mean_ms; /*<< mean duration of the presence periods*/
+    uint32_t dwell_max_ms;  /*<< longest presence period*/
+} presence_event_log_stats_s;
+
+
+/*******************************************************************************
+ * Function Name: presence_event_log_init
+ ****************************************************************************//**
+ *
+ * @brief Clears the event log.
+ *
+ *******************************************************************************/
+void presence_event_log_init(void);
+
+/*******************************************************************************
+ * Function Name: presence_event_log_add
+ ****************************************************************************//**
+ *
+ * @brief Appends a presence event.
+ *
+ * @param event Reported event.
+ *
+ *******************************************************************************/
+void presence_event_log_add(const xensiv_radar_presence_event_t *event);
+
+/*******************************************************************************
+ * Function Name: presence_event_log_get_count
+ ****************************************************************************//**
+ *
+ * @return Number of records in the log.
+ *
+ *******************************************************************************/
+uint32_t presence_event_log_get_count(void);
+
+/*******************************************************************************
+ * Function Name: presence_event_log_get
+ ****************************************************************************//**
+ *
+ * @brief Reads a logged event.
+ *
+ * @param index 0 for the newest event, count - 1 for the oldest one.
+ * @param event Logged event with absolute timestamp.
+ *
+ * @return 0 on success, -1 if the index is out of range.
+ *
+ *******************************************************************************/
+int32_t presence_event_log_get(uint32_t index, xensiv_radar_presence_event_t *event);
+
+/*******************************************************************************
+ * Function Name: presence_event_log_query
+ ****************************************************************************//**
+ *
+ * @brief Computes occupancy, transition and dwell statistics over the window
+ * [now - window_ms, now]. Before the first logged event the scene is taken as
+ * absent. A presence period, macro and micro presence together, counts if it
+ * overlaps the window, with its duration clipped to the window, and a period
+ * still going on counts up to now.
+ *
+ * @param now_ms Current timestamp.
+ * @param window_ms Length of the window.
+ * @param stats Aggregates.
+ *
+ *******************************************************************************/
+void presence_event_log_query(XENSIV_RADAR_PRESENCE_TIMESTAMP now_ms, uint32_t window_ms,
+                              presence_event_log_stats_s *stats);
+
+#endif /* SOURCE_PRESENCE_EVENT_LOG_H_ */
@@ -42,6 +42,26 @@
 #include "radar_low_framerate_config.h"
 #include "xensiv_radar_presence.h"
 
+/* Max range min - max */
+#define MAX_RANGE_MIN_LIMIT (0.66f)
+#define MAX_RANGE_MAX_LIMIT (5.0f)
+
+/* Macro threshold min - max */
+#define MACRO_THRESHOLD_MIN_LIMIT (0.5f)
+#define MACRO_THRESHOLD_MAX_LIMIT (2.0f)
+
+/* Micro threshold min - max */
+#define MICRO_THRESHOLD_MIN_LIMIT (0.2f)
+#define MICRO_THRESHOLD_MAX_LIMIT (50.0f)
+
+/* Macro compare interval min - max in ms */
+#define MACRO_COMPARE_INTERVAL_MIN_LIMIT (100U)
+#define MACRO_COMPARE_INTERVAL_MAX_LIMIT (2000U)
+
+/* Micro FFT size min - max, a power of two */
+#define MICRO_FFT_SIZE_MIN_LIMIT (32U)
+#define MICRO_FFT_SIZE_MAX_LIMIT (256U)
+
 #if defined(XENSIV_RADAR_PRESENCE_SETTINGS_H_IMPL)
 static const xensiv_radar_presence_config_t default_config =
 {
@@ -0,0 +1,504 @@
+/*****************************************************************************
+ * File name: presence_tracker.c
+ *
+ * Description: This file implements a lightweight multi-target tracker on top
+ *   of the macro FFT buffer of the presence algorithm
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+
+#include "presence_tracker.h"
+
+/* Process noise: standard deviation of the target acceleration in m/s^2 */
+#define TRACKER_ACCEL_STD                   (0.5f)
+
+/* Initial velocity standard deviation of a new track in m/s */
+#define TRACKER_INIT_VELOCITY_STD           (1.0f)
+
+/* Largest time step accepted for the prediction in seconds */
+#define TRACKER_MAX_DT_S                    (1.0f)
+
+static presence_tracker_s live_tracker;
+
+static float32_t tracker_threshold = TRACKER_DEFAULT_THRESHOLD;
+
+/*******************************************************************************
+ * Function Name: tracker_pick_peaks
+ ****************************************************************************//**
+ *
+ * @brief Picks the strongest local maxima of the frame to frame change inside
+ * the gate and converts them into ranges with parabolic interpolation.
+ *
+ * @param tracker Tracker instance.
+ * @param first_bin First bin of the change buffer.
+ * @param num_bins Number of bins in the change buffer.
+ *
+ *******************************************************************************/
+static void tracker_pick_peaks(presence_tracker_s *tracker, int32_t first_bin, int32_t num_bins)
+{
+    const float32_t *change = tracker->change;
+
+    tracker->num_detections = 0;
+
+    for (int32_t i = 0; i < num_bins; i++)
+    {
+        float32_t c = change[i];
+        float32_t l = (i > 0) ? change[i - 1] : 0.0f;
+        float32_t r = (i < (num_bins - 1)) ? change[i + 1] : 0.0f;
+        float32_t denom;
+        float32_t offset = 0.0f;
+        uint32_t pos;
+
+        if ((c < tracker_threshold) || (c <= l) || (c < r))
+        {
+            continue;
+        }
+
+        denom = l - (2.0f * c) + r;
+        if (denom < 0.0f)
+        {
+            offset = 0.5f * (l - r) / denom;
+        }
+
+        /* keep the detections sorted by strength, drop the weakest */
+        pos = tracker->num_detections;
+        while ((pos > 0U) && (tracker->det_strength[pos - 1U] < c))
+        {
+            if (pos < TRACKER_MAX_TARGETS)
+            {
+                tracker->det_strength[pos] = tracker->det_strength[pos - 1U];
+                tracker->det_range[pos] = tracker->det_range[pos - 1U];
+            }
+            pos--;
+        }
+
+        if (pos < TRACKER_MAX_TARGETS)
+        {
+            tracker->det_strength[pos] = c;
+            tracker->det_range[pos] = ((float32_t)(first_bin + i) + offset) * tracker->bin_length;
+            if (tracker->num_detections < TRACKER_MAX_TARGETS)
+            {
+                tracker->num_detections++;
+            }
+        }
+    }
+
+    memset(tracker->det_used, 0, sizeof(tracker->det_used));
+}
+
+/*******************************************************************************
+ * Function Name: tracker_predict
+ ****************************************************************************//**
+ *
+ * @brief Kalman prediction of all tracks with a constant velocity model.
+ *
+ * @param tracker Tracker instance.
+ * @param dt Time step in seconds.
+ *
+ *******************************************************************************/
+static void tracker_predict(presence_tracker_s *tracker, float32_t dt)
+{
+    presence_tracks_s *t = &tracker->tracks;
+    const float32_t q = TRACKER_ACCEL_STD * TRACKER_ACCEL_STD;
+    const float32_t dt2 = dt * dt;
+    const float32_t q_rr = 0.25f * dt2 * dt2 * q;
+    const float32_t q_rv = 0.5f * dt2 * dt * q;
+    const float32_t q_vv = dt2 * q;
+
+    for (uint32_t i = 0; i < t->count; i++)
+    {
+        t->range[i] += t->velocity[i] * dt;
+        t->p_rr[i] += (dt * ((2.0f * t->p_rv[i]) + (dt * t->p_vv[i]))) + q_rr;
+        t->p_rv[i] += (dt * t->p_vv[i]) + q_rv;
+        t->p_vv[i] += q_vv;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: tracker_copy
+ ****************************************************************************//**
+ *
+ * @brief Copies a track from one slot to another.
+ *
+ * @param tracker Tracker instance.
+ * @param dst Destination slot.
+ * @param src Source slot.
+ *
+ *******************************************************************************/
+static void tracker_copy(presence_tracker_s *tracker, uint32_t dst, uint32_t src)
+{
+    presence_tracks_s *t = &tracker->tracks;
+
+    t->id[dst] = t->id[src];
+    t->range[dst] = t->range[src];
+    t->velocity[dst] = t->velocity[src];
+    t->p_rr[dst] = t->p_rr[src];
+    t->p_rv[dst] = t->p_rv[src];
+    t->p_vv[dst] = t->p_vv[src];
+    t->hits[dst] = t->hits[src];
+    t->last_hit_ms[dst] = t->last_hit_ms[src];
+}
+
+/*******************************************************************************
+ * Function Name: tracker_remove
+ ****************************************************************************//**
+ *
+ * @brief Removes a track by moving the last track into its slot.
+ *
+ * @param tracker Tracker instance.
+ * @param slot Slot of the track to be removed.
+ *
+ *******************************************************************************/
+static void tracker_remove(presence_tracker_s *tracker, uint32_t slot)
+{
+    presence_tracks_s *t = &tracker->tracks;
+
+    tracker_copy(tracker, slot, t->count - 1U);
+    t->count--;
+}
+
+/*******************************************************************************
+ * Function Name: tracker_update
+ ****************************************************************************//**
+ *
+ * @brief Associates one track with the closest free detection inside the
+ * gate and runs the Kalman update.
+ *
+ * @param tracker Tracker instance.
+ * @param i Slot of the track.
+ * @param time_ms Timestamp of the frame.
+ *
+ *******************************************************************************/
+static void tracker_update(presence_tracker_s *tracker, uint32_t i, XENSIV_RADAR_PRESENCE_TIMESTAMP time_ms)
+{
+    presence_tracks_s *t = &tracker->tracks;
+    int32_t best = -1;
+    float32_t best_dist = TRACKER_GATE_BINS * tracker->bin_length;
+
+    for (uint32_t d = 0; d < tracker->num_detections; d++)
+    {
+        float32_t dist = fabsf(tracker->det_range[d] - t->range[i]);
+
+        if (!tracker->det_used[d] && (dist < best_dist))
+        {
+            best = (int32_t)d;
+            best_dist = dist;
+        }
+    }
+
+    if (best >= 0)
+    {
+        float32_t innovation = tracker->det_range[best] - t->range[i];
+        float32_t s = t->p_rr[i] + tracker->meas_var;
+        float32_t k_r = t->p_rr[i] / s;
+        float32_t k_v = t->p_rv[i] / s;
+
+        t->range[i] += k_r * innovation;
+        t->velocity[i] += k_v * innovation;
+        t->p_vv[i] -= k_v * t->p_rv[i];
+        t->p_rr[i] *= (1.0f - k_r);
+        t->p_rv[i] *= (1.0f - k_r);
+
+        if (t->hits[i] < UINT8_MAX)
+        {
+            t->hits[i]++;
+        }
+        t->last_hit_ms[i] = time_ms;
+        tracker->det_used[best] = true;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: tracker_associate
+ ****************************************************************************//**
+ *
+ * @brief Associates every track with the closest free detection inside the
+ * gate and runs the Kalman update. Confirmed tracks are served first.
+ *
+ * @param tracker Tracker instance.
+ * @param time_ms Timestamp of the frame.
+ *
+ *******************************************************************************/
+static void tracker_associate(presence_tracker_s *tracker, XENSIV_RADAR_PRESENCE_TIMESTAMP time_ms)
+{
+    for (uint32_t pass = 0; pass < 2U; pass++)
+    {
+        for (uint32_t i = 0; i < tracker->tracks.count; i++)
+        {
+            if (presence_tracker_is_confirmed(tracker, i) == (pass == 0U))
+            {
+                tracker_update(tracker, i, time_ms);
+            }
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function Name: tracker_hold
+ ****************************************************************************//**
+ *
+ * @brief Keeps the confirmed tracks at the range bin of a reported micro
+ * presence alive. They are not associated with a detection in this frame, as
+ * a person who sits still does not change the macro FFT buffer, and are held
+ * at rest.
+ *
+ * @param tracker Tracker instance.
+ * @param range_bin Range bin of the micro presence.
+ * @param time_ms Timestamp of the frame.
+ *
+ *******************************************************************************/
+static void tracker_hold(presence_tracker_s *tracker, int32_t range_bin, XENSIV_RADAR_PRESENCE_TIMESTAMP time_ms)
+{
+    presence_tracks_s *t = &tracker->tracks;
+    float32_t range = (float32_t)range_bin * tracker->bin_length;
+
+    for (uint32_t i = 0; i < t->count; i++)
+    {
+        if (presence_tracker_is_confirmed(tracker, i) && (t->last_hit_ms[i] != time_ms) &&
+            (fabsf(t->range[i] - range) < (TRACKER_GATE_BINS * tracker->bin_length)))
+        {
+            t->velocity[i] = 0.0f;
+            t->last_hit_ms[i] = time_ms;
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function Name: tracker_manage
+ ****************************************************************************//**
+ *
+ * @brief Deletes stale tracks and starts new tracks from free detections.
+ *
+ * @param tracker Tracker instance.
+ * @param time_ms Timestamp of the frame.
+ *
+ *******************************************************************************/
+static void tracker_manage(presence_tracker_s *tracker, XENSIV_RADAR_PRESENCE_TIMESTAMP time_ms)
+{
+    presence_tracks_s *t = &tracker->tracks;
+    uint32_t i = 0;
+
+    while (i < t->count)
+    {
+        if ((time_ms - t->last_hit_ms[i]) > TRACKER_DELETE_MS)
+        {
+            tracker_remove(tracker, i);
+        }
+        else
+        {
+            i++;
+        }
+    }
+
+    /* tracks that converged onto the same target are merged into the older one */
+    for (i = 0; i < t->count; i++)
+    {
+        uint32_t j = i + 1U;
+
+        while (j < t->count)
+        {
+            if (fabsf(t->range[i] - t->range[j]) < (TRACKER_MERGE_BINS * tracker->bin_length))
+            {
+                if (t->hits[j] > t->hits[i])
+                {
+                    tracker_copy(tracker, i, j);
+                }
+                tracker_remove(tracker, j);
+            }
+            else
+            {
+                j++;
+            }
+        }
+    }
+
+    for (uint32_t d = 0; (d < tracker->num_detections) && (t->count < TRACKER_MAX_TARGETS); d++)
+    {
+        uint32_t slot = t->count;
+
+        if (tracker->det_used[d])
+        {
+            continue;
+        }
+
+        if (tracker->next_id == 0U)
+        {
+            tracker->next_id = 1U;
+        }
+
+        t->id[slot] = tracker->next_id++;
+        t->range[slot] = tracker->det_range[d];
+        t->velocity[slot] = 0.0f;
+        t->p_rr[slot] = tracker->meas_var;
+        t->p_rv[slot] = 0.0f;
+        t->p_vv[slot] = TRACKER_INIT_VELOCITY_STD * TRACKER_INIT_VELOCITY_STD;
+        t->hits[slot] = 1U;
+        t->last_hit_ms[slot] = time_ms;
+        t->count++;
+    }
+}
+
+/*
+ * initialize the tracker
+ */
+int32_t presence_tracker_init(presence_tracker_s *tracker, int32_t num_range_bins, float32_t bin_length)
+{
+    if ((num_range_bins <= 0) || (num_range_bins > TRACKER_MAX_RANGE_BINS) || (bin_length <= 0.0f))
+    {
+        return -1;
+    }
+
+    memset(tracker, 0, sizeof(*tracker));
+
+    tracker->num_range_bins = num_range_bins;
+    tracker->bin_length = bin_length;
+    /* uniform quantization error of one range bin */
+    tracker->meas_var = (bin_length * bin_length) / 12.0f;
+    tracker->next_id = 1U;
+
+    return 0;
+}
+
+/*
+ * get the live tracker
+ */
+presence_tracker_s *presence_tracker_get_live(void)
+{
+    return &live_tracker;
+}
+
+/*
+ * set the detection threshold
+ */
+int32_t presence_tracker_set_threshold(float32_t threshold)
+{
+    if ((threshold < TRACKER_MIN_THRESHOLD) || (threshold > TRACKER_MAX_THRESHOLD))
+    {
+        return -1;
+    }
+
+    tracker_threshold = threshold;
+
+    return 0;
+}
+
+/*
+ * get the detection threshold
+ */
+float32_t presence_tracker_get_threshold(void)
+{
+    return tracker_threshold;
+}
+
+/*
+ * run one tracker iteration
+ */
+void presence_tracker_process(presence_tracker_s *tracker,
+                              const cfloat32_t *macro_fft_buff,
+                              const range_gate_s *gate,
+                              xensiv_radar_presence_state_t state,
+                              int32_t range_bin,
+                              XENSIV_RADAR_PRESENCE_TIMESTAMP time_ms)
+{
+    const float32_t *current = (const float32_t *)macro_fft_buff;
+    float32_t dt;
+
+    if ((tracker->num_range_bins == 0) || (macro_fft_buff == NULL))
+    {
+        return;
+    }
+
+    if (tracker->has_previous && (gate->num_bins > 0))
+    {
+        /* frame to frame change of the gated bins, static reflectors cancel out */
+        arm_sub_f32(&current[2 * gate->first_bin], &tracker->previous[2 * gate->first_bin],
+                    tracker->diff, 2U * (uint32_t)gate->num_bins);
+        arm_cmplx_mag_f32(tracker->diff, tracker->change, (uint32_t)gate->num_bins);
+
+        dt = (float32_t)(time_ms - tracker->last_time_ms) / 1000.0f;
+        if (dt > TRACKER_MAX_DT_S)
+        {
+            dt = TRACKER_MAX_DT_S;
+        }
+
+        tracker_pick_peaks(tracker, gate->first_bin, gate->num_bins);
+        tracker_predict(tracker, dt);
+        tracker_associate(tracker, time_ms);
+        if (state == XENSIV_RADAR_PRESENCE_STATE_MICRO_PRESENCE)
+        {
+            tracker_hold(tracker, range_bin, time_ms);
+        }
+        tracker_manage(tracker, time_ms);
+    }
+
+    arm_copy_f32(current, tracker->previous, 2U * (uint32_t)tracker->num_range_bins);
+    tracker->last_time_ms = time_ms;
+    tracker->has_previous = true;
+}
+
+/*
+ * get the track table
+ */
+const presence_tracks_s *presence_tracker_get_tracks(const presence_tracker_s *tracker)
+{
+    return &tracker->tracks;
+}
+
+/*
+ * check if a track is confirmed
+ */
+bool presence_tracker_is_confirmed(const presence_tracker_s *tracker, uint32_t slot)
+{
+    return (slot < tracker->tracks.count) &&
+           (tracker->tracks.hits[slot] >= TRACKER_CONFIRM_HITS);
+}
+
+/*
+ * get the number of confirmed tracks
+ */
+uint32_t presence_tracker_get_count(const presence_tracker_s *tracker)
+{
+    uint32_t count = 0;
+
+    for (uint32_t i = 0; i < tracker->tracks.count; i++)
+    {
+        if (presence_tracker_is_confirmed(tracker, i))
+        {
+            count++;
+        }
+    }
+
+    return count;
+}
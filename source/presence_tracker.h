@@ -0,0 +1,260 @@
+/*****************************************************************************
+ * File name: presence_tracker.h
+ *
+ * Description: This file contains types and function prototypes of the
+ *   multi-target tracker
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_PRESENCE_TRACKER_H_
+#define SOURCE_PRESENCE_TRACKER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "arm_math.h"
+#include "xensiv_radar_presence.h"
+#include "range_gate.h"
+
+/*
+ * @def TRACKER_MAX_TARGETS
+ * Capacity of the track table
+ */
+#define TRACKER_MAX_TARGETS                 (8)
+
+/*
+ * @def TRACKER_MAX_RANGE_BINS
+ * Largest supported macro FFT buffer
+ */
+#define TRACKER_MAX_RANGE_BINS              (64)
+
+/*
+ * @def TRACKER_CONFIRM_HITS
+ * Number of associated detections before a track is reported
+ */
+#define TRACKER_CONFIRM_HITS                (3)
+
+/*
+ * @def TRACKER_DELETE_MS
+ * Time without associated detection after which a track is deleted
+ */
+#define TRACKER_DELETE_MS                   (3000U)
+
+/*
+ * @def TRACKER_DEFAULT_THRESHOLD
+ * Default detection threshold of the peak picking
+ */
+#define TRACKER_DEFAULT_THRESHOLD           (0.5f)
+
+/*
+ * @def TRACKER_MIN_THRESHOLD
+ * Smallest detection threshold
+ */
+#define TRACKER_MIN_THRESHOLD               (0.1f)
+
+/*
+ * @def TRACKER_MAX_THRESHOLD
+ * Largest detection threshold
+ */
+#define TRACKER_MAX_THRESHOLD               (5.0f)
+
+/*
+ * @def TRACKER_GATE_BINS
+ * Association gate around the predicted range in range bins
+ */
+#define TRACKER_GATE_BINS                   (1.5f)
+
+/*
+ * @def TRACKER_MERGE_BINS
+ * Tracks closer than this distance in range bins are merged
+ */
+#define TRACKER_MERGE_BINS                  (0.75f)
+
+/*
+ * @typedef typedef struct presence_tracks_s
+ * Fixed-capacity track table in structure-of-arrays layout. Every array is
+ * indexed by the track slot, slots [0, count) are in use.
+ */
+typedef struct
+{
+    uint32_t count;                                     /*<< number of tracks in use*/
+    uint16_t id[TRACKER_MAX_TARGETS];                   /*<< track identifier*/
+    float32_t range[TRACKER_MAX_TARGETS];               /*<< filtered range in meters*/
+    float32_t velocity[TRACKER_MAX_TARGETS];            /*<< filtered radial velocity in m/s, positive moving away*/
+    float32_t p_rr[TRACKER_MAX_TARGETS];                /*<< range variance*/
+    float32_t p_rv[TRACKER_MAX_TARGETS];                /*<< range/velocity covariance*/
+    float32_t p_vv[TRACKER_MAX_TARGETS];                /*<< velocity variance*/
+    uint8_t hits[TRACKER_MAX_TARGETS];                  /*<< associated detections, saturating*/
+    XENSIV_RADAR_PRESENCE_TIMESTAMP last_hit_ms[TRACKER_MAX_TARGETS]; /*<< time of the last associated detection*/
+} presence_tracks_s;
+
+/*
+ * @typedef typedef struct presence_tracker_s
+ * Tracker instance, the track table and the previous macro FFT buffer
+ */
+typedef struct
+{
+    presence_tracks_s tracks;
+    int32_t num_range_bins;
+    float32_t bin_length;
+    float32_t meas_var;
+    uint16_t next_id;
+    bool has_previous;
+    XENSIV_RADAR_PRESENCE_TIMESTAMP last_time_ms;
+    float32_t previous[2 * TRACKER_MAX_RANGE_BINS];
+    float32_t diff[2 * TRACKER_MAX_RANGE_BINS];
+    float32_t change[TRACKER_MAX_RANGE_BINS];
+    uint32_t num_detections;
+    float32_t det_range[TRACKER_MAX_TARGETS];
+    float32_t det_strength[TRACKER_MAX_TARGETS];
+    bool det_used[TRACKER_MAX_TARGETS];
+} presence_tracker_s;
+
+/*******************************************************************************
+ * Function Name: presence_tracker_init
+ ****************************************************************************//**
+ *
+ * @brief Initializes a tracker and clears all tracks. The detection
+ * threshold is kept.
+ *
+ * @param tracker Tracker instance.
+ * @param num_range_bins Number of bins of the macro FFT buffer.
+ * @param bin_length Length of one range bin in meters.
+ *
+ * @return 0 on success, -1 on invalid parameters.
+ *
+ *******************************************************************************/
+int32_t presence_tracker_init(presence_tracker_s *tracker, int32_t num_range_bins, float32_t bin_length);
+
+/*******************************************************************************
+ * Function Name: presence_tracker_get_live
+ ****************************************************************************//**
+ *
+ * @return The tracker instance of the live detection.
+ *
+ *******************************************************************************/
+presence_tracker_s *presence_tracker_get_live(void);
+
+/*******************************************************************************
+ * Function Name: presence_tracker_set_threshold
+ ****************************************************************************//**
+ *
+ * @brief Sets the detection threshold used by the peak picking. The tracker
+ * has its own threshold, the macro threshold of the presence algorithm
+ * applies to a different signal.
+ *
+ * @param threshold Detection threshold.
+ *
+ * @return 0 on success, -1 if the threshold is out of range.
+ *
+ *******************************************************************************/
+int32_t presence_tracker_set_threshold(float32_t threshold);
+
+/*******************************************************************************
+ * Function Name: presence_tracker_get_threshold
+ ****************************************************************************//**
+ *
+ * @return Detection threshold of the peak picking.
+ *
+ *******************************************************************************/
+float32_t presence_tracker_get_threshold(void);
+
+/*******************************************************************************
+ * Function Name: presence_tracker_process
+ ****************************************************************************//**
+ *
+ * @brief Runs one tracker iteration: picks the peaks of the frame to frame
+ * change of the macro FFT buffer inside the range gate, predicts all tracks,
+ * associates the detections and updates the Kalman filter of every track.
+ * A person who sits still barely changes the macro FFT buffer, so while the
+ * presence algorithm reports micro presence, confirmed tracks within the
+ * association gate of the reported range bin are held at rest instead of
+ * being deleted.
+ *
+ * @param tracker Tracker instance.
+ * @param macro_fft_buff Macro FFT buffer of the presence algorithm.
+ * @param gate Range bins to be searched.
+ * @param state Presence state reported last.
+ * @param range_bin Range bin of the presence state reported last.
+ * @param time_ms Timestamp of the frame.
+ *
+ *******************************************************************************/
+void presence_tracker_process(presence_tracker_s *tracker,
+                              const cfloat32_t *macro_fft_buff,
+                              const range_gate_s *gate,
+                              xensiv_radar_presence_state_t state,
+                              int32_t range_bin,
+                              XENSIV_RADAR_PRESENCE_TIMESTAMP time_ms);
+
+/*******************************************************************************
+ * Function Name: presence_tracker_get_tracks
+ ****************************************************************************//**
+ *
+ * @brief Returns the track table.
+ *
+ * @param tracker Tracker instance.
+ *
+ * @return Pointer to the track table.
+ *
+ *******************************************************************************/
+const presence_tracks_s *presence_tracker_get_tracks(const presence_tracker_s *tracker);
+
+/*******************************************************************************
+ * Function Name: presence_tracker_is_confirmed
+ ****************************************************************************//**
+ *
+ * @brief Checks if the track in a slot is confirmed.
+ *
+ * @param tracker Tracker instance.
+ * @param slot Track slot.
+ *
+ * @return true if the track has been confirmed.
+ *
+ *******************************************************************************/
+bool presence_tracker_is_confirmed(const presence_tracker_s *tracker, uint32_t slot);
+
+/*******************************************************************************
+ * Function Name: presence_tracker_get_count
+ ****************************************************************************//**
+ *
+ * @brief Returns the number of confirmed tracks, i.e. the number of people.
+ *
+ * @param tracker Tracker instance.
+ *
+ * @return Number of confirmed tracks.
+ *
+ *******************************************************************************/
+uint32_t presence_tracker_get_count(const presence_tracker_s *tracker);
+
+#endif /* SOURCE_PRESENCE_TRACKER_H_ */
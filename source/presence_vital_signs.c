@@ -0,0 +1,313 @@
+/*****************************************************************************
+ * File name: presence_vital_signs.c
+ *
+ * Description: This file implements the breathing rate estimation on the
+ *   phase of the range bin of a person in micro presence
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+
+#include "presence_vital_signs.h"
+
+/* Band-pass corner frequencies in Hz: high-pass removes drift of the unwrapped
+ * phase, low-pass removes heartbeat and residual motion */
+#define VITAL_HIGHPASS_HZ                   (0.1f)
+#define VITAL_LOWPASS_HZ                    (0.6f)
+#define VITAL_BIQUAD_Q                      (0.7071f)
+
+/* Damping of the sliding DFT, keeps the recursion stable in float */
+#define VITAL_SDFT_DAMPING                  (0.9999f)
+
+/* A frame gap longer than this restarts the history */
+#define VITAL_MAX_GAP_MS                    (1000U)
+
+static presence_vital_signs_state_s live_vital;
+
+/*******************************************************************************
+ * Function Name: vital_design_biquad
+ ****************************************************************************//**
+ *
+ * @brief Designs a second order Butterworth section in the CMSIS DF2T
+ * coefficient order {b0, b1, b2, -a1, -a2}.
+ *
+ * @param coeffs Five coefficients of the section.
+ * @param corner_hz Corner frequency in Hz.
+ * @param highpass true for a high-pass, false for a low-pass.
+ *
+ *******************************************************************************/
+static void vital_design_biquad(float32_t *coeffs, float32_t corner_hz, bool highpass)
+{
+    float32_t sample_rate = 1000.0f / (float32_t)VITAL_SAMPLE_PERIOD_MS;
+    float32_t w0 = 2.0f * PI * corner_hz / sample_rate;
+    float32_t cos_w0 = arm_cos_f32(w0);
+    float32_t alpha = arm_sin_f32(w0) / (2.0f * VITAL_BIQUAD_Q);
+    float32_t a0 = 1.0f + alpha;
+    float32_t b = highpass ? ((1.0f + cos_w0) / 2.0f) : ((1.0f - cos_w0) / 2.0f);
+
+    coeffs[0] = b / a0;
+    coeffs[1] = (highpass ? (-2.0f * b) : (2.0f * b)) / a0;
+    coeffs[2] = b / a0;
+    coeffs[3] = (2.0f * cos_w0) / a0;
+    coeffs[4] = -(1.0f - alpha) / a0;
+}
+
+/*******************************************************************************
+ * Function Name: vital_push_sample
+ ****************************************************************************//**
+ *
+ * @brief Filters one decimated phase sample and updates the sliding DFT bank.
+ *
+ * @param vital Estimator instance.
+ * @param phase Decimated unwrapped phase.
+ *
+ *******************************************************************************/
+static void vital_push_sample(presence_vital_signs_state_s *vital, float32_t phase)
+{
+    float32_t x;
+    float32_t x_old = vital->window[vital->window_index];
+    float32_t *spectrum = vital->spectrum;
+
+    arm_biquad_cascade_df2T_f32(&vital->bandpass, &phase, &x, 1U);
+
+    /* the filter transient is kept out of the window */
+    if (vital->num_samples < VITAL_SETTLE_SAMPLES)
+    {
+        vital->num_samples++;
+        return;
+    }
+
+    /* S = e^jw * (r * S + x[n] - r^N * e^jwN * x[n - N]) */
+    for (uint32_t k = 0; k < VITAL_NUM_RATES; k++)
+    {
+        float32_t re = (VITAL_SDFT_DAMPING * spectrum[2U * k]) + x -
+                       (vital->damping_n * vital->wrap[2U * k] * x_old);
+        float32_t im = (VITAL_SDFT_DAMPING * spectrum[(2U * k) + 1U]) -
+                       (vital->damping_n * vital->wrap[(2U * k) + 1U] * x_old);
+        float32_t c = vital->rotation[2U * k];
+        float32_t s = vital->rotation[(2U * k) + 1U];
+
+        spectrum[2U * k] = (re * c) - (im * s);
+        spectrum[(2U * k) + 1U] = (re * s) + (im * c);
+    }
+
+    vital->window[vital->window_index] = x;
+    vital->window_index = (vital->window_index + 1U) % VITAL_WINDOW_LENGTH;
+    vital->num_samples++;
+}
+
+/*
+ * initialize the breathing rate estimation
+ */
+int32_t presence_vital_signs_init(presence_vital_signs_state_s *vital)
+{
+    float32_t sample_rate = 1000.0f / (float32_t)VITAL_SAMPLE_PERIOD_MS;
+
+    memset(vital, 0, sizeof(*vital));
+
+    vital_design_biquad(&vital->bandpass_coeffs[0], VITAL_HIGHPASS_HZ, true);
+    vital_design_biquad(&vital->bandpass_coeffs[5], VITAL_LOWPASS_HZ, false);
+    arm_biquad_cascade_df2T_init_f32(&vital->bandpass, VITAL_NUM_STAGES,
+                                     vital->bandpass_coeffs, vital->bandpass_state);
+
+    for (uint32_t k = 0; k < VITAL_NUM_RATES; k++)
+    {
+        float32_t w = 2.0f * PI * ((float32_t)(VITAL_MIN_RATE_BPM + k) / 60.0f) / sample_rate;
+        float32_t wn = fmodf(w * (float32_t)VITAL_WINDOW_LENGTH, 2.0f * PI);
+
+        vital->rotation[2U * k] = arm_cos_f32(w);
+        vital->rotation[(2U * k) + 1U] = arm_sin_f32(w);
+        vital->wrap[2U * k] = arm_cos_f32(wn);
+        vital->wrap[(2U * k) + 1U] = arm_sin_f32(wn);
+    }
+
+    vital->damping_n = powf(VITAL_SDFT_DAMPING, (float32_t)VITAL_WINDOW_LENGTH);
+
+    return 0;
+}
+
+/*
+ * get the live estimator
+ */
+presence_vital_signs_state_s *presence_vital_signs_get_live(void)
+{
+    return &live_vital;
+}
+
+/*
+ * enable or disable the breathing rate estimation
+ */
+void presence_vital_signs_enable(presence_vital_signs_state_s *vital, bool enable)
+{
+    presence_vital_signs_reset(vital);
+    vital->enabled = enable;
+}
+
+/*
+ * check if the breathing rate estimation is enabled
+ */
+bool presence_vital_signs_is_enabled(const presence_vital_signs_state_s *vital)
+{
+    return vital->enabled;
+}
+
+/*
+ * clear the phase history
+ */
+void presence_vital_signs_reset(presence_vital_signs_state_s *vital)
+{
+    vital->started = false;
+    vital->num_samples = 0;
+    vital->window_index = 0;
+    memset(vital->bandpass_state, 0, sizeof(vital->bandpass_state));
+    memset(vital->window, 0, sizeof(vital->window));
+    memset(vital->spectrum, 0, sizeof(vital->spectrum));
+}
+
+/*
+ * add the phase of one frame
+ */
+void presence_vital_signs_process(presence_vital_signs_state_s *vital,
+                                  const cfloat32_t *macro_fft_buff,
+                                  int32_t range_bin,
+                                  XENSIV_RADAR_PRESENCE_TIMESTAMP time_ms)
+{
+    float32_t phase;
+    float32_t delta;
+
+    if (!vital->enabled || (macro_fft_buff == NULL) || (range_bin < 0))
+    {
+        return;
+    }
+
+    if (vital->started &&
+        ((range_bin != vital->range_bin) || ((time_ms - vital->last_time_ms) > VITAL_MAX_GAP_MS)))
+    {
+        presence_vital_signs_reset(vital);
+    }
+
+    (void)arm_atan2_f32(macro_fft_buff[range_bin].imag, macro_fft_buff[range_bin].real, &phase);
+
+    if (!vital->started)
+    {
+        /* the history starts at zero phase to keep the high-pass transient small */
+        vital->started = true;
+        vital->range_bin = range_bin;
+        vital->block_start_ms = time_ms;
+        vital->previous_phase = phase;
+        vital->unwrapped_phase = 0.0f;
+        vital->block_sum = 0.0f;
+        vital->block_count = 0;
+    }
+
+    delta = phase - vital->previous_phase;
+    if (delta > PI)
+    {
+        delta -= 2.0f * PI;
+    }
+    else if (delta < -PI)
+    {
+        delta += 2.0f * PI;
+    }
+
+    vital->unwrapped_phase += delta;
+    vital->previous_phase = phase;
+    vital->last_time_ms = time_ms;
+
+    /* boxcar decimation to a fixed sample period, independent of the frame rate */
+    vital->block_sum += vital->unwrapped_phase;
+    vital->block_count++;
+
+    while ((time_ms - vital->block_start_ms) >= VITAL_SAMPLE_PERIOD_MS)
+    {
+        if (vital->block_count > 0U)
+        {
+            vital->block_sum /= (float32_t)vital->block_count;
+            vital->block_count = 0;
+        }
+
+        /* slower frames repeat the last sample */
+        vital_push_sample(vital, vital->block_sum);
+        vital->block_start_ms += VITAL_SAMPLE_PERIOD_MS;
+    }
+
+    if (vital->block_count == 0U)
+    {
+        vital->block_sum = 0.0f;
+    }
+}
+
+/*
+ * estimate the breathing rate
+ */
+bool presence_vital_signs_get(presence_vital_signs_state_s *vital, presence_vital_signs_s *result)
+{
+    float32_t energy;
+    float32_t peak;
+    float32_t offset = 0.0f;
+    uint32_t index;
+
+    if (!vital->enabled || (vital->num_samples < (VITAL_SETTLE_SAMPLES + VITAL_WINDOW_LENGTH)))
+    {
+        return false;
+    }
+
+    arm_cmplx_mag_squared_f32(vital->spectrum, vital->power, VITAL_NUM_RATES);
+    arm_max_f32(vital->power, VITAL_NUM_RATES, &peak, &index);
+    arm_power_f32(vital->window, VITAL_WINDOW_LENGTH, &energy);
+
+    if ((index > 0U) && (index < (VITAL_NUM_RATES - 1U)))
+    {
+        float32_t l = vital->power[index - 1U];
+        float32_t r = vital->power[index + 1U];
+        float32_t denom = l - (2.0f * peak) + r;
+
+        if (denom < 0.0f)
+        {
+            offset = 0.5f * (l - r) / denom;
+        }
+    }
+
+    result->range_bin = vital->range_bin;
+    result->rate_bpm = (float32_t)(VITAL_MIN_RATE_BPM + index) + offset;
+
+    /* a pure tone of the window puts (N / 2) * energy into its DFT bin */
+    result->confidence = (energy > 0.0f) ? (peak / (energy * (float32_t)VITAL_WINDOW_LENGTH / 2.0f)) : 0.0f;
+    if (result->confidence > 1.0f)
+    {
+        result->confidence = 1.0f;
+    }
+
+    return result->confidence >= VITAL_MIN_CONFIDENCE;
+}
@@ -0,0 +1,230 @@
+/*****************************************************************************
+ * File name: presence_vital_signs.h
+ *
+ * Description: This file contains types and function prototypes of the
+ *   breathing rate estimation
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_PRESENCE_VITAL_SIGNS_H_
+#define SOURCE_PRESENCE_VITAL_SIGNS_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "arm_math.h"
+#include "xensiv_radar_presence.h"
+
+/*
+ * @def VITAL_SAMPLE_PERIOD_MS
+ * Period of the decimated phase signal, independent of the frame rate
+ */
+#define VITAL_SAMPLE_PERIOD_MS              (100U)
+
+/*
+ * @def VITAL_WINDOW_LENGTH
+ * Number of decimated phase samples of the spectral estimator (25.6 s)
+ */
+#define VITAL_WINDOW_LENGTH                 (256U)
+
+/*
+ * @def VITAL_SETTLE_SAMPLES
+ * Decimated samples discarded after a restart while the band-pass settles
+ */
+#define VITAL_SETTLE_SAMPLES                (30U)
+
+/*
+ * @def VITAL_MIN_RATE_BPM
+ * Lowest breathing rate in breaths per minute
+ */
+#define VITAL_MIN_RATE_BPM                  (6U)
+
+/*
+ * @def VITAL_MAX_RATE_BPM
+ * Highest breathing rate in breaths per minute
+ */
+#define VITAL_MAX_RATE_BPM                  (36U)
+
+/*
+ * @def VITAL_MIN_CONFIDENCE
+ * Minimum share of the band limited phase energy in the breathing tone
+ */
+#define VITAL_MIN_CONFIDENCE                (0.5f)
+
+/*
+ * @def VITAL_NUM_RATES
+ * Number of breathing rates evaluated, one per breath per minute
+ */
+#define VITAL_NUM_RATES                     (VITAL_MAX_RATE_BPM - VITAL_MIN_RATE_BPM + 1U)
+
+/*
+ * @def VITAL_NUM_STAGES
+ * Number of biquad sections of the band-pass filter
+ */
+#define VITAL_NUM_STAGES                    (2U)
+
+/*
+ * @typedef typedef struct presence_vital_signs_s
+ * Breathing rate estimate
+ */
+typedef struct
+{
+    int32_t range_bin;          /*<< range bin of the observed person*/
+    float32_t rate_bpm;         /*<< breathing rate in breaths per minute*/
+    float32_t confidence;       /*<< share of the phase energy in the breathing tone, 0 to 1*/
+} presence_vital_signs_s;
+
+/*
+ * @typedef typedef struct presence_vital_signs_state_s
+ * Estimator instance, the phase history of the observed range bin
+ */
+typedef struct
+{
+    bool enabled;
+    bool started;
+    int32_t range_bin;
+    XENSIV_RADAR_PRESENCE_TIMESTAMP block_start_ms;
+    XENSIV_RADAR_PRESENCE_TIMESTAMP last_time_ms;
+    float32_t previous_phase;
+    float32_t unwrapped_phase;
+    float32_t block_sum;
+    uint32_t block_count;
+    arm_biquad_cascade_df2T_instance_f32 bandpass;
+    float32_t bandpass_coeffs[5U * VITAL_NUM_STAGES];
+    float32_t bandpass_state[2U * VITAL_NUM_STAGES];
+    float32_t window[VITAL_WINDOW_LENGTH];
+    uint32_t window_index;
+    uint32_t num_samples;
+    float32_t damping_n;
+    float32_t rotation[2U * VITAL_NUM_RATES];
+    float32_t wrap[2U * VITAL_NUM_RATES];
+    float32_t spectrum[2U * VITAL_NUM_RATES];
+    float32_t power[VITAL_NUM_RATES];
+} presence_vital_signs_state_s;
+
+
+/*******************************************************************************
+ * Function Name: presence_vital_signs_init
+ ****************************************************************************//**
+ *
+ * @brief Designs the band-pass filter and the spectral estimator of an
+ * instance and clears the history. The estimation starts disabled.
+ *
+ * @param vital Estimator instance.
+ *
+ * @return 0 on success.
+ *
+ *******************************************************************************/
+int32_t presence_vital_signs_init(presence_vital_signs_state_s *vital);
+
+/*******************************************************************************
+ * Function Name: presence_vital_signs_get_live
+ ****************************************************************************//**
+ *
+ * @return The estimator instance of the live detection.
+ *
+ *******************************************************************************/
+presence_vital_signs_state_s *presence_vital_signs_get_live(void);
+
+/*******************************************************************************
+ * Function Name: presence_vital_signs_enable
+ ****************************************************************************//**
+ *
+ * @brief Enables or disables the breathing rate estimation. The history is
+ * cleared in both cases.
+ *
+ * @param vital Estimator instance.
+ * @param enable true to enable the estimation.
+ *
+ *******************************************************************************/
+void presence_vital_signs_enable(presence_vital_signs_state_s *vital, bool enable);
+
+/*******************************************************************************
+ * Function Name: presence_vital_signs_is_enabled
+ ****************************************************************************//**
+ *
+ * @param vital Estimator instance.
+ *
+ * @return true if the breathing rate estimation is enabled.
+ *
+ *******************************************************************************/
+bool presence_vital_signs_is_enabled(const presence_vital_signs_state_s *vital);
+
+/*******************************************************************************
+ * Function Name: presence_vital_signs_reset
+ ****************************************************************************//**
+ *
+ * @brief Clears the phase history, e.g. when the person moved.
+ *
+ * @param vital Estimator instance.
+ *
+ *******************************************************************************/
+void presence_vital_signs_reset(presence_vital_signs_state_s *vital);
+
+/*******************************************************************************
+ * Function Name: presence_vital_signs_process
+ ****************************************************************************//**
+ *
+ * @brief Adds the phase of one frame. The phase of the range bin is unwrapped,
+ * averaged down to VITAL_SAMPLE_PERIOD_MS, band-pass filtered and fed into a
+ * sliding DFT bank covering VITAL_MIN_RATE_BPM to VITAL_MAX_RATE_BPM.
+ * A change of the range bin or a gap in the frames restarts the history.
+ *
+ * @param vital Estimator instance.
+ * @param macro_fft_buff Macro FFT buffer of the presence algorithm.
+ * @param range_bin Range bin of the person.
+ * @param time_ms Timestamp of the frame.
+ *
+ *******************************************************************************/
+void presence_vital_signs_process(presence_vital_signs_state_s *vital,
+                                  const cfloat32_t *macro_fft_buff,
+                                  int32_t range_bin,
+                                  XENSIV_RADAR_PRESENCE_TIMESTAMP time_ms);
+
+/*******************************************************************************
+ * Function Name: presence_vital_signs_get
+ ****************************************************************************//**
+ *
+ * @brief Estimates the breathing rate from the current window.
+ *
+ * @param vital Estimator instance.
+ * @param result Breathing rate estimate.
+ *
+ * @return true if the window is full and the confidence is at least
+ * VITAL_MIN_CONFIDENCE, false otherwise.
+ *
+ *******************************************************************************/
+bool presence_vital_signs_get(presence_vital_signs_state_s *vital, presence_vital_signs_s *result);
+
+#endif /* SOURCE_PRESENCE_VITAL_SIGNS_H_ */
@@ -0,0 +1,300 @@
+/*****************************************************************************
+ * File name: radar_aoa.c
+ *
+ * Description: This file implements the angle of arrival estimation stage
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "radar_aoa.h"
+
+#define AOA_RAD_TO_DEG                      (180.0f / PI)
+#define AOA_SPEED_OF_LIGHT                  (299792458.0f)
+
+static radar_aoa_s live_aoa;
+
+/*******************************************************************************
+ * Function Name: radar_aoa_phase_to_angle
+ ****************************************************************************//**
+ *
+ * @brief Converts the phase difference of two range bins into an angle for
+ * half wavelength antenna spacing.
+ *
+ * @param a Complex range bin of the first antenna.
+ * @param b Complex range bin of the second antenna.
+ *
+ * @return Angle in degrees.
+ *
+ *******************************************************************************/
+static float32_t radar_aoa_phase_to_angle(const float32_t *a, const float32_t *b)
+{
+    /* a * conj(b) */
+    float32_t re = (a[0] * b[0]) + (a[1] * b[1]);
+    float32_t im = (a[1] * b[0]) - (a[0] * b[1]);
+    float32_t phase;
+    float32_t ratio;
+
+    (void)arm_atan2_f32(im, re, &phase);
+
+    /* sin(theta) = delta_phi * lambda / (2 * pi * d) with d = lambda / 2 */
+    ratio = phase / PI;
+    if (ratio > 1.0f)
+    {
+        ratio = 1.0f;
+    }
+    else if (ratio < -1.0f)
+    {
+        ratio = -1.0f;
+    }
+
+    return asinf(ratio) * AOA_RAD_TO_DEG;
+}
+
+/*******************************************************************************
+ * Function Name: radar_aoa_remove_background
+ ****************************************************************************//**
+ *
+ * @brief Updates the background of an antenna while the scene is empty and
+ * subtracts it. The chirp is a time domain signal, by linearity of the range
+ * FFT this equals a complex background per range bin.
+ *
+ * @param aoa Estimator instance.
+ * @param rx Antenna.
+ * @param chirp Average chirp of the antenna.
+ * @param learn true if the background may be updated.
+ * @param alpha Weight of the chirp in the background update.
+ *
+ *******************************************************************************/
+static void radar_aoa_remove_background(radar_aoa_s *aoa, uint32_t rx, const float32_t *chirp,
+                                        bool learn, float32_t alpha)
+{
+    float32_t *background = aoa->background[rx];
+    const uint32_t num_samples = aoa->num_samples;
+
+    if (learn)
+    {
+        if (!aoa->has_background)
+        {
+            arm_copy_f32(chirp, background, num_samples);
+        }
+        else
+        {
+            /* background += alpha * (chirp - background), fft_in is free until the subtraction */
+            arm_sub_f32(chirp, background, aoa->fft_in, num_samples);
+            arm_scale_f32(aoa->fft_in, alpha, aoa->fft_in, num_samples);
+            arm_add_f32(background, aoa->fft_in, background, num_samples);
+        }
+    }
+
+    if (aoa->has_background || learn)
+    {
+        arm_sub_f32(chirp, background, aoa->fft_in, num_samples);
+    }
+    else
+    {
+        arm_copy_f32(chirp, aoa->fft_in, num_samples);
+    }
+}
+
+/*
+ * initialize an angle of arrival estimator
+ */
+int32_t radar_aoa_init(radar_aoa_s *aoa, uint32_t num_samples,
+                       float32_t bandwidth_hz, float32_t macro_bin_length_m)
+{
+    if ((num_samples > AOA_MAX_NUM_SAMPLES) || (bandwidth_hz <= 0.0f) || (macro_bin_length_m <= 0.0f))
+    {
+        return -1;
+    }
+
+    memset(aoa, 0, sizeof(*aoa));
+
+    if (arm_rfft_fast_init_f32(&aoa->rfft, (uint16_t)num_samples) != ARM_MATH_SUCCESS)
+    {
+        return -1;
+    }
+
+    aoa->num_samples = num_samples;
+
+    /* a bin of the real FFT of one chirp is c / (2 * B) long */
+    aoa->bins_per_macro_bin = macro_bin_length_m / (AOA_SPEED_OF_LIGHT / (2.0f * bandwidth_hz));
+
+    return 0;
+}
+
+/*
+ * get the live estimator
+ */
+radar_aoa_s *radar_aoa_get_live(void)
+{
+    return &live_aoa;
+}
+
+/*
+ * estimate the angle of arrival of the strongest range bins
+ */
+int32_t radar_aoa_process(radar_aoa_s *aoa,
+                          const float32_t *avg_chirps,
+                          uint32_t num_rx,
+                          const range_gate_s *gate,
+                          bool learn,
+                          uint32_t time_ms,
+                          radar_aoa_result_s *result)
+{
+    const uint32_t num_samples = aoa->num_samples;
+    const uint32_t num_bins = num_samples / 2U;
+    float32_t alpha;
+    int32_t first_bin;
+    int32_t last_bin;
+
+    if ((num_samples == 0U) || (num_rx < AOA_MIN_NUM_RX_ANTENNAS) ||
+        (avg_chirps == NULL) || (gate == NULL) || (result == NULL))
+    {
+        return -1;
+    }
+
+    result->num_targets = 0;
+
+    /* the weight follows the frame period, so the time constant holds for both frame rates */
+    alpha = (float32_t)(time_ms - aoa->last_time_ms) / (float32_t)AOA_BACKGROUND_TIME_CONSTANT_MS;
+    if (alpha > 1.0f)
+    {
+        alpha = 1.0f;
+    }
+    aoa->last_time_ms = time_ms;
+
+    /* Range spectrum of every antenna without its background, the FFT works in place on fft_in */
+    for (uint32_t rx = 0; rx < AOA_MIN_NUM_RX_ANTENNAS; rx++)
+    {
+        radar_aoa_remove_background(aoa, rx, &avg_chirps[rx * num_samples], learn, alpha);
+        arm_rfft_fast_f32(&aoa->rfft, aoa->fft_in, aoa->spectrum[rx], 0);
+    }
+
+    if (learn)
+    {
+        aoa->has_background = true;
+    }
+
+    /* Non-coherent power sum over the antennas; bin 0 holds DC and Nyquist packed */
+    arm_cmplx_mag_squared_f32(aoa->spectrum[0], aoa->power, num_bins);
+    for (uint32_t rx = 1; rx < AOA_MIN_NUM_RX_ANTENNAS; rx++)
+    {
+        arm_cmplx_mag_squared_f32(aoa->spectrum[rx], aoa->scratch, num_bins);
+        arm_add_f32(aoa->power, aoa->scratch, aoa->power, num_bins);
+    }
+    aoa->power[0] = 0.0f;
+
+    /* The gate is given in macro FFT bins, it is widened to whole bins of the chirp FFT */
+    first_bin = (int32_t)floorf((float32_t)gate->first_bin * aoa->bins_per_macro_bin);
+    last_bin = (int32_t)ceilf((float32_t)(gate->first_bin + gate->num_bins - 1) * aoa->bins_per_macro_bin);
+    if (first_bin < 1)
+    {
+        first_bin = 1;
+    }
+    if (last_bin > (int32_t)(num_bins - 2U))
+    {
+        last_bin = (int32_t)(num_bins - 2U);
+    }
+
+    /* Pick the strongest local maxima inside the gate, strongest first */
+    for (int32_t bin = first_bin; bin <= last_bin; bin++)
+    {
+        float32_t p = aoa->power[bin];
+        uint32_t pos;
+
+        if ((p <= aoa->power[bin - 1]) || (p < aoa->power[bin + 1]))
+        {
+            continue;
+        }
+
+        pos = result->num_targets;
+        while ((pos > 0U) && (result->targets[pos - 1U].magnitude < p))
+        {
+            if (pos < AOA_MAX_TARGETS)
+            {
+                result->targets[pos] = result->targets[pos - 1U];
+            }
+            pos--;
+        }
+
+        if (pos < AOA_MAX_TARGETS)
+        {
+            result->targets[pos].range_bin = bin;
+            result->targets[pos].magnitude = p;
+            if (result->num_targets < AOA_MAX_TARGETS)
+            {
+                result->num_targets++;
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < result->num_targets; i++)
+    {
+        radar_aoa_target_s *target = &result->targets[i];
+        uint32_t idx = 2U * (uint32_t)target->range_bin;
+
+        (void)arm_sqrt_f32(target->magnitude, &target->magnitude);
+        target->azimuth = radar_aoa_phase_to_angle(&aoa->spectrum[AOA_AZIMUTH_RX_A][idx],
+                                                   &aoa->spectrum[AOA_AZIMUTH_RX_B][idx]);
+        target->elevation = radar_aoa_phase_to_angle(&aoa->spectrum[AOA_ELEVATION_RX_A][idx],
+                                                     &aoa->spectrum[AOA_ELEVATION_RX_B][idx]);
+
+        /* reported in macro FFT bins, so the presence events can look the target up */
+        target->range_bin = (int32_t)lroundf((float32_t)target->range_bin / aoa->bins_per_macro_bin);
+    }
+
+    return 0;
+}
+
+/*
+ * look up the target closest to a range bin
+ */
+const radar_aoa_target_s *radar_aoa_find_target(const radar_aoa_result_s *result,
+                                                int32_t range_bin)
+{
+    const radar_aoa_target_s *closest = NULL;
+
+    for (uint32_t i = 0; i < result->num_targets; i++)
+    {
+        if ((closest == NULL) ||
+            (abs(result->targets[i].range_bin - range_bin) < abs(closest->range_bin - range_bin)))
+        {
+            closest = &result->targets[i];
+        }
+    }
+
+    return closest;
+}
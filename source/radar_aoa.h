@@ -0,0 +1,199 @@
+/*****************************************************************************
+ * File name: radar_aoa.h
+ *
+ * Description: This file contains types and function prototypes of the
+ *   angle of arrival estimation stage
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_RADAR_AOA_H_
+#define SOURCE_RADAR_AOA_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "arm_math.h"
+#include "range_gate.h"
+
+/*
+ * @def AOA_MAX_TARGETS
+ * Maximum number of range bins for which the angle is estimated per frame
+ */
+#define AOA_MAX_TARGETS                     (3)
+
+/*
+ * @def AOA_MIN_NUM_RX_ANTENNAS
+ * Number of receiving antennas needed for azimuth and elevation
+ */
+#define AOA_MIN_NUM_RX_ANTENNAS             (3)
+
+/*
+ * @def AOA_MAX_NUM_SAMPLES
+ * Largest supported chirp length
+ */
+#define AOA_MAX_NUM_SAMPLES                 (128U)
+
+/*
+ * @def AOA_BACKGROUND_TIME_CONSTANT_MS
+ * Time constant of the static background of every antenna, the same as the
+ * one of the clutter map
+ */
+#define AOA_BACKGROUND_TIME_CONSTANT_MS     (20000U)
+
+/*
+ * Antenna pairs of the BGT60TR13C L-shaped receiver array (zero based).
+ * RX1 and RX3 are placed horizontally, RX2 and RX3 vertically, both pairs
+ * with half wavelength spacing.
+ */
+#define AOA_AZIMUTH_RX_A                    (0)
+#define AOA_AZIMUTH_RX_B                    (2)
+#define AOA_ELEVATION_RX_A                  (1)
+#define AOA_ELEVATION_RX_B                  (2)
+
+/*
+ * @typedef typedef struct radar_aoa_target_s
+ * Angle of arrival of one range bin
+ */
+typedef struct
+{
+    int32_t range_bin;      /*<< macro FFT range bin of the target, as used by the presence events*/
+    float32_t magnitude;    /*<< summed magnitude of the range bin over all antennas*/
+    float32_t azimuth;      /*<< azimuth in degrees, positive towards RX1*/
+    float32_t elevation;    /*<< elevation in degrees, positive towards RX2*/
+} radar_aoa_target_s;
+
+/*
+ * @typedef typedef struct radar_aoa_result_s
+ * Angle of arrival estimation result of one frame
+ */
+typedef struct
+{
+    uint32_t num_targets;                           /*<< number of valid entries in targets*/
+    radar_aoa_target_s targets[AOA_MAX_TARGETS];    /*<< strongest range bins, strongest first*/
+} radar_aoa_result_s;
+
+
+/*
+ * @typedef typedef struct radar_aoa_s
+ * Estimator instance, the range spectra and the static background of every antenna
+ */
+typedef struct
+{
+    arm_rfft_fast_instance_f32 rfft;
+    uint32_t num_samples;
+    float32_t bins_per_macro_bin;   /*<< range bins of the chirp FFT per macro FFT bin*/
+    bool has_background;
+    uint32_t last_time_ms;
+    float32_t background[AOA_MIN_NUM_RX_ANTENNAS][AOA_MAX_NUM_SAMPLES];
+    float32_t fft_in[AOA_MAX_NUM_SAMPLES];
+    float32_t spectrum[AOA_MIN_NUM_RX_ANTENNAS][AOA_MAX_NUM_SAMPLES]; /* complex, num_samples / 2 bins */
+    float32_t power[AOA_MAX_NUM_SAMPLES / 2U];
+    float32_t scratch[AOA_MAX_NUM_SAMPLES / 2U];
+} radar_aoa_s;
+
+
+/*******************************************************************************
+ * Function Name: radar_aoa_init
+ ****************************************************************************//**
+ *
+ * @brief Initializes an estimator and clears its background. The range bins
+ * of the chirp FFT differ from the macro FFT bins of the presence library,
+ * the bin lengths of both are used to map between them.
+ *
+ * @param aoa Estimator instance.
+ * @param num_samples Number of samples per chirp, must be a supported
+ * real FFT length.
+ * @param bandwidth_hz Chirp bandwidth, sets the bin length of the chirp FFT.
+ * @param macro_bin_length_m Bin length of the macro FFT of the presence library.
+ *
+ * @return 0 on success, -1 on invalid parameters or an unsupported FFT length.
+ *
+ *******************************************************************************/
+int32_t radar_aoa_init(radar_aoa_s *aoa, uint32_t num_samples,
+                       float32_t bandwidth_hz, float32_t macro_bin_length_m);
+
+/*******************************************************************************
+ * Function Name: radar_aoa_get_live
+ ****************************************************************************//**
+ *
+ * @return Estimator instance of the live frame path.
+ *
+ *******************************************************************************/
+radar_aoa_s *radar_aoa_get_live(void);
+
+/*******************************************************************************
+ * Function Name: radar_aoa_process
+ ****************************************************************************//**
+ *
+ * @brief Removes the static background of every antenna, computes the range
+ * spectra, selects the strongest range bins inside the range gate and
+ * estimates their azimuth and elevation from the phase differences between
+ * the antenna pairs. The background is learned while the scene is empty,
+ * so static reflectors do not mask a person or bias the angle.
+ *
+ * @param aoa Estimator instance.
+ * @param avg_chirps Average chirp of every antenna, num_rx * num_samples elements.
+ * @param num_rx Number of receivers, at least AOA_MIN_NUM_RX_ANTENNAS.
+ * @param gate Range gate in macro FFT bins.
+ * @param learn true if the scene is empty and the background may be updated.
+ * @param time_ms Timestamp of the frame.
+ * @param result Estimated angles.
+ *
+ * @return 0 on success, -1 on invalid parameters.
+ *
+ *******************************************************************************/
+int32_t radar_aoa_process(radar_aoa_s *aoa,
+                          const float32_t *avg_chirps,
+                          uint32_t num_rx,
+                          const range_gate_s *gate,
+                          bool learn,
+                          uint32_t time_ms,
+                          radar_aoa_result_s *result);
+
+/*******************************************************************************
+ * Function Name: radar_aoa_find_target
+ ****************************************************************************//**
+ *
+ * @brief Returns the target of the result closest to the given range bin.
+ *
+ * @param result Angle of arrival estimation result.
+ * @param range_bin Range bin to be looked up.
+ *
+ * @return Pointer to the target or NULL if the result is empty.
+ *
+ *******************************************************************************/
+const radar_aoa_target_s *radar_aoa_find_target(const radar_aoa_result_s *result,
+                                                int32_t range_bin);
+
+#endif /* SOURCE_RADAR_AOA_H_ */
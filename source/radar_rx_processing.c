@@ -0,0 +1,255 @@
+/*****************************************************************************
+ * File name: radar_rx_processing.c
+ *
+ * Description: This file implements the multi-antenna (RX) acquisition path
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+
+#include "radar_rx_processing.h"
+
+/* Full scale of the 12-bit ADC */
+#define RADAR_RX_ADC_FULL_SCALE             (4096.0F)
+
+static radar_rx_combiner_s live_combiner;
+
+/*
+ * unpack the FIFO words
+ */
+void radar_rx_unpack_fifo(const uint8_t *fifo_words, uint16_t *fifo_data, uint32_t num_samples)
+{
+    /* backwards, the samples of a word never overwrite the words before it */
+    for (uint32_t word = num_samples / 2U; word > 0U; word--)
+    {
+        const uint8_t *bytes = &fifo_words[3U * (word - 1U)];
+        uint16_t first = (uint16_t)(((uint16_t)bytes[0] << 4) | ((uint16_t)bytes[1] >> 4));
+        uint16_t second = (uint16_t)((((uint16_t)bytes[1] & 0x0FU) << 8) | (uint16_t)bytes[2]);
+
+        fifo_data[(2U * word) - 2U] = first;
+        fifo_data[(2U * word) - 1U] = second;
+    }
+}
+
+/*
+ * de-interleave and convert the raw FIFO samples
+ */
+void radar_rx_deinterleave(const uint16_t *fifo_data,
+                           float32_t *planar,
+                           uint32_t num_rx,
+                           uint32_t samples_per_antenna)
+{
+    const float32_t scale = 1.0F / RADAR_RX_ADC_FULL_SCALE;
+
+    if (num_rx == 3U)
+    {
+        /* Three antennas is the common case, the loop handles one sample of
+         * every antenna per iteration and writes three linear streams */
+        float32_t *rx1 = planar;
+        float32_t *rx2 = planar + samples_per_antenna;
+        float32_t *rx3 = planar + (2U * samples_per_antenna);
+        uint32_t blk_cnt = samples_per_antenna >> 1U;
+
+        while (blk_cnt > 0U)
+        {
+            rx1[0] = (float32_t)fifo_data[0] * scale;
+            rx2[0] = (float32_t)fifo_data[1] * scale;
+            rx3[0] = (float32_t)fifo_data[2] * scale;
+            rx1[1] = (float32_t)fifo_data[3] * scale;
+            rx2[1] = (float32_t)fifo_data[4] * scale;
+            rx3[1] = (float32_t)fifo_data[5] * scale;
+
+            rx1 += 2;
+            rx2 += 2;
+            rx3 += 2;
+            fifo_data += 6;
+            blk_cnt--;
+        }
+
+        if ((samples_per_antenna & 1U) != 0U)
+        {
+            *rx1 = (float32_t)fifo_data[0] * scale;
+            *rx2 = (float32_t)fifo_data[1] * scale;
+            *rx3 = (float32_t)fifo_data[2] * scale;
+        }
+    }
+    else
+    {
+        for (uint32_t rx = 0; rx < num_rx; rx++)
+        {
+            const uint16_t *src = fifo_data + rx;
+            float32_t *dst = planar + (rx * samples_per_antenna);
+
+            for (uint32_t sample = 0; sample < samples_per_antenna; sample++)
+            {
+                *dst++ = (float32_t)(*src) * scale;
+                src += num_rx;
+            }
+        }
+    }
+}
+
+/*
+ * average the chirps of every antenna
+ */
+void radar_rx_average_chirps(const float32_t *planar,
+                             float32_t *avg_chirps,
+                             uint32_t num_rx,
+                             uint32_t num_chirps,
+                             uint32_t num_samples)
+{
+    for (uint32_t rx = 0; rx < num_rx; rx++)
+    {
+        const float32_t *antenna = planar + (rx * num_chirps * num_samples);
+        float32_t *avg = avg_chirps + (rx * num_samples);
+
+        arm_copy_f32(antenna, avg, num_samples);
+
+        for (uint32_t chirp = 1; chirp < num_chirps; chirp++)
+        {
+            arm_add_f32(avg, &antenna[chirp * num_samples], avg, num_samples);
+        }
+
+        arm_scale_f32(avg, 1.0f / (float32_t)num_chirps, avg, num_samples);
+    }
+}
+
+/*
+ * initialize a combiner
+ */
+int32_t radar_rx_combiner_init(radar_rx_combiner_s *combiner, uint32_t num_rx, uint32_t num_samples)
+{
+    if ((num_rx == 0U) || (num_rx > RADAR_RX_MAX_ANTENNAS) || (num_samples > RADAR_RX_MAX_SAMPLES))
+    {
+        return -1;
+    }
+
+    memset(combiner, 0, sizeof(*combiner));
+
+    if (arm_rfft_fast_init_f32(&combiner->rfft, (uint16_t)num_samples) != ARM_MATH_SUCCESS)
+    {
+        return -1;
+    }
+
+    combiner->num_rx = num_rx;
+    combiner->num_samples = num_samples;
+
+    return 0;
+}
+
+/*
+ * get the live combiner
+ */
+radar_rx_combiner_s *radar_rx_combiner_get_live(void)
+{
+    return &live_combiner;
+}
+
+/*
+ * combine the phase aligned average chirps of all antennas
+ */
+void radar_rx_combine(radar_rx_combiner_s *combiner,
+                      const float32_t *avg_chirps,
+                      float32_t *combined,
+                      uint32_t time_ms)
+{
+    const uint32_t num_samples = combiner->num_samples;
+    const uint32_t num_bins = num_samples / 2U;
+    float32_t alpha = 1.0f;
+
+    if (combiner->num_rx <= 1U)
+    {
+        arm_copy_f32(avg_chirps, combined, num_samples);
+        return;
+    }
+
+    /* the weight follows the frame period, the first frame sets the phases */
+    if (combiner->has_phases)
+    {
+        alpha = (float32_t)(time_ms - combiner->last_time_ms) / (float32_t)RADAR_RX_ALIGN_TIME_CONSTANT_MS;
+        if (alpha > 1.0f)
+        {
+            alpha = 1.0f;
+        }
+    }
+    combiner->last_time_ms = time_ms;
+    combiner->has_phases = true;
+
+    /* the FFT works in place on its input, so every chirp is copied first */
+    arm_copy_f32(avg_chirps, combiner->fft_in, num_samples);
+    arm_rfft_fast_f32(&combiner->rfft, combiner->fft_in, combiner->reference, 0);
+    arm_copy_f32(combiner->reference, combiner->sum, num_samples);
+
+    for (uint32_t rx = 1U; rx < combiner->num_rx; rx++)
+    {
+        float32_t *cross = combiner->cross[rx - 1U];
+        const float32_t *ref = combiner->reference;
+        const float32_t *spec = combiner->spectrum;
+
+        arm_copy_f32(&avg_chirps[rx * num_samples], combiner->fft_in, num_samples);
+        arm_rfft_fast_f32(&combiner->rfft, combiner->fft_in, combiner->spectrum, 0);
+
+        /* DC and Nyquist are real and packed into bin 0, they are summed as they are */
+        combiner->sum[0] += spec[0];
+        combiner->sum[1] += spec[1];
+
+        for (uint32_t bin = 1U; bin < num_bins; bin++)
+        {
+            const uint32_t re = 2U * bin;
+            const uint32_t im = re + 1U;
+            float32_t magnitude;
+
+            /* cross += alpha * (spec * conj(ref) - cross) */
+            cross[re] += alpha * (((spec[re] * ref[re]) + (spec[im] * ref[im])) - cross[re]);
+            cross[im] += alpha * (((spec[im] * ref[re]) - (spec[re] * ref[im])) - cross[im]);
+
+            (void)arm_sqrt_f32((cross[re] * cross[re]) + (cross[im] * cross[im]), &magnitude);
+            if (magnitude > 0.0f)
+            {
+                /* sum += spec * conj(cross) / |cross| */
+                combiner->sum[re] += ((spec[re] * cross[re]) + (spec[im] * cross[im])) / magnitude;
+                combiner->sum[im] += ((spec[im] * cross[re]) - (spec[re] * cross[im])) / magnitude;
+            }
+            else
+            {
+                combiner->sum[re] += spec[re];
+                combiner->sum[im] += spec[im];
+            }
+        }
+    }
+
+    /* Keep the signal level of a single antenna so the detection thresholds still apply */
+    arm_scale_f32(combiner->sum, 1.0f / (float32_t)combiner->num_rx, combiner->sum, num_samples);
+    arm_rfft_fast_f32(&combiner->rfft, combiner->sum, combined, 1);
+}
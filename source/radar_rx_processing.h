@@ -0,0 +1,198 @@
+/*****************************************************************************
+ * File name: radar_rx_processing.h
+ *
+ * Description: This file contains function prototypes for the multi-antenna
+ *   (RX) acquisition path
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_RADAR_RX_PROCESSING_H_
+#define SOURCE_RADAR_RX_PROCESSING_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "arm_math.h"
+
+/*
+ * @def RADAR_RX_MAX_ANTENNAS
+ * Largest number of combined receivers
+ */
+#define RADAR_RX_MAX_ANTENNAS               (3U)
+
+/*
+ * @def RADAR_RX_MAX_SAMPLES
+ * Largest supported chirp length of the combination
+ */
+#define RADAR_RX_MAX_SAMPLES                (128U)
+
+/*
+ * @def RADAR_RX_ALIGN_TIME_CONSTANT_MS
+ * Time constant of the phase of every antenna relative to RX1, long against
+ * the noise of a single frame and short against a person walking across
+ */
+#define RADAR_RX_ALIGN_TIME_CONSTANT_MS     (2000U)
+
+/*
+ * Frame layout used by the multi-antenna path
+ *
+ * The BGT60TRxx FIFO delivers the samples of all enabled receivers interleaved
+ * sample by sample (RX1 RX2 RX3 RX1 RX2 RX3 ...). Every 24-bit FIFO word holds
+ * two 12-bit samples, the first one in the upper bits, and is read most
+ * significant byte first. On the target, the SPI reads the FIFO in 12-bit
+ * frames, so the samples arrive unpacked; radar_rx_unpack_fifo does the same
+ * for FIFO words read as bytes. The functions below convert
+ * this stream into a planar layout [antenna][chirp][sample], so the chirps of
+ * one antenna are contiguous in memory and every per antenna kernel walks
+ * a linear buffer.
+ */
+
+/*
+ * @typedef typedef struct radar_rx_combiner_s
+ * Combiner instance, the relative phases of the antennas per range bin
+ */
+typedef struct
+{
+    arm_rfft_fast_instance_f32 rfft;
+    uint32_t num_rx;
+    uint32_t num_samples;
+    bool has_phases;
+    uint32_t last_time_ms;
+    float32_t cross[RADAR_RX_MAX_ANTENNAS - 1U][RADAR_RX_MAX_SAMPLES]; /* complex, antenna times conjugated RX1 */
+    float32_t reference[RADAR_RX_MAX_SAMPLES];  /* complex range spectrum of RX1 */
+    float32_t spectrum[RADAR_RX_MAX_SAMPLES];   /* complex range spectrum of the other antennas */
+    float32_t sum[RADAR_RX_MAX_SAMPLES];        /* complex sum of the aligned spectra */
+    float32_t fft_in[RADAR_RX_MAX_SAMPLES];
+} radar_rx_combiner_s;
+
+/*******************************************************************************
+ * Function Name: radar_rx_unpack_fifo
+ ****************************************************************************//**
+ *
+ * @brief Unpacks FIFO words into 12-bit samples. The samples may overwrite
+ * the words, i.e. both may start at the same address.
+ *
+ * @param fifo_words FIFO words, three bytes per two samples.
+ * @param fifo_data Output buffer of num_samples samples.
+ * @param num_samples Number of samples, even.
+ *
+ *******************************************************************************/
+void radar_rx_unpack_fifo(const uint8_t *fifo_words, uint16_t *fifo_data, uint32_t num_samples);
+
+/*******************************************************************************
+ * Function Name: radar_rx_deinterleave
+ ****************************************************************************//**
+ *
+ * @brief Converts the raw 12-bit FIFO samples to float and de-interleaves them
+ * into one contiguous block per antenna.
+ *
+ * @param fifo_data Raw samples as read from the radar FIFO.
+ * @param planar Output buffer of num_rx * samples_per_antenna elements.
+ * @param num_rx Number of interleaved receivers.
+ * @param samples_per_antenna Number of samples of every antenna in the frame.
+ *
+ *******************************************************************************/
+void radar_rx_deinterleave(const uint16_t *fifo_data,
+                           float32_t *planar,
+                           uint32_t num_rx,
+                           uint32_t samples_per_antenna);
+
+/*******************************************************************************
+ * Function Name: radar_rx_average_chirps
+ ****************************************************************************//**
+ *
+ * @brief Averages all chirps of every antenna.
+ *
+ * @param planar Frame in planar layout as produced by radar_rx_deinterleave.
+ * @param avg_chirps Output buffer of num_rx * num_samples elements, one average
+ * chirp per antenna.
+ * @param num_rx Number of receivers.
+ * @param num_chirps Number of chirps per frame.
+ * @param num_samples Number of samples per chirp.
+ *
+ *******************************************************************************/
+void radar_rx_average_chirps(const float32_t *planar,
+                             float32_t *avg_chirps,
+                             uint32_t num_rx,
+                             uint32_t num_chirps,
+                             uint32_t num_samples);
+
+/*******************************************************************************
+ * Function Name: radar_rx_combiner_init
+ ****************************************************************************//**
+ *
+ * @brief Initializes a combiner and clears the learned phases.
+ *
+ * @param combiner Combiner instance.
+ * @param num_rx Number of receivers, at most RADAR_RX_MAX_ANTENNAS.
+ * @param num_samples Number of samples per chirp, must be a supported
+ * real FFT length.
+ *
+ * @return 0 on success, -1 on invalid parameters.
+ *
+ *******************************************************************************/
+int32_t radar_rx_combiner_init(radar_rx_combiner_s *combiner, uint32_t num_rx, uint32_t num_samples);
+
+/*******************************************************************************
+ * Function Name: radar_rx_combiner_get_live
+ ****************************************************************************//**
+ *
+ * @return Combiner instance of the live frame path.
+ *
+ *******************************************************************************/
+radar_rx_combiner_s *radar_rx_combiner_get_live(void);
+
+/*******************************************************************************
+ * Function Name: radar_rx_combine
+ ****************************************************************************//**
+ *
+ * @brief Coherently combines the average chirps of all antennas into one chirp.
+ * Every range bin of every antenna is rotated onto the phase of RX1 before
+ * the sum, with the relative phase averaged over the last frames. The echo
+ * of a target adds up in phase from any direction while the receiver noise
+ * adds up incoherently, and a static scene gives a constant chirp once the
+ * phases are learned. The result keeps the signal level of a single antenna.
+ *
+ * @param combiner Combiner instance.
+ * @param avg_chirps Average chirp of every antenna, num_rx * num_samples elements.
+ * @param combined Output chirp of num_samples elements.
+ * @param time_ms Timestamp of the frame.
+ *
+ *******************************************************************************/
+void radar_rx_combine(radar_rx_combiner_s *combiner,
+                      const float32_t *avg_chirps,
+                      float32_t *combined,
+                      uint32_t time_ms);
+
+#endif /* SOURCE_RADAR_RX_PROCESSING_H_ */
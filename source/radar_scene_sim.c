@@ -0,0 +1,251 @@
+/*****************************************************************************
+ * File name: radar_scene_sim.c
+ *
+ * Description: This file implements the FMCW scene simulator that
+ *   generates synthetic radar FIFO frames
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "radar_low_framerate_config.h"
+#include "radar_scene_sim.h"
+
+#define RADAR_SCENE_SIM_SPEED_OF_LIGHT      (299792458.0f)
+#define RADAR_SCENE_SIM_DC_LEVEL            (2048.0f)
+#define RADAR_SCENE_SIM_NOISE_LEVEL         (8.0f)
+#define RADAR_SCENE_SIM_MIN_RANGE_M         (0.1f)
+
+/*******************************************************************************
+ * Function Name: radar_scene_sim_random
+ ****************************************************************************//**
+ *
+ * @brief xorshift32 generator, the same on every build and target.
+ *
+ * @param state Generator state, not 0.
+ *
+ * @return Uniform value in [-1, 1).
+ *
+ *******************************************************************************/
+static float32_t radar_scene_sim_random(uint32_t *state)
+{
+    uint32_t x = *state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+
+    return ((float32_t)(x >> 8) / 8388608.0f) - 1.0f;
+}
+
+/*******************************************************************************
+ * Function Name: radar_scene_sim_range
+ ****************************************************************************//**
+ *
+ * @brief Distance of a target at a point in time.
+ *
+ * @param target Target.
+ * @param time_s Time since the target was set.
+ *
+ * @return Range in meters.
+ *
+ *******************************************************************************/
+static float32_t radar_scene_sim_range(const radar_scene_sim_target_s *target, float32_t time_s)
+{
+    float32_t range = target->range_m + (target->velocity_mps * time_s);
+
+    if (target->breathing_m != 0.0f)
+    {
+        range += target->breathing_m * sinf(2.0f * PI * target->breathing_hz * time_s);
+    }
+
+    return (range < RADAR_SCENE_SIM_MIN_RANGE_M) ? RADAR_SCENE_SIM_MIN_RANGE_M : range;
+}
+
+/*
+ * initialize with the low frame rate chirp parameters
+ */
+void radar_scene_sim_init(radar_scene_sim_s *sim, uint32_t seed)
+{
+    sim->params.start_freq_hz = (float32_t)XENSIV_BGT60TRXX_CONF_START_FREQ_HZ;
+    sim->params.end_freq_hz = (float32_t)XENSIV_BGT60TRXX_CONF_END_FREQ_HZ;
+    sim->params.sample_rate_hz = (float32_t)XENSIV_BGT60TRXX_CONF_SAMPLE_RATE;
+    sim->params.chirp_repetition_time_s = (float32_t)XENSIV_BGT60TRXX_CONF_CHIRP_REPETITION_TIME_S;
+    sim->params.frame_repetition_time_s = (float32_t)XENSIV_BGT60TRXX_CONF_FRAME_REPETITION_TIME_S;
+    sim->params.num_samples_per_chirp = XENSIV_BGT60TRXX_CONF_NUM_SAMPLES_PER_CHIRP;
+    sim->params.num_chirps_per_frame = XENSIV_BGT60TRXX_CONF_NUM_CHIRPS_PER_FRAME;
+    sim->params.num_rx_antennas = XENSIV_BGT60TRXX_CONF_NUM_RX_ANTENNAS;
+
+    sim->num_targets = 0U;
+    sim->dc_level = RADAR_SCENE_SIM_DC_LEVEL;
+    sim->noise_level = RADAR_SCENE_SIM_NOISE_LEVEL;
+    sim->time_s = 0.0f;
+    sim->targets_time_s = 0.0f;
+    sim->seed = seed;
+}
+
+/*
+ * replace the targets of the scene
+ */
+int32_t radar_scene_sim_set_targets(radar_scene_sim_s *sim,
+                                    const radar_scene_sim_target_s *targets,
+                                    uint32_t num_targets)
+{
+    if (num_targets > RADAR_SCENE_SIM_MAX_TARGETS)
+    {
+        return -1;
+    }
+
+    for (uint32_t i = 0U; i < num_targets; i++)
+    {
+        sim->targets[i] = targets[i];
+    }
+
+    sim->num_targets = num_targets;
+    sim->targets_time_s = sim->time_s;
+
+    return 0;
+}
+
+/*
+ * generate the next frame
+ */
+void radar_scene_sim_frame(radar_scene_sim_s *sim, uint8_t *fifo_words)
+{
+    const radar_scene_sim_params_s *params = &sim->params;
+    const uint32_t num_samples = params->num_samples_per_chirp;
+    const uint32_t num_rx = params->num_rx_antennas;
+    /* frequency change from one sample to the next */
+    const float32_t freq_step = (params->end_freq_hz - params->start_freq_hz) / (float32_t)(num_samples - 1U);
+    float32_t weight_re[RADAR_SCENE_SIM_MAX_TARGETS][RADAR_SCENE_SIM_MAX_RX_ANTENNAS];
+    float32_t weight_im[RADAR_SCENE_SIM_MAX_TARGETS][RADAR_SCENE_SIM_MAX_RX_ANTENNAS];
+    float32_t phasor_re[RADAR_SCENE_SIM_MAX_TARGETS];
+    float32_t phasor_im[RADAR_SCENE_SIM_MAX_TARGETS];
+    float32_t rotation_re[RADAR_SCENE_SIM_MAX_TARGETS];
+    float32_t rotation_im[RADAR_SCENE_SIM_MAX_TARGETS];
+    uint32_t first = 0U;
+    bool has_first = false;
+
+    for (uint32_t chirp = 0U; chirp < params->num_chirps_per_frame; chirp++)
+    {
+        float32_t time_s = (sim->time_s - sim->targets_time_s) +
+                           ((float32_t)chirp * params->chirp_repetition_time_s);
+
+        /* The IF signal of a target at range R is cos(4 pi f(n) R / c), so every
+         * target is a phasor that rotates by a constant angle per sample. The
+         * receivers see it with the phase offsets of the L-shaped array, relative
+         * to RX1: RX3 lags by pi sin(azimuth), RX2 sits above RX3 and leads it by
+         * pi sin(elevation). */
+        for (uint32_t t = 0U; t < sim->num_targets; t++)
+        {
+            const radar_scene_sim_target_s *target = &sim->targets[t];
+            float32_t range = radar_scene_sim_range(target, time_s);
+            float32_t amplitude = target->amplitude / (range * range);
+            float32_t phase = fmodf((4.0f * PI * params->start_freq_hz * range) / RADAR_SCENE_SIM_SPEED_OF_LIGHT,
+                                    2.0f * PI);
+            float32_t step = (4.0f * PI * freq_step * range) / RADAR_SCENE_SIM_SPEED_OF_LIGHT;
+            float32_t azimuth_phase = PI * sinf(target->angle_deg * (PI / 180.0f));
+            float32_t elevation_phase = PI * sinf(target->elevation_deg * (PI / 180.0f));
+            const float32_t rx_phase[RADAR_SCENE_SIM_MAX_RX_ANTENNAS] =
+            {
+                0.0f, elevation_phase - azimuth_phase, -azimuth_phase
+            };
+
+            phasor_re[t] = cosf(phase);
+            phasor_im[t] = sinf(phase);
+            rotation_re[t] = cosf(step);
+            rotation_im[t] = sinf(step);
+
+            for (uint32_t rx = 0U; rx < num_rx; rx++)
+            {
+                weight_re[t][rx] = amplitude * cosf(rx_phase[rx]);
+                weight_im[t][rx] = amplitude * sinf(rx_phase[rx]);
+            }
+        }
+
+        for (uint32_t sample = 0U; sample < num_samples; sample++)
+        {
+            for (uint32_t rx = 0U; rx < num_rx; rx++)
+            {
+                float32_t value = sim->dc_level + (0.5f * sim->noise_level *
+                                                   (radar_scene_sim_random(&sim->seed) +
+                                                    radar_scene_sim_random(&sim->seed)));
+
+                for (uint32_t t = 0U; t < sim->num_targets; t++)
+                {
+                    value += (phasor_re[t] * weight_re[t][rx]) - (phasor_im[t] * weight_im[t][rx]);
+                }
+
+                if (value < 0.0f)
+                {
+                    value = 0.0f;
+                }
+                else if (value > (float32_t)RADAR_SCENE_SIM_ADC_MAX)
+                {
+                    value = (float32_t)RADAR_SCENE_SIM_ADC_MAX;
+                }
+
+                /* two samples make one FIFO word, the first one in the upper bits */
+                if (!has_first)
+                {
+                    first = (uint32_t)(value + 0.5f);
+                    has_first = true;
+                }
+                else
+                {
+                    uint32_t word = (first << 12) | (uint32_t)(value + 0.5f);
+
+                    *fifo_words++ = (uint8_t)(word >> 16);
+                    *fifo_words++ = (uint8_t)(word >> 8);
+                    *fifo_words++ = (uint8_t)word;
+                    has_first = false;
+                }
+            }
+
+            for (uint32_t t = 0U; t < sim->num_targets; t++)
+            {
+                float32_t re = (phasor_re[t] * rotation_re[t]) - (phasor_im[t] * rotation_im[t]);
+
+                phasor_im[t] = (phasor_re[t] * rotation_im[t]) + (phasor_im[t] * rotation_re[t]);
+                phasor_re[t] = re;
+            }
+        }
+    }
+
+    sim->time_s += params->frame_repetition_time_s;
+}
@@ -0,0 +1,196 @@
+/*****************************************************************************
+ * File name: radar_scene_sim.h
+ *
+ * Description: This file contains types and function prototypes of the
+ *   FMCW scene simulator that generates synthetic radar FIFO frames
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_RADAR_SCENE_SIM_H_
+#define SOURCE_RADAR_SCENE_SIM_H_
+
+#include <stdint.h>
+
+#include "arm_math.h"
+
+/*
+ * @def RADAR_SCENE_SIM_MAX_TARGETS
+ * Maximum number of point targets of a scene, people and clutter together
+ */
+#define RADAR_SCENE_SIM_MAX_TARGETS         (4U)
+
+/*
+ * @def RADAR_SCENE_SIM_MAX_RX_ANTENNAS
+ * Maximum number of simulated receivers
+ */
+#define RADAR_SCENE_SIM_MAX_RX_ANTENNAS     (3U)
+
+/*
+ * @def RADAR_SCENE_SIM_ADC_MAX
+ * Largest 12-bit ADC code, samples are clipped to 0..RADAR_SCENE_SIM_ADC_MAX
+ */
+#define RADAR_SCENE_SIM_ADC_MAX             (4095U)
+
+/*
+ * @def RADAR_SCENE_SIM_FIFO_BYTES
+ * Bytes of the FIFO words of a number of samples, two 12-bit samples per
+ * 24-bit word
+ */
+#define RADAR_SCENE_SIM_FIFO_BYTES(num_samples)     (((num_samples) / 2U) * 3U)
+
+/*
+ * @def struct radar_scene_sim_params_s
+ * Chirp parameters of the simulated sensor
+ * start_freq_hz - frequency at the first sample of a chirp
+ * end_freq_hz - frequency at the last sample of a chirp
+ * sample_rate_hz - ADC sample rate
+ * chirp_repetition_time_s - time between the starts of two chirps
+ * frame_repetition_time_s - time between two frames
+ * num_samples_per_chirp - samples of every chirp and antenna
+ * num_chirps_per_frame - chirps of a frame
+ * num_rx_antennas - receivers, interleaved sample by sample like the FIFO,
+ *   at most RADAR_SCENE_SIM_MAX_RX_ANTENNAS. They are placed like the L-shaped
+ *   array of the BGT60TR13C: RX1 and RX3 horizontally, RX2 and RX3 vertically,
+ *   both pairs half a wavelength apart
+ */
+typedef struct
+{
+    float32_t start_freq_hz;
+    float32_t end_freq_hz;
+    float32_t sample_rate_hz;
+    float32_t chirp_repetition_time_s;
+    float32_t frame_repetition_time_s;
+    uint32_t num_samples_per_chirp;
+    uint32_t num_chirps_per_frame;
+    uint32_t num_rx_antennas;
+} radar_scene_sim_params_s;
+
+/*
+ * @def struct radar_scene_sim_target_s
+ * Point target, a target without velocity and breathing is static clutter
+ * range_m - distance when the target is set
+ * velocity_mps - radial velocity, negative towards the sensor
+ * breathing_m - peak displacement of the breathing motion
+ * breathing_hz - breathing rate
+ * angle_deg - azimuth, positive towards RX1
+ * amplitude - echo amplitude in ADC codes at 1 m, falls with the square of the range
+ * elevation_deg - elevation, positive towards RX2
+ */
+typedef struct
+{
+    float32_t range_m;
+    float32_t velocity_mps;
+    float32_t breathing_m;
+    float32_t breathing_hz;
+    float32_t angle_deg;
+    float32_t amplitude;
+    float32_t elevation_deg;
+} radar_scene_sim_target_s;
+
+/*
+ * @def struct radar_scene_sim_s
+ * Simulator instance, owned by the caller
+ * params - chirp parameters
+ * targets - point targets of the scene
+ * num_targets - number of targets
+ * dc_level - ADC code of the IF signal without echo
+ * noise_level - peak receiver noise in ADC codes
+ * time_s - time of the next frame
+ * targets_time_s - time the targets were set
+ * seed - noise generator state
+ */
+typedef struct
+{
+    radar_scene_sim_params_s params;
+    radar_scene_sim_target_s targets[RADAR_SCENE_SIM_MAX_TARGETS];
+    uint32_t num_targets;
+    float32_t dc_level;
+    float32_t noise_level;
+    float32_t time_s;
+    float32_t targets_time_s;
+    uint32_t seed;
+} radar_scene_sim_s;
+
+
+/*******************************************************************************
+ * Function Name: radar_scene_sim_init
+ ****************************************************************************//**
+ *
+ * @brief Initializes a simulator with the chirp parameters of the low frame
+ * rate sensor configuration, mid-scale DC level, a few codes of noise and an
+ * empty scene. The fields may be changed before the first frame.
+ *
+ * @param sim Simulator instance.
+ * @param seed Noise generator seed, not 0. The same seed gives the same frames.
+ *
+ *******************************************************************************/
+void radar_scene_sim_init(radar_scene_sim_s *sim, uint32_t seed);
+
+/*******************************************************************************
+ * Function Name: radar_scene_sim_set_targets
+ ****************************************************************************//**
+ *
+ * @brief Replaces the targets of the scene. The ranges are taken as the
+ * positions at the time of the next frame, moving targets continue from there.
+ *
+ * @param sim Simulator instance.
+ * @param targets New targets, may be NULL if num_targets is 0.
+ * @param num_targets Number of targets, at most RADAR_SCENE_SIM_MAX_TARGETS.
+ *
+ * @return 0 on success, -1 if there are too many targets.
+ *
+ *******************************************************************************/
+int32_t radar_scene_sim_set_targets(radar_scene_sim_s *sim,
+                                    const radar_scene_sim_target_s *targets,
+                                    uint32_t num_targets);
+
+/*******************************************************************************
+ * Function Name: radar_scene_sim_frame
+ ****************************************************************************//**
+ *
+ * @brief Generates the next frame as the sensor FIFO holds it: 12-bit
+ * samples, chirp after chirp, with the receivers interleaved sample by sample,
+ * packed two samples per 24-bit word, most significant byte first.
+ * radar_rx_unpack_fifo turns them into the samples the data manager delivers.
+ * Advances the scene time by one frame repetition time.
+ *
+ * @param sim Simulator instance.
+ * @param fifo_words Output of RADAR_SCENE_SIM_FIFO_BYTES(num_chirps_per_frame *
+ * num_samples_per_chirp * num_rx_antennas) bytes. The number of samples must
+ * be even, the FIFO only holds whole words.
+ *
+ *******************************************************************************/
+void radar_scene_sim_frame(radar_scene_sim_s *sim, uint8_t *fifo_words);
+
+#endif /* SOURCE_RADAR_SCENE_SIM_H_ */
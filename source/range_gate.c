@@ -0,0 +1,144 @@
+/*****************************************************************************
+ * File name: range_gate.c
+ *
+ * Description: This file implements the range gate which limits the per range
+ *   bin processing to the configured detection range
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "range_gate.h"
+
+typedef struct
+{
+    int32_t num_range_bins;
+    int32_t min_range_bin;
+    int32_t max_range_bin;
+    range_gate_s gate;
+} range_gate_state_s;
+
+static range_gate_state_s gate_state;
+
+/*******************************************************************************
+ * Function Name: range_gate_recompute
+ ****************************************************************************//**
+ *
+ * @brief Computes the gate from the stored detection range and guard bins.
+ *
+ *******************************************************************************/
+static void range_gate_recompute(void)
+{
+    range_gate_compute(&gate_state.gate, gate_state.num_range_bins,
+                       gate_state.min_range_bin, gate_state.max_range_bin,
+                       gate_state.gate.enabled);
+}
+
+/*
+ * compute a gate
+ */
+void range_gate_compute(range_gate_s *gate, int32_t num_range_bins,
+                        int32_t min_range_bin, int32_t max_range_bin, bool enabled)
+{
+    int32_t first = 0;
+    int32_t last = num_range_bins - 1;
+
+    if (enabled)
+    {
+        first = min_range_bin - RANGE_GATE_GUARD_BINS;
+        last = max_range_bin + RANGE_GATE_GUARD_BINS;
+
+        if (first < 0)
+        {
+            first = 0;
+        }
+
+        if (last > (num_range_bins - 1))
+        {
+            last = num_range_bins - 1;
+        }
+    }
+
+    gate->enabled = enabled;
+    gate->first_bin = first;
+    gate->num_bins = (last >= first) ? (last - first + 1) : 0;
+}
+
+/*
+ * initialize the range gate
+ */
+void range_gate_init(int32_t num_range_bins)
+{
+    gate_state.num_range_bins = num_range_bins;
+    gate_state.min_range_bin = 0;
+    gate_state.max_range_bin = num_range_bins - 1;
+    gate_state.gate.enabled = false;
+
+    range_gate_recompute();
+}
+
+/*
+ * update the gate from the detection range
+ */
+void range_gate_update(const xensiv_radar_presence_config_t *config)
+{
+    gate_state.min_range_bin = config->min_range_bin;
+    gate_state.max_range_bin = config->max_range_bin;
+
+    range_gate_recompute();
+}
+
+/*
+ * enable/disable range gated processing
+ */
+void range_gate_enable(bool enable)
+{
+    gate_state.gate.enabled = enable;
+
+    range_gate_recompute();
+}
+
+/*
+ * get the current gate
+ */
+const range_gate_s *range_gate_get(void)
+{
+    return &gate_state.gate;
+}
+
+/*
+ * check if a range bin is inside a gate
+ */
+bool range_gate_contains(const range_gate_s *gate, int32_t range_bin)
+{
+    return (range_bin >= gate->first_bin) && (range_bin < (gate->first_bin + gate->num_bins));
+}
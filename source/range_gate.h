@@ -0,0 +1,148 @@
+/*****************************************************************************
+ * File name: range_gate.h
+ *
+ * Description: This file contains types and function prototypes of the
+ *   range gate used to limit per range bin processing
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_RANGE_GATE_H_
+#define SOURCE_RANGE_GATE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "xensiv_radar_presence.h"
+
+/*
+ * @def RANGE_GATE_GUARD_BINS
+ * Number of range bins kept on each side of the configured detection range
+ * @note: A target sitting on the edge of the range still leaks energy into
+ *        its neighbour bins, the guard keeps them available to the
+ *        downstream stages
+ */
+#define RANGE_GATE_GUARD_BINS               (2)
+
+/*
+ * @typedef typedef struct range_gate_s
+ * Range bins to be processed by the per range bin stages
+ */
+typedef struct
+{
+    bool enabled;        /*<< true if range gated processing is enabled*/
+    int32_t first_bin;   /*<< first range bin inside the gate*/
+    int32_t num_bins;    /*<< number of consecutive range bins inside the gate*/
+} range_gate_s;
+
+
+/*******************************************************************************
+ * Function Name: range_gate_init
+ ****************************************************************************//**
+ *
+ * @brief Initializes the range gate with the number of available range bins.
+ * Gating is disabled after initialization, the gate covers all range bins.
+ *
+ * @param num_range_bins Number of range bins provided by the presence library.
+ *
+ *******************************************************************************/
+void range_gate_init(int32_t num_range_bins);
+
+/*******************************************************************************
+ * Function Name: range_gate_compute
+ ****************************************************************************//**
+ *
+ * @brief Computes a gate from a detection range, e.g. to evaluate a range
+ * without changing the live gate.
+ *
+ * @param gate Computed gate.
+ * @param num_range_bins Number of available range bins.
+ * @param min_range_bin First range bin of the detection range.
+ * @param max_range_bin Last range bin of the detection range.
+ * @param enabled false for a gate covering all range bins.
+ *
+ *******************************************************************************/
+void range_gate_compute(range_gate_s *gate, int32_t num_range_bins,
+                        int32_t min_range_bin, int32_t max_range_bin, bool enabled);
+
+/*******************************************************************************
+ * Function Name: range_gate_update
+ ****************************************************************************//**
+ *
+ * @brief Recomputes the gate from the detection range of the presence
+ * configuration. Has to be called whenever min_range_bin or max_range_bin
+ * are changed.
+ *
+ * @param config Presence configuration in use.
+ *
+ *******************************************************************************/
+void range_gate_update(const xensiv_radar_presence_config_t *config);
+
+/*******************************************************************************
+ * Function Name: range_gate_enable
+ ****************************************************************************//**
+ *
+ * @brief Enables or disables range gated processing.
+ *
+ * @param enable true to enable range gated processing.
+ *
+ *******************************************************************************/
+void range_gate_enable(bool enable);
+
+/*******************************************************************************
+ * Function Name: range_gate_get
+ ****************************************************************************//**
+ *
+ * @brief Returns the range bins to be processed. When gating is disabled the
+ * whole range is returned.
+ *
+ * @return Pointer to the current gate.
+ *
+ *******************************************************************************/
+const range_gate_s *range_gate_get(void);
+
+/*******************************************************************************
+ * Function Name: range_gate_contains
+ ****************************************************************************//**
+ *
+ * @brief Checks if a range bin is processed by the per range bin stages.
+ *
+ * @param gate Gate to check.
+ * @param range_bin Range bin.
+ *
+ * @return true if the range bin is inside the gate.
+ *
+ *******************************************************************************/
+bool range_gate_contains(const range_gate_s *gate, int32_t range_bin);
+
+#endif /* SOURCE_RANGE_GATE_H_ */
@@ -0,0 +1,427 @@
+/*****************************************************************************
+ * File name: raw_stream.c
+ *
+ * Description: This file implements the lossless raw frame stream, delta and
+ *   Rice coded FIFO frames sent as base64 lines over the console UART
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "console_uart.h"
+#include "flash_storage.h"
+#include "raw_stream.h"
+
+#define RAW_STREAM_VERSION                  (1U)
+#define RAW_STREAM_SAMPLE_BITS              (12U)
+#define RAW_STREAM_SAMPLE_MASK              (0x0FFFU)
+#define RAW_STREAM_K_BITS                   (4U)
+#define RAW_STREAM_K_RAW                    (15U)
+#define RAW_STREAM_MAX_K                    (12U)
+#define RAW_STREAM_ESCAPE                   (16U)
+#define RAW_STREAM_ESCAPE_BITS              (RAW_STREAM_SAMPLE_BITS + 1U)
+#define RAW_STREAM_LINE_PREFIX              ("[RAW] ")
+#define RAW_STREAM_LINE_SIZE                (sizeof(RAW_STREAM_LINE_PREFIX) + \
+                                             (((RAW_STREAM_MAX_FRAME_SIZE + 2U) / 3U) * 4U) + 2U)
+
+typedef struct
+{
+    uint8_t *dst;
+    size_t size;
+    size_t pos;
+    uint32_t acc;
+    uint32_t bits;
+    bool overflow;
+} raw_stream_bits_s;
+
+typedef struct
+{
+    TaskHandle_t task;
+    uint32_t num_chirps;
+    uint32_t samples_per_chirp;
+    uint32_t num_antennas;
+    uint32_t decimation;
+    uint32_t frame_count;
+    uint16_t sequence;
+    volatile bool busy;     /* set by the acquisition task, cleared by the stream task */
+    size_t frame_size;
+    raw_stream_stats_s stats;
+    uint8_t frame[RAW_STREAM_MAX_FRAME_SIZE];
+    char line[RAW_STREAM_LINE_SIZE];
+} raw_stream_state_s;
+
+static raw_stream_state_s stream_state;
+
+/*******************************************************************************
+ * Function Name: raw_stream_put_bits
+ ****************************************************************************//**
+ *
+ * @brief Appends the lowest bits of a value to a bit stream, MSB first.
+ *
+ * @param writer Bit stream.
+ * @param value Bits to append.
+ * @param count Number of bits, at most 24.
+ *
+ *******************************************************************************/
+static void raw_stream_put_bits(raw_stream_bits_s *writer, uint32_t value, uint32_t count)
+{
+    writer->acc = (writer->acc << count) | (value & ((1UL << count) - 1U));
+    writer->bits += count;
+
+    while (writer->bits >= 8U)
+    {
+        writer->bits -= 8U;
+
+        if (writer->pos < writer->size)
+        {
+            writer->dst[writer->pos++] = (uint8_t)(writer->acc >> writer->bits);
+        }
+        else
+        {
+            writer->overflow = true;
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function Name: raw_stream_residual
+ ****************************************************************************//**
+ *
+ * @param samples Samples of a block.
+ * @param index Index of the sample, at least stride.
+ * @param stride Distance to the previous sample of the same antenna.
+ *
+ * @return Zigzag mapped difference to the previous sample of the antenna.
+ *
+ *******************************************************************************/
+static inline uint32_t raw_stream_residual(const uint16_t *samples, uint32_t index, uint32_t stride)
+{
+    int32_t delta = (int32_t)(samples[index] & RAW_STREAM_SAMPLE_MASK) -
+                    (int32_t)(samples[index - stride] & RAW_STREAM_SAMPLE_MASK);
+
+    return ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31);
+}
+
+/*******************************************************************************
+ * Function Name: raw_stream_compress_block
+ ****************************************************************************//**
+ *
+ * @brief Chooses the Rice parameter from the mean residual and writes the
+ * block, or stores it with 12 bits per sample if coding does not pay off.
+ *
+ * @param writer Bit stream.
+ * @param samples Samples of the block.
+ * @param block_size Number of samples.
+ * @param stride Number of interleaved antennas.
+ *
+ *******************************************************************************/
+static void raw_stream_compress_block(raw_stream_bits_s *writer, const uint16_t *samples,
+                                      uint32_t block_size, uint32_t stride)
+{
+    uint32_t num_residuals = block_size - stride;
+    uint32_t sum = 0U;
+    uint32_t bits = stride * RAW_STREAM_SAMPLE_BITS;
+    uint32_t k = 0U;
+
+    for (uint32_t i = stride; i < block_size; i++)
+    {
+        sum += raw_stream_residual(samples, i, stride);
+    }
+
+    /* k close to log2 of the mean residual */
+    while ((k < RAW_STREAM_MAX_K) && ((num_residuals << (k + 1U)) < sum))
+    {
+        k++;
+    }
+
+    for (uint32_t i = stride; i < block_size; i++)
+    {
+        uint32_t quotient = raw_stream_residual(samples, i, stride) >> k;
+
+        bits += (quotient < RAW_STREAM_ESCAPE) ? (quotient + 1U + k) : (RAW_STREAM_ESCAPE + RAW_STREAM_ESCAPE_BITS);
+    }
+
+    if (bits >= (block_size * RAW_STREAM_SAMPLE_BITS))
+    {
+        raw_stream_put_bits(writer, RAW_STREAM_K_RAW, RAW_STREAM_K_BITS);
+
+        for (uint32_t i = 0U; i < block_size; i++)
+        {
+            raw_stream_put_bits(writer, samples[i], RAW_STREAM_SAMPLE_BITS);
+        }
+
+        return;
+    }
+
+    raw_stream_put_bits(writer, k, RAW_STREAM_K_BITS);
+
+    for (uint32_t i = 0U; i < stride; i++)
+    {
+        raw_stream_put_bits(writer, samples[i], RAW_STREAM_SAMPLE_BITS);
+    }
+
+    for (uint32_t i = stride; i < block_size; i++)
+    {
+        uint32_t residual = raw_stream_residual(samples, i, stride);
+        uint32_t quotient = residual >> k;
+
+        if (quotient < RAW_STREAM_ESCAPE)
+        {
+            /* unary quotient terminated by a zero, then the remainder */
+            raw_stream_put_bits(writer, ((1UL << quotient) - 1U) << 1, quotient + 1U);
+            raw_stream_put_bits(writer, residual, k);
+        }
+        else
+        {
+            raw_stream_put_bits(writer, (1UL << RAW_STREAM_ESCAPE) - 1U, RAW_STREAM_ESCAPE);
+            raw_stream_put_bits(writer, residual, RAW_STREAM_ESCAPE_BITS);
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function Name: raw_stream_base64
+ ****************************************************************************//**
+ *
+ * @brief Encodes data in base64 with padding.
+ *
+ * @param src Data.
+ * @param len Number of bytes.
+ * @param dst Destination, at least 4 * ceil(len / 3) characters.
+ *
+ * @return Number of characters written.
+ *
+ *******************************************************************************/
+static size_t raw_stream_base64(const uint8_t *src, size_t len, char *dst)
+{
+    static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    size_t out = 0U;
+
+    for (size_t i = 0U; i < len; i += 3U)
+    {
+        uint32_t group = (uint32_t)src[i] << 16;
+
+        if ((i + 1U) < len)
+        {
+            group |= (uint32_t)src[i + 1U] << 8;
+        }
+
+        if ((i + 2U) < len)
+        {
+            group |= src[i + 2U];
+        }
+
+        dst[out++] = alphabet[(group >> 18) & 0x3FU];
+        dst[out++] = alphabet[(group >> 12) & 0x3FU];
+        dst[out++] = ((i + 1U) < len) ? alphabet[(group >> 6) & 0x3FU] : '=';
+        dst[out++] = ((i + 2U) < len) ? alphabet[group & 0x3FU] : '=';
+    }
+
+    return out;
+}
+
+/*******************************************************************************
+ * Function Name: raw_stream_put_u16
+ ****************************************************************************//**
+ *
+ * @param dst Destination.
+ * @param value Value written little endian.
+ *
+ *******************************************************************************/
+static inline void raw_stream_put_u16(uint8_t *dst, uint32_t value)
+{
+    dst[0] = (uint8_t)value;
+    dst[1] = (uint8_t)(value >> 8);
+}
+
+/*
+ * set the frame format
+ */
+int32_t raw_stream_init(TaskHandle_t task, uint32_t num_chirps,
+                        uint32_t samples_per_chirp, uint32_t num_antennas)
+{
+    if ((task == NULL) || (num_chirps == 0U) || (samples_per_chirp < 2U) || (num_antennas == 0U) ||
+        ((num_chirps * samples_per_chirp * num_antennas) > RAW_STREAM_MAX_SAMPLES))
+    {
+        return -1;
+    }
+
+    memset(&stream_state, 0, sizeof(stream_state));
+    stream_state.task = task;
+    stream_state.num_chirps = num_chirps;
+    stream_state.samples_per_chirp = samples_per_chirp;
+    stream_state.num_antennas = num_antennas;
+
+    return 0;
+}
+
+/*
+ * set the number of frames per streamed frame
+ */
+int32_t raw_stream_set_decimation(uint32_t decimation)
+{
+    if (decimation > RAW_STREAM_MAX_DECIMATION)
+    {
+        return -1;
+    }
+
+    stream_state.decimation = decimation;
+    stream_state.frame_count = 0U;
+
+    return 0;
+}
+
+/*
+ * get the number of frames per streamed frame
+ */
+uint32_t raw_stream_get_decimation(void)
+{
+    return stream_state.decimation;
+}
+
+/*
+ * get the counters of the stream
+ */
+const raw_stream_stats_s *raw_stream_get_stats(void)
+{
+    return &stream_state.stats;
+}
+
+/*
+ * compress a frame for the stream task
+ */
+void raw_stream_capture(const uint16_t *samples, uint32_t timestamp_ms)
+{
+    uint32_t block_size = stream_state.samples_per_chirp * stream_state.num_antennas;
+    uint8_t *frame = stream_state.frame;
+    size_t size;
+    uint32_t crc;
+
+    if ((stream_state.decimation == 0U) || (++stream_state.frame_count < stream_state.decimation))
+    {
+        return;
+    }
+
+    stream_state.frame_count = 0U;
+    stream_state.sequence++;
+
+    if (stream_state.busy)
+    {
+        /* the host sees the gap in the sequence */
+        stream_state.stats.frames_dropped++;
+        return;
+    }
+
+    frame[0] = RAW_STREAM_VERSION;
+    frame[1] = (uint8_t)stream_state.num_antennas;
+    raw_stream_put_u16(&frame[2], stream_state.samples_per_chirp);
+    raw_stream_put_u16(&frame[4], stream_state.num_chirps);
+    raw_stream_put_u16(&frame[6], stream_state.sequence);
+    raw_stream_put_u16(&frame[8], timestamp_ms);
+    raw_stream_put_u16(&frame[10], timestamp_ms >> 16);
+
+    size = raw_stream_compress(samples, stream_state.num_chirps, block_size, stream_state.num_antennas,
+                               &frame[RAW_STREAM_HEADER_SIZE],
+                               sizeof(stream_state.frame) - RAW_STREAM_HEADER_SIZE - 4U);
+    if (size == 0U)
+    {
+        stream_state.stats.frames_dropped++;
+        return;
+    }
+
+    size += RAW_STREAM_HEADER_SIZE;
+    crc = flash_storage_crc32(frame, size);
+    raw_stream_put_u16(&frame[size], crc);
+    raw_stream_put_u16(&frame[size + 2U], crc >> 16);
+    stream_state.frame_size = size + 4U;
+
+    stream_state.stats.raw_bytes += (stream_state.num_chirps * block_size * RAW_STREAM_SAMPLE_BITS) / 8U;
+    stream_state.stats.compressed_bytes += (uint32_t)stream_state.frame_size;
+
+    stream_state.busy = true;
+    xTaskNotifyGive(stream_state.task);
+}
+
+/*
+ * compress samples block by block
+ */
+size_t raw_stream_compress(const uint16_t *samples, uint32_t num_blocks, uint32_t block_size,
+                           uint32_t stride, uint8_t *dst, size_t size)
+{
+    raw_stream_bits_s writer = { .dst = dst, .size = size };
+
+    if ((stride == 0U) || (block_size <= stride))
+    {
+        return 0U;
+    }
+
+    for (uint32_t block = 0U; block < num_blocks; block++)
+    {
+        raw_stream_compress_block(&writer, &samples[block * block_size], block_size, stride);
+    }
+
+    if (writer.bits > 0U)
+    {
+        raw_stream_put_bits(&writer, 0U, 8U - writer.bits);
+    }
+
+    return writer.overflow ? 0U : writer.pos;
+}
+
+/*
+ * send the compressed frames
+ */
+void raw_stream_task(void *pvParameters)
+{
+    (void)pvParameters;
+
+    for (;;)
+    {
+        size_t length = sizeof(RAW_STREAM_LINE_PREFIX) - 1U;
+
+        (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        memcpy(stream_state.line, RAW_STREAM_LINE_PREFIX, length);
+        length += raw_stream_base64(stream_state.frame, stream_state.frame_size, &stream_state.line[length]);
+        stream_state.line[length++] = '\r';
+        stream_state.line[length++] = '\n';
+
+        /* the frame buffer is free again, the line is sent from its own buffer */
+        stream_state.busy = false;
+
+        console_uart_write(stream_state.line, length);
+        stream_state.stats.frames_sent++;
+    }
+}
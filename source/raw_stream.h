@@ -0,0 +1,189 @@
+/*****************************************************************************
+ * File name: raw_stream.h
+ *
+ * Description: This file contains types and function prototypes of the
+ *   lossless raw frame stream over the console UART
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_RAW_STREAM_H_
+#define SOURCE_RAW_STREAM_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*
+ * @def RAW_STREAM_MAX_SAMPLES
+ * Maximum number of samples per frame
+ */
+#define RAW_STREAM_MAX_SAMPLES              (2048U)
+
+/*
+ * @def RAW_STREAM_MAX_DECIMATION
+ * Largest number of frames per streamed frame
+ */
+#define RAW_STREAM_MAX_DECIMATION           (1000U)
+
+/*
+ * @def RAW_STREAM_HEADER_SIZE
+ * Frame header: version, antennas, samples per chirp, chirps, sequence and
+ * timestamp in ms, little endian
+ */
+#define RAW_STREAM_HEADER_SIZE              (12U)
+
+/*
+ * @def RAW_STREAM_MAX_FRAME_SIZE
+ * Size bound of a compressed frame including header and CRC, a chirp that
+ * does not compress is stored with 12 bits per sample
+ */
+#define RAW_STREAM_MAX_FRAME_SIZE           (RAW_STREAM_HEADER_SIZE + (RAW_STREAM_MAX_SAMPLES * 2U) + 4U)
+
+/*
+ * @def struct raw_stream_stats_s
+ * Counters of the stream
+ * frames_sent - streamed frames
+ * frames_dropped - frames skipped because the previous one was still sent
+ * raw_bytes - size of the streamed frames with 12 bits per sample
+ * compressed_bytes - size of the streamed frames after compression
+ */
+typedef struct
+{
+    uint32_t frames_sent;
+    uint32_t frames_dropped;
+    uint32_t raw_bytes;
+    uint32_t compressed_bytes;
+} raw_stream_stats_s;
+
+
+/*******************************************************************************
+ * Function Name: raw_stream_init
+ ****************************************************************************//**
+ *
+ * @brief Sets the frame format. The stream is off until a decimation is set.
+ *
+ * @param task Task running raw_stream_task.
+ * @param num_chirps Number of chirps per frame.
+ * @param samples_per_chirp Number of samples per chirp and antenna.
+ * @param num_antennas Number of interleaved antennas.
+ *
+ * @return 0 on success, -1 if the frame exceeds RAW_STREAM_MAX_SAMPLES.
+ *
+ *******************************************************************************/
+int32_t raw_stream_init(TaskHandle_t task, uint32_t num_chirps,
+                        uint32_t samples_per_chirp, uint32_t num_antennas);
+
+/*******************************************************************************
+ * Function Name: raw_stream_set_decimation
+ ****************************************************************************//**
+ *
+ * @param decimation 0 stops the stream, N streams every Nth frame.
+ *
+ * @return 0 on success, -1 if the decimation is out of range.
+ *
+ *******************************************************************************/
+int32_t raw_stream_set_decimation(uint32_t decimation);
+
+/*******************************************************************************
+ * Function Name: raw_stream_get_decimation
+ ****************************************************************************//**
+ *
+ * @return Current decimation, 0 if the stream is off.
+ *
+ *******************************************************************************/
+uint32_t raw_stream_get_decimation(void);
+
+/*******************************************************************************
+ * Function Name: raw_stream_get_stats
+ ****************************************************************************//**
+ *
+ * @return Counters of the stream.
+ *
+ *******************************************************************************/
+const raw_stream_stats_s *raw_stream_get_stats(void);
+
+/*******************************************************************************
+ * Function Name: raw_stream_capture
+ ****************************************************************************//**
+ *
+ * @brief Compresses a FIFO frame for the stream task if it is selected by the
+ * decimation and the previous frame has been sent. Called from the
+ * acquisition task before the FIFO buffer is released.
+ *
+ * @param samples 12 bit samples of the frame as read from the FIFO.
+ * @param timestamp_ms Time of the frame.
+ *
+ *******************************************************************************/
+void raw_stream_capture(const uint16_t *samples, uint32_t timestamp_ms);
+
+/*******************************************************************************
+ * Function Name: raw_stream_compress
+ ****************************************************************************//**
+ *
+ * @brief Compresses samples block by block. Each block starts with a 4 bit
+ * Rice parameter k, followed by the first sample of each antenna with 12 bits
+ * and the zigzag mapped differences to the previous sample of the same
+ * antenna, Rice coded. A quotient of 16 escapes to a 13 bit difference.
+ * k = 15 marks a block stored with 12 bits per sample. The bit stream is
+ * MSB first and padded to a byte.
+ *
+ * @param samples 12 bit samples.
+ * @param num_blocks Number of blocks, usually the chirps.
+ * @param block_size Number of samples per block.
+ * @param stride Number of interleaved antennas.
+ * @param dst Destination.
+ * @param size Size of the destination.
+ *
+ * @return Number of bytes written, 0 if the destination is too small or a
+ * block is not longer than the stride.
+ *
+ *******************************************************************************/
+size_t raw_stream_compress(const uint16_t *samples, uint32_t num_blocks, uint32_t block_size,
+                           uint32_t stride, uint8_t *dst, size_t size);
+
+/*******************************************************************************
+ * Function Name: raw_stream_task
+ ****************************************************************************//**
+ *
+ * @brief Sends compressed frames as "[RAW] <base64>" lines. A frame is the
+ * header, the compressed samples and the CRC-32 of both.
+ *
+ * @param pvParameters Unused.
+ *
+ *******************************************************************************/
+__NO_RETURN void raw_stream_task(void *pvParameters);
+
+#endif /* SOURCE_RAW_STREAM_H_ */
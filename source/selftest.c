@@ -0,0 +1,198 @@
+/*****************************************************************************
+ * File name: selftest.c
+ *
+ * Description: This file implements the presence detection self test with
+ *   fixed frame sequences
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+
+#include "FreeRTOS.h"
+
+#include "radar_rx_processing.h"
+#include "radar_scene_sim.h"
+#include "frame_change_gate.h"
+#include "selftest.h"
+#include "selftest_scenarios.h"
+
+/*******************************************************************************
+ * Function Name: selftest_event_cb
+ ****************************************************************************//**
+ *
+ * @brief Presence callback of the private instance, collects the events.
+ *
+ *******************************************************************************/
+static void selftest_event_cb(xensiv_radar_presence_handle_t handle,
+                              const xensiv_radar_presence_event_t *event,
+                              void *data)
+{
+    selftest_run_s *run = (selftest_run_s *)data;
+
+    (void)handle;
+
+    if (run->num_events < SELFTEST_MAX_EVENTS)
+    {
+        run->events[run->num_events++] = *event;
+    }
+    else
+    {
+        run->num_dropped++;
+    }
+}
+
+/*
+ * run all scenarios in all modes
+ */
+int32_t selftest_run(const xensiv_radar_presence_config_t *config, selftest_report_t report)
+{
+    static const xensiv_radar_presence_mode_t modes[] =
+    {
+        XENSIV_RADAR_PRESENCE_MODE_MACRO_ONLY,
+        XENSIV_RADAR_PRESENCE_MODE_MICRO_ONLY,
+        XENSIV_RADAR_PRESENCE_MODE_MICRO_IF_MACRO,
+        XENSIV_RADAR_PRESENCE_MODE_MICRO_AND_MACRO
+    };
+    uint32_t num_scenarios;
+    const selftest_scenario_s *scenarios = selftest_scenarios_get(&num_scenarios);
+    radar_scene_sim_s *sim;
+    selftest_run_s *run;
+    frame_change_gate_s *gate;
+    radar_rx_combiner_s *combiner;
+    uint16_t *fifo_data = NULL;
+    float32_t *planar = NULL;
+    float32_t *avg_chirps = NULL;
+    float32_t *chirp = NULL;
+    uint32_t samples_per_antenna = 0U;
+    uint32_t num_samples = 0U;
+    uint32_t num_rx = 0U;
+    int32_t result = 0;
+
+    run = pvPortMalloc(sizeof(*run));
+    sim = pvPortMalloc(sizeof(*sim));
+    gate = pvPortMalloc(sizeof(*gate));
+    combiner = pvPortMalloc(sizeof(*combiner));
+
+    if (sim != NULL)
+    {
+        radar_scene_sim_init(sim, SELFTEST_SEED);
+
+        num_samples = sim->params.num_samples_per_chirp;
+        num_rx = sim->params.num_rx_antennas;
+        samples_per_antenna = sim->params.num_chirps_per_frame * num_samples;
+
+        fifo_data = pvPortMalloc(samples_per_antenna * num_rx * sizeof(uint16_t));
+        planar = pvPortMalloc(samples_per_antenna * num_rx * sizeof(float32_t));
+        avg_chirps = pvPortMalloc(num_samples * num_rx * sizeof(float32_t));
+        chirp = pvPortMalloc(num_samples * sizeof(float32_t));
+    }
+
+    if ((run == NULL) || (sim == NULL) || (gate == NULL) || (combiner == NULL) || (fifo_data == NULL) ||
+        (planar == NULL) || (avg_chirps == NULL) || (chirp == NULL))
+    {
+        result = -1;
+    }
+
+    for (uint32_t s = 0U; (s < num_scenarios) && (result == 0); s++)
+    {
+        for (uint32_t m = 0U; m < (sizeof(modes) / sizeof(modes[0])); m++)
+        {
+            xensiv_radar_presence_config_t run_config = *config;
+            xensiv_radar_presence_handle_t handle;
+            uint32_t frame = 0U;
+
+            run_config.mode = modes[m];
+
+            if (xensiv_radar_presence_alloc(&handle, &run_config) != XENSIV_RADAR_PRESENCE_OK)
+            {
+                result = -1;
+                break;
+            }
+
+            memset(run, 0, sizeof(*run));
+            run->scenario = scenarios[s].name;
+            run->mode = modes[m];
+            xensiv_radar_presence_set_callback(handle, selftest_event_cb, run);
+            (void)frame_change_gate_init(gate, num_samples);
+            (void)radar_rx_combiner_init(combiner, num_rx, num_samples);
+
+            /* every run sees the same frames */
+            radar_scene_sim_init(sim, SELFTEST_SEED);
+            sim->params.frame_repetition_time_s = (float32_t)SELFTEST_FRAME_PERIOD_MS / 1000.0f;
+
+            for (uint32_t i = 0U; i < scenarios[s].num_segments; i++)
+            {
+                const selftest_segment_s *segment = &scenarios[s].segments[i];
+
+                (void)radar_scene_sim_set_targets(sim, segment->targets, segment->num_targets);
+
+                for (uint32_t n = 0U; n < segment->num_frames; n++, frame++)
+                {
+                    /* FIFO words read as bytes, then the same preprocessing as the live path */
+                    radar_scene_sim_frame(sim, (uint8_t *)fifo_data);
+                    radar_rx_unpack_fifo((const uint8_t *)fifo_data, fifo_data, samples_per_antenna * num_rx);
+                    radar_rx_deinterleave(fifo_data, planar, num_rx, samples_per_antenna);
+                    radar_rx_average_chirps(planar, avg_chirps, num_rx, sim->params.num_chirps_per_frame, num_samples);
+                    radar_rx_combine(combiner, avg_chirps, chirp, frame * SELFTEST_FRAME_PERIOD_MS);
+
+                    /* the live path gates the low frame rate profile, which runs while the scene is empty */
+                    if (frame_change_gate_process(gate, chirp,
+                                                  ((modes[m] == XENSIV_RADAR_PRESENCE_MODE_MACRO_ONLY) ||
+                                                   (modes[m] == XENSIV_RADAR_PRESENCE_MODE_MICRO_IF_MACRO)) &&
+                                                  ((run->num_events == 0U) ||
+                                                   (run->events[run->num_events - 1U].state == XENSIV_RADAR_PRESENCE_STATE_ABSENCE))))
+                    {
+                        (void)xensiv_radar_presence_process_frame(handle, chirp, frame * SELFTEST_FRAME_PERIOD_MS);
+                    }
+                }
+            }
+
+            run->num_frames = frame;
+            run->num_skipped = gate->stats.skipped;
+            xensiv_radar_presence_free(handle);
+            report(run);
+        }
+    }
+
+    vPortFree(run);
+    vPortFree(sim);
+    vPortFree(gate);
+    vPortFree(combiner);
+    vPortFree(fifo_data);
+    vPortFree(planar);
+    vPortFree(avg_chirps);
+    vPortFree(chirp);
+
+    return result;
+}
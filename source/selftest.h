@@ -0,0 +1,104 @@
+/*****************************************************************************
+ * File name: selftest.h
+ *
+ * Description: This file contains types and function prototypes of the
+ *   presence detection self test with fixed frame sequences
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_SELFTEST_H_
+#define SOURCE_SELFTEST_H_
+
+#include <stdint.h>
+
+#include "xensiv_radar_presence.h"
+
+/*
+ * @def SELFTEST_MAX_EVENTS
+ * Events kept per scenario and mode, further events are only counted
+ */
+#define SELFTEST_MAX_EVENTS                 (48U)
+
+/*
+ * @def SELFTEST_FRAME_PERIOD_MS
+ * Time between two frames of a scenario
+ */
+#define SELFTEST_FRAME_PERIOD_MS            (100U)
+
+/*
+ * @def struct selftest_run_s
+ * Event stream of one scenario in one mode
+ * scenario - scenario name
+ * mode - presence mode
+ * events - reported events, timestamps count from the first frame
+ * num_events - number of kept events
+ * num_dropped - events beyond SELFTEST_MAX_EVENTS
+ * num_frames - frames of the scenario
+ * num_skipped - frames skipped by the frame change gate
+ */
+typedef struct
+{
+    const char *scenario;
+    xensiv_radar_presence_mode_t mode;
+    xensiv_radar_presence_event_t events[SELFTEST_MAX_EVENTS];
+    uint32_t num_events;
+    uint32_t num_dropped;
+    uint32_t num_frames;
+    uint32_t num_skipped;
+} selftest_run_s;
+
+typedef void (*selftest_report_t)(const selftest_run_s *run);
+
+
+/*******************************************************************************
+ * Function Name: selftest_run
+ ****************************************************************************//**
+ *
+ * @brief Runs every scenario through a private instance of the presence
+ * algorithm in every mode and reports the event streams. The FIFO frames
+ * come from the scene simulator with a fixed seed and pass the preprocessing
+ * of the live path, so a build reports the same streams on every run. The
+ * live processing is not affected. The frame change gate skips frames with
+ * the live threshold, so comparing the streams with the gate disabled and
+ * enabled shows the detection delay it adds. Called from the console task.
+ *
+ * @param config Presence configuration, the mode is replaced for every run.
+ * @param report Called for every scenario and mode.
+ *
+ * @return 0 on success, -1 if the presence algorithm cannot be allocated.
+ *
+ *******************************************************************************/
+int32_t selftest_run(const xensiv_radar_presence_config_t *config, selftest_report_t report);
+
+#endif /* SOURCE_SELFTEST_H_ */
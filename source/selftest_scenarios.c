@@ -0,0 +1,124 @@
+/*****************************************************************************
+ * File name: selftest_scenarios.c
+ *
+ * Description: This file contains the fixed scenarios of the presence
+ *   self test: an empty room, a person walking in near the sensor and sitting
+ *   down, and a person sitting far away, all with a static cabinet as clutter
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "selftest_scenarios.h"
+
+/* Echo amplitude of a person in ADC codes at 1 m */
+#define SELFTEST_PERSON_AMPLITUDE           (800.0f)
+
+/* Static clutter present in every scenario */
+#define SELFTEST_CABINET                    { 2.2f, 0.0f, 0.0f, 0.0f, 30.0f, 1500.0f }
+
+#define SELFTEST_TARGETS(targets)           targets, (sizeof(targets) / sizeof(targets[0]))
+
+/* range, velocity, breathing displacement and rate, angle, amplitude */
+static const radar_scene_sim_target_s cabinet[] =
+{
+    SELFTEST_CABINET
+};
+
+static const radar_scene_sim_target_s walk_in_to_near[] =
+{
+    SELFTEST_CABINET,
+    { 3.0f, -0.5f, 0.0f, 0.0f, 0.0f, SELFTEST_PERSON_AMPLITUDE }
+};
+
+static const radar_scene_sim_target_s move_near[] =
+{
+    SELFTEST_CABINET,
+    { 1.0f, 0.0f, 0.1f, 0.3f, 0.0f, SELFTEST_PERSON_AMPLITUDE }
+};
+
+static const radar_scene_sim_target_s sit_near[] =
+{
+    SELFTEST_CABINET,
+    { 1.0f, 0.0f, 0.002f, 0.25f, 0.0f, SELFTEST_PERSON_AMPLITUDE }
+};
+
+static const radar_scene_sim_target_s walk_in_to_far[] =
+{
+    SELFTEST_CABINET,
+    { 4.0f, -0.5f, 0.0f, 0.0f, -20.0f, SELFTEST_PERSON_AMPLITUDE }
+};
+
+static const radar_scene_sim_target_s sit_far_away[] =
+{
+    SELFTEST_CABINET,
+    { 3.0f, 0.0f, 0.002f, 0.25f, -20.0f, SELFTEST_PERSON_AMPLITUDE }
+};
+
+static const selftest_segment_s empty_room[] =
+{
+    { 300U, SELFTEST_TARGETS(cabinet) }
+};
+
+static const selftest_segment_s walk_in_near[] =
+{
+    { 100U, SELFTEST_TARGETS(cabinet) },
+    { 40U, SELFTEST_TARGETS(walk_in_to_near) },
+    { 160U, SELFTEST_TARGETS(move_near) },
+    { 200U, SELFTEST_TARGETS(sit_near) },
+    { 200U, SELFTEST_TARGETS(cabinet) }
+};
+
+static const selftest_segment_s sit_far[] =
+{
+    { 100U, SELFTEST_TARGETS(cabinet) },
+    { 20U, SELFTEST_TARGETS(walk_in_to_far) },
+    { 300U, SELFTEST_TARGETS(sit_far_away) },
+    { 100U, SELFTEST_TARGETS(cabinet) }
+};
+
+static const selftest_scenario_s scenarios[] =
+{
+    { "empty_room", SELFTEST_TARGETS(empty_room) },
+    { "walk_in_near", SELFTEST_TARGETS(walk_in_near) },
+    { "sit_far", SELFTEST_TARGETS(sit_far) }
+};
+
+/*
+ * get the scenario table
+ */
+const selftest_scenario_s *selftest_scenarios_get(uint32_t *num_scenarios)
+{
+    *num_scenarios = sizeof(scenarios) / sizeof(scenarios[0]);
+
+    return scenarios;
+}
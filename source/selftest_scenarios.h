@@ -0,0 +1,96 @@
+/*****************************************************************************
+ * File name: selftest_scenarios.h
+ *
+ * Description: This file contains the types and the accessor of the fixed
+ *   scenarios of the presence self test, shared with the host regression tests
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_SELFTEST_SCENARIOS_H_
+#define SOURCE_SELFTEST_SCENARIOS_H_
+
+#include <stdint.h>
+
+#include "radar_scene_sim.h"
+
+/*
+ * @def SELFTEST_SEED
+ * Noise seed of the scene simulator, every run sees the same frames
+ */
+#define SELFTEST_SEED                       (0x2545F491U)
+
+/*
+ * @def struct selftest_segment_s
+ * Part of a scenario with a fixed set of targets, the first one is the
+ * static clutter of the room
+ * num_frames - frames of the segment
+ * targets - targets of the segment
+ * num_targets - number of targets, more than one while a person is present
+ */
+typedef struct
+{
+    uint32_t num_frames;
+    const radar_scene_sim_target_s *targets;
+    uint32_t num_targets;
+} selftest_segment_s;
+
+/*
+ * @def struct selftest_scenario_s
+ * Scenario of the self test
+ * name - scenario name
+ * segments - segments in time order
+ * num_segments - number of segments
+ */
+typedef struct
+{
+    const char *name;
+    const selftest_segment_s *segments;
+    uint32_t num_segments;
+} selftest_scenario_s;
+
+
+/*******************************************************************************
+ * Function Name: selftest_scenarios_get
+ ****************************************************************************//**
+ *
+ * @brief Returns the scenarios of the self test.
+ *
+ * @param num_scenarios Number of scenarios.
+ *
+ * @return Scenario table.
+ *
+ *******************************************************************************/
+const selftest_scenario_s *selftest_scenarios_get(uint32_t *num_scenarios);
+
+#endif /* SOURCE_SELFTEST_SCENARIOS_H_ */
@@ -0,0 +1,307 @@
+/*****************************************************************************
+ * File name: slow_time_filter.c
+ *
+ * Description: This file implements a streaming filter bank along slow time
+ *   with one biquad cascade per chirp sample and a frame decimator
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+
+#include "slow_time_filter.h"
+
+/* Butterworth quality factor of the sections */
+#define SLOW_TIME_BIQUAD_Q                  (0.7071f)
+
+/* Sections above this fraction of the frame rate are bypassed */
+#define SLOW_TIME_MAX_NORMALIZED_CUTOFF     (0.45f)
+
+static slow_time_filter_s live_filter;
+
+/*******************************************************************************
+ * Function Name: slow_time_design_biquad
+ ****************************************************************************//**
+ *
+ * @brief Designs a second order Butterworth section in the CMSIS DF2T
+ * coefficient order {b0, b1, b2, -a1, -a2}.
+ *
+ * @param coeffs Five coefficients of the section.
+ * @param normalized_cutoff Cutoff frequency divided by the frame rate.
+ * @param highpass true for a high-pass, false for a low-pass.
+ *
+ *******************************************************************************/
+static void slow_time_design_biquad(float32_t *coeffs, float32_t normalized_cutoff, bool highpass)
+{
+    float32_t w0 = 2.0f * PI * normalized_cutoff;
+    float32_t cos_w0 = arm_cos_f32(w0);
+    float32_t alpha = arm_sin_f32(w0) / (2.0f * SLOW_TIME_BIQUAD_Q);
+    float32_t a0 = 1.0f + alpha;
+    float32_t b = highpass ? ((1.0f + cos_w0) / 2.0f) : ((1.0f - cos_w0) / 2.0f);
+
+    coeffs[0] = b / a0;
+    coeffs[1] = (highpass ? (-2.0f * b) : (2.0f * b)) / a0;
+    coeffs[2] = b / a0;
+    coeffs[3] = (2.0f * cos_w0) / a0;
+    coeffs[4] = -(1.0f - alpha) / a0;
+}
+
+/*******************************************************************************
+ * Function Name: slow_time_design
+ ****************************************************************************//**
+ *
+ * @brief Designs the active sections for the current frame rate and clears
+ * the filter and decimator history.
+ *
+ * @param filter Filter bank instance.
+ *
+ *******************************************************************************/
+static void slow_time_design(slow_time_filter_s *filter)
+{
+    const slow_time_filter_config_s *config = &filter->config;
+    float32_t highpass = config->highpass_hz / filter->frame_rate_hz;
+    float32_t lowpass = config->lowpass_hz / filter->frame_rate_hz;
+
+    filter->num_active_stages = 0;
+
+    if ((config->highpass_hz > 0.0f) && (highpass < SLOW_TIME_MAX_NORMALIZED_CUTOFF))
+    {
+        slow_time_design_biquad(&filter->coeffs[5U * filter->num_active_stages], highpass, true);
+        filter->num_active_stages++;
+    }
+
+    if ((config->lowpass_hz > 0.0f) && (lowpass < SLOW_TIME_MAX_NORMALIZED_CUTOFF))
+    {
+        slow_time_design_biquad(&filter->coeffs[5U * filter->num_active_stages], lowpass, false);
+        filter->num_active_stages++;
+    }
+
+    memset(filter->state, 0, sizeof(filter->state));
+    memset(filter->accumulator, 0, sizeof(filter->accumulator));
+    filter->phase = 0;
+}
+
+/*******************************************************************************
+ * Function Name: slow_time_biquad_multichannel
+ ****************************************************************************//**
+ *
+ * @brief Runs one DF2T section on one sample of every channel. The channels
+ * share the coefficients, so the loop runs over the channels and is unrolled
+ * like the CMSIS kernels.
+ *
+ * @param coeffs Five coefficients of the section.
+ * @param d1 First state variable of every channel.
+ * @param d2 Second state variable of every channel.
+ * @param input One sample per channel.
+ * @param output One sample per channel, may alias the input.
+ * @param num_channels Number of channels.
+ *
+ *******************************************************************************/
+static void slow_time_biquad_multichannel(const float32_t *coeffs, float32_t *d1, float32_t *d2,
+                                          const float32_t *input, float32_t *output,
+                                          uint32_t num_channels)
+{
+    const float32_t b0 = coeffs[0];
+    const float32_t b1 = coeffs[1];
+    const float32_t b2 = coeffs[2];
+    const float32_t a1 = coeffs[3];
+    const float32_t a2 = coeffs[4];
+    uint32_t ch = 0;
+
+    for (; (ch + 4U) <= num_channels; ch += 4U)
+    {
+        float32_t x0 = input[ch];
+        float32_t x1 = input[ch + 1U];
+        float32_t x2 = input[ch + 2U];
+        float32_t x3 = input[ch + 3U];
+        float32_t y0 = (b0 * x0) + d1[ch];
+        float32_t y1 = (b0 * x1) + d1[ch + 1U];
+        float32_t y2 = (b0 * x2) + d1[ch + 2U];
+        float32_t y3 = (b0 * x3) + d1[ch + 3U];
+
+        d1[ch] = (b1 * x0) + (a1 * y0) + d2[ch];
+        d1[ch + 1U] = (b1 * x1) + (a1 * y1) + d2[ch + 1U];
+        d1[ch + 2U] = (b1 * x2) + (a1 * y2) + d2[ch + 2U];
+        d1[ch + 3U] = (b1 * x3) + (a1 * y3) + d2[ch + 3U];
+
+        d2[ch] = (b2 * x0) + (a2 * y0);
+        d2[ch + 1U] = (b2 * x1) + (a2 * y1);
+        d2[ch + 2U] = (b2 * x2) + (a2 * y2);
+        d2[ch + 3U] = (b2 * x3) + (a2 * y3);
+
+        output[ch] = y0;
+        output[ch + 1U] = y1;
+        output[ch + 2U] = y2;
+        output[ch + 3U] = y3;
+    }
+
+    for (; ch < num_channels; ch++)
+    {
+        float32_t x = input[ch];
+        float32_t y = (b0 * x) + d1[ch];
+
+        d1[ch] = (b1 * x) + (a1 * y) + d2[ch];
+        d2[ch] = (b2 * x) + (a2 * y);
+        output[ch] = y;
+    }
+}
+
+/*
+ * initialize the filter bank in bypass
+ */
+int32_t slow_time_filter_init(slow_time_filter_s *filter, uint32_t num_channels, float32_t frame_period_s)
+{
+    if ((num_channels == 0U) || (num_channels > SLOW_TIME_MAX_CHANNELS) || (frame_period_s <= 0.0f))
+    {
+        return -1;
+    }
+
+    memset(filter, 0, sizeof(*filter));
+    filter->num_channels = num_channels;
+    filter->frame_rate_hz = 1.0f / frame_period_s;
+    filter->config.decimation = 1U;
+
+    return 0;
+}
+
+/*
+ * get the live filter bank
+ */
+slow_time_filter_s *slow_time_filter_get_live(void)
+{
+    return &live_filter;
+}
+
+/*
+ * redesign the sections for a new frame rate
+ */
+int32_t slow_time_filter_set_frame_period(slow_time_filter_s *filter, float32_t frame_period_s)
+{
+    if (frame_period_s <= 0.0f)
+    {
+        return -1;
+    }
+
+    filter->frame_rate_hz = 1.0f / frame_period_s;
+    slow_time_design(filter);
+
+    return 0;
+}
+
+/*
+ * set the cutoff frequencies
+ */
+int32_t slow_time_filter_set_cutoff(slow_time_filter_s *filter, float32_t highpass_hz, float32_t lowpass_hz)
+{
+    if ((highpass_hz < 0.0f) || (highpass_hz > SLOW_TIME_MAX_CUTOFF_HZ) ||
+        (lowpass_hz < 0.0f) || (lowpass_hz > SLOW_TIME_MAX_CUTOFF_HZ) ||
+        ((highpass_hz > 0.0f) && (lowpass_hz > 0.0f) && (highpass_hz >= lowpass_hz)))
+    {
+        return -1;
+    }
+
+    filter->config.highpass_hz = highpass_hz;
+    filter->config.lowpass_hz = lowpass_hz;
+    slow_time_design(filter);
+
+    return 0;
+}
+
+/*
+ * set the frame decimation factor
+ */
+int32_t slow_time_filter_set_decimation(slow_time_filter_s *filter, uint32_t decimation)
+{
+    if ((decimation == 0U) || (decimation > SLOW_TIME_MAX_DECIMATION))
+    {
+        return -1;
+    }
+
+    filter->config.decimation = decimation;
+    slow_time_design(filter);
+
+    return 0;
+}
+
+/*
+ * get the filter bank settings
+ */
+const slow_time_filter_config_s *slow_time_filter_get_config(const slow_time_filter_s *filter)
+{
+    return &filter->config;
+}
+
+/*
+ * filter one averaged chirp
+ */
+bool slow_time_filter_process(slow_time_filter_s *filter, const float32_t *input, float32_t *output)
+{
+    const float32_t *stage_input = input;
+    uint32_t decimation = filter->config.decimation;
+
+    if ((filter->num_active_stages == 0U) && (decimation == 1U))
+    {
+        arm_copy_f32(input, output, filter->num_channels);
+        return true;
+    }
+
+    for (uint32_t stage = 0; stage < filter->num_active_stages; stage++)
+    {
+        slow_time_biquad_multichannel(&filter->coeffs[5U * stage],
+                                      filter->state[stage][0],
+                                      filter->state[stage][1],
+                                      stage_input, filter->stage_buff,
+                                      filter->num_channels);
+        stage_input = filter->stage_buff;
+    }
+
+    if (decimation == 1U)
+    {
+        arm_copy_f32(stage_input, output, filter->num_channels);
+        return true;
+    }
+
+    /* boxcar polyphase decimator: accumulate the phases, dump on the last one */
+    arm_add_f32(filter->accumulator, stage_input, filter->accumulator, filter->num_channels);
+
+    if (++filter->phase < decimation)
+    {
+        return false;
+    }
+
+    arm_scale_f32(filter->accumulator, 1.0f / (float32_t)decimation, output, filter->num_channels);
+    arm_fill_f32(0.0f, filter->accumulator, filter->num_channels);
+    filter->phase = 0;
+
+    return true;
+}
@@ -0,0 +1,197 @@
+/*****************************************************************************
+ * File name: slow_time_filter.h
+ *
+ * Description: This file contains types and function prototypes of the
+ *   streaming slow time filter bank
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_SLOW_TIME_FILTER_H_
+#define SOURCE_SLOW_TIME_FILTER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "arm_math.h"
+
+/*
+ * @def SLOW_TIME_MAX_CHANNELS
+ * Largest number of samples per chirp
+ */
+#define SLOW_TIME_MAX_CHANNELS              (128)
+
+/*
+ * @def SLOW_TIME_MAX_DECIMATION
+ * Largest frame decimation factor
+ */
+#define SLOW_TIME_MAX_DECIMATION            (8U)
+
+/*
+ * @def SLOW_TIME_MAX_CUTOFF_HZ
+ * Largest accepted cutoff frequency. Sections at or above 0.45 times the
+ * current frame rate are bypassed.
+ */
+#define SLOW_TIME_MAX_CUTOFF_HZ             (100.0f)
+
+/*
+ * @typedef typedef struct slow_time_filter_config_s
+ * Filter bank settings, a cutoff of zero disables the section
+ */
+typedef struct
+{
+    float32_t highpass_hz;      /*<< high-pass cutoff in Hz, removes static reflectors*/
+    float32_t lowpass_hz;       /*<< low-pass cutoff in Hz, anti-aliasing for the decimation*/
+    uint32_t decimation;        /*<< only every decimation-th filtered frame is passed on*/
+} slow_time_filter_config_s;
+
+/*
+ * @def SLOW_TIME_NUM_STAGES
+ * High-pass and low-pass section
+ */
+#define SLOW_TIME_NUM_STAGES                (2U)
+
+/*
+ * @typedef typedef struct slow_time_filter_s
+ * Filter bank instance, the settings and the history of every channel
+ */
+typedef struct
+{
+    slow_time_filter_config_s config;
+    uint32_t num_channels;
+    float32_t frame_rate_hz;
+    uint32_t num_active_stages;
+    float32_t coeffs[5U * SLOW_TIME_NUM_STAGES];
+    float32_t state[SLOW_TIME_NUM_STAGES][2][SLOW_TIME_MAX_CHANNELS];
+    float32_t stage_buff[SLOW_TIME_MAX_CHANNELS];
+    float32_t accumulator[SLOW_TIME_MAX_CHANNELS];
+    uint32_t phase;
+} slow_time_filter_s;
+
+
+/*******************************************************************************
+ * Function Name: slow_time_filter_init
+ ****************************************************************************//**
+ *
+ * @brief Initializes a filter bank in bypass.
+ *
+ * @param filter Filter bank instance.
+ * @param num_channels Number of samples per chirp, one filter per sample.
+ * @param frame_period_s Frame period in seconds.
+ *
+ * @return 0 on success, -1 on invalid parameters.
+ *
+ *******************************************************************************/
+int32_t slow_time_filter_init(slow_time_filter_s *filter, uint32_t num_channels, float32_t frame_period_s);
+
+/*******************************************************************************
+ * Function Name: slow_time_filter_get_live
+ ****************************************************************************//**
+ *
+ * @return Filter bank instance of the live frame path.
+ *
+ *******************************************************************************/
+slow_time_filter_s *slow_time_filter_get_live(void);
+
+/*******************************************************************************
+ * Function Name: slow_time_filter_set_frame_period
+ ****************************************************************************//**
+ *
+ * @brief Redesigns the sections for a new frame rate and clears the history.
+ *
+ * @param filter Filter bank instance.
+ * @param frame_period_s Frame period in seconds.
+ *
+ * @return 0 on success, -1 on invalid parameters.
+ *
+ *******************************************************************************/
+int32_t slow_time_filter_set_frame_period(slow_time_filter_s *filter, float32_t frame_period_s);
+
+/*******************************************************************************
+ * Function Name: slow_time_filter_set_cutoff
+ ****************************************************************************//**
+ *
+ * @brief Sets the cutoff frequencies and clears the history.
+ *
+ * @param filter Filter bank instance.
+ * @param highpass_hz High-pass cutoff in Hz, 0 disables the high-pass.
+ * @param lowpass_hz Low-pass cutoff in Hz, 0 disables the low-pass.
+ *
+ * @return 0 on success, -1 on invalid parameters.
+ *
+ *******************************************************************************/
+int32_t slow_time_filter_set_cutoff(slow_time_filter_s *filter, float32_t highpass_hz, float32_t lowpass_hz);
+
+/*******************************************************************************
+ * Function Name: slow_time_filter_set_decimation
+ ****************************************************************************//**
+ *
+ * @brief Sets the frame decimation factor and clears the history.
+ *
+ * @param filter Filter bank instance.
+ * @param decimation Decimation factor, 1 passes every frame.
+ *
+ * @return 0 on success, -1 on invalid parameters.
+ *
+ *******************************************************************************/
+int32_t slow_time_filter_set_decimation(slow_time_filter_s *filter, uint32_t decimation);
+
+/*******************************************************************************
+ * Function Name: slow_time_filter_get_config
+ ****************************************************************************//**
+ *
+ * @param filter Filter bank instance.
+ *
+ * @return Pointer to the filter bank settings.
+ *
+ *******************************************************************************/
+const slow_time_filter_config_s *slow_time_filter_get_config(const slow_time_filter_s *filter);
+
+/*******************************************************************************
+ * Function Name: slow_time_filter_process
+ ****************************************************************************//**
+ *
+ * @brief Filters one averaged chirp along slow time. Every sample of the chirp
+ * has its own filter state, which is kept across frames. The decimator sums
+ * the filtered chirps and outputs their mean every decimation-th frame.
+ *
+ * @param filter Filter bank instance.
+ * @param input Averaged chirp of the current frame.
+ * @param output Filtered chirp, only written if an output is ready.
+ *
+ * @return true if an output is ready, false otherwise.
+ *
+ *******************************************************************************/
+bool slow_time_filter_process(slow_time_filter_s *filter, const float32_t *input, float32_t *output);
+
+#endif /* SOURCE_SLOW_TIME_FILTER_H_ */
@@ -0,0 +1,221 @@
+/*****************************************************************************
+ * File name: task_stats.c
+ *
+ * Description: This file implements the per task CPU load, stack and
+ *   heap statistics
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "cyhal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+#include "task_stats.h"
+
+typedef struct
+{
+    cyhal_timer_t timer;
+    bool timer_ready;
+    TimerHandle_t window_timer;
+    TaskStatus_t status[TASK_STATS_MAX_TASKS];
+    uint32_t previous_number[TASK_STATS_MAX_TASKS];
+    uint32_t previous_counter[TASK_STATS_MAX_TASKS];
+    uint32_t num_previous;
+    uint32_t previous_total;
+    task_stats_s stats;
+    bool valid;
+} task_stats_state_s;
+
+static task_stats_state_s stats_state;
+
+/*******************************************************************************
+ * Function Name: task_stats_previous_counter
+ ****************************************************************************//**
+ *
+ * @brief Run time counter of a task at the end of the previous window.
+ *
+ * @param number Task number.
+ *
+ * @return Counter value, 0 for a task created during the window.
+ *
+ *******************************************************************************/
+static uint32_t task_stats_previous_counter(uint32_t number)
+{
+    for (uint32_t i = 0U; i < stats_state.num_previous; i++)
+    {
+        if (stats_state.previous_number[i] == number)
+        {
+            return stats_state.previous_counter[i];
+        }
+    }
+
+    return 0U;
+}
+
+/*******************************************************************************
+ * Function Name: task_stats_window_callback
+ ****************************************************************************//**
+ *
+ * @brief Closes a window: the CPU share of every task is the difference of its
+ * run time counter to the previous window, so the counters may wrap around.
+ * Runs in the timer task, the scheduler is suspended while the statistics
+ * are updated.
+ *
+ *******************************************************************************/
+static void task_stats_window_callback(TimerHandle_t timer)
+{
+    TaskHandle_t idle = xTaskGetIdleTaskHandle();
+    uint32_t total;
+    uint32_t elapsed;
+    UBaseType_t num_tasks;
+
+    (void)timer;
+
+    vTaskSuspendAll();
+
+    num_tasks = uxTaskGetSystemState(stats_state.status, TASK_STATS_MAX_TASKS, &total);
+    elapsed = total - stats_state.previous_total;
+
+    if ((num_tasks > 0U) && (elapsed > 0U))
+    {
+        stats_state.stats.window_ms = elapsed / (TASK_STATS_TIMER_HZ / 1000U);
+        stats_state.stats.load_permille = 1000U;
+        stats_state.stats.heap_free = (uint32_t)xPortGetFreeHeapSize();
+        stats_state.stats.heap_min_free = (uint32_t)xPortGetMinimumEverFreeHeapSize();
+        stats_state.stats.num_tasks = (uint32_t)num_tasks;
+
+        for (uint32_t i = 0U; i < (uint32_t)num_tasks; i++)
+        {
+            const TaskStatus_t *status = &stats_state.status[i];
+            task_stats_task_s *task = &stats_state.stats.tasks[i];
+            uint32_t busy = status->ulRunTimeCounter - task_stats_previous_counter((uint32_t)status->xTaskNumber);
+
+            strncpy(task->name, status->pcTaskName, sizeof(task->name) - 1U);
+            task->name[sizeof(task->name) - 1U] = '\0';
+            task->priority = (uint32_t)status->uxCurrentPriority;
+            task->cpu_permille = (uint32_t)(((uint64_t)busy * 1000U) / elapsed);
+            task->stack_free = (uint32_t)status->usStackHighWaterMark * sizeof(StackType_t);
+
+            if (status->xHandle == idle)
+            {
+                stats_state.stats.load_permille = (task->cpu_permille < 1000U) ? (1000U - task->cpu_permille) : 0U;
+            }
+        }
+
+        for (uint32_t i = 0U; i < (uint32_t)num_tasks; i++)
+        {
+            stats_state.previous_number[i] = (uint32_t)stats_state.status[i].xTaskNumber;
+            stats_state.previous_counter[i] = stats_state.status[i].ulRunTimeCounter;
+        }
+
+        stats_state.num_previous = (uint32_t)num_tasks;
+        stats_state.previous_total = total;
+        stats_state.valid = true;
+    }
+
+    (void)xTaskResumeAll();
+}
+
+/*
+ * create the window timer
+ */
+int32_t task_stats_init(void)
+{
+    stats_state.window_timer = xTimerCreate("task_stats", pdMS_TO_TICKS(TASK_STATS_WINDOW_MS),
+                                            pdTRUE, NULL, task_stats_window_callback);
+
+    if (stats_state.window_timer == NULL)
+    {
+        return -1;
+    }
+
+    return (xTimerStart(stats_state.window_timer, 0) == pdPASS) ? 0 : -1;
+}
+
+/*
+ * start the 1 MHz run time counter
+ */
+void task_stats_timer_init(void)
+{
+    const cyhal_timer_cfg_t timer_cfg =
+    {
+        .is_continuous = true,
+        .direction = CYHAL_TIMER_DIR_UP,
+        .is_compare = false,
+        .period = UINT32_MAX,
+        .compare_value = 0U,
+        .value = 0U
+    };
+
+    if ((cyhal_timer_init(&stats_state.timer, NC, NULL) != CY_RSLT_SUCCESS) ||
+        (cyhal_timer_configure(&stats_state.timer, &timer_cfg) != CY_RSLT_SUCCESS) ||
+        (cyhal_timer_set_frequency(&stats_state.timer, TASK_STATS_TIMER_HZ) != CY_RSLT_SUCCESS) ||
+        (cyhal_timer_start(&stats_state.timer) != CY_RSLT_SUCCESS))
+    {
+        printf("[MSG] ERROR: run time statistics timer initialization failed\n");
+        return;
+    }
+
+    stats_state.timer_ready = true;
+}
+
+/*
+ * read the run time counter
+ */
+uint32_t task_stats_timer_read(void)
+{
+    return stats_state.timer_ready ? cyhal_timer_read(&stats_state.timer) : 0U;
+}
+
+/*
+ * copy the statistics of the last window
+ */
+bool task_stats_get(task_stats_s *stats)
+{
+    bool valid;
+
+    vTaskSuspendAll();
+    valid = stats_state.valid;
+    if (valid)
+    {
+        *stats = stats_state.stats;
+    }
+    (void)xTaskResumeAll();
+
+    return valid;
+}
@@ -0,0 +1,150 @@
+/*****************************************************************************
+ * File name: task_stats.h
+ *
+ * Description: This file contains types and function prototypes of the
+ *   per task CPU load, stack and heap statistics
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_TASK_STATS_H_
+#define SOURCE_TASK_STATS_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+
+/*
+ * @def TASK_STATS_MAX_TASKS
+ * Maximum number of tasks in the statistics, including the kernel tasks
+ */
+#define TASK_STATS_MAX_TASKS                (12U)
+
+/*
+ * @def TASK_STATS_TIMER_HZ
+ * Resolution of the run time counter
+ */
+#define TASK_STATS_TIMER_HZ                 (1000000U)
+
+/*
+ * @def TASK_STATS_WINDOW_MS
+ * The CPU load is measured over windows of this length
+ */
+#define TASK_STATS_WINDOW_MS                (5000U)
+
+/*
+ * @def struct task_stats_task_s
+ * Statistics of one task
+ * name - task name
+ * priority - current priority
+ * cpu_permille - share of the CPU time in the last window, 1000 is 100 %
+ * stack_free - smallest free stack since the task was created, in bytes
+ */
+typedef struct
+{
+    char name[configMAX_TASK_NAME_LEN];
+    uint32_t priority;
+    uint32_t cpu_permille;
+    uint32_t stack_free;
+} task_stats_task_s;
+
+/*
+ * @def struct task_stats_s
+ * Statistics of the last window
+ * window_ms - length of the window
+ * load_permille - CPU time not spent in the idle task, 1000 is 100 %
+ * heap_free - free heap at the end of the window, in bytes
+ * heap_min_free - smallest free heap since boot, in bytes
+ * num_tasks - number of tasks
+ * tasks - statistics per task
+ */
+typedef struct
+{
+    uint32_t window_ms;
+    uint32_t load_permille;
+    uint32_t heap_free;
+    uint32_t heap_min_free;
+    uint32_t num_tasks;
+    task_stats_task_s tasks[TASK_STATS_MAX_TASKS];
+} task_stats_s;
+
+
+/*******************************************************************************
+ * Function Name: task_stats_init
+ ****************************************************************************//**
+ *
+ * @brief Creates the timer that closes a statistics window every
+ * TASK_STATS_WINDOW_MS. Called once before the scheduler starts.
+ *
+ * @return 0 on success, -1 if the timer cannot be created.
+ *
+ *******************************************************************************/
+int32_t task_stats_init(void);
+
+/*******************************************************************************
+ * Function Name: task_stats_timer_init
+ ****************************************************************************//**
+ *
+ * @brief Starts the free running run time counter, called by the kernel when
+ * the scheduler starts (portCONFIGURE_TIMER_FOR_RUN_TIME_STATS).
+ *
+ *******************************************************************************/
+void task_stats_timer_init(void);
+
+/*******************************************************************************
+ * Function Name: task_stats_timer_read
+ ****************************************************************************//**
+ *
+ * @brief Reads the run time counter, called by the kernel on every context
+ * switch (portGET_RUN_TIME_COUNTER_VALUE).
+ *
+ * @return Counter value in 1 / TASK_STATS_TIMER_HZ s, wraps around.
+ *
+ *******************************************************************************/
+uint32_t task_stats_timer_read(void);
+
+/*******************************************************************************
+ * Function Name: task_stats_get
+ ****************************************************************************//**
+ *
+ * @brief Copies the statistics of the last complete window.
+ *
+ * @param stats Output statistics.
+ *
+ * @return true if a window was completed, false before the first one.
+ *
+ *******************************************************************************/
+bool task_stats_get(task_stats_s *stats);
+
+#endif /* SOURCE_TASK_STATS_H_ */
@@ -86,6 +86,8 @@ typedef struct {
 
     uint32_t fill_level; /*<< FIFO water mark level in bytes*/
 
+    uint32_t slots; /*<< Number of fill level sized slots offered by the last notification*/
+
     uint8_t subscribers; /*<< Number of subscribers (task/callers)*/
 
 #ifdef FREERTOS_AWARE
@@ -297,9 +299,9 @@ radar_data_manager_run()
 
         if (adjust_queue == true)
         {
-            // now adjust the queue by fill level
-            // considering reader has read all data till fill level
-            manager.head += manager.fill_level;
+            // now adjust the queue by all slots of the last notification
+            // considering reader has read all of them
+            manager.head += manager.fill_level * manager.slots;
 
             //move the buffer to front by amount data already read
             if (manager.head >0)
@@ -313,6 +315,7 @@ radar_data_manager_run()
 
                 manager.head = 0;
 
+                manager.samples = sz;
 
             }
             for (int sub = 1; sub <= ACTIVE_SUBSCRIPTION_UB; sub++)
@@ -326,6 +329,13 @@ radar_data_manager_run()
 
         }
 
+        // a burst of several fill levels is offered as one slot per fill level,
+        // the slots stay fixed until all subscribers acknowledged them
+        if ((adjust_queue == true) || (manager.slots == 0))
+        {
+            manager.slots = (manager.tail - manager.head) / manager.fill_level;
+        }
+
 #else
         //now inform all subscribers about available data
         for (int sub = 1; sub <= ACTIVE_SUBSCRIPTION_UB; sub++)
@@ -407,6 +417,30 @@ radar_data_manager_read_buffer(int32_t subscription_id, uint16_t **data_ptr, uin
     return 0;
 }
 
+/*
+ * read one slot of the last notification from RDM data buffer
+ */
+int32_t
+radar_data_manager_read_slot(int32_t subscription_id, uint32_t slot, uint16_t **data_ptr, uint32_t *size)
+{
+    if ((subscription_id <= 0) || (subscription_id > ACTIVE_SUBSCRIPTION_UB))
+    {
+        return -1;
+    }
+
+    if ((slot >= manager.slots) ||
+        (NULL == manager.subscriptions[subscription_id].suscriber_task_handle))
+    {
+        return -2;
+    }
+
+    *data_ptr = (uint16_t*) (manager.buffer + manager.head + (slot * manager.fill_level));
+
+    *size = (manager.fill_level);
+
+    return 0;
+}
+
 /*
  * acknowledge the data read
  */
@@ -510,6 +544,8 @@ radar_data_manager_init(radar_data_manager_s* mgr_interface, uint32_t buffer_siz
     manager.head = 0;
     manager.tail = 0;
 
+    manager.slots = 0;
+
     mgr_interface->subscribe = radar_data_manager_subscribe;
 
     mgr_interface->unsubscribe = radar_data_manager_unsubscribe;
@@ -523,6 +559,8 @@ radar_data_manager_init(radar_data_manager_s* mgr_interface, uint32_t buffer_siz
 #ifdef FREERTOS_AWARE
     mgr_interface->read_from_buffer = radar_data_manager_read_buffer;
 
+    mgr_interface->read_slot = radar_data_manager_read_slot;
+
     mgr_interface->ack_data_read = radar_data_manager_ack_data_read;
 #endif
 
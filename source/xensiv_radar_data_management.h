@@ -110,6 +110,24 @@ int32_t (*subscribe)(TaskHandle_t subscriber_task);
  */
 int32_t (*read_from_buffer)(int32_t subscription_id, uint16_t **data_ptr, uint32_t *size);
 
+/** @brief Provided interface:Read one slot of radar data from buffer
+ *
+ * When more than one fill level of data arrived with a single run() call, the notification
+ * offers one slot per fill level. Slot 0 is the data returned by <b>read_from_buffer</b>, the
+ * following slots are the later fill levels in arrival order. All slots stay valid until the
+ * subscriber acknowledges the read.
+ *
+ * @param[in] subscription_id subscription id of the subscriber. This ID is provided by RDM on successful subscription
+ * @param[in] slot index of the slot, starting at zero
+ * @param[out] data_ptr pointer to the internal buffer where the slot has to be read from subscriber task
+ * @param[out] size number of bytes that are available to read
+ *
+ * @return function shall return zero (0) on successful completion of the readout of data.
+ *         in case the parameters supplied are not valid it shall return -1 and in case if
+ *         the slot is not available it shall return -2
+ */
+int32_t (*read_slot)(int32_t subscription_id, uint32_t slot, uint16_t **data_ptr, uint32_t *size);
+
 /** @brief Provided interface:Acknowledge to RDM that the subscriber has read the data from buffer
  *
  * Subscriber task shall notify RDM by calling this function, that it has finished reading the data from buffer
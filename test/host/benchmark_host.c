@@ -0,0 +1,150 @@
+/*****************************************************************************
+ * File name: benchmark_host.c
+ *
+ * Description: This file times the kernel table of the benchmark on the
+ *   host and prints the same [BENCHMARK] JSON lines as the benchmark
+ *   command. A cycle is one ns of the monotonic clock.
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <time.h>
+
+#define XENSIV_RADAR_PRESENCE_SETTINGS_H_IMPL
+#include "benchmark_kernels.h"
+#include "optimization_list.h"
+#include "presence_settings.h"
+
+/* A cycle of the host is one ns */
+#define BENCHMARK_HOST_CLOCK_HZ     (1000000000U)
+
+#define BENCHMARK_SPEED_OF_LIGHT    (299792458.0f)
+
+/*******************************************************************************
+ * Function Name: benchmark_host_get_ns
+ ****************************************************************************//**
+ *
+ * @return Monotonic clock in ns, wraps around.
+ *
+ *******************************************************************************/
+static uint32_t benchmark_host_get_ns(void)
+{
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint32_t)(((uint64_t)now.tv_sec * BENCHMARK_HOST_CLOCK_HZ) + (uint64_t)now.tv_nsec);
+}
+
+/*******************************************************************************
+ * Function Name: benchmark_host_measure
+ ****************************************************************************//**
+ *
+ * @brief Runs a kernel of the table and reports the result, like
+ * benchmark_measure_frames on the device without the scheduler.
+ *
+ * @param entry Kernel.
+ * @param kernels Buffers of the kernels.
+ *
+ *******************************************************************************/
+static void benchmark_host_measure(const benchmark_kernel_s *entry, benchmark_kernels_s *kernels)
+{
+    uint32_t num_frames = benchmark_kernels_get_frames(entry->period);
+    benchmark_result_s result = { .name = entry->name, .frames = num_frames, .cycles_min = UINT32_MAX };
+    uint64_t total = 0U;
+
+    for (uint32_t frame = 0U; frame < num_frames; frame++)
+    {
+        uint32_t start;
+        uint32_t ns;
+
+        if (entry->prepare != NULL)
+        {
+            entry->prepare(kernels, frame);
+        }
+
+        start = benchmark_host_get_ns();
+        entry->kernel(kernels, frame);
+        ns = benchmark_host_get_ns() - start;
+
+        total += ns;
+        if (ns < result.cycles_min)
+        {
+            result.cycles_min = ns;
+        }
+    }
+
+    result.cycles_mean = (uint32_t)(total / num_frames);
+    result.ns_mean = result.cycles_mean;
+    benchmark_print_result(&result);
+}
+
+int main(void)
+{
+    const xensiv_radar_presence_config_t *config = &default_config;
+    benchmark_kernels_s kernels;
+    const benchmark_kernel_s *table;
+    uint32_t num_kernels;
+    int32_t result = 0;
+
+    /* the live filter bank of the device, with the default cutoffs */
+    if ((slow_time_filter_init(slow_time_filter_get_live(), NUM_SAMPLES_PER_CHIRP,
+                               XENSIV_BGT60TRXX_CONF_FRAME_REPETITION_TIME_S) != 0) ||
+        (benchmark_kernels_alloc(&kernels, NUM_CHIRPS_PER_FRAME, NUM_SAMPLES_PER_CHIRP, NUM_RX_ANTENNAS,
+                                 MACRO_FFT_BUFF_SIZE,
+                                 BENCHMARK_SPEED_OF_LIGHT / (2.0f * config->bandwidth)) != 0))
+    {
+        result = -1;
+    }
+    else
+    {
+        table = benchmark_kernels_get(&num_kernels);
+        for (uint32_t i = 0U; i < num_kernels; i++)
+        {
+            if ((table[i].setup == NULL) || (table[i].setup(&kernels, config, table[i].arg) == 0))
+            {
+                benchmark_host_measure(&table[i], &kernels);
+            }
+        }
+
+        benchmark_kernels_free(&kernels);
+    }
+
+    printf("[BENCHMARK] {\"core_hz\":%" PRIu32 ",\"status\":%" PRIi32 "}\n", BENCHMARK_HOST_CLOCK_HZ, result);
+
+    return (result == 0) ? 0 : 1;
+}
@@ -0,0 +1,89 @@
+/*****************************************************************************
+ * File name: cli_commands.c
+ *
+ * Description: This file contains the command table of the dispatch tests
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "cli_commands.h"
+
+/* The callbacks take the names of the cli_task.c callbacks, every one records its command */
+#define CLI_COMMAND_CALLBACK(id, name, callback, parameters, help) \
+    static BaseType_t callback(char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString) \
+    { \
+        (void)xWriteBufferLen; \
+        pcWriteBuffer[0] = '\0'; \
+        cli_commands_dispatched = CLI_COMMAND_##id; \
+        read_parameters(pcCommandString); \
+        return pdFALSE; \
+    }
+
+#define CLI_COMMAND_ENTRY(id, name, callback, parameters, help) \
+    { .pcCommand = name, .pcHelpString = help, \
+      .pxCommandInterpreter = callback, .cExpectedNumberOfParameters = (parameters) },
+
+int cli_commands_dispatched = -1;
+uint32_t cli_commands_num_parameters;
+cli_commands_parameter_s cli_commands_parameters[CLI_MAX_PARAMETERS];
+
+/*******************************************************************************
+ * Function Name: read_parameters
+ ****************************************************************************//**
+ *
+ * @brief Reads the parameters of the command until there are no more.
+ *
+ * @param command_string Command line passed to the callback.
+ *
+ *******************************************************************************/
+static void read_parameters(const char *command_string)
+{
+    const char *parameter;
+    BaseType_t length;
+
+    cli_commands_num_parameters = 0;
+    while ((cli_commands_num_parameters < CLI_MAX_PARAMETERS) &&
+           ((parameter = FreeRTOS_CLIGetParameter(command_string, cli_commands_num_parameters + 1U, &length)) != NULL))
+    {
+        cli_commands_parameters[cli_commands_num_parameters].start = parameter;
+        cli_commands_parameters[cli_commands_num_parameters].length = (size_t)length;
+        cli_commands_num_parameters++;
+    }
+}
+
+CLI_COMMAND_LIST(CLI_COMMAND_CALLBACK)
+
+const CLI_Command_Definition_t cli_commands[CLI_NUM_COMMANDS] =
+{
+    CLI_COMMAND_LIST(CLI_COMMAND_ENTRY)
+};
@@ -0,0 +1,76 @@
+/*****************************************************************************
+ * File name: cli_commands.h
+ *
+ * Description: This file contains the command table of the dispatch tests,
+ *   built from the command list of cli_task.c
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef CLI_COMMANDS_H_
+#define CLI_COMMANDS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "FreeRTOS_CLI.h"
+#include "console_uart.h"
+
+/* The command list of cli_task.c */
+#include "cli_command_list.h"
+
+/* Number of commands */
+#define CLI_NUM_COMMANDS        (NUMBER_OF_COMMANDS)
+
+/* Most parameters of a command line of CONSOLE_LINE_LENGTH */
+#define CLI_MAX_PARAMETERS      (CONSOLE_LINE_LENGTH / 2U)
+
+typedef struct
+{
+    const char *start;
+    size_t length;
+} cli_commands_parameter_s;
+
+/* Index of the last dispatched command, -1 if none */
+extern int cli_commands_dispatched;
+
+/* Parameters read by the last dispatched command with FreeRTOS_CLIGetParameter */
+extern uint32_t cli_commands_num_parameters;
+extern cli_commands_parameter_s cli_commands_parameters[CLI_MAX_PARAMETERS];
+
+/* Command table, every command writes its index into cli_commands_dispatched
+ * and reads its parameters like the variadic commands of cli_task.c */
+extern const CLI_Command_Definition_t cli_commands[CLI_NUM_COMMANDS];
+
+#endif /* CLI_COMMANDS_H_ */
@@ -0,0 +1,272 @@
+/*****************************************************************************
+ * File name: flash_storage_file.c
+ *
+ * Description: This file implements the storage regions of the host build
+ *   with a file in place of the auxiliary flash. The region layout and the
+ *   row-wise programming are those of flash_storage.c.
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "flash_storage.h"
+#include "flash_storage_file.h"
+
+typedef struct
+{
+    const char *path;
+    bool powered;
+    bool cut_armed;
+    uint32_t cut_bytes;
+    uint32_t num_row_writes;
+    uint8_t image[FLASH_STORAGE_NUM_ROWS * FLASH_STORAGE_ROW_SIZE];
+} flash_storage_file_state_s;
+
+static const uint32_t flash_storage_first_row[FLASH_STORAGE_NUM_REGIONS] =
+{
+    [FLASH_STORAGE_CLUTTER_MAP] = 0U,
+    [FLASH_STORAGE_CONFIG]      = FLASH_STORAGE_CLUTTER_MAP_ROWS,
+    [FLASH_STORAGE_OCCUPANCY]   = FLASH_STORAGE_CLUTTER_MAP_ROWS + FLASH_STORAGE_CONFIG_ROWS
+};
+
+static const uint32_t flash_storage_num_rows[FLASH_STORAGE_NUM_REGIONS] =
+{
+    [FLASH_STORAGE_CLUTTER_MAP] = FLASH_STORAGE_CLUTTER_MAP_ROWS,
+    [FLASH_STORAGE_CONFIG]      = FLASH_STORAGE_CONFIG_ROWS,
+    [FLASH_STORAGE_OCCUPANCY]   = FLASH_STORAGE_OCCUPANCY_ROWS
+};
+
+static flash_storage_file_state_s file_state;
+
+/*******************************************************************************
+ * Function Name: flash_storage_file_store
+ ****************************************************************************//**
+ *
+ * @brief Writes a part of the image into the backing file.
+ *
+ * @param offset Offset in the image.
+ * @param len Number of bytes.
+ *
+ * @return 0 on success, -1 if the file cannot be written.
+ *
+ *******************************************************************************/
+static int32_t flash_storage_file_store(uint32_t offset, uint32_t len)
+{
+    FILE *file = fopen(file_state.path, "r+b");
+    int32_t result = 0;
+
+    if (file == NULL)
+    {
+        file = fopen(file_state.path, "w+b");
+    }
+    if (file == NULL)
+    {
+        return -1;
+    }
+
+    if ((fseek(file, (long)offset, SEEK_SET) != 0) ||
+        (fwrite(&file_state.image[offset], 1U, len, file) != len))
+    {
+        result = -1;
+    }
+
+    if (fclose(file) != 0)
+    {
+        result = -1;
+    }
+
+    return result;
+}
+
+/*
+ * select the backing file
+ */
+void flash_storage_file_set_path(const char *path)
+{
+    file_state.path = path;
+    file_state.num_row_writes = 0U;
+}
+
+/*
+ * erase the flash and the file
+ */
+int32_t flash_storage_file_erase(void)
+{
+    memset(file_state.image, 0, sizeof(file_state.image));
+
+    return flash_storage_file_store(0U, sizeof(file_state.image));
+}
+
+/*
+ * lose the power during the next row write
+ */
+void flash_storage_file_cut_power(uint32_t num_bytes)
+{
+    file_state.cut_armed = true;
+    file_state.cut_bytes = (num_bytes < FLASH_STORAGE_ROW_SIZE) ? num_bytes : FLASH_STORAGE_ROW_SIZE;
+}
+
+/*
+ * invert one byte
+ */
+void flash_storage_file_corrupt(flash_storage_region_e region, uint32_t offset)
+{
+    uint32_t address = (flash_storage_first_row[region] * FLASH_STORAGE_ROW_SIZE) + offset;
+
+    file_state.image[address] ^= 0xFFU;
+    (void)flash_storage_file_store(address, 1U);
+}
+
+/*
+ * get the number of programmed rows
+ */
+uint32_t flash_storage_file_get_num_row_writes(void)
+{
+    return file_state.num_row_writes;
+}
+
+/*
+ * load the backing file, simulates a reset
+ */
+int32_t flash_storage_init(void)
+{
+    FILE *file;
+
+    memset(file_state.image, 0, sizeof(file_state.image));
+    file_state.powered = true;
+    file_state.cut_armed = false;
+
+    if (file_state.path == NULL)
+    {
+        return -1;
+    }
+
+    file = fopen(file_state.path, "rb");
+    if (file != NULL)
+    {
+        (void)fread(file_state.image, 1U, sizeof(file_state.image), file);
+        (void)fclose(file);
+    }
+
+    return 0;
+}
+
+/*
+ * get the start of a region
+ */
+const uint8_t *flash_storage_get_address(flash_storage_region_e region)
+{
+    if (region >= FLASH_STORAGE_NUM_REGIONS)
+    {
+        return NULL;
+    }
+
+    return &file_state.image[flash_storage_first_row[region] * FLASH_STORAGE_ROW_SIZE];
+}
+
+/*
+ * get the size of a region
+ */
+uint32_t flash_storage_get_size(flash_storage_region_e region)
+{
+    if (region >= FLASH_STORAGE_NUM_REGIONS)
+    {
+        return 0U;
+    }
+
+    return flash_storage_num_rows[region] * FLASH_STORAGE_ROW_SIZE;
+}
+
+/*
+ * write data into a region, row by row
+ */
+int32_t flash_storage_write(flash_storage_region_e region, uint32_t offset,
+                            const void *data, size_t len)
+{
+    const uint8_t *src = (const uint8_t *)data;
+    const uint8_t *base = flash_storage_get_address(region);
+    uint8_t row_buff[FLASH_STORAGE_ROW_SIZE];
+
+    if ((base == NULL) || (data == NULL) || (((size_t)offset + len) > flash_storage_get_size(region)))
+    {
+        return -1;
+    }
+
+    while (len > 0U)
+    {
+        uint32_t row_offset = offset % FLASH_STORAGE_ROW_SIZE;
+        uint32_t address = (uint32_t)(&base[offset - row_offset] - file_state.image);
+        size_t chunk = FLASH_STORAGE_ROW_SIZE - row_offset;
+
+        if (!file_state.powered)
+        {
+            return -1;
+        }
+        if (chunk > len)
+        {
+            chunk = len;
+        }
+
+        /* read-modify-write of the whole row */
+        memcpy(row_buff, &file_state.image[address], FLASH_STORAGE_ROW_SIZE);
+        memcpy(&row_buff[row_offset], src, chunk);
+
+        if (file_state.cut_armed)
+        {
+            /* the row was erased, the programming stopped early */
+            memset(&file_state.image[address], 0, FLASH_STORAGE_ROW_SIZE);
+            memcpy(&file_state.image[address], row_buff, file_state.cut_bytes);
+            file_state.cut_armed = false;
+            file_state.powered = false;
+        }
+        else
+        {
+            memcpy(&file_state.image[address], row_buff, FLASH_STORAGE_ROW_SIZE);
+        }
+
+        file_state.num_row_writes++;
+        if ((flash_storage_file_store(address, FLASH_STORAGE_ROW_SIZE) != 0) || !file_state.powered)
+        {
+            return -1;
+        }
+
+        src += chunk;
+        offset += (uint32_t)chunk;
+        len -= chunk;
+    }
+
+    return 0;
+}
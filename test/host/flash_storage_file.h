@@ -0,0 +1,106 @@
+/*****************************************************************************
+ * File name: flash_storage_file.h
+ *
+ * Description: This file contains the functions of the file backed flash
+ *   storage of the host build. They select the backing file and inject
+ *   corruption and power loss.
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef FLASH_STORAGE_FILE_H_
+#define FLASH_STORAGE_FILE_H_
+
+#include <stdint.h>
+
+#include "flash_storage.h"
+
+/*******************************************************************************
+ * Function Name: flash_storage_file_set_path
+ ****************************************************************************//**
+ *
+ * @brief Selects the file which backs the flash. flash_storage_init() loads
+ * it, a missing or short file reads as erased flash (zeros). Every call of
+ * flash_storage_init() simulates a reset of the device.
+ *
+ * @param path Path of the backing file.
+ *
+ *******************************************************************************/
+void flash_storage_file_set_path(const char *path);
+
+/*******************************************************************************
+ * Function Name: flash_storage_file_erase
+ ****************************************************************************//**
+ *
+ * @brief Erases the whole flash and the backing file.
+ *
+ * @return 0 on success, -1 if the file cannot be written.
+ *
+ *******************************************************************************/
+int32_t flash_storage_file_erase(void);
+
+/*******************************************************************************
+ * Function Name: flash_storage_file_cut_power
+ ****************************************************************************//**
+ *
+ * @brief Loses the power during the next row write: the row is erased and
+ * only its first bytes are programmed. That write and all later ones fail
+ * until the next flash_storage_init().
+ *
+ * @param num_bytes Programmed bytes of the interrupted row.
+ *
+ *******************************************************************************/
+void flash_storage_file_cut_power(uint32_t num_bytes);
+
+/*******************************************************************************
+ * Function Name: flash_storage_file_corrupt
+ ****************************************************************************//**
+ *
+ * @brief Inverts one byte of a region in the flash and in the backing file.
+ *
+ * @param region Storage region.
+ * @param offset Offset of the byte inside the region.
+ *
+ *******************************************************************************/
+void flash_storage_file_corrupt(flash_storage_region_e region, uint32_t offset);
+
+/*******************************************************************************
+ * Function Name: flash_storage_file_get_num_row_writes
+ ****************************************************************************//**
+ *
+ * @return Number of programmed rows since the file was selected.
+ *
+ *******************************************************************************/
+uint32_t flash_storage_file_get_num_row_writes(void);
+
+#endif /* FLASH_STORAGE_FILE_H_ */
@@ -0,0 +1,236 @@
+/*****************************************************************************
+ * File name: fuzz_cli_dispatch.c
+ *
+ * Description: This file contains the fuzz target of the command dispatch of
+ *   FreeRTOS_CLI.c. The dispatched command and the parameters of every
+ *   command line are compared with a linear reference tokenizer.
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cli_commands.h"
+#include "console_uart.h"
+
+/* Words of the structured inputs of the driver without libFuzzer */
+const char * const fuzz_dictionary[] =
+{
+#define FUZZ_DICTIONARY_ENTRY(id, name, callback, parameters, help)  name,
+    CLI_COMMAND_LIST(FUZZ_DICTIONARY_ENTRY)
+#undef FUZZ_DICTIONARY_ENTRY
+    "help", "1", "enable", "0.5", "", " "
+};
+const size_t fuzz_dictionary_size = sizeof(fuzz_dictionary) / sizeof(fuzz_dictionary[0]);
+
+typedef struct
+{
+    const char *word;
+    size_t length;
+} reference_word_s;
+
+/*******************************************************************************
+ * Function Name: fuzz_require
+ ****************************************************************************//**
+ *
+ * @brief Aborts on a violated property, libFuzzer then stores the input.
+ *
+ * @param cond Property.
+ * @param text Text of the property.
+ *
+ *******************************************************************************/
+static void fuzz_require(int cond, const char *text)
+{
+    if (!cond)
+    {
+        printf("property violated: %s\n", text);
+        (void)fflush(stdout);
+        abort();
+    }
+}
+
+/*******************************************************************************
+ * Function Name: reference_tokenize
+ ****************************************************************************//**
+ *
+ * @brief Splits a command line at the spaces.
+ *
+ * @param line Command line.
+ * @param words Words of the line, the first one is the command. The command
+ * may be empty if the line starts with a space.
+ *
+ * @return Number of words.
+ *
+ *******************************************************************************/
+static uint32_t reference_tokenize(const char *line, reference_word_s *words)
+{
+    uint32_t num_words = 0;
+    size_t i = 0;
+
+    /* the command ends at the first space */
+    words[num_words].word = line;
+    words[num_words].length = strcspn(line, " ");
+    i = words[num_words++].length;
+
+    while (line[i] != '\0')
+    {
+        if (line[i] == ' ')
+        {
+            ++i;
+        }
+        else
+        {
+            words[num_words].word = &line[i];
+            words[num_words].length = strcspn(&line[i], " ");
+            i += words[num_words++].length;
+        }
+    }
+
+    return num_words;
+}
+
+/*******************************************************************************
+ * Function Name: reference_find
+ ****************************************************************************//**
+ *
+ * @brief Searches the command table linearly.
+ *
+ * @param words Words of the command line.
+ * @param num_words Number of words.
+ *
+ * @return Index of the command which must be dispatched, -1 if none.
+ *
+ *******************************************************************************/
+static int reference_find(const reference_word_s *words, uint32_t num_words)
+{
+    for (int i = 0; i < CLI_NUM_COMMANDS; ++i)
+    {
+        const CLI_Command_Definition_t *command = &cli_commands[i];
+
+        if ((strlen(command->pcCommand) == words[0].length) &&
+            (memcmp(command->pcCommand, words[0].word, words[0].length) == 0))
+        {
+            return ((command->cExpectedNumberOfParameters < 0) ||
+                    ((uint32_t)command->cExpectedNumberOfParameters == (num_words - 1U))) ? i : -1;
+        }
+    }
+
+    return -1;
+}
+
+/*******************************************************************************
+ * Function Name: LLVMFuzzerTestOneInput
+ ****************************************************************************//**
+ *
+ * @brief Dispatches the input as a command line of at most CONSOLE_LINE_LENGTH
+ * characters and compares the result with the reference.
+ *
+ * @param data Input, truncated at the first zero.
+ * @param size Size of the input.
+ *
+ * @return 0
+ *
+ *******************************************************************************/
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    static bool registered = false;
+    static char output[configCOMMAND_INT_MAX_OUTPUT_SIZE];
+    reference_word_s words[CLI_MAX_PARAMETERS + 1U];
+    size_t length = (size < (CONSOLE_LINE_LENGTH - 1U)) ? size : (CONSOLE_LINE_LENGTH - 1U);
+    /* exact size copy, an overread is caught by the address sanitizer */
+    char *line = malloc(length + 1U);
+    uint32_t num_words;
+    uint32_t num_calls = 0;
+    int expected;
+
+    if (line == NULL)
+    {
+        return 0;
+    }
+    memcpy(line, data, length);
+    line[length] = '\0';
+
+    if (!registered)
+    {
+        (void)FreeRTOS_CLIRegisterCommandTable(cli_commands, CLI_NUM_COMMANDS);
+        registered = true;
+    }
+
+    num_words = reference_tokenize(line, words);
+    expected = reference_find(words, num_words);
+
+    cli_commands_dispatched = -1;
+    while ((FreeRTOS_CLIProcessCommand(line, output, sizeof(output)) != pdFALSE) && (num_calls < 1000U))
+    {
+        ++num_calls;
+    }
+    fuzz_require(num_calls < 1000U, "every command ends");
+    fuzz_require(cli_commands_dispatched == expected, "dispatched command");
+    fuzz_require(memchr(output, '\0', sizeof(output)) != NULL, "output is terminated");
+
+    /* the parameters read by the command while it runs */
+    if (expected >= 0)
+    {
+        fuzz_require(cli_commands_num_parameters == (num_words - 1U), "number of parameters read by the command");
+        for (uint32_t i = 1; i < num_words; ++i)
+        {
+            fuzz_require((cli_commands_parameters[i - 1U].start == words[i].word) &&
+                         (cli_commands_parameters[i - 1U].length == words[i].length),
+                         "parameter read by the command");
+        }
+    }
+
+    /* and read after the command ended */
+    /* one more than the number of parameters returns NULL */
+    for (uint32_t i = 1; i <= num_words; ++i)
+    {
+        BaseType_t parameter_length;
+        const char *parameter = FreeRTOS_CLIGetParameter(line, i, &parameter_length);
+
+        if (i < num_words)
+        {
+            fuzz_require((parameter == words[i].word) && ((size_t)parameter_length == words[i].length),
+                         "parameter");
+        }
+        else
+        {
+            fuzz_require((parameter == NULL) && (parameter_length == 0), "no more parameters");
+        }
+    }
+
+    free(line);
+
+    return 0;
+}
@@ -0,0 +1,198 @@
+/*****************************************************************************
+ * File name: fuzz_cli_parse.c
+ *
+ * Description: This file contains the fuzz target of the CLI parameter parsers.
+ *   Every accepted parameter is checked against the grammar of the parser,
+ *   so the target finds wrong results as well as memory errors.
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cli_parse.h"
+
+/* Words of the structured inputs of the driver without libFuzzer */
+const char * const fuzz_dictionary[] =
+{
+    "0", "1", "4294967295", "4294967296", "000000000000000000000001", "-1", "+1",
+    "0.5", "-0.0", "1e38", "1e39", "1e-46", "0x1p3", ".", "e", "nan", "inf", "infinity",
+    "enable", "disable", MACRO_ONLY_STRING, MICRO_ONLY_STRING, MICRO_IF_MACRO_STRING,
+    MICRO_AND_MACRO_STRING
+};
+const size_t fuzz_dictionary_size = sizeof(fuzz_dictionary) / sizeof(fuzz_dictionary[0]);
+
+/*******************************************************************************
+ * Function Name: fuzz_require
+ ****************************************************************************//**
+ *
+ * @brief Aborts on a violated property, libFuzzer then stores the input.
+ *
+ * @param cond Property.
+ * @param text Text of the property.
+ *
+ *******************************************************************************/
+static void fuzz_require(int cond, const char *text)
+{
+    if (!cond)
+    {
+        printf("property violated: %s\n", text);
+        (void)fflush(stdout);
+        abort();
+    }
+}
+
+/*******************************************************************************
+ * Function Name: fuzz_is_digits
+ ****************************************************************************//**
+ *
+ * @brief Checks if a parameter is made of decimal digits only.
+ *
+ * @param string Parameter string.
+ * @param length Length of the parameter string.
+ *
+ * @return true if the parameter is not empty and made of digits only.
+ *
+ *******************************************************************************/
+static bool fuzz_is_digits(const char *string, size_t length)
+{
+    for (size_t i = 0; i < length; ++i)
+    {
+        if ((string[i] < '0') || (string[i] > '9'))
+        {
+            return false;
+        }
+    }
+
+    return length > 0U;
+}
+
+/*******************************************************************************
+ * Function Name: fuzz_equals
+ ****************************************************************************//**
+ *
+ * @brief Compares a parameter with a name.
+ *
+ * @param string Parameter string.
+ * @param length Length of the parameter string.
+ * @param name Zero terminated name.
+ *
+ * @return true if the parameter is exactly the name.
+ *
+ *******************************************************************************/
+static bool fuzz_equals(const char *string, size_t length, const char *name)
+{
+    return (strlen(name) == length) && (memcmp(string, name, length) == 0);
+}
+
+/*******************************************************************************
+ * Function Name: LLVMFuzzerTestOneInput
+ ****************************************************************************//**
+ *
+ * @brief Runs every parser on the input.
+ *
+ * @param data Input, used as a parameter string which is not zero terminated.
+ * @param size Size of the input.
+ *
+ * @return 0
+ *
+ *******************************************************************************/
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    static const char * const modes[] =
+    {
+        MACRO_ONLY_STRING, MICRO_ONLY_STRING, MICRO_IF_MACRO_STRING, MICRO_AND_MACRO_STRING
+    };
+    /* exact size copy, an overread is caught by the address sanitizer */
+    char *string = malloc((size > 0U) ? size : 1U);
+    float32_t float_value;
+    uint32_t u32_value;
+    bool bool_value;
+    xensiv_radar_presence_mode_t mode;
+
+    if (string == NULL)
+    {
+        return 0;
+    }
+    memcpy(string, data, size);
+
+    if (cli_parse_float(string, size, &float_value))
+    {
+        fuzz_require(isfinite(float_value), "float is finite");
+        fuzz_require(size <= CLI_PARSE_MAX_NUMBER_LENGTH, "float length is limited");
+        fuzz_require(!isspace((unsigned char)string[0]) && !isspace((unsigned char)string[size - 1U]),
+                     "float has no surrounding space");
+    }
+
+    if (fuzz_is_digits(string, size) && (size <= CLI_PARSE_MAX_NUMBER_LENGTH))
+    {
+        char number[CLI_PARSE_MAX_NUMBER_LENGTH + 1U];
+        unsigned long long expected;
+
+        memcpy(number, string, size);
+        number[size] = '\0';
+        expected = strtoull(number, NULL, 10);
+
+        fuzz_require(cli_parse_u32(string, size, &u32_value) == (expected <= UINT32_MAX),
+                     "u32 accepts every digit string which fits");
+        fuzz_require((expected > UINT32_MAX) || (u32_value == expected), "u32 value");
+    }
+    else
+    {
+        fuzz_require(!cli_parse_u32(string, size, &u32_value), "u32 rejects non digits");
+    }
+
+    fuzz_require(cli_parse_bool(string, size, "enable", "disable", &bool_value) ==
+                 (fuzz_equals(string, size, "enable") || fuzz_equals(string, size, "disable")),
+                 "bool accepts exactly its names");
+
+    if (cli_parse_mode(string, size, &mode))
+    {
+        fuzz_require(((uint32_t)mode < (sizeof(modes) / sizeof(modes[0]))) &&
+                     fuzz_equals(string, size, modes[mode]), "mode accepts exactly its names");
+    }
+    else
+    {
+        for (uint32_t i = 0; i < (sizeof(modes) / sizeof(modes[0])); ++i)
+        {
+            fuzz_require(!fuzz_equals(string, size, modes[i]), "mode accepts its names");
+        }
+    }
+
+    free(string);
+
+    return 0;
+}
@@ -0,0 +1,147 @@
+/*****************************************************************************
+ * File name: fuzz_driver.c
+ *
+ * Description: This file contains the driver of the fuzz targets for compilers
+ *   without libFuzzer. It feeds random and structured inputs built from
+ *   the dictionary of the target with a fixed seed.
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "host_test.h"
+
+/* Longest generated input */
+#define FUZZ_DRIVER_MAX_INPUT       (300U)
+
+/* Default number of inputs */
+#define FUZZ_DRIVER_NUM_INPUTS      (500000U)
+
+/* Provided by the target */
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+extern const char * const fuzz_dictionary[];
+extern const size_t fuzz_dictionary_size;
+
+/*******************************************************************************
+ * Function Name: fuzz_driver_structured
+ ****************************************************************************//**
+ *
+ * @brief Builds an input from dictionary words, separators and random bytes.
+ *
+ * @param seed State of the generator.
+ * @param input Input buffer of FUZZ_DRIVER_MAX_INPUT bytes.
+ *
+ * @return Size of the input.
+ *
+ *******************************************************************************/
+static size_t fuzz_driver_structured(uint32_t *seed, uint8_t *input)
+{
+    static const char separators[] = { ' ', ' ', ' ', '=', '\t', '\0', '-', '.' };
+    uint32_t num_words = 1U + (host_test_random(seed) % 4U);
+    size_t size = 0;
+
+    for (uint32_t word = 0; word < num_words; ++word)
+    {
+        const char *text = fuzz_dictionary[host_test_random(seed) % fuzz_dictionary_size];
+        size_t length = strlen(text);
+
+        /* truncated words are near misses of the grammar */
+        if ((host_test_random(seed) % 4U) == 0U)
+        {
+            length = host_test_random(seed) % (length + 1U);
+        }
+        if ((size + length + 1U) > FUZZ_DRIVER_MAX_INPUT)
+        {
+            break;
+        }
+        memcpy(&input[size], text, length);
+        size += length;
+
+        if ((word + 1U) < num_words)
+        {
+            input[size++] = (uint8_t)separators[host_test_random(seed) % sizeof(separators)];
+        }
+    }
+
+    /* trailing spaces and single byte flips */
+    while (((host_test_random(seed) % 3U) == 0U) && (size < FUZZ_DRIVER_MAX_INPUT))
+    {
+        input[size++] = ' ';
+    }
+    if ((size > 0U) && ((host_test_random(seed) % 4U) == 0U))
+    {
+        input[host_test_random(seed) % size] = (uint8_t)host_test_random(seed);
+    }
+
+    return size;
+}
+
+/*
+ * feed the inputs to the target
+ */
+int main(int argc, char *argv[])
+{
+    uint8_t input[FUZZ_DRIVER_MAX_INPUT];
+    uint32_t num_inputs = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 10) : FUZZ_DRIVER_NUM_INPUTS;
+    uint32_t seed = 0x2545F491U;
+    double start = host_test_time_s();
+    double elapsed;
+
+    for (uint32_t i = 0; i < num_inputs; ++i)
+    {
+        size_t size;
+
+        if ((i % 2U) == 0U)
+        {
+            size = fuzz_driver_structured(&seed, input);
+        }
+        else
+        {
+            size = host_test_random(&seed) % 48U;
+            for (size_t j = 0; j < size; ++j)
+            {
+                input[j] = (uint8_t)host_test_random(&seed);
+            }
+        }
+
+        (void)LLVMFuzzerTestOneInput(input, size);
+    }
+
+    elapsed = host_test_time_s() - start;
+    printf("%u inputs in %.3f s (%.0f inputs/s)\n", num_inputs, elapsed, num_inputs / elapsed);
+
+    return 0;
+}
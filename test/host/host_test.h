@@ -0,0 +1,103 @@
+/*****************************************************************************
+ * File name: host_test.h
+ *
+ * Description: This file contains the checks and helpers shared by the host
+ *   tests
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef HOST_TEST_H_
+#define HOST_TEST_H_
+
+#include <stdint.h>
+
+/*
+ * @def HOST_TEST_CHECK
+ * Records a failure with the location if the condition is false
+ */
+#define HOST_TEST_CHECK(cond)   host_test_check((cond), #cond, __FILE__, __LINE__)
+
+/*******************************************************************************
+ * Function Name: host_test_check
+ ****************************************************************************//**
+ *
+ * @brief Records a failure and prints it if the condition is false.
+ *
+ * @param cond Checked condition.
+ * @param text Text of the condition.
+ * @param file File of the check.
+ * @param line Line of the check.
+ *
+ * @return Value of the condition.
+ *
+ *******************************************************************************/
+int host_test_check(int cond, const char *text, const char *file, int line);
+
+/*******************************************************************************
+ * Function Name: host_test_result
+ ****************************************************************************//**
+ *
+ * @brief Prints the number of failed checks.
+ *
+ * @return Exit code of the test, 0 if all checks passed, 1 otherwise.
+ *
+ *******************************************************************************/
+int host_test_result(void);
+
+/*******************************************************************************
+ * Function Name: host_test_random
+ ****************************************************************************//**
+ *
+ * @brief Returns the next value of a xorshift generator, tests are
+ * reproducible with a fixed seed.
+ *
+ * @param state State of the generator, must not be 0.
+ *
+ * @return Random value.
+ *
+ *******************************************************************************/
+uint32_t host_test_random(uint32_t *state);
+
+/*******************************************************************************
+ * Function Name: host_test_time_s
+ ****************************************************************************//**
+ *
+ * @brief Returns the monotonic time for throughput measurements.
+ *
+ * @return Time in seconds.
+ *
+ *******************************************************************************/
+double host_test_time_s(void);
+
+#endif /* HOST_TEST_H_ */
@@ -0,0 +1,374 @@
+/*****************************************************************************
+ * File name: scene_gen.c
+ *
+ * Description: Multithreaded host generator of synthetic sensor FIFO data.
+ *   Every stream runs its own scene simulator through a repeating script of an
+ *   empty room, a person walking in, sitting and breathing, and walking out, and
+ *   yields the packed FIFO words of every frame. A stream only depends on its
+ *   seed, not on the number of threads.
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "host_test.h"
+#include "radar_rx_processing.h"
+#include "radar_scene_sim.h"
+
+#define SCENE_GEN_MAX_THREADS       (64U)
+#define SCENE_GEN_DEFAULT_THREADS   (4U)
+#define SCENE_GEN_DEFAULT_SECONDS   (3600.0)
+#define SCENE_GEN_SEED              (0x5CE7E5EDU)
+
+/* Segments of the script of every stream */
+typedef enum
+{
+    SCENE_GEN_EMPTY,
+    SCENE_GEN_WALK_IN,
+    SCENE_GEN_SIT,
+    SCENE_GEN_WALK_OUT,
+    SCENE_GEN_NUM_SEGMENTS
+} scene_gen_segment_e;
+
+/* One stream, generated by one thread */
+typedef struct
+{
+    uint32_t index;
+    uint32_t num_frames;
+    const char *out_prefix;
+    uint32_t hash;
+    uint32_t max_sample;
+    int32_t status;
+} scene_gen_stream_s;
+
+/*******************************************************************************
+ * Function Name: scene_gen_hash
+ ****************************************************************************//**
+ *
+ * @brief FNV-1a hash of a block of bytes, chained over the frames of a stream.
+ *
+ * @param hash Hash of the previous blocks.
+ * @param data Block.
+ * @param size Size of the block.
+ *
+ * @return Hash including the block.
+ *
+ *******************************************************************************/
+static uint32_t scene_gen_hash(uint32_t hash, const uint8_t *data, size_t size)
+{
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash = (hash ^ data[i]) * 16777619U;
+    }
+
+    return hash;
+}
+
+/*******************************************************************************
+ * Function Name: scene_gen_uniform
+ ****************************************************************************//**
+ *
+ * @brief Draws a scene parameter.
+ *
+ * @param seed State of the generator of the scene parameters.
+ * @param low Lowest value.
+ * @param high Highest value.
+ *
+ * @return Uniform value in [low, high].
+ *
+ *******************************************************************************/
+static float32_t scene_gen_uniform(uint32_t *seed, float32_t low, float32_t high)
+{
+    return low + ((high - low) * ((float32_t)(host_test_random(seed) % 10001U) / 10000.0f));
+}
+
+/*******************************************************************************
+ * Function Name: scene_gen_segment
+ ****************************************************************************//**
+ *
+ * @brief Sets the targets of the next segment of the script, with the
+ * position, the angle and the breathing of the person drawn anew every time.
+ *
+ * @param sim Simulator of the stream.
+ * @param segment Segment.
+ * @param seed State of the generator of the scene parameters.
+ *
+ * @return Number of frames of the segment.
+ *
+ *******************************************************************************/
+static uint32_t scene_gen_segment(radar_scene_sim_s *sim, scene_gen_segment_e segment, uint32_t *seed)
+{
+    static const float32_t walk_speed_mps = 0.5f;
+    static const float32_t walk_time_s = 4.0f;
+    radar_scene_sim_target_s targets[2];
+    float32_t duration_s;
+    uint32_t num_targets = 1U;
+
+    memset(targets, 0, sizeof(targets));
+
+    /* static clutter of the room */
+    targets[0].range_m = 3.2f;
+    targets[0].angle_deg = -20.0f;
+    targets[0].amplitude = 250.0f;
+
+    targets[1].range_m = scene_gen_uniform(seed, 1.0f, 2.5f);
+    targets[1].angle_deg = scene_gen_uniform(seed, -45.0f, 45.0f);
+    targets[1].amplitude = scene_gen_uniform(seed, 200.0f, 600.0f);
+
+    switch (segment)
+    {
+        case SCENE_GEN_EMPTY:
+            duration_s = scene_gen_uniform(seed, 30.0f, 120.0f);
+            break;
+
+        case SCENE_GEN_WALK_IN:
+            targets[1].range_m += walk_speed_mps * walk_time_s;
+            targets[1].velocity_mps = -walk_speed_mps;
+            duration_s = walk_time_s;
+            num_targets = 2U;
+            break;
+
+        case SCENE_GEN_SIT:
+            targets[1].breathing_m = scene_gen_uniform(seed, 0.002f, 0.006f);
+            targets[1].breathing_hz = scene_gen_uniform(seed, 0.15f, 0.45f);
+            duration_s = scene_gen_uniform(seed, 60.0f, 300.0f);
+            num_targets = 2U;
+            break;
+
+        default:
+            targets[1].velocity_mps = walk_speed_mps;
+            duration_s = walk_time_s;
+            num_targets = 2U;
+            break;
+    }
+
+    (void)radar_scene_sim_set_targets(sim, targets, num_targets);
+
+    return (uint32_t)(duration_s / sim->params.frame_repetition_time_s) + 1U;
+}
+
+/*******************************************************************************
+ * Function Name: scene_gen_run
+ ****************************************************************************//**
+ *
+ * @brief Generates one stream: hashes the FIFO words of every frame, writes
+ * them to <prefix>_<index>.fifo if a prefix is set, and unpacks them to find
+ * the largest sample.
+ *
+ * @param arg Stream.
+ *
+ * @return NULL
+ *
+ *******************************************************************************/
+static void *scene_gen_run(void *arg)
+{
+    scene_gen_stream_s *stream = (scene_gen_stream_s *)arg;
+    radar_scene_sim_s sim;
+    uint32_t seed = SCENE_GEN_SEED + stream->index;
+    uint32_t num_samples;
+    uint32_t segment_frames = 0U;
+    scene_gen_segment_e segment = SCENE_GEN_EMPTY;
+    uint8_t *words;
+    uint16_t *samples;
+    FILE *out = NULL;
+
+    radar_scene_sim_init(&sim, seed);
+    num_samples = sim.params.num_chirps_per_frame * sim.params.num_samples_per_chirp * sim.params.num_rx_antennas;
+    words = malloc(RADAR_SCENE_SIM_FIFO_BYTES(num_samples));
+    samples = malloc(num_samples * sizeof(uint16_t));
+
+    stream->hash = 2166136261U;
+    stream->max_sample = 0U;
+    stream->status = ((words != NULL) && (samples != NULL)) ? 0 : -1;
+
+    if ((stream->status == 0) && (stream->out_prefix != NULL))
+    {
+        char name[256];
+
+        (void)snprintf(name, sizeof(name), "%s_%u.fifo", stream->out_prefix, (unsigned int)stream->index);
+        out = fopen(name, "wb");
+        stream->status = (out != NULL) ? 0 : -1;
+    }
+
+    for (uint32_t frame = 0U; (frame < stream->num_frames) && (stream->status == 0); frame++)
+    {
+        if (segment_frames == 0U)
+        {
+            segment_frames = scene_gen_segment(&sim, segment, &seed);
+            segment = (scene_gen_segment_e)((segment + 1U) % SCENE_GEN_NUM_SEGMENTS);
+        }
+        segment_frames--;
+
+        radar_scene_sim_frame(&sim, words);
+        stream->hash = scene_gen_hash(stream->hash, words, RADAR_SCENE_SIM_FIFO_BYTES(num_samples));
+
+        if ((out != NULL) && (fwrite(words, RADAR_SCENE_SIM_FIFO_BYTES(num_samples), 1U, out) != 1U))
+        {
+            stream->status = -1;
+        }
+
+        radar_rx_unpack_fifo(words, samples, num_samples);
+        for (uint32_t n = 0U; n < num_samples; n++)
+        {
+            if (samples[n] > stream->max_sample)
+            {
+                stream->max_sample = samples[n];
+            }
+        }
+    }
+
+    if ((out != NULL) && (fclose(out) != 0))
+    {
+        stream->status = -1;
+    }
+
+    free(words);
+    free(samples);
+
+    return NULL;
+}
+
+/*******************************************************************************
+ * Function Name: scene_gen_usage
+ ****************************************************************************//**
+ *
+ * @brief Prints the command line.
+ *
+ *******************************************************************************/
+static void scene_gen_usage(void)
+{
+    printf("usage: scene_gen [--threads N] [--seconds S] [--out PREFIX] [--verify]\n"
+           "  --threads N    streams, generated in parallel (default %u, at most %u)\n"
+           "  --seconds S    simulated time of every stream (default %.0f)\n"
+           "  --out PREFIX   writes the FIFO words of stream i to PREFIX_i.fifo\n"
+           "  --verify       generates every stream again on one thread and compares\n",
+           SCENE_GEN_DEFAULT_THREADS, SCENE_GEN_MAX_THREADS, SCENE_GEN_DEFAULT_SECONDS);
+}
+
+int main(int argc, char **argv)
+{
+    static scene_gen_stream_s streams[SCENE_GEN_MAX_THREADS];
+    static pthread_t threads[SCENE_GEN_MAX_THREADS];
+    radar_scene_sim_s sim;
+    uint32_t num_threads = SCENE_GEN_DEFAULT_THREADS;
+    double seconds = SCENE_GEN_DEFAULT_SECONDS;
+    const char *out_prefix = NULL;
+    bool verify = false;
+    uint32_t num_frames;
+    double start_s;
+    double wall_s;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if ((strcmp(argv[i], "--threads") == 0) && ((i + 1) < argc))
+        {
+            num_threads = (uint32_t)strtoul(argv[++i], NULL, 10);
+        }
+        else if ((strcmp(argv[i], "--seconds") == 0) && ((i + 1) < argc))
+        {
+            seconds = strtod(argv[++i], NULL);
+        }
+        else if ((strcmp(argv[i], "--out") == 0) && ((i + 1) < argc))
+        {
+            out_prefix = argv[++i];
+        }
+        else if (strcmp(argv[i], "--verify") == 0)
+        {
+            verify = true;
+        }
+        else
+        {
+            scene_gen_usage();
+            return 2;
+        }
+    }
+
+    if ((num_threads == 0U) || (num_threads > SCENE_GEN_MAX_THREADS) || !(seconds > 0.0))
+    {
+        scene_gen_usage();
+        return 2;
+    }
+
+    radar_scene_sim_init(&sim, SCENE_GEN_SEED);
+    num_frames = (uint32_t)(seconds / sim.params.frame_repetition_time_s);
+
+    start_s = host_test_time_s();
+    for (uint32_t i = 0U; i < num_threads; i++)
+    {
+        streams[i].index = i;
+        streams[i].num_frames = num_frames;
+        streams[i].out_prefix = out_prefix;
+
+        if (pthread_create(&threads[i], NULL, scene_gen_run, &streams[i]) != 0)
+        {
+            printf("thread %u not started\n", (unsigned int)i);
+            return 1;
+        }
+    }
+    for (uint32_t i = 0U; i < num_threads; i++)
+    {
+        (void)pthread_join(threads[i], NULL);
+    }
+    wall_s = host_test_time_s() - start_s;
+
+    for (uint32_t i = 0U; i < num_threads; i++)
+    {
+        printf("{\"stream\":%u,\"frames\":%u,\"hash\":\"%08x\",\"max_sample\":%u,\"status\":%d}\n",
+               (unsigned int)i, (unsigned int)num_frames, (unsigned int)streams[i].hash,
+               (unsigned int)streams[i].max_sample, (int)streams[i].status);
+        HOST_TEST_CHECK(streams[i].status == 0);
+        HOST_TEST_CHECK(streams[i].max_sample <= RADAR_SCENE_SIM_ADC_MAX);
+    }
+
+    printf("{\"threads\":%u,\"simulated_s\":%.0f,\"wall_s\":%.3f,\"hours_per_minute\":%.1f}\n",
+           (unsigned int)num_threads, (double)num_frames * sim.params.frame_repetition_time_s * num_threads,
+           wall_s, ((double)num_frames * sim.params.frame_repetition_time_s * num_threads / 3600.0) /
+           (wall_s / 60.0));
+
+    /* the streams of the threads equal the streams of a sequential run */
+    for (uint32_t i = 0U; verify && (i < num_threads); i++)
+    {
+        scene_gen_stream_s sequential = streams[i];
+
+        sequential.out_prefix = NULL;
+        (void)scene_gen_run(&sequential);
+        HOST_TEST_CHECK(sequential.hash == streams[i].hash);
+    }
+
+    return host_test_result();
+}
@@ -0,0 +1,300 @@
+/*****************************************************************************
+ * File name: arm_math_host.c
+ *
+ * Description: This file implements the CMSIS-DSP functions of the host
+ *   replacement header as plain C reference code
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+
+#include "arm_math.h"
+
+/*
+ * sine
+ */
+float32_t arm_sin_f32(float32_t x)
+{
+    return sinf(x);
+}
+
+/*
+ * cosine
+ */
+float32_t arm_cos_f32(float32_t x)
+{
+    return cosf(x);
+}
+
+/*
+ * four quadrant arc tangent
+ */
+arm_status arm_atan2_f32(float32_t y, float32_t x, float32_t *result)
+{
+    *result = atan2f(y, x);
+
+    return ARM_MATH_SUCCESS;
+}
+
+/*
+ * square root, negative inputs give 0
+ */
+arm_status arm_sqrt_f32(float32_t in, float32_t *pOut)
+{
+    if (in < 0.0f)
+    {
+        *pOut = 0.0f;
+        return ARM_MATH_ARGUMENT_ERROR;
+    }
+
+    *pOut = sqrtf(in);
+
+    return ARM_MATH_SUCCESS;
+}
+
+/*
+ * copy
+ */
+void arm_copy_f32(const float32_t *pSrc, float32_t *pDst, uint32_t blockSize)
+{
+    memmove(pDst, pSrc, blockSize * sizeof(float32_t));
+}
+
+/*
+ * fill with a constant
+ */
+void arm_fill_f32(float32_t value, float32_t *pDst, uint32_t blockSize)
+{
+    for (uint32_t i = 0; i < blockSize; ++i)
+    {
+        pDst[i] = value;
+    }
+}
+
+/*
+ * element wise sum, the output may be one of the inputs
+ */
+void arm_add_f32(const float32_t *pSrcA, const float32_t *pSrcB, float32_t *pDst, uint32_t blockSize)
+{
+    for (uint32_t i = 0; i < blockSize; ++i)
+    {
+        pDst[i] = pSrcA[i] + pSrcB[i];
+    }
+}
+
+/*
+ * element wise difference, the output may be one of the inputs
+ */
+void arm_sub_f32(const float32_t *pSrcA, const float32_t *pSrcB, float32_t *pDst, uint32_t blockSize)
+{
+    for (uint32_t i = 0; i < blockSize; ++i)
+    {
+        pDst[i] = pSrcA[i] - pSrcB[i];
+    }
+}
+
+/*
+ * multiplication with a constant
+ */
+void arm_scale_f32(const float32_t *pSrc, float32_t scale, float32_t *pDst, uint32_t blockSize)
+{
+    for (uint32_t i = 0; i < blockSize; ++i)
+    {
+        pDst[i] = pSrc[i] * scale;
+    }
+}
+
+/*
+ * maximum and its first index
+ */
+void arm_max_f32(const float32_t *pSrc, uint32_t blockSize, float32_t *pResult, uint32_t *pIndex)
+{
+    uint32_t index = 0;
+
+    for (uint32_t i = 1; i < blockSize; ++i)
+    {
+        if (pSrc[i] > pSrc[index])
+        {
+            index = i;
+        }
+    }
+
+    *pResult = pSrc[index];
+    *pIndex = index;
+}
+
+/*
+ * sum of squares
+ */
+void arm_power_f32(const float32_t *pSrc, uint32_t blockSize, float32_t *pResult)
+{
+    float32_t sum = 0.0f;
+
+    for (uint32_t i = 0; i < blockSize; ++i)
+    {
+        sum += pSrc[i] * pSrc[i];
+    }
+
+    *pResult = sum;
+}
+
+/*
+ * squared magnitude of interleaved complex values
+ */
+void arm_cmplx_mag_squared_f32(const float32_t *pSrc, float32_t *pDst, uint32_t numSamples)
+{
+    for (uint32_t i = 0; i < numSamples; ++i)
+    {
+        pDst[i] = (pSrc[2U * i] * pSrc[2U * i]) + (pSrc[(2U * i) + 1U] * pSrc[(2U * i) + 1U]);
+    }
+}
+
+/*
+ * magnitude of interleaved complex values
+ */
+void arm_cmplx_mag_f32(const float32_t *pSrc, float32_t *pDst, uint32_t numSamples)
+{
+    for (uint32_t i = 0; i < numSamples; ++i)
+    {
+        pDst[i] = sqrtf((pSrc[2U * i] * pSrc[2U * i]) + (pSrc[(2U * i) + 1U] * pSrc[(2U * i) + 1U]));
+    }
+}
+
+/*
+ * initialize a real FFT, the lengths of CMSIS-DSP are supported
+ */
+arm_status arm_rfft_fast_init_f32(arm_rfft_fast_instance_f32 *S, uint16_t fftLen)
+{
+    if ((fftLen < 32U) || (fftLen > 4096U) || ((fftLen & (fftLen - 1U)) != 0U))
+    {
+        return ARM_MATH_ARGUMENT_ERROR;
+    }
+
+    S->fftLenRFFT = fftLen;
+
+    return ARM_MATH_SUCCESS;
+}
+
+/*
+ * real FFT as a plain DFT with the packing of CMSIS-DSP: the real parts of
+ * DC and Nyquist first, then bins 1 .. N / 2 - 1 as complex pairs. The
+ * inverse transform is scaled by 1 / N, so a round trip gives the input.
+ */
+void arm_rfft_fast_f32(const arm_rfft_fast_instance_f32 *S, float32_t *p, float32_t *pOut, uint8_t ifftFlag)
+{
+    const uint32_t n = S->fftLenRFFT;
+
+    if (ifftFlag != 0U)
+    {
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            double value = p[0] + (((i & 1U) != 0U) ? -p[1] : p[1]);
+
+            for (uint32_t k = 1; k < (n / 2U); ++k)
+            {
+                double angle = (2.0 * M_PI * (double)((k * i) % n)) / (double)n;
+
+                value += 2.0 * ((p[2U * k] * cos(angle)) - (p[(2U * k) + 1U] * sin(angle)));
+            }
+
+            pOut[i] = (float32_t)(value / (double)n);
+        }
+
+        return;
+    }
+
+    for (uint32_t k = 0; k < (n / 2U); ++k)
+    {
+        double re = 0.0;
+        double im = 0.0;
+
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            double angle = (-2.0 * M_PI * (double)((k * i) % n)) / (double)n;
+
+            re += p[i] * cos(angle);
+            im += p[i] * sin(angle);
+        }
+
+        pOut[2U * k] = (float32_t)re;
+        pOut[(2U * k) + 1U] = (float32_t)im;
+    }
+
+    /* bin 0 carries the Nyquist bin in place of the zero imaginary part of DC */
+    pOut[1] = 0.0f;
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        pOut[1] += ((i & 1U) != 0U) ? -p[i] : p[i];
+    }
+}
+
+/*
+ * initialize a biquad cascade, coefficients {b0, b1, b2, a1, a2} per stage
+ */
+void arm_biquad_cascade_df2T_init_f32(arm_biquad_cascade_df2T_instance_f32 *S, uint8_t numStages,
+                                      const float32_t *pCoeffs, float32_t *pState)
+{
+    S->numStages = numStages;
+    S->pCoeffs = pCoeffs;
+    S->pState = pState;
+    memset(pState, 0, 2U * numStages * sizeof(float32_t));
+}
+
+/*
+ * biquad cascade in transposed direct form II
+ */
+void arm_biquad_cascade_df2T_f32(const arm_biquad_cascade_df2T_instance_f32 *S, const float32_t *pSrc,
+                                 float32_t *pDst, uint32_t blockSize)
+{
+    const float32_t *in = pSrc;
+
+    for (uint32_t stage = 0; stage < S->numStages; ++stage)
+    {
+        const float32_t *c = &S->pCoeffs[5U * stage];
+        float32_t *d = &S->pState[2U * stage];
+
+        for (uint32_t i = 0; i < blockSize; ++i)
+        {
+            float32_t x = in[i];
+            float32_t y = (c[0] * x) + d[0];
+
+            d[0] = (c[1] * x) + (c[3] * y) + d[1];
+            d[1] = (c[2] * x) + (c[4] * y);
+            pDst[i] = y;
+        }
+
+        /* the next stage filters the output in place */
+        in = pDst;
+    }
+}
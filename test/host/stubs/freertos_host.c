@@ -0,0 +1,198 @@
+/*****************************************************************************
+ * File name: freertos_host.c
+ *
+ * Description: This file implements the FreeRTOS functions used by the
+ *   modules built on the host
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+#include "freertos_host.h"
+
+/* Timers of all modules of one test */
+#define HOST_MAX_TIMERS     (8U)
+
+struct host_timer_s
+{
+    TimerCallbackFunction_t callback;
+    bool auto_reload;
+    bool active;
+};
+
+static struct host_timer_s host_timers[HOST_MAX_TIMERS];
+static uint32_t host_num_timers;
+
+/*
+ * allocate from the C heap
+ */
+void *pvPortMalloc(size_t size)
+{
+    return malloc(size);
+}
+
+/*
+ * free to the C heap
+ */
+void vPortFree(void *pv)
+{
+    free(pv);
+}
+
+/*
+ * the host tests run in one thread
+ */
+void vTaskSuspendAll(void)
+{
+}
+
+/*
+ * the host tests run in one thread
+ */
+BaseType_t xTaskResumeAll(void)
+{
+    return pdFALSE;
+}
+
+/*
+ * no task waits on the host
+ */
+BaseType_t xTaskNotifyGive(TaskHandle_t task)
+{
+    (void)task;
+
+    return pdPASS;
+}
+
+/*
+ * no task waits on the host
+ */
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks_to_wait)
+{
+    (void)clear_on_exit;
+    (void)ticks_to_wait;
+
+    return 0U;
+}
+
+/*
+ * create a stopped timer
+ */
+TimerHandle_t xTimerCreate(const char * const pcTimerName, const TickType_t xTimerPeriodInTicks,
+                           const UBaseType_t uxAutoReload, void * const pvTimerID,
+                           TimerCallbackFunction_t pxCallbackFunction)
+{
+    struct host_timer_s *timer;
+
+    (void)pcTimerName;
+    (void)xTimerPeriodInTicks;
+    (void)pvTimerID;
+
+    if (host_num_timers >= HOST_MAX_TIMERS)
+    {
+        return NULL;
+    }
+
+    timer = &host_timers[host_num_timers++];
+    timer->callback = pxCallbackFunction;
+    timer->auto_reload = (uxAutoReload != 0U);
+    timer->active = false;
+
+    return timer;
+}
+
+/*
+ * start a timer
+ */
+BaseType_t xTimerStart(TimerHandle_t xTimer, TickType_t xTicksToWait)
+{
+    (void)xTicksToWait;
+    xTimer->active = true;
+
+    return pdPASS;
+}
+
+/*
+ * restart a timer
+ */
+BaseType_t xTimerReset(TimerHandle_t xTimer, TickType_t xTicksToWait)
+{
+    return xTimerStart(xTimer, xTicksToWait);
+}
+
+/*
+ * stop a timer
+ */
+BaseType_t xTimerStop(TimerHandle_t xTimer, TickType_t xTicksToWait)
+{
+    (void)xTicksToWait;
+    xTimer->active = false;
+
+    return pdPASS;
+}
+
+/*
+ * let the period of all started timers elapse
+ */
+uint32_t freertos_host_fire_timers(void)
+{
+    uint32_t num_fired = 0;
+
+    for (uint32_t i = 0; i < host_num_timers; ++i)
+    {
+        struct host_timer_s *timer = &host_timers[i];
+
+        if (timer->active)
+        {
+            timer->active = timer->auto_reload;
+            timer->callback(timer);
+            ++num_fired;
+        }
+    }
+
+    return num_fired;
+}
+
+/*
+ * delete all timers
+ */
+void freertos_host_reset(void)
+{
+    host_num_timers = 0;
+}
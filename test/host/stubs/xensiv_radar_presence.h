@@ -0,0 +1,99 @@
+/*****************************************************************************
+ * File name: xensiv_radar_presence.h
+ *
+ * Description: Host replacement of the header of the prebuilt presence
+ *   library. It provides the types used by the modules built on the host.
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef HOST_XENSIV_RADAR_PRESENCE_H_
+#define HOST_XENSIV_RADAR_PRESENCE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "arm_math.h"
+
+#define XENSIV_RADAR_PRESENCE_OK            (0)
+#define XENSIV_RADAR_PRESENCE_TIMESTAMP     uint32_t
+
+typedef struct
+{
+    float32_t real;
+    float32_t imag;
+} cfloat32_t;
+
+typedef enum
+{
+    XENSIV_RADAR_PRESENCE_STATE_MACRO_PRESENCE,
+    XENSIV_RADAR_PRESENCE_STATE_MICRO_PRESENCE,
+    XENSIV_RADAR_PRESENCE_STATE_ABSENCE
+} xensiv_radar_presence_state_t;
+
+typedef enum
+{
+    XENSIV_RADAR_PRESENCE_MODE_MACRO_ONLY,
+    XENSIV_RADAR_PRESENCE_MODE_MICRO_ONLY,
+    XENSIV_RADAR_PRESENCE_MODE_MICRO_IF_MACRO,
+    XENSIV_RADAR_PRESENCE_MODE_MICRO_AND_MACRO
+} xensiv_radar_presence_mode_t;
+
+typedef struct
+{
+    XENSIV_RADAR_PRESENCE_TIMESTAMP timestamp;
+    xensiv_radar_presence_state_t state;
+    int32_t range_bin;
+} xensiv_radar_presence_event_t;
+
+typedef struct
+{
+    float32_t bandwidth;
+    int32_t num_samples_per_chirp;
+    bool micro_fft_decimation_enabled;
+    int32_t micro_fft_size;
+    float32_t macro_threshold;
+    float32_t micro_threshold;
+    int32_t min_range_bin;
+    int32_t max_range_bin;
+    XENSIV_RADAR_PRESENCE_TIMESTAMP macro_compare_interval_ms;
+    XENSIV_RADAR_PRESENCE_TIMESTAMP macro_movement_validity_ms;
+    XENSIV_RADAR_PRESENCE_TIMESTAMP micro_movement_validity_ms;
+    int32_t macro_movement_confirmations;
+    int32_t macro_trigger_range;
+    xensiv_radar_presence_mode_t mode;
+    bool macro_fft_bandpass_filter_enabled;
+    int32_t micro_movement_compare_idx;
+} xensiv_radar_presence_config_t;
+
+#endif /* HOST_XENSIV_RADAR_PRESENCE_H_ */
@@ -0,0 +1,227 @@
+/*****************************************************************************
+ * File name: test_cli_dispatch.c
+ *
+ * Description: This file contains the tests of the command dispatch of
+ *   FreeRTOS_CLI.c and compares the dispatch time of the sorted command
+ *   table with the registered command list
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "cli_commands.h"
+#include "host_test.h"
+
+/* Number of dispatched command lines of the time measurement */
+#define NUM_DISPATCHES          (2000000U)
+
+/* Number of parameters of the batch line of test_parameters */
+#define BATCH_PARAMETERS        (12U)
+
+/* Longest generated command line */
+#define COMMAND_LINE_LENGTH     (64U)
+
+static char command_lines[CLI_NUM_COMMANDS][COMMAND_LINE_LENGTH];
+static char output[configCOMMAND_INT_MAX_OUTPUT_SIZE];
+
+/*******************************************************************************
+ * Function Name: dispatch
+ ****************************************************************************//**
+ *
+ * @brief Processes a command line until the command has no more output.
+ *
+ * @param line Command line.
+ *
+ * @return Index of the dispatched command, -1 if none was dispatched.
+ *
+ *******************************************************************************/
+static int dispatch(const char *line)
+{
+    uint32_t num_calls = 0;
+
+    cli_commands_dispatched = -1;
+    while ((FreeRTOS_CLIProcessCommand(line, output, sizeof(output)) != pdFALSE) && (num_calls < 1000U))
+    {
+        ++num_calls;
+    }
+
+    return cli_commands_dispatched;
+}
+
+/*******************************************************************************
+ * Function Name: build_command_lines
+ ****************************************************************************//**
+ *
+ * @brief Builds a valid command line for every command.
+ *
+ *******************************************************************************/
+static void build_command_lines(void)
+{
+    for (int i = 0; i < CLI_NUM_COMMANDS; ++i)
+    {
+        int length = snprintf(command_lines[i], COMMAND_LINE_LENGTH, "%s", cli_commands[i].pcCommand);
+
+        for (int parameter = 0; parameter < cli_commands[i].cExpectedNumberOfParameters; ++parameter)
+        {
+            length += snprintf(&command_lines[i][length], COMMAND_LINE_LENGTH - (size_t)length, " %d", parameter);
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function Name: measure_dispatch
+ ****************************************************************************//**
+ *
+ * @brief Measures the dispatch time of the valid command lines.
+ *
+ * @param name Name of the measured lookup.
+ *
+ *******************************************************************************/
+static void measure_dispatch(const char *name)
+{
+    uint32_t dispatched = 0;
+    double start = host_test_time_s();
+
+    for (uint32_t i = 0; i < NUM_DISPATCHES; ++i)
+    {
+        dispatched += (dispatch(command_lines[i % CLI_NUM_COMMANDS]) >= 0) ? 1U : 0U;
+    }
+
+    printf("%s: %.1f ns per command line\n", name, (host_test_time_s() - start) * 1E9 / NUM_DISPATCHES);
+    HOST_TEST_CHECK(dispatched == NUM_DISPATCHES);
+}
+
+/*******************************************************************************
+ * Function Name: test_lookup
+ ****************************************************************************//**
+ *
+ * @brief Checks that every command is found and that prefixes, extensions and
+ * wrong parameter counts are not dispatched.
+ *
+ *******************************************************************************/
+static void test_lookup(void)
+{
+    static const char * const rejected[] =
+    {
+        "", " ", "set", "set_", "set_mod 1", "set_modes 1", "set_mode_ 1", "Set_mode 1", "set_mode",
+        "set_mode 1 2", "stats 1", "zzz", "a", "occupancy 1", "board_info x"
+    };
+
+    for (int i = 0; i < CLI_NUM_COMMANDS; ++i)
+    {
+        char line[COMMAND_LINE_LENGTH + 4U];
+        size_t length = strlen(command_lines[i]);
+
+        HOST_TEST_CHECK(dispatch(command_lines[i]) == i);
+
+        /* trailing spaces are not counted as parameters */
+        memcpy(line, command_lines[i], length);
+        memcpy(&line[length], "   ", 4U);
+        HOST_TEST_CHECK(dispatch(line) == i);
+    }
+
+    for (size_t i = 0; i < (sizeof(rejected) / sizeof(rejected[0])); ++i)
+    {
+        HOST_TEST_CHECK(dispatch(rejected[i]) == -1);
+    }
+
+    HOST_TEST_CHECK(dispatch("set_mod 1") == -1);
+    HOST_TEST_CHECK(strncmp(output, "Command not recognised", 22) == 0);
+
+    HOST_TEST_CHECK(dispatch("set_mode") == -1);
+    HOST_TEST_CHECK(strncmp(output, "Incorrect command parameter(s)", 30) == 0);
+}
+
+/*******************************************************************************
+ * Function Name: test_parameters
+ ****************************************************************************//**
+ *
+ * @brief Checks the parameters of command lines with repeated spaces, read
+ * after the dispatch and by the command while it runs.
+ *
+ *******************************************************************************/
+static void test_parameters(void)
+{
+    static const char line[] = "set_filter_bank  low   12.5 ";
+    static const char batch_line[] = "batch a  b c=1 d   e f g h i=2 j k  l ";
+    BaseType_t length;
+    const char *parameter;
+
+    parameter = FreeRTOS_CLIGetParameter(line, 1, &length);
+    HOST_TEST_CHECK((parameter == &line[17]) && (length == 3));
+
+    parameter = FreeRTOS_CLIGetParameter(line, 2, &length);
+    HOST_TEST_CHECK((parameter == &line[23]) && (length == 4));
+
+    parameter = FreeRTOS_CLIGetParameter(line, 3, &length);
+    HOST_TEST_CHECK((parameter == NULL) && (length == 0));
+
+    HOST_TEST_CHECK(dispatch(line) == CLI_COMMAND_SET_FILTER_BANK);
+    HOST_TEST_CHECK((cli_commands_num_parameters == 2U) &&
+                    (cli_commands_parameters[0].start == &line[17]) && (cli_commands_parameters[0].length == 3U) &&
+                    (cli_commands_parameters[1].start == &line[23]) && (cli_commands_parameters[1].length == 4U));
+
+    /* more parameters than configCOMMAND_INT_MAX_PARAMETERS, the rest are scanned */
+    HOST_TEST_CHECK(dispatch(batch_line) == CLI_COMMAND_BATCH);
+    HOST_TEST_CHECK(cli_commands_num_parameters == BATCH_PARAMETERS);
+    for (uint32_t i = 0; i < cli_commands_num_parameters; ++i)
+    {
+        parameter = FreeRTOS_CLIGetParameter(batch_line, i + 1U, &length);
+        HOST_TEST_CHECK((cli_commands_parameters[i].start == parameter) &&
+                        (cli_commands_parameters[i].length == (size_t)length) &&
+                        (parameter[0] == (char)('a' + i)));
+    }
+}
+
+int main(void)
+{
+    build_command_lines();
+
+    /* the same commands, first in the list of FreeRTOS_CLIRegisterCommand */
+    for (int i = 0; i < CLI_NUM_COMMANDS; ++i)
+    {
+        HOST_TEST_CHECK(FreeRTOS_CLIRegisterCommand(&cli_commands[i]) == pdPASS);
+    }
+    test_lookup();
+    measure_dispatch("registered list");
+
+    /* then in the sorted table, which is searched first */
+    HOST_TEST_CHECK(FreeRTOS_CLIRegisterCommandTable(cli_commands, CLI_NUM_COMMANDS) == pdPASS);
+    test_lookup();
+    test_parameters();
+    measure_dispatch("sorted table");
+
+    return host_test_result();
+}
@@ -0,0 +1,231 @@
+/*****************************************************************************
+ * File name: test_cli_parse.c
+ *
+ * Description: This file contains the property tests of the CLI parameter
+ *   parsers and measures their throughput
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "cli_parse.h"
+#include "host_test.h"
+
+/* Number of random values of the round trip tests */
+#define NUM_ROUND_TRIPS         (200000U)
+
+/* Number of parsed parameters of the throughput measurement */
+#define NUM_THROUGHPUT_PARSES   (2000000U)
+
+/*******************************************************************************
+ * Function Name: test_round_trip
+ ****************************************************************************//**
+ *
+ * @brief Prints random values and parses them again, the parsed value must be
+ * exactly the printed one.
+ *
+ *******************************************************************************/
+static void test_round_trip(void)
+{
+    uint32_t seed = 0x9E3779B9U;
+
+    for (uint32_t i = 0; i < NUM_ROUND_TRIPS; ++i)
+    {
+        char string[CLI_PARSE_MAX_NUMBER_LENGTH + 1U];
+        uint32_t bits = host_test_random(&seed);
+        uint32_t u32_value = 0;
+        float32_t expected;
+        float32_t value = 0.0f;
+        int length;
+
+        memcpy(&expected, &bits, sizeof(expected));
+        if (isfinite(expected))
+        {
+            length = snprintf(string, sizeof(string), "%.9g", (double)expected);
+            HOST_TEST_CHECK(cli_parse_float(string, (size_t)length, &value) &&
+                            (memcmp(&value, &expected, sizeof(value)) == 0));
+        }
+
+        /* leading zeros up to the length limit are accepted */
+        length = snprintf(string, sizeof(string), "%0*u", (int)(bits % CLI_PARSE_MAX_NUMBER_LENGTH) + 1, bits);
+        HOST_TEST_CHECK(cli_parse_u32(string, (size_t)length, &u32_value) && (u32_value == bits));
+    }
+}
+
+/*******************************************************************************
+ * Function Name: test_rejection
+ ****************************************************************************//**
+ *
+ * @brief Checks that malformed parameters are rejected and leave the output
+ * untouched.
+ *
+ *******************************************************************************/
+static void test_rejection(void)
+{
+    static const char * const bad_floats[] =
+    {
+        "", "-", ".", "e5", "1e", "1.0x", "1,5", "nan", "-nan", "inf", "-inf", "infinity", "1e39",
+        " 1", "1 ", "\t1", "0000000000000000000000001"
+    };
+    static const char * const bad_u32s[] =
+    {
+        "", "-1", "+1", " 1", "1 ", "1.0", "1e3", "0x10", "4294967296", "99999999999",
+        "0000000000000000000000001"
+    };
+    static const char * const bad_names[] =
+    {
+        "", "enabl", "enable_", "Enable", "macro_onl", "macro_only_", "micro", "MACRO_ONLY"
+    };
+    float32_t float_value = 42.0f;
+    uint32_t u32_value = 42U;
+    bool bool_value = true;
+    xensiv_radar_presence_mode_t mode = XENSIV_RADAR_PRESENCE_MODE_MICRO_AND_MACRO;
+
+    for (size_t i = 0; i < (sizeof(bad_floats) / sizeof(bad_floats[0])); ++i)
+    {
+        HOST_TEST_CHECK(!cli_parse_float(bad_floats[i], strlen(bad_floats[i]), &float_value));
+    }
+    for (size_t i = 0; i < (sizeof(bad_u32s) / sizeof(bad_u32s[0])); ++i)
+    {
+        HOST_TEST_CHECK(!cli_parse_u32(bad_u32s[i], strlen(bad_u32s[i]), &u32_value));
+    }
+    for (size_t i = 0; i < (sizeof(bad_names) / sizeof(bad_names[0])); ++i)
+    {
+        HOST_TEST_CHECK(!cli_parse_bool(bad_names[i], strlen(bad_names[i]), "enable", "disable", &bool_value));
+        HOST_TEST_CHECK(!cli_parse_mode(bad_names[i], strlen(bad_names[i]), &mode));
+    }
+
+    /* an embedded zero must not end the comparison early */
+    HOST_TEST_CHECK(!cli_parse_bool("enable\0xx", 9U, "enable", "disable", &bool_value));
+    HOST_TEST_CHECK(!cli_parse_mode("micro_only\0xyz", 14U, &mode));
+
+    HOST_TEST_CHECK((float_value == 42.0f) && (u32_value == 42U) && bool_value &&
+                    (mode == XENSIV_RADAR_PRESENCE_MODE_MICRO_AND_MACRO));
+}
+
+/*******************************************************************************
+ * Function Name: test_trailing_space
+ ****************************************************************************//**
+ *
+ * @brief Checks that valid parameters followed by spaces are rejected. The
+ * parameter length of the CLI includes the rest of the line, so the handlers
+ * rely on this.
+ *
+ *******************************************************************************/
+static void test_trailing_space(void)
+{
+    static const char * const valid[] =
+    {
+        "0", "1.5", "-2e3", "4294967295", "enable", "disable", MACRO_ONLY_STRING, MICRO_AND_MACRO_STRING
+    };
+    char string[64];
+    float32_t float_value;
+    uint32_t u32_value;
+    bool bool_value;
+    xensiv_radar_presence_mode_t mode;
+
+    for (size_t i = 0; i < (sizeof(valid) / sizeof(valid[0])); ++i)
+    {
+        size_t length = strlen(valid[i]);
+
+        memcpy(string, valid[i], length);
+        for (size_t spaces = 1; (length + spaces) < sizeof(string); ++spaces)
+        {
+            string[length + spaces - 1U] = ' ';
+
+            HOST_TEST_CHECK(!cli_parse_float(string, length + spaces, &float_value));
+            HOST_TEST_CHECK(!cli_parse_u32(string, length + spaces, &u32_value));
+            HOST_TEST_CHECK(!cli_parse_bool(string, length + spaces, "enable", "disable", &bool_value));
+            HOST_TEST_CHECK(!cli_parse_mode(string, length + spaces, &mode));
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function Name: test_throughput
+ ****************************************************************************//**
+ *
+ * @brief Measures the parsed parameters per second of every parser.
+ *
+ *******************************************************************************/
+static void test_throughput(void)
+{
+    static const char * const floats[] = { "1.5", "0.25", "-12.125", "3e-2", "100", "5" };
+    static const char * const u32s[] = { "1", "250", "4096", "4294967295", "7", "60000" };
+    static const char * const modes[] =
+    {
+        MACRO_ONLY_STRING, MICRO_ONLY_STRING, MICRO_IF_MACRO_STRING, MICRO_AND_MACRO_STRING, "disable", "x"
+    };
+    uint32_t accepted = 0;
+    double start;
+
+    start = host_test_time_s();
+    for (uint32_t i = 0; i < NUM_THROUGHPUT_PARSES; ++i)
+    {
+        float32_t value;
+        accepted += cli_parse_float(floats[i % 6U], strlen(floats[i % 6U]), &value) ? 1U : 0U;
+    }
+    printf("cli_parse_float: %.1f M parameters/s\n", NUM_THROUGHPUT_PARSES / (host_test_time_s() - start) * 1E-6);
+
+    start = host_test_time_s();
+    for (uint32_t i = 0; i < NUM_THROUGHPUT_PARSES; ++i)
+    {
+        uint32_t value;
+        accepted += cli_parse_u32(u32s[i % 6U], strlen(u32s[i % 6U]), &value) ? 1U : 0U;
+    }
+    printf("cli_parse_u32: %.1f M parameters/s\n", NUM_THROUGHPUT_PARSES / (host_test_time_s() - start) * 1E-6);
+
+    start = host_test_time_s();
+    for (uint32_t i = 0; i < NUM_THROUGHPUT_PARSES; ++i)
+    {
+        xensiv_radar_presence_mode_t mode;
+        accepted += cli_parse_mode(modes[i % 6U], strlen(modes[i % 6U]), &mode) ? 1U : 0U;
+    }
+    printf("cli_parse_mode: %.1f M parameters/s\n", NUM_THROUGHPUT_PARSES / (host_test_time_s() - start) * 1E-6);
+
+    /* also keeps the loops from being optimized away */
+    HOST_TEST_CHECK(accepted == (NUM_THROUGHPUT_PARSES * 2U) + ((NUM_THROUGHPUT_PARSES / 6U) * 4U) +
+                                ((NUM_THROUGHPUT_PARSES % 6U) < 4U ? (NUM_THROUGHPUT_PARSES % 6U) : 4U));
+}
+
+int main(void)
+{
+    test_round_trip();
+    test_rejection();
+    test_trailing_space();
+    test_throughput();
+
+    return host_test_result();
+}
@@ -0,0 +1,378 @@
+/*****************************************************************************
+ * File name: test_clutter_map.c
+ *
+ * Description: This file contains the host test of the clutter map. It
+ *   checks that the learned background and its learned flag survive a reset
+ *   through the autosave timer, and replays the selftest scenarios with the
+ *   map off and learning to compare the false macro triggers.
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "clutter_map.h"
+#include "flash_storage_file.h"
+#include "freertos_host.h"
+#include "host_test.h"
+#include "radar_rx_processing.h"
+#include "radar_scene_sim.h"
+#include "selftest_scenarios.h"
+
+#define BACKING_FILE            "test_clutter_map.bin"
+
+#define FRAME_PERIOD_MS         (100U)
+#define NUM_BINS                (64U)
+#define MAX_SAMPLES             (RADAR_RX_MAX_ANTENNAS * 16U * 128U)
+
+/* Frames between the two spectra a macro trigger compares, like the macro compare interval of 1 s */
+#define COMPARE_FRAMES          (10U)
+
+/* A macro trigger is a change of a range bin by more than this part of the strongest bin... */
+#define TRIGGER_RELATIVE        (0.1f)
+
+/* ...plus this many times the mean change of the noise bins in the empty room */
+#define TRIGGER_SCALE           (8.0f)
+
+/* Swing of a person which is macro motion, the selftest people breathe 2 mm */
+#define MACRO_SWING_M           (0.01f)
+
+/* Range bins around the cabinet left out of the noise estimate */
+#define CABINET_GUARD_BINS      (2)
+
+/* Static clutter and a person sitting in the range bin of the cabinet */
+static const radar_scene_sim_target_s cabinet[] =
+{
+    { 2.2f, 0.0f, 0.0f, 0.0f, 30.0f, 1500.0f }
+};
+
+static const radar_scene_sim_target_s walk_to_cabinet[] =
+{
+    { 2.2f, 0.0f, 0.0f, 0.0f, 30.0f, 1500.0f },
+    { 3.2f, -0.5f, 0.0f, 0.0f, 0.0f, 800.0f }
+};
+
+static const radar_scene_sim_target_s sit_at_cabinet[] =
+{
+    { 2.2f, 0.0f, 0.0f, 0.0f, 30.0f, 1500.0f },
+    { 2.2f, 0.0f, 0.002f, 0.25f, 0.0f, 800.0f }
+};
+
+static const selftest_segment_s sit_at_cabinet_segments[] =
+{
+    { 100U, cabinet, 1U },
+    { 20U, walk_to_cabinet, 2U },
+    { 300U, sit_at_cabinet, 2U },
+    { 100U, cabinet, 1U }
+};
+
+static const selftest_scenario_s sit_at_cabinet_scenario =
+{
+    "sit_at_cabinet", sit_at_cabinet_segments, 4U
+};
+
+/*
+ * Macro triggers of one replay
+ * frames - frames which are counted, frames right after a change of the scene are not
+ * moving - counted frames while the person walks or moves
+ * moving_triggers - of these, frames with a macro trigger
+ * false_triggers - frames with a macro trigger while nobody moves
+ */
+typedef struct
+{
+    uint32_t frames;
+    uint32_t moving;
+    uint32_t moving_triggers;
+    uint32_t false_triggers;
+} replay_result_s;
+
+static uint16_t fifo_data[MAX_SAMPLES];
+static float32_t planar[MAX_SAMPLES];
+static float32_t avg_chirps[RADAR_RX_MAX_ANTENNAS * RADAR_RX_MAX_SAMPLES];
+static float32_t chirp[RADAR_RX_MAX_SAMPLES];
+static float32_t spectrum[2U * NUM_BINS];
+static float32_t magnitude[COMPARE_FRAMES][NUM_BINS];
+static radar_scene_sim_s sim;
+static radar_rx_combiner_s combiner;
+static clutter_map_s map;
+static arm_rfft_fast_instance_f32 rfft;
+
+/*******************************************************************************
+ * Function Name: cabinet_bin
+ ****************************************************************************//**
+ *
+ * @return Range bin of the cabinet.
+ *
+ *******************************************************************************/
+static int32_t cabinet_bin(void)
+{
+    float32_t bin_length = 299792458.0f / (2.0f * (sim.params.end_freq_hz - sim.params.start_freq_hz));
+
+    return (int32_t)lroundf(cabinet[0].range_m / bin_length);
+}
+
+/*******************************************************************************
+ * Function Name: replay
+ ****************************************************************************//**
+ *
+ * @brief Replays a scenario through the FIFO unpacking, the chirp averaging,
+ * the antenna combination and the clutter map, which learns while the
+ * scenario is empty. A frame is a macro trigger if the magnitude of a range
+ * bin changed since COMPARE_FRAMES frames before by more than TRIGGER_RELATIVE
+ * of the strongest bin plus the threshold.
+ * Static clutter in the bin of a breathing person turns the phase motion into
+ * such a magnitude change.
+ *
+ * @param scenario Scenario.
+ * @param mode Clutter map mode.
+ * @param threshold Noise part of the trigger threshold, 0 to only measure the noise.
+ * @param result Counters of the replay.
+ *
+ * @return Mean magnitude change of the range bins away from the cabinet.
+ *
+ *******************************************************************************/
+static float32_t replay(const selftest_scenario_s *scenario, clutter_map_mode_e mode, float32_t threshold,
+                        replay_result_s *result)
+{
+    uint32_t num_rx;
+    uint32_t num_samples;
+    uint32_t samples_per_antenna;
+    uint32_t frame = 0U;
+    int32_t clutter_bin;
+    float32_t noise_sum = 0.0f;
+    uint32_t noise_count = 0U;
+
+    memset(result, 0, sizeof(*result));
+    radar_scene_sim_init(&sim, SELFTEST_SEED);
+    sim.params.frame_repetition_time_s = (float32_t)FRAME_PERIOD_MS / 1000.0f;
+    num_rx = sim.params.num_rx_antennas;
+    num_samples = sim.params.num_samples_per_chirp;
+    samples_per_antenna = sim.params.num_chirps_per_frame * num_samples;
+    clutter_bin = cabinet_bin();
+
+    HOST_TEST_CHECK((samples_per_antenna * num_rx) <= MAX_SAMPLES);
+    HOST_TEST_CHECK(num_samples == (2U * NUM_BINS));
+    HOST_TEST_CHECK(radar_rx_combiner_init(&combiner, num_rx, num_samples) == 0);
+
+    /* the map starts without a background, a stored one is not used */
+    memset(&map, 0, sizeof(map));
+    map.num_samples = num_samples;
+    clutter_map_set_mode(&map, mode);
+
+    for (uint32_t i = 0U; i < scenario->num_segments; i++)
+    {
+        const selftest_segment_s *segment = &scenario->segments[i];
+        bool occupied = (segment->num_targets > 1U);
+        bool moving = occupied && ((segment->targets[1].velocity_mps != 0.0f) ||
+                                   (segment->targets[1].breathing_m > MACRO_SWING_M));
+
+        (void)radar_scene_sim_set_targets(&sim, segment->targets, segment->num_targets);
+
+        for (uint32_t n = 0U; n < segment->num_frames; n++, frame++)
+        {
+            float32_t *current = magnitude[frame % COMPARE_FRAMES];
+            float32_t previous[NUM_BINS];
+            bool trigger = false;
+
+            memcpy(previous, current, sizeof(previous));
+
+            radar_scene_sim_frame(&sim, (uint8_t *)fifo_data);
+            radar_rx_unpack_fifo((const uint8_t *)fifo_data, fifo_data, samples_per_antenna * num_rx);
+            radar_rx_deinterleave(fifo_data, planar, num_rx, samples_per_antenna);
+            radar_rx_average_chirps(planar, avg_chirps, num_rx, sim.params.num_chirps_per_frame, num_samples);
+            radar_rx_combine(&combiner, avg_chirps, chirp, frame * FRAME_PERIOD_MS);
+            clutter_map_process(&map, chirp, !occupied, frame * FRAME_PERIOD_MS);
+
+            arm_rfft_fast_f32(&rfft, chirp, spectrum, 0U);
+            spectrum[0] = 0.0f;
+            spectrum[1] = 0.0f;
+            arm_cmplx_mag_f32(spectrum, current, NUM_BINS);
+
+            /* the spectra of the compare interval belong to one scene */
+            if ((frame < COMPARE_FRAMES) || (n < COMPARE_FRAMES))
+            {
+                continue;
+            }
+
+            float32_t peak = 0.0f;
+            uint32_t peak_index;
+
+            arm_max_f32(current, NUM_BINS, &peak, &peak_index);
+            for (int32_t bin = 1; bin < (int32_t)NUM_BINS; bin++)
+            {
+                float32_t change = fabsf(current[bin] - previous[bin]);
+
+                trigger = trigger || ((threshold > 0.0f) &&
+                                      (change > (threshold + (TRIGGER_RELATIVE * peak))));
+                if (abs(bin - clutter_bin) > CABINET_GUARD_BINS)
+                {
+                    noise_sum += change;
+                    noise_count++;
+                }
+            }
+
+            result->frames++;
+            if (moving)
+            {
+                result->moving++;
+                result->moving_triggers += trigger ? 1U : 0U;
+            }
+            else
+            {
+                result->false_triggers += trigger ? 1U : 0U;
+            }
+        }
+    }
+
+    return (noise_count > 0U) ? (noise_sum / (float32_t)noise_count) : 0.0f;
+}
+
+/*******************************************************************************
+ * Function Name: test_false_triggers
+ ****************************************************************************//**
+ *
+ * @brief Compares the false macro triggers of the selftest scenarios and of
+ * a person sitting in the range bin of the cabinet with the map off and
+ * learning. The map must not add false triggers or lose the walking person,
+ * and it must remove the triggers the cabinet causes with the sitting person.
+ *
+ *******************************************************************************/
+static void test_false_triggers(void)
+{
+    static const char * const mode_names[] = { "off", "learn" };
+    uint32_t num_scenarios;
+    const selftest_scenario_s *scenarios = selftest_scenarios_get(&num_scenarios);
+    replay_result_s result[2];
+    float32_t threshold;
+
+    HOST_TEST_CHECK(arm_rfft_fast_init_f32(&rfft, 2U * NUM_BINS) == ARM_MATH_SUCCESS);
+
+    /* the threshold follows the noise of the empty room */
+    threshold = TRIGGER_SCALE * replay(&scenarios[0], CLUTTER_MAP_OFF, 0.0f, &result[0]);
+    HOST_TEST_CHECK(threshold > 0.0f);
+
+    for (uint32_t s = 0U; s <= num_scenarios; s++)
+    {
+        const selftest_scenario_s *scenario = (s < num_scenarios) ? &scenarios[s] : &sit_at_cabinet_scenario;
+
+        for (uint32_t m = 0U; m < 2U; m++)
+        {
+            (void)replay(scenario, (m == 0U) ? CLUTTER_MAP_OFF : CLUTTER_MAP_LEARN, threshold, &result[m]);
+            printf("%-16s map %-5s: %u of %u frames with a false macro trigger, moving person triggers %u of %u\n",
+                   scenario->name, mode_names[m], (unsigned int)result[m].false_triggers,
+                   (unsigned int)(result[m].frames - result[m].moving),
+                   (unsigned int)result[m].moving_triggers, (unsigned int)result[m].moving);
+        }
+
+        HOST_TEST_CHECK(result[1].false_triggers <= result[0].false_triggers);
+        HOST_TEST_CHECK((result[1].moving == 0U) || (result[1].moving_triggers > 0U));
+        if (scenario == &sit_at_cabinet_scenario)
+        {
+            HOST_TEST_CHECK(result[1].false_triggers < result[0].false_triggers);
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function Name: test_persistence
+ ****************************************************************************//**
+ *
+ * @brief A map stored before it learned restores only its mode. A learned
+ * background is stored by the autosave timer and restored after a reset,
+ * and the timer does not write again while nothing was learned.
+ *
+ *******************************************************************************/
+static void test_persistence(void)
+{
+    static float32_t background[CLUTTER_MAP_MAX_SAMPLES];
+    const uint32_t num_samples = 128U;
+    uint32_t writes;
+
+    HOST_TEST_CHECK(flash_storage_file_erase() == 0);
+    freertos_host_reset();
+    HOST_TEST_CHECK(flash_storage_init() == 0);
+    HOST_TEST_CHECK(clutter_map_init(&map, num_samples) == 0);
+    HOST_TEST_CHECK(clutter_map_start_autosave(&map) == 0);
+    HOST_TEST_CHECK((clutter_map_get_mode(&map) == CLUTTER_MAP_OFF) && !map.has_background);
+
+    /* set_clutter_map learn on a fresh device */
+    clutter_map_set_mode(&map, CLUTTER_MAP_LEARN);
+    HOST_TEST_CHECK(clutter_map_save(&map) == 0);
+    HOST_TEST_CHECK(flash_storage_init() == 0);
+    HOST_TEST_CHECK(clutter_map_init(&map, num_samples) == 0);
+    HOST_TEST_CHECK((clutter_map_get_mode(&map) == CLUTTER_MAP_LEARN) && !map.has_background);
+
+    /* learn, the timer stores the background */
+    for (uint32_t frame = 0U; frame < 50U; frame++)
+    {
+        for (uint32_t i = 0U; i < num_samples; i++)
+        {
+            chirp[i] = 100.0f * sinf(0.1f * (float32_t)(i + frame));
+        }
+        clutter_map_process(&map, chirp, true, frame * FRAME_PERIOD_MS);
+    }
+    memcpy(background, map.background, sizeof(background));
+    HOST_TEST_CHECK(map.modified);
+    HOST_TEST_CHECK(freertos_host_fire_timers() == 1U);
+    HOST_TEST_CHECK(!map.modified);
+
+    /* nothing learned, nothing written */
+    writes = flash_storage_file_get_num_row_writes();
+    HOST_TEST_CHECK(freertos_host_fire_timers() == 1U);
+    HOST_TEST_CHECK(flash_storage_file_get_num_row_writes() == writes);
+
+    /* reset */
+    freertos_host_reset();
+    HOST_TEST_CHECK(flash_storage_init() == 0);
+    HOST_TEST_CHECK(clutter_map_init(&map, num_samples) == 0);
+    HOST_TEST_CHECK((clutter_map_get_mode(&map) == CLUTTER_MAP_LEARN) && map.has_background);
+    HOST_TEST_CHECK(memcmp(background, map.background, num_samples * sizeof(float32_t)) == 0);
+
+    /* a frozen map does not change */
+    clutter_map_set_mode(&map, CLUTTER_MAP_FREEZE);
+    clutter_map_process(&map, chirp, true, 0U);
+    HOST_TEST_CHECK(!map.modified);
+}
+
+int main(void)
+{
+    flash_storage_file_set_path(BACKING_FILE);
+
+    test_persistence();
+    test_false_triggers();
+
+    return host_test_result();
+}
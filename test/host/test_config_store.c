@@ -0,0 +1,269 @@
+/*****************************************************************************
+ * File name: test_config_store.c
+ *
+ * Description: This file contains the tests of the configuration store on the
+ *   file backed flash: round trip, batching, wear levelling, CRC
+ *   corruption and power loss
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "config_store.h"
+#include "flash_storage_file.h"
+#include "freertos_host.h"
+#include "host_test.h"
+
+#define BACKING_FILE            "test_config_store.bin"
+
+/* Size of a snapshot, magic, sequence, valid mask, values and CRC */
+#define RECORD_SIZE             ((4U + CONFIG_STORE_NUM_KEYS) * sizeof(uint32_t))
+
+/*******************************************************************************
+ * Function Name: reboot
+ ****************************************************************************//**
+ *
+ * @brief Simulates a reset: the flash is reloaded from the file and the store
+ * is initialized from it.
+ *
+ *******************************************************************************/
+static void reboot(void)
+{
+    freertos_host_reset();
+    HOST_TEST_CHECK(flash_storage_init() == 0);
+    HOST_TEST_CHECK(config_store_init() == 0);
+}
+
+/*******************************************************************************
+ * Function Name: stored_u32
+ ****************************************************************************//**
+ *
+ * @param key Setting.
+ *
+ * @return Stored value, 0xFFFFFFFF if the setting is not stored.
+ *
+ *******************************************************************************/
+static uint32_t stored_u32(config_store_key_e key)
+{
+    uint32_t value;
+
+    return config_store_get_u32(key, &value) ? value : 0xFFFFFFFFU;
+}
+
+/*******************************************************************************
+ * Function Name: test_round_trip
+ ****************************************************************************//**
+ *
+ * @brief Checks that a burst of changes is written once, after the flush
+ * delay, and is restored after a reset.
+ *
+ *******************************************************************************/
+static void test_round_trip(void)
+{
+    xensiv_radar_presence_config_t config;
+    uint32_t num_row_writes;
+    float32_t value = 0.0f;
+
+    HOST_TEST_CHECK(flash_storage_file_erase() == 0);
+    reboot();
+    HOST_TEST_CHECK(stored_u32(CONFIG_KEY_MAX_RANGE_BIN) == 0xFFFFFFFFU);
+
+    num_row_writes = flash_storage_file_get_num_row_writes();
+    config_store_set_u32(CONFIG_KEY_MAX_RANGE_BIN, 4U);
+    config_store_set_float(CONFIG_KEY_MACRO_THRESHOLD, 1.25f);
+    config_store_set_float(CONFIG_KEY_MICRO_THRESHOLD, 30.5f);
+    config_store_set_u32(CONFIG_KEY_MODE, XENSIV_RADAR_PRESENCE_MODE_MICRO_ONLY);
+    config_store_set_float(CONFIG_KEY_TRACKER_THRESHOLD, 0.75f);
+    HOST_TEST_CHECK(flash_storage_file_get_num_row_writes() == num_row_writes);
+
+    HOST_TEST_CHECK(freertos_host_fire_timers() == 1U);
+    HOST_TEST_CHECK(flash_storage_file_get_num_row_writes() == (num_row_writes + 1U));
+
+    reboot();
+    HOST_TEST_CHECK(stored_u32(CONFIG_KEY_MAX_RANGE_BIN) == 4U);
+    HOST_TEST_CHECK(config_store_get_float(CONFIG_KEY_TRACKER_THRESHOLD, &value) && (value == 0.75f));
+    HOST_TEST_CHECK(stored_u32(CONFIG_KEY_CFAR_MODE) == 0xFFFFFFFFU);
+
+    memset(&config, 0, sizeof(config));
+    config.mode = XENSIV_RADAR_PRESENCE_MODE_MICRO_IF_MACRO;
+    config_store_apply(&config);
+    HOST_TEST_CHECK((config.max_range_bin == 4) && (config.macro_threshold == 1.25f) &&
+                    (config.micro_threshold == 30.5f) && (config.mode == XENSIV_RADAR_PRESENCE_MODE_MICRO_ONLY));
+
+    /* nothing pending, nothing written */
+    HOST_TEST_CHECK(config_store_flush() == 0);
+    HOST_TEST_CHECK(flash_storage_file_get_num_row_writes() == (num_row_writes + 1U));
+
+    config_store_clear();
+    HOST_TEST_CHECK(freertos_host_fire_timers() == 1U);
+    reboot();
+    HOST_TEST_CHECK(stored_u32(CONFIG_KEY_MAX_RANGE_BIN) == 0xFFFFFFFFU);
+}
+
+/*******************************************************************************
+ * Function Name: test_wear_levelling
+ ****************************************************************************//**
+ *
+ * @brief Writes more snapshots than rows, every row is used in turn and the
+ * newest snapshot wins after a reset.
+ *
+ *******************************************************************************/
+static void test_wear_levelling(void)
+{
+    const uint8_t *base;
+
+    HOST_TEST_CHECK(flash_storage_file_erase() == 0);
+    reboot();
+    base = flash_storage_get_address(FLASH_STORAGE_CONFIG);
+
+    for (uint32_t i = 1; i <= (3U * FLASH_STORAGE_CONFIG_ROWS) + 1U; ++i)
+    {
+        config_store_set_u32(CONFIG_KEY_FRAME_DECIMATION, i);
+        HOST_TEST_CHECK(config_store_flush() == 0);
+
+        if (i == FLASH_STORAGE_CONFIG_ROWS)
+        {
+            for (uint32_t row = 0; row < FLASH_STORAGE_CONFIG_ROWS; ++row)
+            {
+                uint32_t magic;
+
+                memcpy(&magic, &base[row * FLASH_STORAGE_ROW_SIZE], sizeof(magic));
+                HOST_TEST_CHECK(magic != 0U);
+            }
+        }
+    }
+
+    reboot();
+    HOST_TEST_CHECK(stored_u32(CONFIG_KEY_FRAME_DECIMATION) == ((3U * FLASH_STORAGE_CONFIG_ROWS) + 1U));
+}
+
+/*******************************************************************************
+ * Function Name: test_corruption
+ ****************************************************************************//**
+ *
+ * @brief Corrupts every byte of the newest snapshot in turn, the previous
+ * snapshot must be restored.
+ *
+ *******************************************************************************/
+static void test_corruption(void)
+{
+    for (uint32_t offset = 0; offset < RECORD_SIZE; ++offset)
+    {
+        HOST_TEST_CHECK(flash_storage_file_erase() == 0);
+        reboot();
+
+        /* snapshots in rows 0 and 1 */
+        config_store_set_u32(CONFIG_KEY_MAX_RANGE_BIN, 2U);
+        HOST_TEST_CHECK(config_store_flush() == 0);
+        config_store_set_u32(CONFIG_KEY_MAX_RANGE_BIN, 3U);
+        HOST_TEST_CHECK(config_store_flush() == 0);
+
+        flash_storage_file_corrupt(FLASH_STORAGE_CONFIG, FLASH_STORAGE_ROW_SIZE + offset);
+        reboot();
+        HOST_TEST_CHECK(stored_u32(CONFIG_KEY_MAX_RANGE_BIN) == 2U);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: test_power_loss
+ ****************************************************************************//**
+ *
+ * @brief Loses the power at every byte of a snapshot write. After the reset
+ * the store holds either the complete old or the complete new snapshot, and
+ * the next write still works.
+ *
+ *******************************************************************************/
+static void test_power_loss(void)
+{
+    for (uint32_t num_bytes = 0; num_bytes <= FLASH_STORAGE_ROW_SIZE; num_bytes += ((num_bytes < RECORD_SIZE) ? 1U : 64U))
+    {
+        uint32_t value;
+
+        HOST_TEST_CHECK(flash_storage_file_erase() == 0);
+        reboot();
+        config_store_set_u32(CONFIG_KEY_MAX_RANGE_BIN, 2U);
+        config_store_set_u32(CONFIG_KEY_MODE, 1U);
+        HOST_TEST_CHECK(config_store_flush() == 0);
+
+        config_store_set_u32(CONFIG_KEY_MAX_RANGE_BIN, 5U);
+        config_store_set_u32(CONFIG_KEY_MODE, 3U);
+        flash_storage_file_cut_power(num_bytes);
+        HOST_TEST_CHECK(config_store_flush() != 0);
+
+        reboot();
+        value = stored_u32(CONFIG_KEY_MAX_RANGE_BIN);
+        HOST_TEST_CHECK((num_bytes >= RECORD_SIZE) ? (value == 5U) : (value == 2U));
+        HOST_TEST_CHECK(stored_u32(CONFIG_KEY_MODE) == ((value == 5U) ? 3U : 1U));
+
+        config_store_set_u32(CONFIG_KEY_MAX_RANGE_BIN, 1U);
+        HOST_TEST_CHECK(config_store_flush() == 0);
+        reboot();
+        HOST_TEST_CHECK(stored_u32(CONFIG_KEY_MAX_RANGE_BIN) == 1U);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: test_load_time
+ ****************************************************************************//**
+ *
+ * @brief Measures the load of the snapshots at boot.
+ *
+ *******************************************************************************/
+static void test_load_time(void)
+{
+    const uint32_t num_loads = 100000U;
+    double start;
+
+    start = host_test_time_s();
+    for (uint32_t i = 0; i < num_loads; ++i)
+    {
+        freertos_host_reset();
+        (void)config_store_init();
+    }
+    printf("config_store_init: %.2f us\n", (host_test_time_s() - start) * 1E6 / num_loads);
+}
+
+int main(void)
+{
+    flash_storage_file_set_path(BACKING_FILE);
+
+    test_round_trip();
+    test_wear_levelling();
+    test_corruption();
+    test_power_loss();
+    test_load_time();
+
+    return host_test_result();
+}
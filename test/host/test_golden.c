@@ -0,0 +1,582 @@
+/*****************************************************************************
+ * File name: test_golden.c
+ *
+ * Description: This file contains the golden vector regression test of
+ *   the frame path which runs on the host. The self test scenarios pass the FIFO
+ *   unpacking, the de-interleaving, the chirp averaging, the antenna
+ *   combination and the frame change gate, with and without gating the empty
+ *   scene, and the people tracker and the breathing rate estimation on the
+ *   range spectrum.
+ *   The event stream is compared with golden/frame_path.golden under a
+ *   tolerance model for float differences.
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "frame_change_gate.h"
+#include "host_test.h"
+#include "presence_tracker.h"
+#include "presence_vital_signs.h"
+#include "radar_rx_processing.h"
+#include "radar_scene_sim.h"
+#include "range_gate.h"
+#include "selftest_scenarios.h"
+
+#define GOLDEN_FRAME_PERIOD_MS      (100U)
+#define GOLDEN_NUM_BINS             (64U)
+#define GOLDEN_MAX_LINES            (4096U)
+#define GOLDEN_MAX_SAMPLES          (RADAR_RX_MAX_ANTENNAS * 16U * 128U)
+
+/* Peak and valid breathing lines every this many processed frames */
+#define GOLDEN_REPORT_FRAMES        (10U)
+
+/* Threshold of the frame change gate */
+#define GOLDEN_CHANGE_GATE          (3.0f)
+
+/* Timestamps of matching lines may differ by two frames */
+#define GOLDEN_TIME_TOLERANCE_MS    (200U)
+
+#define GOLDEN_SPEED_OF_LIGHT       (299792458.0f)
+
+/* One line of the event stream: <scenario> <config> <kind> <time ms> <value> <amount> */
+typedef struct
+{
+    char scenario[16];
+    char config[16];
+    char kind[12];
+    uint32_t time_ms;
+    int32_t value;
+    float32_t amount;
+} golden_line_s;
+
+/*
+ * Tolerances of the lines of a kind
+ * skip - a run of frames skipped by the gate: value is the length
+ * peak - strongest range bin of a processed frame: value is the bin, amount the magnitude
+ * people - change of the number of confirmed tracks: value is the count
+ * breathing - breathing rate estimate: value is the range bin, amount the rate in bpm
+ * end - end of a stream: value is the number of frames, amount the skipped frames
+ */
+typedef struct
+{
+    const char *kind;
+    int32_t value_tolerance;
+    float32_t amount_tolerance;
+    float32_t amount_rel_tolerance;
+} golden_tolerance_s;
+
+static const golden_tolerance_s tolerances[] =
+{
+    { "skip", 2, 0.0f, 0.0f },
+    { "peak", 1, 1E-3f, 0.02f },
+    { "people", 0, 0.0f, 0.0f },
+    { "breathing", 1, 0.5f, 0.0f },
+    { "end", 0, 2.0f, 0.0f }
+};
+
+/*
+ * Configurations of the frame path. Without the presence library the presence
+ * mode only decides whether the frame change gate runs on the empty scene
+ * (macro_only and micro_if_macro) or not, so the four modes give these two
+ * streams. The modes themselves are compared on the device with selftest.
+ */
+typedef struct
+{
+    const char *name;
+    bool gated;
+} golden_config_s;
+
+static const golden_config_s configs[] =
+{
+    { "gated", true },
+    { "ungated", false }
+};
+
+static golden_line_s actual[GOLDEN_MAX_LINES];
+static golden_line_s expected[GOLDEN_MAX_LINES];
+static uint16_t fifo_data[GOLDEN_MAX_SAMPLES];
+static float32_t planar[GOLDEN_MAX_SAMPLES];
+static float32_t avg_chirps[RADAR_RX_MAX_ANTENNAS * RADAR_RX_MAX_SAMPLES];
+static float32_t chirp[RADAR_RX_MAX_SAMPLES];
+static float32_t spectrum[RADAR_RX_MAX_SAMPLES];
+static cfloat32_t macro_fft[GOLDEN_NUM_BINS];
+static float32_t magnitude[GOLDEN_NUM_BINS];
+static radar_scene_sim_s sim;
+static radar_rx_combiner_s combiner;
+static frame_change_gate_s gate;
+static presence_tracker_s tracker;
+static presence_vital_signs_state_s vital;
+static arm_rfft_fast_instance_f32 rfft;
+
+/*******************************************************************************
+ * Function Name: golden_add
+ ****************************************************************************//**
+ *
+ * @brief Appends a line to an event stream.
+ *
+ * @param lines Event stream.
+ * @param num_lines Number of lines of the stream.
+ * @param scenario Scenario name.
+ * @param config Configuration name.
+ * @param kind Kind of the line.
+ * @param time_ms Timestamp.
+ * @param value Integer value.
+ * @param amount Float value.
+ *
+ *******************************************************************************/
+static void golden_add(golden_line_s *lines, uint32_t *num_lines, const char *scenario, const char *config,
+                       const char *kind, uint32_t time_ms, int32_t value, float32_t amount)
+{
+    golden_line_s *line;
+
+    if (!HOST_TEST_CHECK(*num_lines < GOLDEN_MAX_LINES))
+    {
+        return;
+    }
+
+    line = &lines[(*num_lines)++];
+    (void)snprintf(line->scenario, sizeof(line->scenario), "%s", scenario);
+    (void)snprintf(line->config, sizeof(line->config), "%s", config);
+    (void)snprintf(line->kind, sizeof(line->kind), "%s", kind);
+    line->time_ms = time_ms;
+    line->value = value;
+    line->amount = amount;
+}
+
+/*******************************************************************************
+ * Function Name: golden_person_bin
+ ****************************************************************************//**
+ *
+ * @brief Range bin of the person of a segment at the time of the next frame.
+ *
+ * @param bin_length Length of a range bin in meters.
+ *
+ * @return Range bin.
+ *
+ *******************************************************************************/
+static int32_t golden_person_bin(float32_t bin_length)
+{
+    const radar_scene_sim_target_s *person = &sim.targets[1];
+    float32_t range = person->range_m + (person->velocity_mps * (sim.time_s - sim.targets_time_s));
+
+    return (int32_t)lroundf(range / bin_length);
+}
+
+/*******************************************************************************
+ * Function Name: golden_run
+ ****************************************************************************//**
+ *
+ * @brief Runs one scenario in one configuration and appends its event stream. The
+ * presence algorithm does not run on the host, so the presence state of the
+ * gate, the tracker and the breathing rate estimation is taken from the
+ * scenario: absence without a person, micro presence while the person does
+ * not walk and macro presence otherwise.
+ *
+ * @param scenario Scenario.
+ * @param config Configuration of the frame path.
+ * @param lines Event stream.
+ * @param num_lines Number of lines of the stream.
+ *
+ *******************************************************************************/
+static void golden_run(const selftest_scenario_s *scenario, const golden_config_s *config,
+                       golden_line_s *lines, uint32_t *num_lines)
+{
+    uint32_t num_rx;
+    uint32_t num_samples;
+    uint32_t samples_per_antenna;
+    float32_t bin_length;
+    range_gate_s range;
+    uint32_t frame = 0U;
+    uint32_t processed = 0U;
+    uint32_t skip_start = 0U;
+    uint32_t skip_run = 0U;
+    uint32_t people = 0U;
+
+    radar_scene_sim_init(&sim, SELFTEST_SEED);
+    sim.params.frame_repetition_time_s = (float32_t)GOLDEN_FRAME_PERIOD_MS / 1000.0f;
+    num_rx = sim.params.num_rx_antennas;
+    num_samples = sim.params.num_samples_per_chirp;
+    samples_per_antenna = sim.params.num_chirps_per_frame * num_samples;
+    bin_length = GOLDEN_SPEED_OF_LIGHT / (2.0f * (sim.params.end_freq_hz - sim.params.start_freq_hz));
+
+    HOST_TEST_CHECK((samples_per_antenna * num_rx) <= GOLDEN_MAX_SAMPLES);
+    HOST_TEST_CHECK(radar_rx_combiner_init(&combiner, num_rx, num_samples) == 0);
+    HOST_TEST_CHECK(frame_change_gate_init(&gate, num_samples) == 0);
+    HOST_TEST_CHECK(presence_tracker_init(&tracker, (int32_t)GOLDEN_NUM_BINS, bin_length) == 0);
+    HOST_TEST_CHECK(presence_vital_signs_init(&vital) == 0);
+    presence_vital_signs_enable(&vital, true);
+    range_gate_compute(&range, (int32_t)GOLDEN_NUM_BINS, 0, (int32_t)GOLDEN_NUM_BINS - 1, false);
+
+    for (uint32_t i = 0U; i < scenario->num_segments; i++)
+    {
+        const selftest_segment_s *segment = &scenario->segments[i];
+        bool occupied = (segment->num_targets > 1U);
+        bool walking = occupied && (segment->targets[1].velocity_mps != 0.0f);
+        xensiv_radar_presence_state_t state = !occupied ? XENSIV_RADAR_PRESENCE_STATE_ABSENCE :
+                                              (walking ? XENSIV_RADAR_PRESENCE_STATE_MACRO_PRESENCE :
+                                                         XENSIV_RADAR_PRESENCE_STATE_MICRO_PRESENCE);
+
+        (void)radar_scene_sim_set_targets(&sim, segment->targets, segment->num_targets);
+
+        for (uint32_t n = 0U; n < segment->num_frames; n++, frame++)
+        {
+            uint32_t time_ms = frame * GOLDEN_FRAME_PERIOD_MS;
+            int32_t person_bin = occupied ? golden_person_bin(bin_length) : -1;
+            float32_t peak;
+            uint32_t peak_bin;
+
+            radar_scene_sim_frame(&sim, (uint8_t *)fifo_data);
+            radar_rx_unpack_fifo((const uint8_t *)fifo_data, fifo_data, samples_per_antenna * num_rx);
+            radar_rx_deinterleave(fifo_data, planar, num_rx, samples_per_antenna);
+            radar_rx_average_chirps(planar, avg_chirps, num_rx, sim.params.num_chirps_per_frame, num_samples);
+            radar_rx_combine(&combiner, avg_chirps, chirp, time_ms);
+
+            if (!frame_change_gate_process(&gate, chirp, config->gated && !occupied))
+            {
+                if (skip_run++ == 0U)
+                {
+                    skip_start = time_ms;
+                }
+                continue;
+            }
+
+            if (skip_run > 0U)
+            {
+                golden_add(lines, num_lines, scenario->name, config->name, "skip", skip_start, (int32_t)skip_run, 0.0f);
+                skip_run = 0U;
+            }
+
+            /* range spectrum without DC as the macro FFT buffer */
+            memcpy(spectrum, chirp, num_samples * sizeof(float32_t));
+            arm_rfft_fast_f32(&rfft, spectrum, (float32_t *)macro_fft, 0U);
+            macro_fft[0].real = 0.0f;
+            macro_fft[0].imag = 0.0f;
+            arm_cmplx_mag_f32((const float32_t *)macro_fft, magnitude, GOLDEN_NUM_BINS);
+            arm_max_f32(magnitude, GOLDEN_NUM_BINS, &peak, &peak_bin);
+
+            presence_tracker_process(&tracker, macro_fft, &range, state, person_bin, time_ms);
+            if (presence_tracker_get_count(&tracker) != people)
+            {
+                people = presence_tracker_get_count(&tracker);
+                golden_add(lines, num_lines, scenario->name, config->name, "people", time_ms, (int32_t)people, 0.0f);
+            }
+
+            if (state == XENSIV_RADAR_PRESENCE_STATE_MICRO_PRESENCE)
+            {
+                presence_vital_signs_process(&vital, macro_fft, person_bin, time_ms);
+            }
+            else
+            {
+                presence_vital_signs_reset(&vital);
+            }
+
+            if ((processed % GOLDEN_REPORT_FRAMES) == 0U)
+            {
+                presence_vital_signs_s breathing;
+
+                golden_add(lines, num_lines, scenario->name, config->name, "peak", time_ms, (int32_t)peak_bin, peak);
+                if (presence_vital_signs_get(&vital, &breathing))
+                {
+                    golden_add(lines, num_lines, scenario->name, config->name, "breathing", time_ms,
+                               breathing.range_bin, breathing.rate_bpm);
+                }
+            }
+
+            processed++;
+        }
+    }
+
+    if (skip_run > 0U)
+    {
+        golden_add(lines, num_lines, scenario->name, config->name, "skip", skip_start, (int32_t)skip_run, 0.0f);
+    }
+
+    golden_add(lines, num_lines, scenario->name, config->name, "end", frame * GOLDEN_FRAME_PERIOD_MS,
+               (int32_t)frame, (float32_t)gate.stats.skipped);
+}
+
+/*******************************************************************************
+ * Function Name: golden_match
+ ****************************************************************************//**
+ *
+ * @brief Compares two lines under the tolerance model.
+ *
+ * @param golden Golden line.
+ * @param line Line of the build under test.
+ *
+ * @return true if the lines match.
+ *
+ *******************************************************************************/
+static bool golden_match(const golden_line_s *golden, const golden_line_s *line)
+{
+    const golden_tolerance_s *tolerance = NULL;
+    uint32_t time_diff = (golden->time_ms > line->time_ms) ? (golden->time_ms - line->time_ms) :
+                                                              (line->time_ms - golden->time_ms);
+
+    for (size_t i = 0; i < (sizeof(tolerances) / sizeof(tolerances[0])); ++i)
+    {
+        if (strcmp(tolerances[i].kind, golden->kind) == 0)
+        {
+            tolerance = &tolerances[i];
+        }
+    }
+
+    return (tolerance != NULL) &&
+           (strcmp(golden->scenario, line->scenario) == 0) &&
+           (strcmp(golden->config, line->config) == 0) &&
+           (strcmp(golden->kind, line->kind) == 0) &&
+           (time_diff <= GOLDEN_TIME_TOLERANCE_MS) &&
+           (abs(golden->value - line->value) <= tolerance->value_tolerance) &&
+           (fabsf(golden->amount - line->amount) <=
+            (tolerance->amount_tolerance + (tolerance->amount_rel_tolerance * fabsf(golden->amount))));
+}
+
+/*******************************************************************************
+ * Function Name: golden_compare
+ ****************************************************************************//**
+ *
+ * @brief Compares an event stream with the golden stream line by line.
+ *
+ * @param golden Golden stream.
+ * @param num_golden Number of golden lines.
+ * @param lines Stream of the build under test.
+ * @param num_lines Number of lines.
+ * @param report true to print the first differences.
+ *
+ * @return Number of differing lines, a missing or extra line counts as one.
+ *
+ *******************************************************************************/
+static uint32_t golden_compare(const golden_line_s *golden, uint32_t num_golden,
+                               const golden_line_s *lines, uint32_t num_lines, bool report)
+{
+    uint32_t num_common = (num_golden < num_lines) ? num_golden : num_lines;
+    uint32_t differences = (num_golden > num_lines) ? (num_golden - num_lines) : (num_lines - num_golden);
+
+    for (uint32_t i = 0U; i < num_common; i++)
+    {
+        if (!golden_match(&golden[i], &lines[i]))
+        {
+            if (report && (differences < 5U))
+            {
+                printf("line %u: golden %s %s %s %u %d %g, got %s %s %s %u %d %g\n", (unsigned int)(i + 1U),
+                       golden[i].scenario, golden[i].config, golden[i].kind, (unsigned int)golden[i].time_ms,
+                       (int)golden[i].value, (double)golden[i].amount,
+                       lines[i].scenario, lines[i].config, lines[i].kind, (unsigned int)lines[i].time_ms,
+                       (int)lines[i].value, (double)lines[i].amount);
+            }
+            differences++;
+        }
+    }
+
+    if (report && (num_golden != num_lines))
+    {
+        printf("golden stream has %u lines, got %u\n", (unsigned int)num_golden, (unsigned int)num_lines);
+    }
+
+    return differences;
+}
+
+/*******************************************************************************
+ * Function Name: golden_load
+ ****************************************************************************//**
+ *
+ * @brief Reads a golden file, lines starting with # are comments.
+ *
+ * @param path Golden file.
+ * @param lines Golden stream.
+ * @param num_lines Number of lines read.
+ *
+ * @return true if the file was read.
+ *
+ *******************************************************************************/
+static bool golden_load(const char *path, golden_line_s *lines, uint32_t *num_lines)
+{
+    FILE *file = fopen(path, "r");
+    char text[160];
+
+    *num_lines = 0U;
+    if (file == NULL)
+    {
+        return false;
+    }
+
+    while ((fgets(text, sizeof(text), file) != NULL) && (*num_lines < GOLDEN_MAX_LINES))
+    {
+        golden_line_s *line = &lines[*num_lines];
+        unsigned int time_ms;
+        int value;
+        float amount;
+
+        if ((text[0] != '#') &&
+            (sscanf(text, "%15s %15s %11s %u %d %f", line->scenario, line->config, line->kind,
+                    &time_ms, &value, &amount) == 6))
+        {
+            line->time_ms = time_ms;
+            line->value = value;
+            line->amount = amount;
+            (*num_lines)++;
+        }
+    }
+
+    (void)fclose(file);
+
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: golden_save
+ ****************************************************************************//**
+ *
+ * @brief Writes an event stream as the golden file.
+ *
+ * @param path Golden file.
+ * @param lines Event stream.
+ * @param num_lines Number of lines.
+ *
+ * @return true if the file was written.
+ *
+ *******************************************************************************/
+static bool golden_save(const char *path, const golden_line_s *lines, uint32_t num_lines)
+{
+    FILE *file = fopen(path, "w");
+    bool ok = (file != NULL);
+
+    if (ok)
+    {
+        (void)fprintf(file, "# <scenario> <config> <kind> <time ms> <value> <amount>, see test_golden.c\n");
+        for (uint32_t i = 0U; i < num_lines; i++)
+        {
+            (void)fprintf(file, "%s %s %s %u %d %.6g\n", lines[i].scenario, lines[i].config, lines[i].kind,
+                          (unsigned int)lines[i].time_ms, (int)lines[i].value, (double)lines[i].amount);
+        }
+        ok = (fclose(file) == 0);
+    }
+
+    return ok;
+}
+
+/*******************************************************************************
+ * Function Name: test_tolerance
+ ****************************************************************************//**
+ *
+ * @brief Checks the tolerance model on a copy of the stream: differences
+ * within the tolerances pass, a larger difference of every field, a changed
+ * kind and a missing line are found.
+ *
+ * @param lines Event stream.
+ * @param num_lines Number of lines, at least two.
+ *
+ *******************************************************************************/
+static void test_tolerance(const golden_line_s *lines, uint32_t num_lines)
+{
+    static golden_line_s copy[GOLDEN_MAX_LINES];
+    uint32_t peak = 0U;
+
+    memcpy(copy, lines, num_lines * sizeof(golden_line_s));
+    for (uint32_t i = 0U; i < num_lines; i++)
+    {
+        copy[i].time_ms += GOLDEN_TIME_TOLERANCE_MS;
+        if (strcmp(copy[i].kind, "peak") == 0)
+        {
+            copy[i].value += 1;
+            copy[i].amount *= 1.01f;
+            peak = i;
+        }
+    }
+    HOST_TEST_CHECK(golden_compare(lines, num_lines, copy, num_lines, false) == 0U);
+
+    memcpy(copy, lines, num_lines * sizeof(golden_line_s));
+    copy[peak].time_ms += GOLDEN_TIME_TOLERANCE_MS + GOLDEN_FRAME_PERIOD_MS;
+    HOST_TEST_CHECK(golden_compare(lines, num_lines, copy, num_lines, false) == 1U);
+
+    memcpy(copy, lines, num_lines * sizeof(golden_line_s));
+    copy[peak].value += 2;
+    HOST_TEST_CHECK(golden_compare(lines, num_lines, copy, num_lines, false) == 1U);
+
+    memcpy(copy, lines, num_lines * sizeof(golden_line_s));
+    copy[peak].amount *= 1.05f;
+    HOST_TEST_CHECK(golden_compare(lines, num_lines, copy, num_lines, false) == 1U);
+
+    memcpy(copy, lines, num_lines * sizeof(golden_line_s));
+    (void)snprintf(copy[peak].kind, sizeof(copy[peak].kind), "people");
+    HOST_TEST_CHECK(golden_compare(lines, num_lines, copy, num_lines, false) == 1U);
+
+    HOST_TEST_CHECK(golden_compare(lines, num_lines, lines, num_lines - 1U, false) == 1U);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t num_scenarios;
+    const selftest_scenario_s *scenarios = selftest_scenarios_get(&num_scenarios);
+    uint32_t num_actual = 0U;
+    uint32_t num_expected = 0U;
+
+    if ((argc < 2) || ((argc > 2) && (strcmp(argv[2], "--update") != 0)))
+    {
+        printf("usage: test_golden <golden file> [--update]\n");
+        return 2;
+    }
+
+    HOST_TEST_CHECK(arm_rfft_fast_init_f32(&rfft, 2U * GOLDEN_NUM_BINS) == ARM_MATH_SUCCESS);
+    HOST_TEST_CHECK(frame_change_gate_set_threshold(GOLDEN_CHANGE_GATE) == 0);
+
+    for (uint32_t s = 0U; s < num_scenarios; s++)
+    {
+        for (uint32_t c = 0U; c < (sizeof(configs) / sizeof(configs[0])); c++)
+        {
+            golden_run(&scenarios[s], &configs[c], actual, &num_actual);
+        }
+    }
+
+    if (argc > 2)
+    {
+        HOST_TEST_CHECK(golden_save(argv[1], actual, num_actual));
+        printf("%u lines written to %s\n", (unsigned int)num_actual, argv[1]);
+        return host_test_result();
+    }
+
+    HOST_TEST_CHECK(num_actual >= 2U);
+    test_tolerance(actual, num_actual);
+
+    if (HOST_TEST_CHECK(golden_load(argv[1], expected, &num_expected)))
+    {
+        HOST_TEST_CHECK(golden_compare(expected, num_expected, actual, num_actual, true) == 0U);
+    }
+
+    return host_test_result();
+}
@@ -0,0 +1,578 @@
+/*****************************************************************************
+ * File name: test_occupancy_store.c
+ *
+ * Description: This file contains the tests of the occupancy history on the
+ *   file backed flash: round trip over resets, ring wrap, CRC corruption,
+ *   power loss and the encoded size and query speed
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "flash_storage_file.h"
+#include "freertos_host.h"
+#include "host_test.h"
+#include "occupancy_store.h"
+
+#define BACKING_FILE            "test_occupancy_store.bin"
+
+/* Minutes kept by the model of the expected records */
+#define MAX_MINUTES             (20000U)
+
+/* Size of the segment header, a shorter programmed part never gives a valid segment */
+#define SEGMENT_HEADER_SIZE     (24U)
+
+/* Simulated frames per minute */
+#define FRAMES_PER_MINUTE       (60U)
+
+/* Longest time an empty room goes without a write of the minute index */
+#define IDLE_WRITE_MINUTES      (1440U)
+
+typedef struct
+{
+    uint32_t boot;
+    uint32_t boot_ms;       /* time since the boot, restarts at every reset */
+    uint32_t next_minute;   /* minute of the next simulated minute */
+    uint32_t num_records;
+    uint32_t seed;
+    occupancy_record_s records[MAX_MINUTES];
+} occupancy_model_s;
+
+static occupancy_model_s model;
+
+/*******************************************************************************
+ * Function Name: reboot
+ ****************************************************************************//**
+ *
+ * @brief Simulates a reset: the flash is reloaded from the file and the store
+ * continues the newest segment. The time since the boot starts again at zero.
+ *
+ *******************************************************************************/
+static void reboot(void)
+{
+    freertos_host_reset();
+    HOST_TEST_CHECK(flash_storage_init() == 0);
+    HOST_TEST_CHECK(occupancy_store_init() == 0);
+    model.boot_ms = 0U;
+}
+
+/*******************************************************************************
+ * Function Name: resume
+ ****************************************************************************//**
+ *
+ * @brief Updates the model after a reset. The boot number only counts up if
+ * the last boot stored records, and the minute index goes on after the last
+ * minute in flash, which is not before the last record.
+ *
+ *******************************************************************************/
+static void resume(void)
+{
+    uint32_t minute = occupancy_store_get_minute();
+
+    if ((model.num_records > 0U) && (model.records[model.num_records - 1U].boot == model.boot))
+    {
+        model.boot++;
+    }
+
+    HOST_TEST_CHECK(minute <= model.next_minute);
+    HOST_TEST_CHECK((model.num_records == 0U) || (minute > model.records[model.num_records - 1U].minute));
+    model.next_minute = minute;
+}
+
+/*******************************************************************************
+ * Function Name: count_stored
+ ****************************************************************************//**
+ *
+ * @return Number of records returned by a query of all minutes.
+ *
+ *******************************************************************************/
+static uint32_t count_stored(void)
+{
+    occupancy_store_cursor_s cursor;
+    occupancy_record_s record;
+    uint32_t num_stored = 0U;
+
+    occupancy_store_query_begin(&cursor, 0U, UINT32_MAX);
+    while (occupancy_store_query_next(&cursor, &record))
+    {
+        ++num_stored;
+    }
+
+    return num_stored;
+}
+
+/*******************************************************************************
+ * Function Name: erase
+ ****************************************************************************//**
+ *
+ * @brief Starts with an erased flash and an empty model.
+ *
+ *******************************************************************************/
+static void erase(void)
+{
+    HOST_TEST_CHECK(flash_storage_file_erase() == 0);
+    reboot();
+    model.boot = 0U;
+    model.next_minute = 0U;
+    model.num_records = 0U;
+    model.seed = 0x600DCAFEU;
+}
+
+/*******************************************************************************
+ * Function Name: simulate_minutes
+ ****************************************************************************//**
+ *
+ * @brief Feeds presence events and frames. A minute is empty, or a person
+ * enters at 15 s and leaves at 45 s, or enters at 30 s and leaves at 50 s, at
+ * a random range bin. The flush timer fires every ten minutes.
+ *
+ * @param num_minutes Number of simulated minutes.
+ *
+ *******************************************************************************/
+static void simulate_minutes(uint32_t num_minutes)
+{
+    for (uint32_t i = 0; i < num_minutes; ++i)
+    {
+        uint32_t pattern = host_test_random(&model.seed);
+        uint32_t start_ms = model.boot_ms;
+        xensiv_radar_presence_event_t enter = { 0U, XENSIV_RADAR_PRESENCE_STATE_MACRO_PRESENCE, 0 };
+        xensiv_radar_presence_event_t leave = { 0U, XENSIV_RADAR_PRESENCE_STATE_ABSENCE, 0 };
+
+        enter.range_bin = (int32_t)((pattern >> 8) % 8U);
+
+        if ((pattern % 3U) == 1U)
+        {
+            enter.timestamp = start_ms + 15000U;
+            leave.timestamp = start_ms + 45000U;
+        }
+        else if ((pattern % 3U) == 2U)
+        {
+            enter.timestamp = start_ms + 30000U;
+            leave.timestamp = start_ms + 50000U;
+        }
+
+        for (uint32_t frame = 0; frame < FRAMES_PER_MINUTE; ++frame)
+        {
+            uint32_t now_ms = start_ms + (frame * (OCCUPANCY_STORE_MINUTE_MS / FRAMES_PER_MINUTE));
+
+            if ((pattern % 3U) != 0U)
+            {
+                if (now_ms == enter.timestamp)
+                {
+                    occupancy_store_add_event(&enter);
+                }
+                if (now_ms == leave.timestamp)
+                {
+                    occupancy_store_add_event(&leave);
+                }
+            }
+            occupancy_store_update(now_ms);
+        }
+
+        if (((pattern % 3U) != 0U) && (model.num_records < MAX_MINUTES))
+        {
+            occupancy_record_s *record = &model.records[model.num_records++];
+
+            record->minute = model.next_minute;
+            record->boot = (uint16_t)model.boot;
+            record->occupancy = ((pattern % 3U) == 1U) ? 50U : 33U;
+            record->max_range_bin = enter.range_bin;
+            record->transitions = 2U;
+        }
+
+        model.boot_ms += OCCUPANCY_STORE_MINUTE_MS;
+        model.next_minute++;
+
+        if ((model.next_minute % 10U) == 0U)
+        {
+            (void)freertos_host_fire_timers();
+        }
+    }
+
+    /* closes the last minute */
+    occupancy_store_update(model.boot_ms);
+}
+
+/*******************************************************************************
+ * Function Name: simulate_empty_minutes
+ ****************************************************************************//**
+ *
+ * @brief Feeds frames of an empty room. The flush timer fires every ten
+ * minutes.
+ *
+ * @param num_minutes Number of simulated minutes.
+ *
+ *******************************************************************************/
+static void simulate_empty_minutes(uint32_t num_minutes)
+{
+    for (uint32_t i = 0; i < num_minutes; ++i)
+    {
+        for (uint32_t frame = 0; frame < FRAMES_PER_MINUTE; ++frame)
+        {
+            occupancy_store_update(model.boot_ms + (frame * (OCCUPANCY_STORE_MINUTE_MS / FRAMES_PER_MINUTE)));
+        }
+
+        model.boot_ms += OCCUPANCY_STORE_MINUTE_MS;
+        model.next_minute++;
+
+        if ((model.next_minute % 10U) == 0U)
+        {
+            (void)freertos_host_fire_timers();
+        }
+    }
+
+    occupancy_store_update(model.boot_ms);
+}
+
+/*******************************************************************************
+ * Function Name: check_query
+ ****************************************************************************//**
+ *
+ * @brief Compares a range query with the records of the model in the range.
+ *
+ * @param first_minute First minute of the range.
+ * @param last_minute Last minute of the range.
+ * @param first_kept First minute still stored, older ones were overwritten.
+ *
+ * @return Number of returned records.
+ *
+ *******************************************************************************/
+static uint32_t check_query(uint32_t first_minute, uint32_t last_minute, uint32_t first_kept)
+{
+    occupancy_store_cursor_s cursor;
+    occupancy_record_s record;
+    uint32_t index = 0;
+    uint32_t num_returned = 0;
+    bool equal = true;
+
+    occupancy_store_query_begin(&cursor, first_minute, last_minute);
+
+    while (occupancy_store_query_next(&cursor, &record))
+    {
+        const occupancy_record_s *expected;
+
+        while ((index < model.num_records) &&
+               ((model.records[index].minute < first_minute) || (model.records[index].minute < first_kept)))
+        {
+            ++index;
+        }
+
+        if (index >= model.num_records)
+        {
+            equal = false;
+            break;
+        }
+
+        expected = &model.records[index++];
+        equal = equal && (record.minute == expected->minute) && (record.boot == expected->boot) &&
+                (record.occupancy == expected->occupancy) && (record.max_range_bin == expected->max_range_bin) &&
+                (record.transitions == expected->transitions);
+        ++num_returned;
+    }
+
+    /* no record of the range is missing at the end */
+    while ((index < model.num_records) &&
+           ((model.records[index].minute < first_minute) || (model.records[index].minute < first_kept)))
+    {
+        ++index;
+    }
+
+    HOST_TEST_CHECK(equal);
+    HOST_TEST_CHECK((index >= model.num_records) || (model.records[index].minute > last_minute));
+
+    return num_returned;
+}
+
+/*******************************************************************************
+ * Function Name: test_round_trip
+ ****************************************************************************//**
+ *
+ * @brief Checks the records of several resets, the minutes continue over a
+ * reset and the boot number counts up.
+ *
+ *******************************************************************************/
+static void test_round_trip(void)
+{
+    erase();
+
+    for (uint32_t boot = 0; boot < 4U; ++boot)
+    {
+        simulate_minutes(100U);
+        HOST_TEST_CHECK(occupancy_store_flush() == 0);
+        HOST_TEST_CHECK(check_query(0U, UINT32_MAX, 0U) == model.num_records);
+
+        reboot();
+        resume();
+        HOST_TEST_CHECK(check_query(0U, UINT32_MAX, 0U) == model.num_records);
+    }
+
+    /* sub ranges */
+    (void)check_query(50U, 149U, 0U);
+    (void)check_query(399U, 399U, 0U);
+    HOST_TEST_CHECK(check_query(1000U, 2000U, 0U) == 0U);
+}
+
+/*******************************************************************************
+ * Function Name: test_wrap
+ ****************************************************************************//**
+ *
+ * @brief Fills more segments than rows. The oldest segments are dropped, the
+ * newer ones are returned completely. Prints the encoded size and the query
+ * speed.
+ *
+ *******************************************************************************/
+static void test_wrap(void)
+{
+    occupancy_store_cursor_s cursor;
+    occupancy_record_s record;
+    uint32_t first_kept;
+    uint32_t num_returned = 0;
+    uint32_t num_queries = 0;
+    double start;
+    double elapsed;
+
+    erase();
+    simulate_minutes(MAX_MINUTES);
+    HOST_TEST_CHECK(occupancy_store_flush() == 0);
+
+    occupancy_store_query_begin(&cursor, 0U, UINT32_MAX);
+    HOST_TEST_CHECK(occupancy_store_query_next(&cursor, &record));
+    first_kept = record.minute;
+    HOST_TEST_CHECK(first_kept > 0U);
+    num_returned = check_query(0U, UINT32_MAX, first_kept);
+
+    printf("%u of %u records kept in %u bytes, %.2f bytes per record\n", num_returned, model.num_records,
+           FLASH_STORAGE_OCCUPANCY_ROWS * FLASH_STORAGE_ROW_SIZE,
+           (double)(FLASH_STORAGE_OCCUPANCY_ROWS * FLASH_STORAGE_ROW_SIZE) / num_returned);
+
+    start = host_test_time_s();
+    do
+    {
+        occupancy_store_query_begin(&cursor, 0U, UINT32_MAX);
+        while (occupancy_store_query_next(&cursor, &record))
+        {
+        }
+        ++num_queries;
+        elapsed = host_test_time_s() - start;
+    } while (elapsed < 0.2);
+    printf("full range query: %.1f M records/s\n", (double)num_queries * num_returned / elapsed * 1E-6);
+}
+
+/*******************************************************************************
+ * Function Name: test_corruption
+ ****************************************************************************//**
+ *
+ * @brief Corrupts a byte of a full segment in flash. The query skips that
+ * segment and returns all records of the others.
+ *
+ *******************************************************************************/
+static void test_corruption(void)
+{
+    uint32_t num_records;
+    uint32_t num_returned;
+
+    erase();
+    simulate_minutes(1000U);
+    HOST_TEST_CHECK(occupancy_store_flush() == 0);
+    reboot();
+    num_records = check_query(0U, UINT32_MAX, 0U);
+    HOST_TEST_CHECK(num_records == model.num_records);
+
+    /* a payload byte of the second segment, the queries read it from flash */
+    flash_storage_file_corrupt(FLASH_STORAGE_OCCUPANCY, FLASH_STORAGE_ROW_SIZE + 100U);
+
+    {
+        occupancy_store_cursor_s cursor;
+        occupancy_record_s record;
+        uint32_t previous = 0;
+        bool ordered = true;
+
+        num_returned = 0;
+        occupancy_store_query_begin(&cursor, 0U, UINT32_MAX);
+        while (occupancy_store_query_next(&cursor, &record))
+        {
+            ordered = ordered && ((num_returned == 0U) || (record.minute > previous));
+            previous = record.minute;
+            ++num_returned;
+        }
+        HOST_TEST_CHECK(ordered);
+    }
+
+    HOST_TEST_CHECK((num_returned < num_records) && (num_returned > (num_records / 2U)));
+
+    /* a corrupted segment is not the newest one after the next reset */
+    reboot();
+    resume();
+}
+
+/*******************************************************************************
+ * Function Name: test_reboots
+ ****************************************************************************//**
+ *
+ * @brief Resets the device three times as often as there are rows, after a
+ * few minutes or right after the boot. The boots share the rows, so no
+ * record is dropped, and every record keeps the number of its boot.
+ *
+ *******************************************************************************/
+static void test_reboots(void)
+{
+    uint32_t first_writes;
+
+    erase();
+    first_writes = flash_storage_file_get_num_row_writes();
+
+    for (uint32_t boot = 0; boot < (3U * FLASH_STORAGE_OCCUPANCY_ROWS); ++boot)
+    {
+        if ((boot % 4U) != 3U)
+        {
+            simulate_minutes(3U);
+        }
+        HOST_TEST_CHECK(occupancy_store_flush() == 0);
+        reboot();
+        resume();
+    }
+
+    HOST_TEST_CHECK(check_query(0U, UINT32_MAX, 0U) == model.num_records);
+    printf("%u boots, %u records, %u row writes\n", 3U * FLASH_STORAGE_OCCUPANCY_ROWS, model.num_records,
+           flash_storage_file_get_num_row_writes() - first_writes);
+}
+
+/*******************************************************************************
+ * Function Name: test_idle_wear
+ ****************************************************************************//**
+ *
+ * @brief Runs an empty room for three days. Without records the open segment
+ * is only rewritten once a day to keep the minute index, and a reset goes on
+ * less than a day before the last minute.
+ *
+ *******************************************************************************/
+static void test_idle_wear(void)
+{
+    uint32_t writes;
+    uint32_t minute;
+
+    erase();
+    simulate_minutes(30U);
+    HOST_TEST_CHECK(occupancy_store_flush() == 0);
+
+    writes = flash_storage_file_get_num_row_writes();
+    simulate_empty_minutes(3U * IDLE_WRITE_MINUTES);
+    HOST_TEST_CHECK((flash_storage_file_get_num_row_writes() - writes) <= 3U);
+
+    minute = model.next_minute;
+    reboot();
+    resume();
+    HOST_TEST_CHECK((minute - model.next_minute) <= IDLE_WRITE_MINUTES);
+    HOST_TEST_CHECK(check_query(0U, UINT32_MAX, 0U) == model.num_records);
+}
+
+/*******************************************************************************
+ * Function Name: test_power_loss
+ ****************************************************************************//**
+ *
+ * @brief Loses the power at several bytes of a rewrite of the open segment,
+ * once for a write to its own row and once for a write to the shadow row.
+ * After the reset the store holds either the new copy or the previous one
+ * in the other row, so only the minutes since the last completed write can
+ * be lost. The history goes on after the kept copy.
+ *
+ *******************************************************************************/
+static void test_power_loss(void)
+{
+    for (uint32_t num_bytes = 0; num_bytes <= FLASH_STORAGE_ROW_SIZE; num_bytes += 16U)
+    {
+        for (uint32_t num_writes = 1U; num_writes <= 2U; ++num_writes)
+        {
+            uint32_t num_written;
+            uint32_t num_stored;
+
+            erase();
+            simulate_minutes(300U);
+            HOST_TEST_CHECK(occupancy_store_flush() == 0);
+            reboot();
+            resume();
+
+            /* the open segment is written once or twice, then interrupted at its next write */
+            for (uint32_t i = 0; i < num_writes; ++i)
+            {
+                simulate_minutes(5U);
+                HOST_TEST_CHECK(occupancy_store_flush() == 0);
+            }
+            num_written = model.num_records;
+            simulate_minutes(3U);
+            HOST_TEST_CHECK(model.num_records > num_written);
+            flash_storage_file_cut_power(num_bytes);
+            HOST_TEST_CHECK(occupancy_store_flush() != 0);
+
+            reboot();
+            num_stored = count_stored();
+
+            if (num_stored != model.num_records)
+            {
+                HOST_TEST_CHECK(num_bytes < FLASH_STORAGE_ROW_SIZE);
+                HOST_TEST_CHECK(num_stored == num_written);
+                model.num_records = num_written;
+            }
+            else
+            {
+                /* the used part of the row was programmed */
+                HOST_TEST_CHECK(num_bytes > SEGMENT_HEADER_SIZE);
+            }
+            resume();
+            HOST_TEST_CHECK(check_query(0U, UINT32_MAX, 0U) == model.num_records);
+
+            /* the history goes on */
+            simulate_minutes(20U);
+            HOST_TEST_CHECK(occupancy_store_flush() == 0);
+            reboot();
+            resume();
+            HOST_TEST_CHECK(check_query(0U, UINT32_MAX, 0U) == model.num_records);
+        }
+    }
+}
+
+int main(void)
+{
+    flash_storage_file_set_path(BACKING_FILE);
+
+    test_round_trip();
+    test_wrap();
+    test_corruption();
+    test_reboots();
+    test_idle_wear();
+    test_power_loss();
+
+    return host_test_result();
+}
@@ -0,0 +1,335 @@
+/*****************************************************************************
+ * File name: test_presence_cfar.c
+ *
+ * Description: This file contains the host test of the CFAR detector. It
+ *   replays the selftest scenarios in the CA and the OS mode and reports
+ *   their false alarms, and checks the auto thresholds on noise of known
+ *   statistics.
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "host_test.h"
+#include "presence_cfar.h"
+#include "radar_rx_processing.h"
+#include "radar_scene_sim.h"
+#include "range_gate.h"
+#include "selftest_scenarios.h"
+
+#define CFAR_TEST_FRAME_PERIOD_MS   (100U)
+#define CFAR_TEST_NUM_BINS          (64U)
+#define CFAR_TEST_MAX_SAMPLES       (RADAR_RX_MAX_ANTENNAS * 16U * 128U)
+
+/* Swing of a person which is macro motion, the selftest people breathe 2 mm */
+#define CFAR_TEST_MACRO_SWING_M     (0.01f)
+
+/* Detected range bins per bin and frame of absence */
+#define CFAR_TEST_MAX_FALSE_ALARM_RATE  (0.01f)
+
+/* Noise of the auto threshold test: bins and standard deviation of a component, one bin is noisier
+ * but stays below CFAR_SCALE, a bin which is detected does not learn its noise */
+#define AUTO_NUM_BINS               (32)
+#define AUTO_NOISE_SIGMA            (0.01f)
+#define AUTO_NOISY_BIN              (20)
+#define AUTO_NOISY_SCALE            (2.0f)
+#define AUTO_MICRO_MEAN             (3.0f)
+#define AUTO_MICRO_SPREAD           (2.0f)
+
+/* Relative error of the thresholds estimated with the exponential weights of the detector */
+#define AUTO_TOLERANCE              (0.25f)
+
+/*
+ * Detections of one replay
+ * absence_frames - frames labelled absent
+ * false_alarms - detected range bins in these frames
+ * moving_frames - frames while the person walks or moves
+ * moving_detected - of these, frames with at least one detection
+ */
+typedef struct
+{
+    uint32_t absence_frames;
+    uint32_t false_alarms;
+    uint32_t moving_frames;
+    uint32_t moving_detected;
+} cfar_replay_s;
+
+static uint16_t fifo_data[CFAR_TEST_MAX_SAMPLES];
+static float32_t planar[CFAR_TEST_MAX_SAMPLES];
+static float32_t avg_chirps[RADAR_RX_MAX_ANTENNAS * RADAR_RX_MAX_SAMPLES];
+static float32_t chirp[RADAR_RX_MAX_SAMPLES];
+static cfloat32_t macro_fft[CFAR_TEST_NUM_BINS];
+static radar_scene_sim_s sim;
+static radar_rx_combiner_s combiner;
+static presence_cfar_s cfar;
+static arm_rfft_fast_instance_f32 rfft;
+
+/*******************************************************************************
+ * Function Name: cfar_replay
+ ****************************************************************************//**
+ *
+ * @brief Replays a scenario through the FIFO unpacking, the chirp averaging
+ * and the antenna combination. The range spectrum without DC is the macro FFT
+ * buffer of the detector, and the presence state is taken from the scenario,
+ * as the presence library does not run on the host.
+ *
+ * @param scenario Scenario.
+ * @param mode CFAR mode.
+ * @param result Detections of the replay.
+ *
+ *******************************************************************************/
+static void cfar_replay(const selftest_scenario_s *scenario, presence_cfar_mode_e mode, cfar_replay_s *result)
+{
+    uint32_t num_rx;
+    uint32_t num_samples;
+    uint32_t samples_per_antenna;
+    range_gate_s gate;
+    uint32_t frame = 0U;
+
+    memset(result, 0, sizeof(*result));
+    radar_scene_sim_init(&sim, SELFTEST_SEED);
+    sim.params.frame_repetition_time_s = (float32_t)CFAR_TEST_FRAME_PERIOD_MS / 1000.0f;
+    num_rx = sim.params.num_rx_antennas;
+    num_samples = sim.params.num_samples_per_chirp;
+    samples_per_antenna = sim.params.num_chirps_per_frame * num_samples;
+
+    HOST_TEST_CHECK((samples_per_antenna * num_rx) <= CFAR_TEST_MAX_SAMPLES);
+    HOST_TEST_CHECK(num_samples == (2U * CFAR_TEST_NUM_BINS));
+    HOST_TEST_CHECK(radar_rx_combiner_init(&combiner, num_rx, num_samples) == 0);
+    HOST_TEST_CHECK(presence_cfar_init(&cfar, (int32_t)CFAR_TEST_NUM_BINS) == 0);
+    presence_cfar_set_mode(mode);
+    range_gate_compute(&gate, (int32_t)CFAR_TEST_NUM_BINS, 0, (int32_t)CFAR_TEST_NUM_BINS - 1, false);
+
+    for (uint32_t i = 0U; i < scenario->num_segments; i++)
+    {
+        const selftest_segment_s *segment = &scenario->segments[i];
+        bool occupied = (segment->num_targets > 1U);
+        bool moving = occupied && ((segment->targets[1].velocity_mps != 0.0f) ||
+                                   (segment->targets[1].breathing_m > CFAR_TEST_MACRO_SWING_M));
+        xensiv_radar_presence_state_t state = !occupied ? XENSIV_RADAR_PRESENCE_STATE_ABSENCE :
+                                              (moving ? XENSIV_RADAR_PRESENCE_STATE_MACRO_PRESENCE :
+                                                        XENSIV_RADAR_PRESENCE_STATE_MICRO_PRESENCE);
+
+        (void)radar_scene_sim_set_targets(&sim, segment->targets, segment->num_targets);
+
+        for (uint32_t n = 0U; n < segment->num_frames; n++, frame++)
+        {
+            uint32_t detected;
+
+            radar_scene_sim_frame(&sim, (uint8_t *)fifo_data);
+            radar_rx_unpack_fifo((const uint8_t *)fifo_data, fifo_data, samples_per_antenna * num_rx);
+            radar_rx_deinterleave(fifo_data, planar, num_rx, samples_per_antenna);
+            radar_rx_average_chirps(planar, avg_chirps, num_rx, sim.params.num_chirps_per_frame, num_samples);
+            radar_rx_combine(&combiner, avg_chirps, chirp, frame * CFAR_TEST_FRAME_PERIOD_MS);
+
+            arm_rfft_fast_f32(&rfft, chirp, (float32_t *)macro_fft, 0U);
+            macro_fft[0].real = 0.0f;
+            macro_fft[0].imag = 0.0f;
+
+            detected = presence_cfar_process(&cfar, macro_fft, &gate, state, 0.0f);
+
+            if (moving)
+            {
+                result->moving_frames++;
+                result->moving_detected += (detected > 0U) ? 1U : 0U;
+            }
+        }
+    }
+
+    result->absence_frames = presence_cfar_get_stats(&cfar)->absence_frames;
+    result->false_alarms = presence_cfar_get_stats(&cfar)->false_alarms;
+}
+
+/*******************************************************************************
+ * Function Name: test_false_alarms
+ ****************************************************************************//**
+ *
+ * @brief Reports the false alarms of the CA and the OS mode on the selftest
+ * scenarios. Both modes must keep the false alarm rate of the absence frames
+ * low and detect the moving person.
+ *
+ *******************************************************************************/
+static void test_false_alarms(void)
+{
+    static const char * const mode_names[] = { [CFAR_MODE_CA] = "ca", [CFAR_MODE_OS] = "os" };
+    uint32_t num_scenarios;
+    const selftest_scenario_s *scenarios = selftest_scenarios_get(&num_scenarios);
+
+    HOST_TEST_CHECK(arm_rfft_fast_init_f32(&rfft, 2U * CFAR_TEST_NUM_BINS) == ARM_MATH_SUCCESS);
+
+    for (uint32_t s = 0U; s < num_scenarios; s++)
+    {
+        for (uint32_t mode = (uint32_t)CFAR_MODE_CA; mode <= (uint32_t)CFAR_MODE_OS; mode++)
+        {
+            cfar_replay_s result;
+            float32_t rate;
+
+            cfar_replay(&scenarios[s], (presence_cfar_mode_e)mode, &result);
+            rate = (float32_t)result.false_alarms /
+                   ((float32_t)result.absence_frames * (float32_t)CFAR_TEST_NUM_BINS);
+
+            printf("%-14s %s: %u false alarms in %u absence frames (%.5f per bin), moving person detected in %u of %u frames\n",
+                   scenarios[s].name, mode_names[mode], (unsigned int)result.false_alarms,
+                   (unsigned int)result.absence_frames, (double)rate,
+                   (unsigned int)result.moving_detected, (unsigned int)result.moving_frames);
+
+            HOST_TEST_CHECK(result.absence_frames > 0U);
+            HOST_TEST_CHECK(rate <= CFAR_TEST_MAX_FALSE_ALARM_RATE);
+            HOST_TEST_CHECK((result.moving_frames == 0U) || (result.moving_detected > 0U));
+        }
+    }
+
+    presence_cfar_set_mode(CFAR_MODE_CA);
+}
+
+/*******************************************************************************
+ * Function Name: auto_noise
+ ****************************************************************************//**
+ *
+ * @param seed Random state.
+ *
+ * @return Approximately normal noise with unit variance.
+ *
+ *******************************************************************************/
+static float32_t auto_noise(uint32_t *seed)
+{
+    float32_t sum = 0.0f;
+
+    /* the sum of 12 uniform numbers has unit variance */
+    for (uint32_t i = 0U; i < 12U; i++)
+    {
+        sum += (float32_t)host_test_random(seed) / 4294967296.0f;
+    }
+
+    return sum - 6.0f;
+}
+
+/*******************************************************************************
+ * Function Name: auto_frames
+ ****************************************************************************//**
+ *
+ * @brief Runs frames of complex noise with AUTO_NOISE_SIGMA per component,
+ * AUTO_NOISY_SCALE times more in AUTO_NOISY_BIN, and a uniform micro energy.
+ *
+ * @param num_frames Number of frames.
+ * @param state Presence state of the frames.
+ * @param seed Random state.
+ *
+ *******************************************************************************/
+static void auto_frames(uint32_t num_frames, xensiv_radar_presence_state_t state, uint32_t *seed)
+{
+    range_gate_s gate;
+
+    range_gate_compute(&gate, AUTO_NUM_BINS, 0, AUTO_NUM_BINS - 1, false);
+
+    for (uint32_t frame = 0U; frame < num_frames; frame++)
+    {
+        float32_t micro = AUTO_MICRO_MEAN +
+                          (AUTO_MICRO_SPREAD * (((float32_t)host_test_random(seed) / 4294967296.0f) - 0.5f));
+
+        for (int32_t bin = 0; bin < AUTO_NUM_BINS; bin++)
+        {
+            float32_t sigma = (bin == AUTO_NOISY_BIN) ? (AUTO_NOISY_SCALE * AUTO_NOISE_SIGMA) : AUTO_NOISE_SIGMA;
+
+            macro_fft[bin].real = sigma * auto_noise(seed);
+            macro_fft[bin].imag = sigma * auto_noise(seed);
+        }
+
+        (void)presence_cfar_process(&cfar, macro_fft, &gate, state, micro);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: test_auto_thresholds
+ ****************************************************************************//**
+ *
+ * @brief The auto thresholds need CFAR_AUTO_MIN_FRAMES frames of absence.
+ * The macro threshold is the mean plus CFAR_AUTO_SIGMA standard deviations of
+ * the frame to frame change of the noisiest bin of the detection range, and
+ * the micro threshold the same of the micro energy.
+ *
+ *******************************************************************************/
+static void test_auto_thresholds(void)
+{
+    /* the change of complex normal noise is Rayleigh distributed */
+    const float32_t change_mean = AUTO_NOISE_SIGMA * sqrtf(PI);
+    const float32_t change_sigma = AUTO_NOISE_SIGMA * sqrtf(4.0f - PI);
+    const float32_t macro_expected = change_mean + (CFAR_AUTO_SIGMA * change_sigma);
+    const float32_t micro_expected = AUTO_MICRO_MEAN + (CFAR_AUTO_SIGMA * AUTO_MICRO_SPREAD / sqrtf(12.0f));
+    uint32_t seed = 0xCFA2CFA2U;
+    float32_t macro;
+    float32_t micro;
+    float32_t noisy_macro;
+    float32_t clamped_macro;
+
+    presence_cfar_set_mode(CFAR_MODE_CA);
+    HOST_TEST_CHECK(presence_cfar_init(&cfar, AUTO_NUM_BINS) == 0);
+
+    /* presence is not noise */
+    auto_frames(2U * CFAR_AUTO_MIN_FRAMES, XENSIV_RADAR_PRESENCE_STATE_MACRO_PRESENCE, &seed);
+    HOST_TEST_CHECK(!presence_cfar_get_auto_thresholds(&cfar, 1, 10, &macro, &micro));
+
+    auto_frames(CFAR_AUTO_MIN_FRAMES - 1U, XENSIV_RADAR_PRESENCE_STATE_ABSENCE, &seed);
+    HOST_TEST_CHECK(!presence_cfar_get_auto_thresholds(&cfar, 1, 10, &macro, &micro));
+
+    auto_frames(1U, XENSIV_RADAR_PRESENCE_STATE_ABSENCE, &seed);
+    HOST_TEST_CHECK(presence_cfar_get_auto_thresholds(&cfar, 1, 10, &macro, &micro));
+
+    /* the statistics settle with the weight of CFAR_NOISE_ALPHA */
+    auto_frames(4U * CFAR_AUTO_MIN_FRAMES, XENSIV_RADAR_PRESENCE_STATE_ABSENCE, &seed);
+    HOST_TEST_CHECK(presence_cfar_get_auto_thresholds(&cfar, 1, 10, &macro, &micro));
+    HOST_TEST_CHECK(presence_cfar_get_auto_thresholds(&cfar, 15, 25, &noisy_macro, &micro));
+    HOST_TEST_CHECK(presence_cfar_get_auto_thresholds(&cfar, -5, 1000, &clamped_macro, &micro));
+
+    printf("auto thresholds: macro %.4f (expected %.4f), with the noisy bin %.4f, micro %.3f (expected %.3f)\n",
+           (double)macro, (double)macro_expected, (double)noisy_macro, (double)micro, (double)micro_expected);
+
+    HOST_TEST_CHECK(fabsf(macro - macro_expected) <= (AUTO_TOLERANCE * macro_expected));
+    HOST_TEST_CHECK(fabsf(micro - micro_expected) <= (AUTO_TOLERANCE * micro_expected));
+
+    /* only the bins of the detection range count, a range beyond the bins is clamped */
+    HOST_TEST_CHECK(fabsf(noisy_macro - (AUTO_NOISY_SCALE * macro_expected)) <=
+                    (AUTO_TOLERANCE * AUTO_NOISY_SCALE * macro_expected));
+    HOST_TEST_CHECK(clamped_macro == noisy_macro);
+}
+
+int main(void)
+{
+    test_auto_thresholds();
+    test_false_alarms();
+
+    return host_test_result();
+}
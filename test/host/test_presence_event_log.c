@@ -0,0 +1,224 @@
+/*****************************************************************************
+ * File name: test_presence_event_log.c
+ *
+ * Description: This file contains the host test of the presence event log.
+ *   It checks the window queries against hand computed aggregates, the
+ *   wrap of the ring and of the timestamps.
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+
+#include "host_test.h"
+#include "presence_event_log.h"
+
+#define MACRO       (XENSIV_RADAR_PRESENCE_STATE_MACRO_PRESENCE)
+#define MICRO       (XENSIV_RADAR_PRESENCE_STATE_MICRO_PRESENCE)
+#define ABSENCE     (XENSIV_RADAR_PRESENCE_STATE_ABSENCE)
+
+/* Events of the window tests, the last presence period is still going on */
+typedef struct
+{
+    uint32_t timestamp;
+    xensiv_radar_presence_state_t state;
+} log_event_s;
+
+static const log_event_s events[] =
+{
+    { 0U, MACRO },
+    { 10000U, ABSENCE },
+    { 20000U, MICRO },
+    { 50000U, ABSENCE },
+    { 60000U, MACRO }
+};
+
+/*
+ * Expected aggregates of a window ending at 70 s
+ */
+typedef struct
+{
+    uint32_t window_ms;
+    presence_event_log_stats_s stats;
+} log_window_s;
+
+static const log_window_s windows[] =
+{
+    /* the whole log */
+    { 70000U, { 70000U, 20000U, 30000U, 5U, 3U, 3U, 16666U, 30000U } },
+    /* longer than the log */
+    { 1000000U, { 70000U, 20000U, 30000U, 5U, 3U, 3U, 16666U, 30000U } },
+    /* the micro period is clipped at the window start */
+    { 35000U, { 35000U, 10000U, 15000U, 2U, 1U, 2U, 12500U, 15000U } },
+    /* the start on an event counts the event */
+    { 50000U, { 50000U, 10000U, 30000U, 3U, 2U, 2U, 20000U, 30000U } },
+    /* only the ongoing period, started before the window */
+    { 5000U, { 5000U, 5000U, 0U, 0U, 0U, 1U, 5000U, 5000U } },
+    { 0U, { 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U } }
+};
+
+/*******************************************************************************
+ * Function Name: log_add
+ ****************************************************************************//**
+ *
+ * @brief Appends an event.
+ *
+ *******************************************************************************/
+static void log_add(uint32_t timestamp, xensiv_radar_presence_state_t state)
+{
+    xensiv_radar_presence_event_t event = { timestamp, state, 3 };
+
+    presence_event_log_add(&event);
+}
+
+/*******************************************************************************
+ * Function Name: check_stats
+ ****************************************************************************//**
+ *
+ * @brief Compares the aggregates field by field, so a failure names the field.
+ *
+ *******************************************************************************/
+static void check_stats(const presence_event_log_stats_s *actual, const presence_event_log_stats_s *expected)
+{
+    HOST_TEST_CHECK(actual->covered_ms == expected->covered_ms);
+    HOST_TEST_CHECK(actual->macro_ms == expected->macro_ms);
+    HOST_TEST_CHECK(actual->micro_ms == expected->micro_ms);
+    HOST_TEST_CHECK(actual->transitions == expected->transitions);
+    HOST_TEST_CHECK(actual->entries == expected->entries);
+    HOST_TEST_CHECK(actual->dwell_count == expected->dwell_count);
+    HOST_TEST_CHECK(actual->dwell_mean_ms == expected->dwell_mean_ms);
+    HOST_TEST_CHECK(actual->dwell_max_ms == expected->dwell_max_ms);
+}
+
+/*******************************************************************************
+ * Function Name: test_windows
+ ****************************************************************************//**
+ *
+ * @brief Windows of different length over the same events, also with the
+ * timestamps wrapping around in the middle of the log.
+ *
+ *******************************************************************************/
+static void test_windows(void)
+{
+    static const uint32_t offsets[] = { 0U, 0xFFFFFFFFU - 30000U };
+    presence_event_log_stats_s stats;
+
+    for (uint32_t o = 0U; o < (sizeof(offsets) / sizeof(offsets[0])); o++)
+    {
+        presence_event_log_init();
+        presence_event_log_query(offsets[o], 1000U, &stats);
+        HOST_TEST_CHECK((stats.covered_ms == 0U) && (stats.transitions == 0U) && (stats.dwell_count == 0U));
+
+        for (uint32_t i = 0U; i < (sizeof(events) / sizeof(events[0])); i++)
+        {
+            log_add(offsets[o] + events[i].timestamp, events[i].state);
+        }
+
+        for (uint32_t w = 0U; w < (sizeof(windows) / sizeof(windows[0])); w++)
+        {
+            presence_event_log_query(offsets[o] + 70000U, windows[w].window_ms, &stats);
+            check_stats(&stats, &windows[w].stats);
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function Name: test_macro_micro_period
+ ****************************************************************************//**
+ *
+ * @brief Macro and micro presence without absence in between are one period.
+ *
+ *******************************************************************************/
+static void test_macro_micro_period(void)
+{
+    static const presence_event_log_stats_s expected = { 6000U, 1000U, 4000U, 3U, 1U, 1U, 5000U, 5000U };
+    presence_event_log_stats_s stats;
+
+    presence_event_log_init();
+    log_add(1000U, MACRO);
+    log_add(2000U, MICRO);
+    log_add(6000U, ABSENCE);
+
+    presence_event_log_query(7000U, 10000U, &stats);
+    check_stats(&stats, &expected);
+}
+
+/*******************************************************************************
+ * Function Name: test_ring_wrap
+ ****************************************************************************//**
+ *
+ * @brief The ring keeps the newest EVENT_LOG_SIZE events with their
+ * timestamps, and the queries only cover the time of the kept events.
+ *
+ *******************************************************************************/
+static void test_ring_wrap(void)
+{
+    /* 1 s of macro presence every 2 s, the first 44 events are overwritten */
+    static const presence_event_log_stats_s expected_all =
+    { 256000U, 128000U, 0U, EVENT_LOG_SIZE, 128U, 128U, 1000U, 1000U };
+    static const presence_event_log_stats_s expected_last =
+    { 100500U, 50000U, 0U, 100U, 50U, 50U, 1000U, 1000U };
+    const uint32_t num_events = EVENT_LOG_SIZE + 44U;
+    xensiv_radar_presence_event_t event;
+    presence_event_log_stats_s stats;
+
+    presence_event_log_init();
+    for (uint32_t i = 0U; i < num_events; i++)
+    {
+        log_add(i * 1000U, ((i % 2U) == 0U) ? MACRO : ABSENCE);
+    }
+
+    HOST_TEST_CHECK(presence_event_log_get_count() == EVENT_LOG_SIZE);
+    HOST_TEST_CHECK(presence_event_log_get(EVENT_LOG_SIZE, &event) == -1);
+    HOST_TEST_CHECK(presence_event_log_get(0U, &event) == 0);
+    HOST_TEST_CHECK((event.timestamp == 299000U) && (event.state == ABSENCE) && (event.range_bin == 3));
+    HOST_TEST_CHECK(presence_event_log_get(EVENT_LOG_SIZE - 1U, &event) == 0);
+    HOST_TEST_CHECK((event.timestamp == 44000U) && (event.state == MACRO));
+
+    /* the log only covers the time since the oldest kept event */
+    presence_event_log_query(300000U, 1000000U, &stats);
+    check_stats(&stats, &expected_all);
+
+    /* a window inside the kept events */
+    presence_event_log_query(300000U, 100500U, &stats);
+    check_stats(&stats, &expected_last);
+}
+
+int main(void)
+{
+    test_windows();
+    test_macro_micro_period();
+    test_ring_wrap();
+
+    return host_test_result();
+}
@@ -0,0 +1,342 @@
+/*****************************************************************************
+ * File name: test_radar_aoa.c
+ *
+ * Description: This file contains the host test of the angle of arrival
+ *   estimation. Frames of the scene simulator with static clutter and a
+ *   person at a known azimuth and elevation run through the multi-antenna
+ *   path of the firmware.
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "host_test.h"
+#include "radar_aoa.h"
+#include "radar_rx_processing.h"
+#include "radar_scene_sim.h"
+
+/* Chirp bandwidth of the sensor configuration and a macro bin length which
+ * differs from the bin length of the chirp FFT, so the mapping is exercised */
+#define BANDWIDTH_HZ            (460E6f)
+#define MACRO_BIN_LENGTH_M      (0.2f)
+#define NUM_MACRO_BINS          (30)
+
+#define NUM_RX                  (3U)
+#define FRAME_PERIOD_MS         (100U)
+
+/* Frames of the empty scene, then frames with the person */
+#define NUM_LEARN_FRAMES        (30U)
+#define NUM_PERSON_FRAMES       (10U)
+
+#define PERSON_RANGE_M          (1.5f)
+#define PERSON_AMPLITUDE        (800.0f)
+#define MAX_ANGLE_ERROR_DEG     (2.0f)
+
+/*
+ * @def struct aoa_case_s
+ * Scene of one case
+ * azimuth_deg, elevation_deg - angles of the person
+ * clutter - static reflectors of the room
+ * num_clutter - number of reflectors
+ */
+typedef struct
+{
+    float32_t azimuth_deg;
+    float32_t elevation_deg;
+    const radar_scene_sim_target_s *clutter;
+    uint32_t num_clutter;
+} aoa_case_s;
+
+/* range, velocity, breathing displacement and rate, azimuth, amplitude, elevation */
+static const radar_scene_sim_target_s cabinet[] =
+{
+    { 2.2f, 0.0f, 0.0f, 0.0f, 30.0f, 1500.0f, 0.0f }
+};
+
+/* a reflector in the range bin of the person, twice as strong and from another direction */
+static const radar_scene_sim_target_s chair[] =
+{
+    { 2.2f, 0.0f, 0.0f, 0.0f, 30.0f, 1500.0f, 0.0f },
+    { 1.55f, 0.0f, 0.0f, 0.0f, -35.0f, 1600.0f, 20.0f }
+};
+
+static const aoa_case_s cases[] =
+{
+    { 0.0f, 0.0f, cabinet, 1U },
+    { -40.0f, 10.0f, cabinet, 1U },
+    { 25.0f, -15.0f, cabinet, 1U },
+    { 50.0f, 30.0f, chair, 2U },
+    { -15.0f, -35.0f, chair, 2U },
+    { 10.0f, 5.0f, chair, 2U }
+};
+
+/* Multi-antenna path of the acquisition task */
+typedef struct
+{
+    radar_scene_sim_s sim;
+    uint16_t *fifo;
+    float32_t *planar;
+    float32_t avg_chirps[NUM_RX * AOA_MAX_NUM_SAMPLES];
+    uint32_t time_ms;
+} aoa_path_s;
+
+/*******************************************************************************
+ * Function Name: path_init
+ ****************************************************************************//**
+ *
+ * @brief Sets up a simulator with three receivers and the frame buffers.
+ *
+ * @param path Frame path.
+ * @param seed Noise seed of the simulator.
+ *
+ *******************************************************************************/
+static void path_init(aoa_path_s *path, uint32_t seed)
+{
+    uint32_t num_samples;
+
+    radar_scene_sim_init(&path->sim, seed);
+    path->sim.params.num_rx_antennas = NUM_RX;
+    num_samples = path->sim.params.num_chirps_per_frame * path->sim.params.num_samples_per_chirp * NUM_RX;
+
+    path->fifo = malloc(num_samples * sizeof(uint16_t));
+    path->planar = malloc(num_samples * sizeof(float32_t));
+    path->time_ms = 0U;
+}
+
+/*******************************************************************************
+ * Function Name: path_free
+ ****************************************************************************//**
+ *
+ * @brief Releases the frame buffers.
+ *
+ * @param path Frame path.
+ *
+ *******************************************************************************/
+static void path_free(aoa_path_s *path)
+{
+    free(path->fifo);
+    free(path->planar);
+}
+
+/*******************************************************************************
+ * Function Name: path_run
+ ****************************************************************************//**
+ *
+ * @brief Runs frames through the FIFO unpacking, the de-interleaving, the
+ * chirp averaging and the angle of arrival estimation.
+ *
+ * @param path Frame path.
+ * @param aoa Estimator.
+ * @param gate Range gate.
+ * @param learn Background learning flag of all frames.
+ * @param num_frames Number of frames.
+ * @param result Result of the last frame.
+ *
+ *******************************************************************************/
+static void path_run(aoa_path_s *path, radar_aoa_s *aoa, const range_gate_s *gate, bool learn,
+                     uint32_t num_frames, radar_aoa_result_s *result)
+{
+    const radar_scene_sim_params_s *params = &path->sim.params;
+    const uint32_t samples_per_antenna = params->num_chirps_per_frame * params->num_samples_per_chirp;
+
+    for (uint32_t frame = 0U; frame < num_frames; frame++)
+    {
+        radar_scene_sim_frame(&path->sim, (uint8_t *)path->fifo);
+        radar_rx_unpack_fifo((const uint8_t *)path->fifo, path->fifo, samples_per_antenna * NUM_RX);
+        radar_rx_deinterleave(path->fifo, path->planar, NUM_RX, samples_per_antenna);
+        radar_rx_average_chirps(path->planar, path->avg_chirps, NUM_RX,
+                                params->num_chirps_per_frame, params->num_samples_per_chirp);
+
+        HOST_TEST_CHECK(radar_aoa_process(aoa, path->avg_chirps, NUM_RX, gate, learn,
+                                          path->time_ms, result) == 0);
+        path->time_ms += FRAME_PERIOD_MS;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: run_case
+ ****************************************************************************//**
+ *
+ * @brief Learns the background of the empty room, then lets the person in.
+ *
+ * @param test_case Scene.
+ * @param learn false to skip the background learning.
+ * @param gate Range gate.
+ * @param result Result of the last frame.
+ *
+ *******************************************************************************/
+static void run_case(const aoa_case_s *test_case, bool learn, const range_gate_s *gate,
+                     radar_aoa_result_s *result)
+{
+    radar_scene_sim_target_s targets[RADAR_SCENE_SIM_MAX_TARGETS];
+    radar_aoa_s *aoa = malloc(sizeof(radar_aoa_s));
+    aoa_path_s path;
+
+    HOST_TEST_CHECK(radar_aoa_init(aoa, 128U, BANDWIDTH_HZ, MACRO_BIN_LENGTH_M) == 0);
+    path_init(&path, 0x2468ACE1U);
+
+    for (uint32_t i = 0U; i < test_case->num_clutter; i++)
+    {
+        targets[i] = test_case->clutter[i];
+    }
+
+    (void)radar_scene_sim_set_targets(&path.sim, targets, test_case->num_clutter);
+    path_run(&path, aoa, gate, learn, NUM_LEARN_FRAMES, result);
+
+    /* a breathing person, the static part is not in the background */
+    targets[test_case->num_clutter] = (radar_scene_sim_target_s)
+    {
+        PERSON_RANGE_M, 0.0f, 0.002f, 0.25f, test_case->azimuth_deg, PERSON_AMPLITUDE, test_case->elevation_deg
+    };
+    (void)radar_scene_sim_set_targets(&path.sim, targets, test_case->num_clutter + 1U);
+    path_run(&path, aoa, gate, false, NUM_PERSON_FRAMES, result);
+
+    path_free(&path);
+    free(aoa);
+}
+
+/*******************************************************************************
+ * Function Name: test_known_angles
+ ****************************************************************************//**
+ *
+ * @brief Checks the angles and the range bin of a person in front of static
+ * clutter, also with a stronger reflector in the same range bin. Without the
+ * background the estimate is pulled towards the clutter.
+ *
+ *******************************************************************************/
+static void test_known_angles(void)
+{
+    const int32_t person_bin = (int32_t)lroundf(PERSON_RANGE_M / MACRO_BIN_LENGTH_M);
+    range_gate_s gate;
+
+    range_gate_compute(&gate, NUM_MACRO_BINS, 0, NUM_MACRO_BINS - 1, false);
+
+    for (size_t i = 0U; i < (sizeof(cases) / sizeof(cases[0])); i++)
+    {
+        const aoa_case_s *test_case = &cases[i];
+        radar_aoa_result_s result;
+        radar_aoa_result_s raw_result;
+        const radar_aoa_target_s *target;
+        const radar_aoa_target_s *raw_target;
+
+        run_case(test_case, true, &gate, &result);
+        run_case(test_case, false, &gate, &raw_result);
+
+        target = radar_aoa_find_target(&result, person_bin);
+        raw_target = radar_aoa_find_target(&raw_result, person_bin);
+        if (!HOST_TEST_CHECK((target != NULL) && (raw_target != NULL)))
+        {
+            continue;
+        }
+
+        printf("azimuth %5.1f elevation %5.1f: estimate %5.1f %5.1f in bin %d, without background %5.1f %5.1f\n",
+               (double)test_case->azimuth_deg, (double)test_case->elevation_deg,
+               (double)target->azimuth, (double)target->elevation, (int)target->range_bin,
+               (double)raw_target->azimuth, (double)raw_target->elevation);
+
+        HOST_TEST_CHECK(fabsf(target->azimuth - test_case->azimuth_deg) <= MAX_ANGLE_ERROR_DEG);
+        HOST_TEST_CHECK(fabsf(target->elevation - test_case->elevation_deg) <= MAX_ANGLE_ERROR_DEG);
+        HOST_TEST_CHECK(abs(target->range_bin - person_bin) <= 1);
+        HOST_TEST_CHECK(target == &result.targets[0]);
+
+        if (test_case->clutter == chair)
+        {
+            HOST_TEST_CHECK((fabsf(raw_target->azimuth - test_case->azimuth_deg) > MAX_ANGLE_ERROR_DEG) ||
+                            (fabsf(raw_target->elevation - test_case->elevation_deg) > MAX_ANGLE_ERROR_DEG));
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function Name: test_gate
+ ****************************************************************************//**
+ *
+ * @brief Checks that the gate in macro bins is mapped onto the chirp FFT:
+ * a gate behind the person does not report it, a gate around it does.
+ *
+ *******************************************************************************/
+static void test_gate(void)
+{
+    const int32_t person_bin = (int32_t)lroundf(PERSON_RANGE_M / MACRO_BIN_LENGTH_M);
+    radar_aoa_result_s result;
+    range_gate_s gate;
+
+    range_gate_compute(&gate, NUM_MACRO_BINS, person_bin + 4, NUM_MACRO_BINS - 1, true);
+    run_case(&cases[1], true, &gate, &result);
+    for (uint32_t i = 0U; i < result.num_targets; i++)
+    {
+        HOST_TEST_CHECK(result.targets[i].range_bin >= (gate.first_bin - 1));
+    }
+
+    range_gate_compute(&gate, NUM_MACRO_BINS, person_bin, person_bin, true);
+    run_case(&cases[1], true, &gate, &result);
+    HOST_TEST_CHECK((result.num_targets > 0U) && (abs(result.targets[0].range_bin - person_bin) <= 1));
+}
+
+/*******************************************************************************
+ * Function Name: test_invalid
+ ****************************************************************************//**
+ *
+ * @brief Checks the rejected parameters.
+ *
+ *******************************************************************************/
+static void test_invalid(void)
+{
+    static radar_aoa_s aoa;
+    static float32_t avg_chirps[NUM_RX * AOA_MAX_NUM_SAMPLES];
+    radar_aoa_result_s result;
+    range_gate_s gate;
+
+    HOST_TEST_CHECK(radar_aoa_init(&aoa, 256U, BANDWIDTH_HZ, MACRO_BIN_LENGTH_M) != 0);
+    HOST_TEST_CHECK(radar_aoa_init(&aoa, 100U, BANDWIDTH_HZ, MACRO_BIN_LENGTH_M) != 0);
+    HOST_TEST_CHECK(radar_aoa_init(&aoa, 128U, 0.0f, MACRO_BIN_LENGTH_M) != 0);
+    HOST_TEST_CHECK(radar_aoa_init(&aoa, 128U, BANDWIDTH_HZ, 0.0f) != 0);
+
+    HOST_TEST_CHECK(radar_aoa_init(&aoa, 128U, BANDWIDTH_HZ, MACRO_BIN_LENGTH_M) == 0);
+    range_gate_compute(&gate, NUM_MACRO_BINS, 0, NUM_MACRO_BINS - 1, false);
+    HOST_TEST_CHECK(radar_aoa_process(&aoa, avg_chirps, 2U, &gate, true, 0U, &result) != 0);
+    HOST_TEST_CHECK(radar_aoa_process(&aoa, avg_chirps, NUM_RX, &gate, true, 0U, &result) == 0);
+    HOST_TEST_CHECK(result.num_targets == 0U);
+}
+
+int main(void)
+{
+    test_known_angles();
+    test_gate();
+    test_invalid();
+
+    return host_test_result();
+}
@@ -0,0 +1,413 @@
+/*****************************************************************************
+ * File name: test_radar_rx.c
+ *
+ * Description: This file contains the host replay test of the multi-antenna path.
+ *   Synthetic three receiver frames of the scene simulator are replayed
+ *   through the de-interleaving, the chirp averaging and the phase aligned
+ *   combination of the antennas.
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "host_test.h"
+#include "radar_rx_processing.h"
+#include "radar_scene_sim.h"
+
+#define NUM_RX                  (3U)
+#define NUM_SAMPLES             (128U)
+#define NUM_CHIRPS              (16U)
+#define FRAME_PERIOD_MS         (100U)
+
+/* Frames to learn the phases, then measured frames */
+#define NUM_SETTLE_FRAMES       (40U)
+#define NUM_MEASURED_FRAMES     (40U)
+
+#define PERSON_RANGE_M          (2.0f)
+#define PERSON_AMPLITUDE        (400.0f)
+
+/* Combinations compared by the replay */
+typedef enum
+{
+    COMBINE_RX1,
+    COMBINE_AVERAGE,
+    COMBINE_ALIGNED,
+    COMBINE_NUM
+} combine_e;
+
+static const char * const combine_names[COMBINE_NUM] = { "rx1", "average", "aligned" };
+
+/* Buffers of the replayed frame path */
+static uint16_t fifo_data[NUM_RX * NUM_CHIRPS * NUM_SAMPLES];
+static float32_t planar[NUM_RX * NUM_CHIRPS * NUM_SAMPLES];
+static float32_t avg_chirps[NUM_RX * NUM_SAMPLES];
+static float32_t chirps[COMBINE_NUM][NUM_SAMPLES];
+static radar_rx_combiner_s combiner;
+static arm_rfft_fast_instance_f32 rfft;
+
+/*******************************************************************************
+ * Function Name: test_unpack
+ ****************************************************************************//**
+ *
+ * @brief Checks the bit order of the FIFO words, the unpacking in place and
+ * the packed frames of the simulator, whose samples scatter around the DC
+ * level only if the bit order matches.
+ *
+ *******************************************************************************/
+static void test_unpack(void)
+{
+    static const uint8_t words[] = { 0xABU, 0xCDU, 0xEFU, 0x01U, 0x23U, 0x45U };
+    static const uint16_t expected[] = { 0xABCU, 0xDEFU, 0x012U, 0x345U };
+    static uint8_t packed[RADAR_SCENE_SIM_FIFO_BYTES(NUM_RX * NUM_CHIRPS * NUM_SAMPLES)];
+    static uint16_t reference[NUM_RX * NUM_CHIRPS * NUM_SAMPLES];
+    const uint32_t num_samples = NUM_RX * NUM_CHIRPS * NUM_SAMPLES;
+    uint16_t samples[4];
+    radar_scene_sim_s sim;
+    uint32_t seed = 0x2468ACEU;
+    bool in_range = true;
+    double mean = 0.0;
+
+    radar_rx_unpack_fifo(words, samples, 4U);
+    HOST_TEST_CHECK(memcmp(samples, expected, sizeof(expected)) == 0);
+
+    /* reference packing of random samples, unpacked out of place and in place */
+    for (uint32_t n = 0U; n < num_samples; n++)
+    {
+        reference[n] = (uint16_t)(host_test_random(&seed) & 0xFFFU);
+    }
+    for (uint32_t n = 0U; n < num_samples; n += 2U)
+    {
+        uint32_t word = ((uint32_t)reference[n] << 12) | reference[n + 1U];
+
+        packed[(3U * n) / 2U] = (uint8_t)(word >> 16);
+        packed[((3U * n) / 2U) + 1U] = (uint8_t)(word >> 8);
+        packed[((3U * n) / 2U) + 2U] = (uint8_t)word;
+    }
+
+    radar_rx_unpack_fifo(packed, fifo_data, num_samples);
+    HOST_TEST_CHECK(memcmp(fifo_data, reference, sizeof(reference)) == 0);
+
+    memcpy(fifo_data, packed, sizeof(packed));
+    radar_rx_unpack_fifo((const uint8_t *)fifo_data, fifo_data, num_samples);
+    HOST_TEST_CHECK(memcmp(fifo_data, reference, sizeof(reference)) == 0);
+
+    radar_scene_sim_init(&sim, 0x13579BDU);
+    sim.params.num_rx_antennas = NUM_RX;
+    radar_scene_sim_frame(&sim, packed);
+    radar_rx_unpack_fifo(packed, fifo_data, num_samples);
+
+    for (uint32_t n = 0U; n < num_samples; n++)
+    {
+        in_range &= (fabsf((float32_t)fifo_data[n] - sim.dc_level) <= (sim.noise_level + 1.0f));
+        mean += fifo_data[n];
+    }
+    mean /= num_samples;
+
+    HOST_TEST_CHECK(in_range);
+    HOST_TEST_CHECK(fabs(mean - sim.dc_level) < 0.5);
+}
+
+/*******************************************************************************
+ * Function Name: test_deinterleave
+ ****************************************************************************//**
+ *
+ * @brief Compares the de-interleaving and the chirp averaging with a plain
+ * reference, for the unrolled three antenna loop with an odd number of
+ * samples and for the generic loop.
+ *
+ *******************************************************************************/
+static void test_deinterleave(void)
+{
+    static const uint32_t num_samples[] = { 128U, 17U };
+    uint32_t seed = 0x1234567U;
+
+    for (uint32_t num_rx = 1U; num_rx <= NUM_RX; num_rx++)
+    {
+        for (size_t i = 0; i < (sizeof(num_samples) / sizeof(num_samples[0])); i++)
+        {
+            const uint32_t samples_per_antenna = NUM_CHIRPS * num_samples[i];
+            bool planar_equal = true;
+            bool average_equal = true;
+
+            for (uint32_t n = 0U; n < (num_rx * samples_per_antenna); n++)
+            {
+                fifo_data[n] = (uint16_t)(host_test_random(&seed) & 0xFFFU);
+            }
+
+            radar_rx_deinterleave(fifo_data, planar, num_rx, samples_per_antenna);
+            radar_rx_average_chirps(planar, avg_chirps, num_rx, NUM_CHIRPS, num_samples[i]);
+
+            for (uint32_t rx = 0U; rx < num_rx; rx++)
+            {
+                for (uint32_t n = 0U; n < samples_per_antenna; n++)
+                {
+                    planar_equal &= (planar[(rx * samples_per_antenna) + n] ==
+                                     ((float32_t)fifo_data[(n * num_rx) + rx] / 4096.0f));
+                }
+
+                for (uint32_t n = 0U; n < num_samples[i]; n++)
+                {
+                    float32_t sum = 0.0f;
+
+                    for (uint32_t chirp = 0U; chirp < NUM_CHIRPS; chirp++)
+                    {
+                        sum += (float32_t)fifo_data[(((chirp * num_samples[i]) + n) * num_rx) + rx] / 4096.0f;
+                    }
+
+                    average_equal &= (fabsf(avg_chirps[(rx * num_samples[i]) + n] - (sum / NUM_CHIRPS)) < 1E-5f);
+                }
+            }
+
+            HOST_TEST_CHECK(planar_equal);
+            HOST_TEST_CHECK(average_equal);
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function Name: test_identity
+ ****************************************************************************//**
+ *
+ * @brief A single antenna passes unchanged, and so do antennas which see the
+ * same chirp.
+ *
+ *******************************************************************************/
+static void test_identity(void)
+{
+    uint32_t seed = 0xBEEFU;
+    float32_t max_error = 0.0f;
+
+    for (uint32_t n = 0U; n < NUM_SAMPLES; n++)
+    {
+        avg_chirps[n] = 0.5f + (0.001f * (float32_t)(host_test_random(&seed) % 1000U));
+        avg_chirps[NUM_SAMPLES + n] = avg_chirps[n];
+        avg_chirps[(2U * NUM_SAMPLES) + n] = avg_chirps[n];
+    }
+
+    HOST_TEST_CHECK(radar_rx_combiner_init(&combiner, 1U, NUM_SAMPLES) == 0);
+    radar_rx_combine(&combiner, avg_chirps, chirps[COMBINE_ALIGNED], 0U);
+    HOST_TEST_CHECK(memcmp(avg_chirps, chirps[COMBINE_ALIGNED], sizeof(chirps[COMBINE_ALIGNED])) == 0);
+
+    HOST_TEST_CHECK(radar_rx_combiner_init(&combiner, NUM_RX, NUM_SAMPLES) == 0);
+    for (uint32_t frame = 0U; frame < 3U; frame++)
+    {
+        radar_rx_combine(&combiner, avg_chirps, chirps[COMBINE_ALIGNED], frame * FRAME_PERIOD_MS);
+    }
+
+    for (uint32_t n = 0U; n < NUM_SAMPLES; n++)
+    {
+        max_error = fmaxf(max_error, fabsf(chirps[COMBINE_ALIGNED][n] - avg_chirps[n]));
+    }
+    HOST_TEST_CHECK(max_error < 1E-4f);
+
+    HOST_TEST_CHECK(radar_rx_combiner_init(&combiner, 4U, NUM_SAMPLES) != 0);
+    HOST_TEST_CHECK(radar_rx_combiner_init(&combiner, NUM_RX, 256U) != 0);
+    HOST_TEST_CHECK(radar_rx_combiner_init(&combiner, NUM_RX, 100U) != 0);
+}
+
+/*******************************************************************************
+ * Function Name: replay
+ ****************************************************************************//**
+ *
+ * @brief Replays frames of a static scene through the frame path. The range
+ * bin of the person is split into its mean over the frames, the echo, and
+ * the variation around it, the receiver noise. The leakage of the targets
+ * into the other bins is part of the mean, so it does not count as noise.
+ *
+ * @param targets Targets of the scene.
+ * @param num_targets Number of targets.
+ * @param person_bin Range bin of the chirp FFT of the person.
+ * @param signal Power of the mean of the range bin per combination.
+ * @param noise Variance of the range bin per combination.
+ * @param change Mean squared change of the combined chirp from frame to frame.
+ *
+ *******************************************************************************/
+static void replay(const radar_scene_sim_target_s *targets, uint32_t num_targets, uint32_t person_bin,
+                   double *signal, double *noise, double *change)
+{
+    static float32_t previous[COMBINE_NUM][NUM_SAMPLES];
+    double sum_re[COMBINE_NUM] = { 0.0 };
+    double sum_im[COMBINE_NUM] = { 0.0 };
+    double sum_power[COMBINE_NUM] = { 0.0 };
+    radar_scene_sim_s sim;
+    float32_t fft_in[NUM_SAMPLES];
+    float32_t spectrum[NUM_SAMPLES];
+
+    radar_scene_sim_init(&sim, 0x600DF00DU);
+    sim.params.num_rx_antennas = NUM_RX;
+    (void)radar_scene_sim_set_targets(&sim, targets, num_targets);
+    HOST_TEST_CHECK(radar_rx_combiner_init(&combiner, NUM_RX, NUM_SAMPLES) == 0);
+
+    for (uint32_t c = 0U; c < COMBINE_NUM; c++)
+    {
+        change[c] = 0.0;
+    }
+
+    for (uint32_t frame = 0U; frame < (NUM_SETTLE_FRAMES + NUM_MEASURED_FRAMES); frame++)
+    {
+        radar_scene_sim_frame(&sim, (uint8_t *)fifo_data);
+        radar_rx_unpack_fifo((const uint8_t *)fifo_data, fifo_data, NUM_RX * NUM_CHIRPS * NUM_SAMPLES);
+        radar_rx_deinterleave(fifo_data, planar, NUM_RX, NUM_CHIRPS * NUM_SAMPLES);
+        radar_rx_average_chirps(planar, avg_chirps, NUM_RX, NUM_CHIRPS, NUM_SAMPLES);
+
+        memcpy(chirps[COMBINE_RX1], avg_chirps, sizeof(chirps[COMBINE_RX1]));
+        for (uint32_t n = 0U; n < NUM_SAMPLES; n++)
+        {
+            chirps[COMBINE_AVERAGE][n] = (avg_chirps[n] + avg_chirps[NUM_SAMPLES + n] +
+                                          avg_chirps[(2U * NUM_SAMPLES) + n]) / (float32_t)NUM_RX;
+        }
+        radar_rx_combine(&combiner, avg_chirps, chirps[COMBINE_ALIGNED], frame * FRAME_PERIOD_MS);
+
+        for (uint32_t c = 0U; (c < COMBINE_NUM) && (frame >= NUM_SETTLE_FRAMES); c++)
+        {
+            memcpy(fft_in, chirps[c], sizeof(fft_in));
+            arm_rfft_fast_f32(&rfft, fft_in, spectrum, 0);
+
+            sum_re[c] += spectrum[2U * person_bin];
+            sum_im[c] += spectrum[(2U * person_bin) + 1U];
+            sum_power[c] += ((spectrum[2U * person_bin] * spectrum[2U * person_bin]) +
+                             (spectrum[(2U * person_bin) + 1U] * spectrum[(2U * person_bin) + 1U]));
+
+            for (uint32_t n = 0U; n < NUM_SAMPLES; n++)
+            {
+                float32_t delta = chirps[c][n] - previous[c][n];
+
+                change[c] += (double)(delta * delta) / (NUM_MEASURED_FRAMES * NUM_SAMPLES);
+            }
+        }
+
+        memcpy(previous, chirps, sizeof(previous));
+    }
+
+    for (uint32_t c = 0U; c < COMBINE_NUM; c++)
+    {
+        double mean_re = sum_re[c] / NUM_MEASURED_FRAMES;
+        double mean_im = sum_im[c] / NUM_MEASURED_FRAMES;
+
+        signal[c] = (mean_re * mean_re) + (mean_im * mean_im);
+        noise[c] = (sum_power[c] / NUM_MEASURED_FRAMES) - signal[c];
+    }
+}
+
+/*******************************************************************************
+ * Function Name: test_snr
+ ****************************************************************************//**
+ *
+ * @brief Replays a person at several angles in front of a cabinet. The
+ * aligned combination gains close to 10 log10(3) dB over a single antenna
+ * from every direction, the plain average loses the gain off boresight.
+ *
+ *******************************************************************************/
+static void test_snr(void)
+{
+    /* azimuth, elevation */
+    static const float32_t angles[][2] =
+    {
+        { 0.0f, 0.0f }, { 20.0f, 0.0f }, { 41.8f, 0.0f }, { -30.0f, 25.0f }, { 60.0f, -40.0f }
+    };
+    const uint32_t person_bin = (uint32_t)lroundf(PERSON_RANGE_M / (299792458.0f / (2.0f * 459.8E6f)));
+
+    for (size_t i = 0; i < (sizeof(angles) / sizeof(angles[0])); i++)
+    {
+        const radar_scene_sim_target_s targets[] =
+        {
+            { 3.5f, 0.0f, 0.0f, 0.0f, 30.0f, 1500.0f, 0.0f },
+            { PERSON_RANGE_M, 0.0f, 0.0f, 0.0f, angles[i][0], PERSON_AMPLITUDE, angles[i][1] }
+        };
+        double signal[COMBINE_NUM];
+        double noise[COMBINE_NUM];
+        double change[COMBINE_NUM];
+        double snr_db[COMBINE_NUM];
+
+        replay(targets, 2U, person_bin, signal, noise, change);
+
+        printf("azimuth %5.1f elevation %5.1f: SNR", (double)angles[i][0], (double)angles[i][1]);
+        for (uint32_t c = 0U; c < COMBINE_NUM; c++)
+        {
+            snr_db[c] = 10.0 * log10(signal[c] / noise[c]);
+            printf(" %s %.1f dB", combine_names[c], snr_db[c]);
+        }
+        printf("\n");
+
+        HOST_TEST_CHECK(snr_db[COMBINE_ALIGNED] >= (snr_db[COMBINE_RX1] + 4.0));
+        HOST_TEST_CHECK(snr_db[COMBINE_ALIGNED] >= (snr_db[COMBINE_AVERAGE] - 0.5));
+        if (angles[i][0] == 41.8f)
+        {
+            HOST_TEST_CHECK(snr_db[COMBINE_ALIGNED] >= (snr_db[COMBINE_AVERAGE] + 3.0));
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function Name: test_static_scene
+ ****************************************************************************//**
+ *
+ * @brief The aligned combination of a static scene changes from frame to
+ * frame by the receiver noise only, like the plain average, so it does not
+ * look like movement to the presence detection.
+ *
+ *******************************************************************************/
+static void test_static_scene(void)
+{
+    const radar_scene_sim_target_s targets[] =
+    {
+        { 2.2f, 0.0f, 0.0f, 0.0f, 30.0f, 1500.0f, 0.0f },
+        { 4.0f, 0.0f, 0.0f, 0.0f, -50.0f, 2000.0f, 10.0f }
+    };
+    double signal[COMBINE_NUM];
+    double noise[COMBINE_NUM];
+    double change[COMBINE_NUM];
+
+    replay(targets, 2U, 7U, signal, noise, change);
+
+    printf("static scene: rms change per frame average %.2e aligned %.2e\n",
+           sqrt(change[COMBINE_AVERAGE]), sqrt(change[COMBINE_ALIGNED]));
+    HOST_TEST_CHECK(change[COMBINE_ALIGNED] <= (1.2 * change[COMBINE_AVERAGE]));
+}
+
+int main(void)
+{
+    HOST_TEST_CHECK(arm_rfft_fast_init_f32(&rfft, NUM_SAMPLES) == ARM_MATH_SUCCESS);
+
+    test_unpack();
+    test_deinterleave();
+    test_identity();
+    test_snr();
+    test_static_scene();
+
+    return host_test_result();
+}
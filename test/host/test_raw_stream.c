@@ -0,0 +1,373 @@
+/*****************************************************************************
+ * File name: test_raw_stream.c
+ *
+ * Description: This file contains the host test of the raw stream compression.
+ *   Frames of the scene simulator, random frames and extreme frames
+ *   are compressed and decoded again by the C counterpart of
+ *   scripts/raw_stream_decode.py, which must give the samples back bit exact.
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "host_test.h"
+#include "radar_rx_processing.h"
+#include "radar_scene_sim.h"
+#include "raw_stream.h"
+#include "selftest_scenarios.h"
+
+/* Format of scripts/raw_stream_decode.py */
+#define DECODE_SAMPLE_BITS          (12U)
+#define DECODE_K_BITS               (4U)
+#define DECODE_K_RAW                (15U)
+#define DECODE_ESCAPE               (16U)
+#define DECODE_ESCAPE_BITS          (DECODE_SAMPLE_BITS + 1U)
+
+#define RANDOM_FRAMES               (200U)
+#define RANDOM_SEED                 (0x4A5D4A5DU)
+
+/* MSB first bit reader, the counterpart of raw_stream_put_bits */
+typedef struct
+{
+    const uint8_t *data;
+    size_t size;
+    size_t bit;
+    bool truncated;
+} decode_reader_s;
+
+/*
+ * Bytes of a class of frames
+ * frames - compressed frames
+ * raw_bytes - size of the samples with 12 bits each
+ * compressed_bytes - size of the compressed frames
+ */
+typedef struct
+{
+    uint32_t frames;
+    uint64_t raw_bytes;
+    uint64_t compressed_bytes;
+} frame_class_s;
+
+static uint16_t samples[RAW_STREAM_MAX_SAMPLES];
+static uint16_t decoded[RAW_STREAM_MAX_SAMPLES];
+static uint8_t compressed[RAW_STREAM_MAX_FRAME_SIZE];
+static radar_scene_sim_s sim;
+
+/*******************************************************************************
+ * Function Name: decode_read
+ ****************************************************************************//**
+ *
+ * @param reader Bit reader.
+ * @param count Number of bits.
+ *
+ * @return Next bits of the stream, 0 and truncated set past its end.
+ *
+ *******************************************************************************/
+static uint32_t decode_read(decode_reader_s *reader, uint32_t count)
+{
+    uint32_t value = 0U;
+
+    for (uint32_t i = 0U; i < count; i++, reader->bit++)
+    {
+        if ((reader->bit / 8U) >= reader->size)
+        {
+            reader->truncated = true;
+            return 0U;
+        }
+
+        value = (value << 1) | ((reader->data[reader->bit / 8U] >> (7U - (reader->bit % 8U))) & 1U);
+    }
+
+    return value;
+}
+
+/*******************************************************************************
+ * Function Name: decode_samples
+ ****************************************************************************//**
+ *
+ * @brief Decodes the samples like decompress() of scripts/raw_stream_decode.py.
+ *
+ * @param data Compressed samples.
+ * @param size Number of bytes.
+ * @param num_blocks Number of blocks.
+ * @param block_size Number of samples per block.
+ * @param stride Number of interleaved antennas.
+ * @param dst Decoded samples.
+ *
+ * @return true if the stream held all samples and every sample has 12 bits.
+ *
+ *******************************************************************************/
+static bool decode_samples(const uint8_t *data, size_t size, uint32_t num_blocks, uint32_t block_size,
+                           uint32_t stride, uint16_t *dst)
+{
+    decode_reader_s reader = { data, size, 0U, false };
+
+    for (uint32_t block = 0U; block < num_blocks; block++, dst += block_size)
+    {
+        uint32_t k = decode_read(&reader, DECODE_K_BITS);
+
+        if (k == DECODE_K_RAW)
+        {
+            for (uint32_t i = 0U; i < block_size; i++)
+            {
+                dst[i] = (uint16_t)decode_read(&reader, DECODE_SAMPLE_BITS);
+            }
+            continue;
+        }
+
+        for (uint32_t i = 0U; i < stride; i++)
+        {
+            dst[i] = (uint16_t)decode_read(&reader, DECODE_SAMPLE_BITS);
+        }
+
+        for (uint32_t i = stride; i < block_size; i++)
+        {
+            uint32_t quotient = 0U;
+            uint32_t residual;
+            int32_t value;
+
+            while ((quotient < DECODE_ESCAPE) && (decode_read(&reader, 1U) != 0U))
+            {
+                quotient++;
+            }
+
+            if (quotient == DECODE_ESCAPE)
+            {
+                residual = decode_read(&reader, DECODE_ESCAPE_BITS);
+            }
+            else
+            {
+                residual = (quotient << k) | decode_read(&reader, k);
+            }
+
+            value = (int32_t)dst[i - stride] + ((int32_t)(residual >> 1) ^ -(int32_t)(residual & 1U));
+            if ((value < 0) || (value >= (1 << DECODE_SAMPLE_BITS)))
+            {
+                return false;
+            }
+            dst[i] = (uint16_t)value;
+        }
+    }
+
+    /* only the padding to a byte may follow */
+    return !reader.truncated && (((size * 8U) - reader.bit) < 8U);
+}
+
+/*******************************************************************************
+ * Function Name: round_trip
+ ****************************************************************************//**
+ *
+ * @brief Compresses a frame, decodes it and checks it bit exact, and that a
+ * destination one byte too small is refused.
+ *
+ * @param num_blocks Number of blocks.
+ * @param block_size Number of samples per block.
+ * @param stride Number of interleaved antennas.
+ * @param frame_class Counters of the class of the frame.
+ *
+ *******************************************************************************/
+static void round_trip(uint32_t num_blocks, uint32_t block_size, uint32_t stride, frame_class_s *frame_class)
+{
+    uint32_t num_samples = num_blocks * block_size;
+    size_t size = raw_stream_compress(samples, num_blocks, block_size, stride, compressed, sizeof(compressed));
+
+    HOST_TEST_CHECK(size > 0U);
+    HOST_TEST_CHECK(raw_stream_compress(samples, num_blocks, block_size, stride, compressed, size - 1U) == 0U);
+    (void)raw_stream_compress(samples, num_blocks, block_size, stride, compressed, size);
+
+    memset(decoded, 0xFF, sizeof(decoded));
+    HOST_TEST_CHECK(decode_samples(compressed, size, num_blocks, block_size, stride, decoded));
+    HOST_TEST_CHECK(memcmp(samples, decoded, num_samples * sizeof(uint16_t)) == 0);
+
+    frame_class->frames++;
+    frame_class->raw_bytes += (num_samples * DECODE_SAMPLE_BITS) / 8U;
+    frame_class->compressed_bytes += size;
+}
+
+/*******************************************************************************
+ * Function Name: report
+ ****************************************************************************//**
+ *
+ * @brief Prints the compression ratio of a class of frames.
+ *
+ *******************************************************************************/
+static void report(const char *name, const frame_class_s *frame_class)
+{
+    printf("%-12s %4u frames, 12 bit samples %8llu bytes, compressed %8llu bytes, ratio %.2f\n",
+           name, (unsigned int)frame_class->frames, (unsigned long long)frame_class->raw_bytes,
+           (unsigned long long)frame_class->compressed_bytes,
+           (double)frame_class->raw_bytes / (double)frame_class->compressed_bytes);
+}
+
+/*******************************************************************************
+ * Function Name: test_scene_sim
+ ****************************************************************************//**
+ *
+ * @brief Frames of the selftest scenarios as the FIFO delivers them.
+ *
+ *******************************************************************************/
+static void test_scene_sim(void)
+{
+    frame_class_s frame_class = { 0 };
+    uint32_t num_scenarios;
+    const selftest_scenario_s *scenarios = selftest_scenarios_get(&num_scenarios);
+
+    for (uint32_t s = 0U; s < num_scenarios; s++)
+    {
+        radar_scene_sim_init(&sim, SELFTEST_SEED);
+
+        uint32_t num_rx = sim.params.num_rx_antennas;
+        uint32_t num_chirps = sim.params.num_chirps_per_frame;
+        uint32_t block_size = sim.params.num_samples_per_chirp * num_rx;
+
+        HOST_TEST_CHECK((num_chirps * block_size) <= RAW_STREAM_MAX_SAMPLES);
+
+        for (uint32_t i = 0U; i < scenarios[s].num_segments; i++)
+        {
+            const selftest_segment_s *segment = &scenarios[s].segments[i];
+
+            (void)radar_scene_sim_set_targets(&sim, segment->targets, segment->num_targets);
+
+            for (uint32_t n = 0U; n < segment->num_frames; n++)
+            {
+                radar_scene_sim_frame(&sim, (uint8_t *)samples);
+                radar_rx_unpack_fifo((const uint8_t *)samples, samples, num_chirps * block_size);
+                round_trip(num_chirps, block_size, num_rx, &frame_class);
+            }
+        }
+    }
+
+    report("scene_sim", &frame_class);
+    HOST_TEST_CHECK(frame_class.compressed_bytes < frame_class.raw_bytes);
+}
+
+/*******************************************************************************
+ * Function Name: test_random
+ ****************************************************************************//**
+ *
+ * @brief Uniform 12 bit noise with one and three antennas, stored raw.
+ *
+ *******************************************************************************/
+static void test_random(void)
+{
+    frame_class_s frame_class = { 0 };
+    uint32_t seed = RANDOM_SEED;
+
+    for (uint32_t frame = 0U; frame < RANDOM_FRAMES; frame++)
+    {
+        uint32_t stride = ((frame % 2U) == 0U) ? 1U : 3U;
+        uint32_t block_size = 128U * stride;
+        uint32_t num_blocks = RAW_STREAM_MAX_SAMPLES / block_size;
+
+        for (uint32_t i = 0U; i < (num_blocks * block_size); i++)
+        {
+            samples[i] = (uint16_t)(host_test_random(&seed) & 0x0FFFU);
+        }
+
+        round_trip(num_blocks, block_size, stride, &frame_class);
+    }
+
+    report("random", &frame_class);
+}
+
+/*******************************************************************************
+ * Function Name: test_extreme
+ ****************************************************************************//**
+ *
+ * @brief Constant frames at both ends of the range, full scale steps which
+ * escape, single spikes, ramps and the smallest blocks. A block which is not
+ * longer than the stride is refused.
+ *
+ *******************************************************************************/
+static void test_extreme(void)
+{
+    frame_class_s frame_class = { 0 };
+    const uint32_t num_blocks = 16U;
+    const uint32_t block_size = 128U;
+
+    for (uint32_t pattern = 0U; pattern < 7U; pattern++)
+    {
+        for (uint32_t i = 0U; i < (num_blocks * block_size); i++)
+        {
+            switch (pattern)
+            {
+                case 0U:
+                    samples[i] = 0U;
+                    break;
+                case 1U:
+                    samples[i] = 0x0FFFU;
+                    break;
+                case 2U:
+                    /* every difference is full scale, the coded block escapes */
+                    samples[i] = ((i % 2U) == 0U) ? 0U : 0x0FFFU;
+                    break;
+                case 3U:
+                    samples[i] = ((i % 97U) == 0U) ? 0x0FFFU : 2048U;
+                    break;
+                case 4U:
+                    samples[i] = (uint16_t)((i * 32U) & 0x0FFFU);
+                    break;
+                case 5U:
+                    /* mostly small differences with a full scale jump, coded with escapes */
+                    samples[i] = ((i % block_size) < (block_size / 2U)) ? (uint16_t)(i % 4U) : (uint16_t)(0x0FFFU - (i % 4U));
+                    break;
+                default:
+                    samples[i] = (uint16_t)(2048U + ((i % 3U) * 1000U));
+                    break;
+            }
+        }
+
+        round_trip(num_blocks, block_size, 1U, &frame_class);
+        round_trip(num_blocks, block_size, 2U, &frame_class);
+        round_trip((num_blocks * block_size) / 3U, 3U, 2U, &frame_class);
+        round_trip(1U, 2U, 1U, &frame_class);
+    }
+
+    report("extreme", &frame_class);
+
+    /* a block needs a difference */
+    HOST_TEST_CHECK(raw_stream_compress(samples, 1U, 2U, 2U, compressed, sizeof(compressed)) == 0U);
+    HOST_TEST_CHECK(raw_stream_compress(samples, 1U, 2U, 0U, compressed, sizeof(compressed)) == 0U);
+}
+
+int main(void)
+{
+    test_scene_sim();
+    test_random();
+    test_extreme();
+
+    return host_test_result();
+}
@@ -0,0 +1,176 @@
+/*****************************************************************************
+ * File name: test_vital_signs.c
+ *
+ * Description: This file contains the tests of the breathing rate estimation
+ *   with a synthetic breathing phase at the range bin of a person
+ *
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "host_test.h"
+#include "presence_vital_signs.h"
+
+/* Frame period of the low frame rate configuration */
+#define FRAME_PERIOD_MS         (100U)
+
+/* Range bins of the synthetic macro FFT buffer and bin of the person */
+#define NUM_RANGE_BINS          (8)
+#define PERSON_RANGE_BIN        (3)
+
+/* Frames which fill the settle time and the window */
+#define NUM_FILL_FRAMES         ((((VITAL_SETTLE_SAMPLES + VITAL_WINDOW_LENGTH) * VITAL_SAMPLE_PERIOD_MS) / \
+                                  FRAME_PERIOD_MS) + 10U)
+
+static presence_vital_signs_state_s vital;
+
+/*******************************************************************************
+ * Function Name: feed_breathing
+ ****************************************************************************//**
+ *
+ * @brief Feeds frames with a sinusoidal chest displacement. The phase swings
+ * by more than pi around a static offset near pi, so the unwrapping is used.
+ *
+ * @param rate_bpm Breathing rate, 0 for a person without breathing.
+ * @param amplitude_rad Amplitude of the phase.
+ * @param noise_rad Amplitude of the uniform phase noise.
+ * @param start_ms Timestamp of the first frame.
+ * @param num_frames Number of frames.
+ * @param seed State of the noise generator.
+ *
+ * @return Timestamp after the last frame.
+ *
+ *******************************************************************************/
+static uint32_t feed_breathing(float32_t rate_bpm, float32_t amplitude_rad, float32_t noise_rad,
+                               uint32_t start_ms, uint32_t num_frames, uint32_t *seed)
+{
+    cfloat32_t macro_fft[NUM_RANGE_BINS];
+    uint32_t time_ms = start_ms;
+
+    memset(macro_fft, 0, sizeof(macro_fft));
+
+    for (uint32_t frame = 0; frame < num_frames; ++frame)
+    {
+        float32_t t = (float32_t)time_ms * 1E-3f;
+        float32_t noise = noise_rad * (((float32_t)(host_test_random(seed) % 2001U) / 1000.0f) - 1.0f);
+        float32_t phase = 3.0f + (amplitude_rad * sinf(2.0f * PI * rate_bpm / 60.0f * t)) + noise;
+
+        macro_fft[PERSON_RANGE_BIN].real = 50.0f * cosf(phase);
+        macro_fft[PERSON_RANGE_BIN].imag = 50.0f * sinf(phase);
+
+        presence_vital_signs_process(&vital, macro_fft, PERSON_RANGE_BIN, time_ms);
+        time_ms += FRAME_PERIOD_MS;
+    }
+
+    return time_ms;
+}
+
+/*******************************************************************************
+ * Function Name: test_rates
+ ****************************************************************************//**
+ *
+ * @brief Checks the estimated rate and the confidence of clean breathing
+ * tones across the band.
+ *
+ *******************************************************************************/
+static void test_rates(void)
+{
+    static const float32_t rates_bpm[] = { 15.0f, 8.0f, 12.5f, 22.0f, 30.0f };
+    uint32_t seed = 0x12345678U;
+
+    for (size_t i = 0; i < (sizeof(rates_bpm) / sizeof(rates_bpm[0])); ++i)
+    {
+        presence_vital_signs_s result;
+        bool valid;
+
+        presence_vital_signs_enable(&vital, true);
+        (void)feed_breathing(rates_bpm[i], 2.5f, 0.05f, 1000U, NUM_FILL_FRAMES, &seed);
+        valid = presence_vital_signs_get(&vital, &result);
+
+        printf("%.1f bpm: estimate %.2f bpm, confidence %.2f\n",
+               (double)rates_bpm[i], (double)result.rate_bpm, (double)result.confidence);
+        HOST_TEST_CHECK(valid);
+        HOST_TEST_CHECK(fabsf(result.rate_bpm - rates_bpm[i]) <= 0.5f);
+        HOST_TEST_CHECK(result.confidence >= 0.8f);
+        HOST_TEST_CHECK(result.range_bin == PERSON_RANGE_BIN);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: test_rejection
+ ****************************************************************************//**
+ *
+ * @brief Checks that phase noise without breathing, a partial window and a
+ * restart after a frame gap are not reported.
+ *
+ *******************************************************************************/
+static void test_rejection(void)
+{
+    presence_vital_signs_s result;
+    uint32_t seed = 0xCAFEF00DU;
+    uint32_t time_ms;
+
+    /* noise only, the energy spreads over the whole band */
+    presence_vital_signs_enable(&vital, true);
+    (void)feed_breathing(0.0f, 0.0f, 0.5f, 1000U, NUM_FILL_FRAMES, &seed);
+    HOST_TEST_CHECK(!presence_vital_signs_get(&vital, &result));
+    HOST_TEST_CHECK(result.confidence < VITAL_MIN_CONFIDENCE);
+
+    /* half a window */
+    presence_vital_signs_enable(&vital, true);
+    time_ms = feed_breathing(15.0f, 2.5f, 0.05f, 1000U, NUM_FILL_FRAMES / 2U, &seed);
+    HOST_TEST_CHECK(!presence_vital_signs_get(&vital, &result));
+
+    /* a full window after a gap of two seconds restarts the history */
+    time_ms = feed_breathing(15.0f, 2.5f, 0.05f, time_ms, NUM_FILL_FRAMES, &seed);
+    HOST_TEST_CHECK(presence_vital_signs_get(&vital, &result));
+    (void)feed_breathing(15.0f, 2.5f, 0.05f, time_ms + 2000U, 10U, &seed);
+    HOST_TEST_CHECK(!presence_vital_signs_get(&vital, &result));
+
+    /* disabled */
+    presence_vital_signs_enable(&vital, false);
+    (void)feed_breathing(15.0f, 2.5f, 0.05f, 1000U, NUM_FILL_FRAMES, &seed);
+    HOST_TEST_CHECK(!presence_vital_signs_get(&vital, &result));
+}
+
+int main(void)
+{
+    HOST_TEST_CHECK(presence_vital_signs_init(&vital) == 0);
+
+    test_rates();
+    test_rejection();
+
+    return host_test_result();
+}